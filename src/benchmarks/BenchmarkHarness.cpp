@@ -0,0 +1,407 @@
+#include "BenchmarkHarness.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+std::string EscapeJson(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Just enough JSON to read back what WriteJson writes, or a hand-edited copy of it
+struct JsonValue {
+    enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+    Type type = Type::kNull;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    [[nodiscard]] const JsonValue* Find(const std::string& key) const
+    {
+        for (const auto& [member_key, value] : object) {
+            if (member_key == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(const std::string& text) : m_text_(text) {}
+
+    bool Parse(JsonValue& value)
+    {
+        if (!ParseValue(value)) {
+            return false;
+        }
+        SkipWhitespace();
+        return m_position_ == m_text_.size();
+    }
+
+private:
+    void SkipWhitespace()
+    {
+        while (m_position_ < m_text_.size() && std::isspace(static_cast<unsigned char>(m_text_[m_position_]))) {
+            ++m_position_;
+        }
+    }
+
+    bool Consume(char expected)
+    {
+        SkipWhitespace();
+        if (m_position_ < m_text_.size() && m_text_[m_position_] == expected) {
+            ++m_position_;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConsumeWord(const char* word)
+    {
+        const size_t length = std::char_traits<char>::length(word);
+        if (m_text_.compare(m_position_, length, word) != 0) {
+            return false;
+        }
+        m_position_ += length;
+        return true;
+    }
+
+    bool ParseString(std::string& out)
+    {
+        if (!Consume('"')) {
+            return false;
+        }
+        out.clear();
+        while (m_position_ < m_text_.size()) {
+            const char c = m_text_[m_position_++];
+            if (c == '"') {
+                return true;
+            }
+            if (c == '\\') {
+                if (m_position_ >= m_text_.size()) {
+                    return false;
+                }
+                const char escaped = m_text_[m_position_++];
+                if (escaped == 'n') {
+                    out += '\n';
+                } else if (escaped == 't') {
+                    out += '\t';
+                } else if (escaped == 'u') {
+                    m_position_ = std::min(m_position_ + 4, m_text_.size());  // Names are ASCII; keep a placeholder
+                    out += '?';
+                } else {
+                    out += escaped;
+                }
+            } else {
+                out += c;
+            }
+        }
+        return false;
+    }
+
+    bool ParseValue(JsonValue& value)
+    {
+        SkipWhitespace();
+        if (m_position_ >= m_text_.size()) {
+            return false;
+        }
+        const char c = m_text_[m_position_];
+        if (c == '{') {
+            value.type = JsonValue::Type::kObject;
+            ++m_position_;
+            if (Consume('}')) {
+                return true;
+            }
+            do {
+                std::pair<std::string, JsonValue> member;
+                if (!ParseString(member.first) || !Consume(':') || !ParseValue(member.second)) {
+                    return false;
+                }
+                value.object.push_back(std::move(member));
+            } while (Consume(','));
+            return Consume('}');
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::kArray;
+            ++m_position_;
+            if (Consume(']')) {
+                return true;
+            }
+            do {
+                JsonValue element;
+                if (!ParseValue(element)) {
+                    return false;
+                }
+                value.array.push_back(std::move(element));
+            } while (Consume(','));
+            return Consume(']');
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::kString;
+            return ParseString(value.string);
+        }
+        if (ConsumeWord("true")) {
+            value.type = JsonValue::Type::kBool;
+            value.number = 1.0;
+            return true;
+        }
+        if (ConsumeWord("false")) {
+            value.type = JsonValue::Type::kBool;
+            return true;
+        }
+        if (ConsumeWord("null")) {
+            value.type = JsonValue::Type::kNull;
+            return true;
+        }
+        const char* start = m_text_.c_str() + m_position_;
+        char* end = nullptr;
+        value.number = std::strtod(start, &end);
+        if (end == start) {
+            return false;
+        }
+        value.type = JsonValue::Type::kNumber;
+        m_position_ += static_cast<size_t>(end - start);
+        return true;
+    }
+
+    const std::string& m_text_;
+    size_t m_position_ = 0;
+};
+
+const char* GetVerdictName(BenchmarkHarness::Verdict verdict)
+{
+    switch (verdict) {
+        case BenchmarkHarness::Verdict::kRegressed:
+            return "REGRESSED";
+        case BenchmarkHarness::Verdict::kImproved:
+            return "improved";
+        case BenchmarkHarness::Verdict::kUnchanged:
+            return "ok";
+        case BenchmarkHarness::Verdict::kNew:
+            return "new";
+    }
+    return "";
+}
+}  // namespace
+
+void BenchmarkHarness::Register(const std::string& name, BodyFunction body, SetupFunction setup)
+{
+    m_benchmarks_.push_back({name, std::move(body), std::move(setup)});
+}
+
+std::vector<BenchmarkHarness::Result> BenchmarkHarness::RunAll(const Options& options)
+{
+    std::vector<Result> results;
+    for (const Benchmark& benchmark : m_benchmarks_) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        std::vector<double> samples_ms;
+        std::map<std::string, std::vector<double>> phase_samples_ms;
+        const int total_repetitions = std::max(0, options.warmup_repetitions) + std::max(1, options.repetitions);
+        for (int repetition = 0; repetition < total_repetitions; ++repetition) {
+            if (benchmark.setup) {
+                benchmark.setup();
+            }
+            Run run;
+            const Clock::time_point start = Clock::now();
+            benchmark.body(run);
+            const double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (repetition < total_repetitions - std::max(1, options.repetitions)) {
+                continue;  // Warmup: caches, allocator and branch predictors settle
+            }
+            samples_ms.push_back(elapsed_ms);
+            for (const auto& [phase, seconds] : run.m_phase_seconds_) {
+                phase_samples_ms[phase].push_back(seconds * 1000.0);
+            }
+        }
+
+        results.push_back(Summarize(benchmark.name, std::move(samples_ms)));
+        for (auto& [phase, phase_ms] : phase_samples_ms) {
+            results.push_back(Summarize(benchmark.name + "." + phase, std::move(phase_ms)));
+        }
+        for (size_t i = results.size() - 1 - phase_samples_ms.size(); i < results.size(); ++i) {
+            const Result& result = results[i];
+            std::cout << "BenchmarkHarness: " << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(3)
+                      << " median " << std::setw(10) << result.median_ms << " ms   min " << std::setw(10) << result.min_ms << " ms   p90 "
+                      << std::setw(10) << result.p90_ms << " ms" << std::defaultfloat << std::endl;
+        }
+    }
+    return results;
+}
+
+BenchmarkHarness::Result BenchmarkHarness::Summarize(const std::string& name, std::vector<double> samples_ms)
+{
+    Result result;
+    result.name = name;
+    result.repetitions = static_cast<int>(samples_ms.size());
+    if (samples_ms.empty()) {
+        return result;
+    }
+    std::sort(samples_ms.begin(), samples_ms.end());
+    const size_t count = samples_ms.size();
+    result.min_ms = samples_ms.front();
+    result.median_ms = count % 2 ? samples_ms[count / 2] : (samples_ms[count / 2 - 1] + samples_ms[count / 2]) / 2.0;
+    const size_t p90_index = static_cast<size_t>(std::ceil(0.9 * static_cast<double>(count))) - 1;
+    result.p90_ms = samples_ms[std::min(p90_index, count - 1)];
+    return result;
+}
+
+bool BenchmarkHarness::WriteJson(const std::string& path, const std::vector<Result>& results, const Baseline& settings) const
+{
+    std::ostringstream json;
+    json << std::setprecision(6);
+    json << "{\n  \"version\": 1,\n  \"tolerance\": " << settings.tolerance << ",\n  \"context\": {";
+    bool first = true;
+    for (const auto& [key, value] : m_context_) {
+        json << (first ? "" : ", ") << "\"" << EscapeJson(key) << "\": \"" << EscapeJson(value) << "\"";
+        first = false;
+    }
+    json << "},\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        json << (i ? ",\n" : "\n") << "    {\"name\": \"" << EscapeJson(result.name) << "\", \"median_ms\": " << result.median_ms
+             << ", \"min_ms\": " << result.min_ms << ", \"p90_ms\": " << result.p90_ms << ", \"repetitions\": " << result.repetitions;
+        const auto tolerance = settings.tolerances.find(result.name);
+        if (tolerance != settings.tolerances.end()) {
+            json << ", \"tolerance\": " << tolerance->second;
+        }
+        json << "}";
+    }
+    json << (results.empty() ? "]\n}\n" : "\n  ]\n}\n");
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "BenchmarkHarness: Cannot write " << path << std::endl;
+        return false;
+    }
+    file << json.str();
+    return static_cast<bool>(file);
+}
+
+bool BenchmarkHarness::ReadBaseline(const std::string& path, Baseline& baseline)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "BenchmarkHarness: Cannot read baseline " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.Parse(root) || root.type != JsonValue::Type::kObject) {
+        std::cerr << "BenchmarkHarness: Baseline " << path << " is not valid JSON" << std::endl;
+        return false;
+    }
+
+    baseline = Baseline();
+    if (const JsonValue* tolerance = root.Find("tolerance"); tolerance && tolerance->type == JsonValue::Type::kNumber) {
+        baseline.tolerance = tolerance->number;
+    }
+    if (const JsonValue* context = root.Find("context"); context && context->type == JsonValue::Type::kObject) {
+        for (const auto& [key, value] : context->object) {
+            if (value.type == JsonValue::Type::kString) {
+                baseline.context[key] = value.string;
+            }
+        }
+    }
+    if (const JsonValue* benchmarks = root.Find("benchmarks"); benchmarks && benchmarks->type == JsonValue::Type::kArray) {
+        for (const JsonValue& entry : benchmarks->array) {
+            const JsonValue* name = entry.Find("name");
+            const JsonValue* median = entry.Find("median_ms");
+            if (!name || name->type != JsonValue::Type::kString || !median || median->type != JsonValue::Type::kNumber) {
+                continue;
+            }
+            baseline.median_ms[name->string] = median->number;
+            if (const JsonValue* tolerance = entry.Find("tolerance"); tolerance && tolerance->type == JsonValue::Type::kNumber) {
+                baseline.tolerances[name->string] = tolerance->number;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<BenchmarkHarness::Comparison> BenchmarkHarness::Compare(const std::vector<Result>& results, const Baseline& baseline)
+{
+    std::vector<Comparison> comparisons;
+    comparisons.reserve(results.size());
+    for (const Result& result : results) {
+        Comparison comparison;
+        comparison.name = result.name;
+        comparison.current_ms = result.median_ms;
+        const auto tolerance = baseline.tolerances.find(result.name);
+        comparison.tolerance = tolerance != baseline.tolerances.end() ? tolerance->second : baseline.tolerance;
+
+        const auto baseline_ms = baseline.median_ms.find(result.name);
+        if (baseline_ms == baseline.median_ms.end()) {
+            comparison.verdict = Verdict::kNew;
+        } else {
+            comparison.baseline_ms = baseline_ms->second;
+            if (result.median_ms > comparison.baseline_ms * (1.0 + comparison.tolerance) && result.median_ms - comparison.baseline_ms > kMinRegressionMs) {
+                comparison.verdict = Verdict::kRegressed;
+            } else if (result.median_ms < comparison.baseline_ms * (1.0 - comparison.tolerance)) {
+                comparison.verdict = Verdict::kImproved;
+            } else {
+                comparison.verdict = Verdict::kUnchanged;
+            }
+        }
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
+
+int BenchmarkHarness::PrintComparison(const std::vector<Comparison>& comparisons)
+{
+    int regressions = 0;
+    std::cout << "\nBenchmarkHarness: Comparison with baseline" << std::endl;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "baseline ms" << std::setw(14) << "current ms"
+              << std::setw(10) << "change" << std::setw(11) << "allowed" << "  verdict" << std::endl;
+    for (const Comparison& comparison : comparisons) {
+        std::cout << std::left << std::setw(40) << comparison.name << std::right << std::fixed << std::setprecision(3);
+        if (comparison.verdict == Verdict::kNew) {
+            std::cout << std::setw(14) << "-" << std::setw(14) << comparison.current_ms << std::setw(10) << "-" << std::setw(11) << "-";
+        } else {
+            const double change = comparison.baseline_ms > 0.0 ? (comparison.current_ms / comparison.baseline_ms - 1.0) * 100.0 : 0.0;
+            std::ostringstream change_text;
+            change_text << std::showpos << std::fixed << std::setprecision(1) << change << "%";
+            std::ostringstream allowed_text;
+            allowed_text << "+" << std::fixed << std::setprecision(1) << comparison.tolerance * 100.0 << "%";
+            std::cout << std::setw(14) << comparison.baseline_ms << std::setw(14) << comparison.current_ms << std::setw(10) << change_text.str()
+                      << std::setw(11) << allowed_text.str();
+        }
+        std::cout << "  " << GetVerdictName(comparison.verdict) << std::defaultfloat << std::endl;
+        if (comparison.verdict == Verdict::kRegressed) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Runs named benchmarks, writes their timings as JSON and compares them with a stored baseline.
+//
+// A benchmark is a fixed amount of work timed as a whole, repeated a number of times after a few warmup runs; the
+// median is what gets compared, min and p90 are reported to show the noise. A run can also report phases it timed
+// itself (e.g. the loader's read, XOR, DES and parse times), which become results of their own named
+// "<benchmark>.<phase>" and are compared the same way.
+//
+// A result regresses when its median is more than the tolerance slower than the baseline's, and by more than
+// kMinRegressionMs, so sub-microsecond jitter on tiny timings is not reported. Results without a baseline entry are
+// new and never fail.
+class BenchmarkHarness
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Handed to each repetition to report self-timed phases
+    class Run
+    {
+    public:
+        void ReportPhase(const std::string& phase, double seconds) { m_phase_seconds_[phase] += seconds; }
+
+    private:
+        friend class BenchmarkHarness;
+        std::map<std::string, double> m_phase_seconds_;
+    };
+
+    using SetupFunction = std::function<void()>;    // Untimed, before every repetition
+    using BodyFunction = std::function<void(Run&)>;  // Timed
+
+    struct Options {
+        int warmup_repetitions = 2;
+        int repetitions = 15;
+        std::string filter;  // Only benchmarks whose name contains it
+    };
+
+    struct Result {
+        std::string name;
+        int repetitions = 0;
+        double median_ms = 0.0;
+        double min_ms = 0.0;
+        double p90_ms = 0.0;
+    };
+
+    struct Baseline {
+        double tolerance = kDefaultTolerance;          // Fraction of the baseline median
+        std::map<std::string, std::string> context;    // What the numbers were measured on; see SetContext
+        std::map<std::string, double> median_ms;       // By result name
+        std::map<std::string, double> tolerances;      // Per-result overrides of tolerance, for noisy results
+    };
+
+    enum class Verdict { kRegressed, kImproved, kUnchanged, kNew };
+
+    struct Comparison {
+        std::string name;
+        Verdict verdict = Verdict::kNew;
+        double baseline_ms = 0.0;
+        double current_ms = 0.0;
+        double tolerance = 0.0;
+    };
+
+    static constexpr double kDefaultTolerance = 0.15;
+    static constexpr double kMinRegressionMs = 0.05;
+
+    void Register(const std::string& name, BodyFunction body, SetupFunction setup = nullptr);
+
+    // Key/value pairs written with the results, e.g. the board the benchmarks ran on. A baseline measured in a
+    // different context is not compared against.
+    void SetContext(const std::string& key, const std::string& value) { m_context_[key] = value; }
+    [[nodiscard]] const std::map<std::string, std::string>& GetContext() const { return m_context_; }
+
+    // Runs the registered benchmarks in order, printing each result as it completes
+    std::vector<Result> RunAll(const Options& options);
+
+    // Writes the results with the settings' tolerances, so a result file can serve as the next baseline
+    bool WriteJson(const std::string& path, const std::vector<Result>& results, const Baseline& settings) const;
+    static bool ReadBaseline(const std::string& path, Baseline& baseline);
+
+    // One entry per result, in result order
+    static std::vector<Comparison> Compare(const std::vector<Result>& results, const Baseline& baseline);
+    // Prints the comparison table; returns the number of regressions
+    static int PrintComparison(const std::vector<Comparison>& comparisons);
+
+private:
+    struct Benchmark {
+        std::string name;
+        BodyFunction body;
+        SetupFunction setup;
+    };
+
+    static Result Summarize(const std::string& name, std::vector<double> samples_ms);
+
+    std::vector<Benchmark> m_benchmarks_;
+    std::map<std::string, std::string> m_context_;
+};
@@ -0,0 +1,287 @@
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "pcb/HitTestIndex.hpp"
+#include "pcb/XZZPCBLoader.hpp"
+#include "pcb/elements/Trace.hpp"
+#include "render/BLPathCache.hpp"
+#include "render/TileRenderer.hpp"
+
+namespace benchmarks {
+namespace
+{
+constexpr size_t kPointQueryCount = 10000;
+constexpr size_t kRectQueryCount = 200;
+constexpr float kHitTolerance = 0.05F;
+constexpr int kTileSize = 512;
+constexpr size_t kPathCount = 5000;
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Half on trace midpoints, so queries find something, half anywhere on the board
+std::vector<Vec2> MakeQueryPoints(const Board& board, size_t count)
+{
+    std::vector<const Trace*> traces;
+    for (const auto& layer_pair : board.m_elements_by_layer) {
+        for (const auto& element : layer_pair.second) {
+            if (element && element->GetElementType() == ElementType::kTrace) {
+                traces.push_back(static_cast<const Trace*>(element.get()));
+            }
+        }
+    }
+    const BLRect bounds = board.GetBoundingBox(false);
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<double> x_dist(bounds.x, bounds.x + bounds.w);
+    std::uniform_real_distribution<double> y_dist(bounds.y, bounds.y + bounds.h);
+    std::vector<Vec2> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0 && !traces.empty()) {
+            const Trace* trace = traces[rng() % traces.size()];
+            points.emplace_back(trace->GetCenterX(), trace->GetCenterY());
+        } else {
+            points.emplace_back(x_dist(rng), y_dist(rng));
+        }
+    }
+    return points;
+}
+
+// Viewport-sized rectangles, an eighth of the board across
+std::vector<BLRect> MakeQueryRects(const Board& board, size_t count)
+{
+    const BLRect bounds = board.GetBoundingBox(false);
+    const double width = bounds.w / 8.0;
+    const double height = bounds.h / 8.0;
+    std::mt19937 rng(2424);
+    std::uniform_real_distribution<double> x_dist(bounds.x, bounds.x + bounds.w - width);
+    std::uniform_real_distribution<double> y_dist(bounds.y, bounds.y + bounds.h - height);
+    std::vector<BLRect> rects;
+    rects.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        rects.emplace_back(x_dist(rng), y_dist(rng), width, height);
+    }
+    return rects;
+}
+}  // namespace
+
+void RegisterLoaderBenchmarks(BenchmarkHarness& harness, const Fixture& fixture)
+{
+    // Loaded boards are freed in the untimed setup of the next repetition
+    auto loaded_board = std::make_shared<std::unique_ptr<Board>>();
+    const std::string board_path = fixture.board_path;
+    harness.Register(
+        "loader.load",
+        [loaded_board, board_path](BenchmarkHarness::Run& run) {
+            PcbLoader loader;
+            PcbLoader::LoadProfile profile;
+            loader.SetProfile(&profile);
+            *loaded_board = loader.LoadFromFile(board_path);
+
+            // BoardLoaderFactory initializes every board it loads
+            const std::chrono::steady_clock::time_point initialize_start = std::chrono::steady_clock::now();
+            if (*loaded_board) {
+                (*loaded_board)->Initialize(board_path);
+            }
+            run.ReportPhase("initialize", SecondsSince(initialize_start));
+
+            run.ReportPhase("read", profile.read_seconds);
+            run.ReportPhase("xor", profile.xor_seconds);
+            run.ReportPhase("des", profile.des_seconds);
+            const std::pair<uint8_t, const char*> block_types[] = {{0x01, "parse.arc"},  {0x02, "parse.via"},       {0x05, "parse.trace"},
+                                                                   {0x06, "parse.text"}, {0x07, "parse.component"}, {0x09, "parse.test_pad"}};
+            for (const auto& [type, phase] : block_types) {
+                double seconds = profile.blocks[type].seconds;
+                if (type == 0x07) {
+                    seconds = std::max(0.0, seconds - profile.des_seconds);  // Reported on its own above
+                }
+                run.ReportPhase(phase, seconds);
+            }
+            run.ReportPhase("nets", profile.net_seconds);
+            run.ReportPhase("normalize", profile.normalize_seconds);
+        },
+        [loaded_board]() { loaded_board->reset(); });
+}
+
+void RegisterIndexBenchmarks(BenchmarkHarness& harness, const Fixture& fixture)
+{
+    std::shared_ptr<const Board> board = fixture.board;
+    auto points = std::make_shared<const std::vector<Vec2>>(MakeQueryPoints(*board, kPointQueryCount));
+    auto rects = std::make_shared<const std::vector<BLRect>>(MakeQueryRects(*board, kRectQueryCount));
+
+    // Packed hit-test index, which hover, click and box selection query
+    auto entries = std::make_shared<const std::vector<ElementInteractionInfo>>(board->GetAllElementsForInteraction());
+    auto build_index = std::make_shared<std::unique_ptr<HitTestIndex>>();
+    harness.Register(
+        "hit_test.build", [build_index, entries](BenchmarkHarness::Run&) { (*build_index)->Build(*entries); },
+        [build_index]() { *build_index = std::make_unique<HitTestIndex>(); });
+
+    auto index = std::make_shared<HitTestIndex>();
+    index->Build(*entries);
+    index->SyncLayerVisibility(*board);
+    harness.Register("hit_test.find_best_hit", [index, points](BenchmarkHarness::Run&) {
+        HitTestIndex::Hit hit;
+        for (const Vec2& point : *points) {
+            index->FindBestHit(point, kHitTolerance, hit);
+        }
+    });
+    harness.Register("hit_test.find_hits", [index, points](BenchmarkHarness::Run&) {
+        HitTestIndex::Hit hits[16];
+        for (const Vec2& point : *points) {
+            index->FindHits(point, kHitTolerance, hits, 16);
+        }
+    });
+    harness.Register("hit_test.find_in_rect", [index, rects](BenchmarkHarness::Run&) {
+        std::vector<HitTestIndex::Hit> hits;
+        for (const BLRect& rect : *rects) {
+            hits.clear();
+            index->FindInRect(rect, HitTestIndex::RectMode::kTouching, hits);
+        }
+    });
+}
+
+void RegisterRenderBenchmarks(BenchmarkHarness& harness, const Fixture& fixture)
+{
+    std::shared_ptr<const Board> board = fixture.board_data_manager->GetBoard();
+    const BLRect bounds = board->GetBoundingBox(false);
+    const double fit_zoom = kTileSize / std::max(bounds.w, bounds.h);
+    const BLRgba32 background(0xFF000000);
+
+    // The whole board in one tile: most elements are below a pixel here
+    auto add_fit = [&](const std::string& name, const SubPixelBatch::Options& sub_pixel_options) {
+        auto renderer = std::make_shared<TileRenderer>();
+        renderer->Initialize(kTileSize, fixture.board_data_manager, background);
+        renderer->SetSubPixelCulling(sub_pixel_options);
+        harness.Register(name, [renderer, board, bounds, fit_zoom](BenchmarkHarness::Run&) {
+            renderer->Render(*board, BLPoint(bounds.x, bounds.y), fit_zoom, kTileSize, kTileSize);
+        });
+    };
+    add_fit("render.fit", SubPixelBatch::Options());
+    // Each sub-pixel stand-in turned off on its own, so its share of render.fit shows against the full set
+    SubPixelBatch::Options no_trace_density;
+    no_trace_density.trace_density = false;
+    add_fit("render.fit_no_trace_density", no_trace_density);
+    SubPixelBatch::Options no_pad_points;
+    no_pad_points.pad_points = false;
+    add_fit("render.fit_no_pad_points", no_pad_points);
+    SubPixelBatch::Options no_text_culling;
+    no_text_culling.text_culling = false;
+    add_fit("render.fit_no_text_culling", no_text_culling);
+    SubPixelBatch::Options full_quality;
+    full_quality.trace_density = false;
+    full_quality.pad_points = false;
+    full_quality.text_culling = false;
+    add_fit("render.fit_full_quality", full_quality);
+
+    // The 2x2 tiles around the board center, zoomed in
+    auto add_zoomed = [&](const std::string& name, double zoom_factor) {
+        auto renderer = std::make_shared<TileRenderer>();
+        renderer->Initialize(kTileSize, fixture.board_data_manager, background);
+        const double zoom = fit_zoom * zoom_factor;
+        const double tile_world = kTileSize / zoom;
+        const BLPoint center(bounds.x + bounds.w / 2.0, bounds.y + bounds.h / 2.0);
+        harness.Register(name, [renderer, board, zoom, tile_world, center](BenchmarkHarness::Run&) {
+            for (int tile = 0; tile < 4; ++tile) {
+                const BLPoint origin(center.x + ((tile % 2) - 1) * tile_world, center.y + ((tile / 2) - 1) * tile_world);
+                renderer->Render(*board, origin, zoom, kTileSize, kTileSize);
+            }
+        });
+    };
+    add_zoomed("render.zoom_8x", 8.0);
+    add_zoomed("render.zoom_64x", 64.0);
+}
+
+void PrintSubPixelSpeedups(const std::vector<BenchmarkHarness::Result>& results)
+{
+    const auto find = [&results](const std::string& name) {
+        const auto it = std::find_if(results.begin(), results.end(), [&name](const BenchmarkHarness::Result& result) { return result.name == name; });
+        return it != results.end() ? it->median_ms : 0.0;
+    };
+    const double all_on_ms = find("render.fit");
+    if (all_on_ms <= 0.0) {
+        return;
+    }
+
+    const std::pair<const char*, const char*> toggles[] = {
+        {"rendering.subPixelTraceDensity", "render.fit_no_trace_density"},
+        {"rendering.subPixelPadPoints", "render.fit_no_pad_points"},
+        {"rendering.subPixelTextCulling", "render.fit_no_text_culling"},
+        {"all of them", "render.fit_full_quality"},
+    };
+    std::cout << "\nBenchmarks: Sub-pixel stand-ins at fit zoom (render.fit = " << std::fixed << std::setprecision(3) << all_on_ms << " ms)" << std::endl;
+    std::cout << std::left << std::setw(34) << "turned off" << std::right << std::setw(14) << "median ms" << std::setw(10) << "speedup" << std::endl;
+    for (const auto& [setting, name] : toggles) {
+        const double off_ms = find(name);
+        if (off_ms <= 0.0) {
+            continue;
+        }
+        // How much faster render.fit is than the same tile without this stand-in
+        std::cout << std::left << std::setw(34) << setting << std::right << std::setw(14) << off_ms << std::setw(9) << std::setprecision(2)
+                  << off_ms / all_on_ms << "x" << std::setprecision(3) << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+void RegisterCacheBenchmarks(BenchmarkHarness& harness, const Fixture& fixture)
+{
+    // Stroked trace paths, one entry per trace as RenderPipeline caches highlighted traces
+    struct PathSource {
+        path_cache::PathCacheKey key;
+        BLPath path;
+        BLStrokeOptions stroke_options;
+    };
+    auto sources = std::make_shared<std::vector<PathSource>>();
+    uint64_t trace_id = 0;
+    for (const auto& layer_pair : fixture.board->m_elements_by_layer) {
+        for (const auto& element : layer_pair.second) {
+            if (sources->size() >= kPathCount || !element || element->GetElementType() != ElementType::kTrace) {
+                continue;
+            }
+            const auto* trace = static_cast<const Trace*>(element.get());
+            PathSource source;
+            source.key = path_cache::BLPathCache::CreateTraceKey(trace_id++, trace->GetWidth(), BL_STROKE_CAP_ROUND, BL_STROKE_CAP_ROUND);
+            source.path.moveTo(trace->GetStartX(), trace->GetStartY());
+            source.path.lineTo(trace->GetEndX(), trace->GetEndY());
+            source.stroke_options.width = trace->GetWidth();
+            source.stroke_options.startCap = BL_STROKE_CAP_ROUND;
+            source.stroke_options.endCap = BL_STROKE_CAP_ROUND;
+            sources->push_back(std::move(source));
+        }
+    }
+    auto stroke_all = [sources](path_cache::BLPathCache& cache) {
+        for (const PathSource& source : *sources) {
+            cache.GetStrokedPath(source.key, source.path, source.stroke_options);
+        }
+    };
+
+    auto cold_cache = std::make_shared<std::unique_ptr<path_cache::BLPathCache>>();
+    harness.Register(
+        "cache.path_miss", [cold_cache, stroke_all](BenchmarkHarness::Run&) { stroke_all(**cold_cache); },
+        [cold_cache]() { *cold_cache = std::make_unique<path_cache::BLPathCache>(); });
+
+    auto warm_cache = std::make_shared<path_cache::BLPathCache>();
+    stroke_all(*warm_cache);
+    harness.Register("cache.path_hit", [warm_cache, stroke_all](BenchmarkHarness::Run&) { stroke_all(*warm_cache); });
+
+    // Every hover and pick asks for the list; all but the first are cache hits
+    std::shared_ptr<const Board> board = fixture.board;
+    (void)board->GetInteractionView(false);  // Built once, outside the timing
+    harness.Register("cache.interaction_view_hit", [board](BenchmarkHarness::Run&) {
+        for (int i = 0; i < 10000; ++i) {
+            const Board::InteractionView view = board->GetInteractionView(false);
+            (void)view;
+        }
+    });
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmarks/BenchmarkHarness.hpp"
+#include "core/BoardDataManager.hpp"
+#include "pcb/Board.hpp"
+
+// The suite's benchmarks, by area. Names are "<area>.<what>"; --filter selects by substring.
+namespace benchmarks {
+
+struct Fixture {
+    std::string board_path;                                // Loaded again by every loader benchmark repetition
+    std::shared_ptr<Board> board;                          // The same board, loaded once, for everything else
+    std::shared_ptr<BoardDataManager> board_data_manager;  // Publishes board
+};
+
+// loader.load, with its phases: read, XOR, DES, parse per block type, nets, normalization
+void RegisterLoaderBenchmarks(BenchmarkHarness& harness, const Fixture& fixture);
+// hit_test.*: HitTestIndex, the index behind hover, click and box selection
+void RegisterIndexBenchmarks(BenchmarkHarness& harness, const Fixture& fixture);
+// render.*: single tiles through TileRenderer, at fit-to-board zoom and zoomed in. At fit zoom, with every sub-pixel
+// stand-in on (render.fit), each one off on its own (render.fit_no_*) and all off (render.fit_full_quality).
+void RegisterRenderBenchmarks(BenchmarkHarness& harness, const Fixture& fixture);
+// What each sub-pixel stand-in saves: every render.fit_no_* median against render.fit, as a speedup factor. Prints
+// nothing unless render.fit ran.
+void PrintSubPixelSpeedups(const std::vector<BenchmarkHarness::Result>& results);
+// cache.*: the stroked path cache cold and warm, and the board's cached interaction list
+void RegisterCacheBenchmarks(BenchmarkHarness& harness, const Fixture& fixture);
+
+}  // namespace benchmarks
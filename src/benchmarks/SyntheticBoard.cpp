@@ -0,0 +1,391 @@
+#include "SyntheticBoard.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+#include "pcb/Board.hpp"
+#include "utils/des.h"
+
+namespace synthetic_board {
+namespace
+{
+constexpr double kCoordinateScale = 10000.0;  // File units per world unit (PcbLoader's xyscale)
+constexpr double kBoardWidth = 160.0;
+constexpr double kBoardHeight = 120.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr uint8_t kXorKey = 0x5A;
+constexpr uint64_t kComponentDesKey = 0xDCFC12AC00000000ULL;  // The key PcbLoader::DecryptComponentBlock derives
+
+// Element counts at scale 1, about a dense phone main board
+constexpr size_t kComponentCount = 1500;
+constexpr size_t kTraceCount = 60000;
+constexpr size_t kViaCount = 12000;
+constexpr size_t kArcCount = 400;
+constexpr size_t kTextLabelCount = 200;
+constexpr size_t kTestPadCount = 300;
+constexpr size_t kNetCount = 3000;
+
+constexpr int kSignalLayers[] = {Board::kTraceLayersStart, Board::kTraceLayersStart + 1, Board::kTraceLayersEnd - 1, Board::kTraceLayersEnd};
+constexpr int kPinCounts[] = {2, 2, 2, 2, 3, 4, 6, 8, 14, 16, 20, 32, 48, 64};
+
+// Little-endian writer for file structures
+class ByteWriter
+{
+public:
+    void Put8(uint8_t value) { m_data_.push_back(static_cast<char>(value)); }
+    void Put16(uint16_t value)
+    {
+        Put8(static_cast<uint8_t>(value & 0xFF));
+        Put8(static_cast<uint8_t>(value >> 8));
+    }
+    void Put32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) {
+            Put8(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
+        }
+    }
+    void PutInt(int32_t value) { Put32(static_cast<uint32_t>(value)); }
+    void PutCoordinate(double world) { PutInt(static_cast<int32_t>(std::lround(world * kCoordinateScale))); }
+    void PutBytes(const std::string& bytes) { m_data_.insert(m_data_.end(), bytes.begin(), bytes.end()); }
+    void PutZeros(size_t count) { m_data_.insert(m_data_.end(), count, '\0'); }
+    void Append(const ByteWriter& other) { m_data_.insert(m_data_.end(), other.m_data_.begin(), other.m_data_.end()); }
+    void Patch32(size_t offset, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) {
+            m_data_[offset + static_cast<size_t>(i)] = static_cast<char>((value >> (i * 8)) & 0xFF);
+        }
+    }
+
+    [[nodiscard]] size_t Size() const { return m_data_.size(); }
+    std::vector<char>& Data() { return m_data_; }
+
+private:
+    std::vector<char> m_data_;
+};
+
+// Main data and component sub-blocks: type, size, data
+void PutBlock(ByteWriter& out, uint8_t type, const ByteWriter& block)
+{
+    out.Put8(type);
+    out.Put32(static_cast<uint32_t>(block.Size()));
+    out.Append(block);
+}
+
+// In place, 8 bytes at a time, big-endian as PcbLoader reads it back; the data is zero-padded to whole blocks
+void EncryptComponentBlock(std::vector<char>& data)
+{
+    data.resize((data.size() + 7) / 8 * 8, '\0');
+    for (size_t offset = 0; offset < data.size(); offset += 8) {
+        uint64_t block = 0;
+        for (int i = 0; i < 8; ++i) {
+            block = (block << 8) | static_cast<uint8_t>(data[offset + static_cast<size_t>(i)]);
+        }
+        const uint64_t encrypted = Des(block, kComponentDesKey, 'e');
+        for (int i = 0; i < 8; ++i) {
+            data[offset + static_cast<size_t>(i)] = static_cast<char>((encrypted >> ((7 - i) * 8)) & 0xFF);
+        }
+    }
+}
+
+struct PinSite {
+    double x = 0.0;
+    double y = 0.0;
+    uint32_t net_id = 0;
+};
+
+class Generator
+{
+public:
+    Generator(const Options& options, Counts& counts) : m_options_(options), m_counts_(counts), m_rng_(options.seed) {}
+
+    std::vector<char> Run()
+    {
+        m_net_count_ = std::max<size_t>(2, Scaled(kNetCount));
+        AddOutline();
+        for (size_t i = Scaled(kComponentCount); i > 0; --i) {
+            AddComponent();
+        }
+        const size_t trace_target = Scaled(kTraceCount);
+        while (m_counts_.traces < trace_target) {
+            AddRoute(trace_target);
+        }
+        // Stitching vias for whatever the routes did not place
+        while (m_counts_.vias < Scaled(kViaCount)) {
+            AddVia(0x02, Uniform(1.0, kBoardWidth - 1.0), Uniform(1.0, kBoardHeight - 1.0), 0.3, 1);
+            ++m_counts_.vias;
+        }
+        for (size_t i = Scaled(kArcCount); i > 0; --i) {
+            AddArc();
+        }
+        for (size_t i = Scaled(kTestPadCount); i > 0; --i) {
+            AddVia(0x09, Uniform(2.0, kBoardWidth - 2.0), Uniform(2.0, kBoardHeight - 2.0), 0.5, RandomNet());
+            ++m_counts_.test_pads;
+        }
+        for (size_t i = Scaled(kTextLabelCount); i > 0; --i) {
+            AddTextLabel();
+        }
+        return Assemble();
+    }
+
+private:
+    [[nodiscard]] size_t Scaled(size_t count) const { return static_cast<size_t>(std::llround(static_cast<double>(count) * m_options_.scale)); }
+    double Uniform(double min, double max) { return std::uniform_real_distribution<double>(min, max)(m_rng_); }
+    int UniformInt(int min, int max) { return std::uniform_int_distribution<int>(min, max)(m_rng_); }
+    uint32_t RandomNet()
+    {
+        // A fifth of the pins are ground, like on a real board
+        return UniformInt(0, 4) == 0 ? 1 : static_cast<uint32_t>(UniformInt(1, static_cast<int>(m_net_count_)));
+    }
+
+    void AddTrace(int layer, double x1, double y1, double x2, double y2, double width, uint32_t net_id)
+    {
+        ByteWriter block;
+        block.Put32(static_cast<uint32_t>(layer));
+        block.PutCoordinate(x1);
+        block.PutCoordinate(y1);
+        block.PutCoordinate(x2);
+        block.PutCoordinate(y2);
+        block.PutCoordinate(width);
+        block.Put32(net_id);
+        PutBlock(m_main_, 0x05, block);
+        ++m_counts_.traces;
+    }
+
+    // Vias (0x02) and test pads (0x09) share a layout
+    void AddVia(uint8_t type, double x, double y, double radius, uint32_t net_id)
+    {
+        ByteWriter block;
+        block.PutCoordinate(x);
+        block.PutCoordinate(y);
+        block.PutCoordinate(radius);
+        block.PutCoordinate(radius);
+        block.Put32(static_cast<uint32_t>(Board::kTraceLayersStart));
+        block.Put32(static_cast<uint32_t>(Board::kTraceLayersEnd));
+        block.Put32(net_id);
+        block.Put32(0);  // No via text
+        PutBlock(m_main_, type, block);
+    }
+
+    void AddOutline()
+    {
+        const double corners[][2] = {{0.0, 0.0}, {kBoardWidth, 0.0}, {kBoardWidth, kBoardHeight}, {0.0, kBoardHeight}};
+        for (int i = 0; i < 4; ++i) {
+            const double* from = corners[i];
+            const double* to = corners[(i + 1) % 4];
+            AddTrace(Board::kBoardEdgesLayer, from[0], from[1], to[0], to[1], 0.2, 0);
+        }
+    }
+
+    void AddComponent()
+    {
+        const int pin_count = kPinCounts[UniformInt(0, static_cast<int>(std::size(kPinCounts)) - 1)];
+        const int columns = (pin_count + 1) / 2;
+        const double pitch = pin_count > 8 ? 0.5 : 1.27;
+        const double body_width = columns * pitch + 0.5;
+        const double body_height = pin_count <= 3 ? 1.2 : 4.0;
+        const double x = Uniform(body_width, kBoardWidth - body_width);
+        const double y = Uniform(body_height, kBoardHeight - body_height);
+        const size_t index = ++m_counts_.components;
+        const std::string reference = (pin_count == 2 ? "R" : "U") + std::to_string(index);
+
+        ByteWriter part;
+        part.Put32(0);  // Part size, patched below
+        part.Put32(0);
+        part.PutCoordinate(x);
+        part.PutCoordinate(y);
+        part.Put32(0);  // Rotation
+        part.Put16(0);  // Flags
+        const std::string footprint = "FP" + std::to_string(pin_count);
+        part.Put32(static_cast<uint32_t>(footprint.size()));
+        part.PutBytes(footprint);
+
+        // Silkscreen body outline
+        const double half_width = body_width / 2.0;
+        const double half_height = body_height * 0.4;
+        const double outline[][2] = {{-half_width, -half_height}, {half_width, -half_height}, {half_width, half_height}, {-half_width, half_height}};
+        for (int i = 0; i < 4; ++i) {
+            ByteWriter segment;
+            segment.Put32(static_cast<uint32_t>(Board::kSilkscreenLayer));
+            segment.PutCoordinate(x + outline[i][0]);
+            segment.PutCoordinate(y + outline[i][1]);
+            segment.PutCoordinate(x + outline[(i + 1) % 4][0]);
+            segment.PutCoordinate(y + outline[(i + 1) % 4][1]);
+            segment.PutCoordinate(0.1);
+            PutBlock(part, 0x05, segment);
+        }
+
+        // Reference designator and value; PcbLoader reads label positions unscaled
+        for (const std::string& text : {reference, std::string(pin_count == 2 ? "10K" : "IC")}) {
+            ByteWriter label;
+            label.Put32(static_cast<uint32_t>(Board::kSilkscreenLayer));
+            label.Put32(static_cast<uint32_t>(std::lround(x)));
+            label.Put32(static_cast<uint32_t>(std::lround(y)));
+            label.Put32(10);    // Font size
+            label.Put32(1000);  // Font scale
+            label.Put32(0);
+            label.Put8(0x02);  // Visible
+            label.Put8(0);
+            label.Put32(static_cast<uint32_t>(text.size()));
+            label.PutBytes(text);
+            PutBlock(part, 0x06, label);
+        }
+
+        for (int i = 0; i < pin_count; ++i) {
+            const int column = i % columns;
+            const int row = i / columns;
+            PinSite site;
+            site.x = x - (columns - 1) * pitch / 2.0 + column * pitch;
+            site.y = y + (row == 0 ? -body_height / 2.0 : body_height / 2.0);
+            site.net_id = RandomNet();
+            m_pin_sites_.push_back(site);
+
+            ByteWriter pin;
+            pin.Put32(0);
+            pin.PutCoordinate(site.x);
+            pin.PutCoordinate(site.y);
+            pin.Put32(0);
+            pin.Put32(0);  // Rotation
+            const std::string name = std::to_string(i + 1);
+            pin.Put32(static_cast<uint32_t>(name.size()));
+            pin.PutBytes(name);
+            // One outline: round pads on two-pin parts, rectangles otherwise
+            pin.PutCoordinate(pitch * 0.6);
+            pin.PutCoordinate(pin_count == 2 ? pitch * 0.6 : 1.0);
+            pin.Put8(pin_count == 2 ? 0x01 : 0x02);
+            pin.PutZeros(5);  // Outline list end
+            pin.Put32(site.net_id);
+            pin.PutZeros(8);
+            PutBlock(part, 0x09, pin);
+            ++m_counts_.pins;
+        }
+
+        part.Patch32(0, static_cast<uint32_t>(part.Size()));
+        EncryptComponentBlock(part.Data());
+        PutBlock(m_main_, 0x07, part);
+    }
+
+    // A run of 45-degree segments from a pin, changing layer through a via now and then
+    void AddRoute(size_t trace_target)
+    {
+        const PinSite start = m_pin_sites_.empty() ? PinSite {Uniform(1.0, kBoardWidth - 1.0), Uniform(1.0, kBoardHeight - 1.0), RandomNet()}
+                                                   : m_pin_sites_[static_cast<size_t>(UniformInt(0, static_cast<int>(m_pin_sites_.size()) - 1))];
+        const double widths[] = {0.1, 0.1, 0.15, 0.2, 0.3};
+        const double width = widths[UniformInt(0, 4)];
+        int layer_index = UniformInt(0, 3);
+        int direction = UniformInt(0, 7);
+        double x = start.x;
+        double y = start.y;
+        const size_t via_target = Scaled(kViaCount);
+        for (int segments = UniformInt(3, 12); segments > 0 && m_counts_.traces < trace_target; --segments) {
+            if (UniformInt(0, 9) < 3) {
+                direction = (direction + (UniformInt(0, 1) ? 1 : 7)) % 8;
+            }
+            const double length = Uniform(0.3, 4.0);
+            const double angle = direction * kPi / 4.0;
+            const double next_x = std::clamp(x + std::cos(angle) * length, 0.5, kBoardWidth - 0.5);
+            const double next_y = std::clamp(y + std::sin(angle) * length, 0.5, kBoardHeight - 0.5);
+            AddTrace(kSignalLayers[layer_index], x, y, next_x, next_y, width, start.net_id);
+            x = next_x;
+            y = next_y;
+            if (m_counts_.vias < via_target && UniformInt(0, 6) == 0) {
+                AddVia(0x02, x, y, 0.25, start.net_id);
+                ++m_counts_.vias;
+                layer_index = (layer_index + UniformInt(1, 3)) % 4;
+            }
+        }
+    }
+
+    void AddArc()
+    {
+        ByteWriter block;
+        block.Put32(static_cast<uint32_t>(kSignalLayers[UniformInt(0, 3)]));
+        block.PutCoordinate(Uniform(5.0, kBoardWidth - 5.0));
+        block.PutCoordinate(Uniform(5.0, kBoardHeight - 5.0));
+        block.PutCoordinate(Uniform(0.5, 3.0));
+        const double start_angle = Uniform(0.0, 360.0);
+        block.PutInt(static_cast<int32_t>(std::lround(start_angle * 10000.0)));
+        block.PutInt(static_cast<int32_t>(std::lround((start_angle + Uniform(30.0, 180.0)) * 10000.0)));
+        block.PutCoordinate(0.15);
+        block.Put32(RandomNet());
+        block.Put32(0);
+        PutBlock(m_main_, 0x01, block);
+        ++m_counts_.arcs;
+    }
+
+    void AddTextLabel()
+    {
+        const std::string text = "TP" + std::to_string(++m_counts_.text_labels);
+        ByteWriter block;
+        block.Put32(static_cast<uint32_t>(Board::kSilkscreenLayer));
+        block.PutCoordinate(Uniform(2.0, kBoardWidth - 2.0));
+        block.PutCoordinate(Uniform(2.0, kBoardHeight - 2.0));
+        block.Put32(10);    // Font size
+        block.Put32(1000);  // Divider
+        block.Put32(0);
+        block.Put32(static_cast<uint32_t>(text.size()));
+        block.PutBytes(text);
+        PutBlock(m_main_, 0x06, block);
+    }
+
+    // Header, main data and net block, XOR-encrypted as a whole
+    std::vector<char> Assemble()
+    {
+        ByteWriter nets;
+        for (size_t id = 1; id <= m_net_count_; ++id) {
+            const std::string name = id == 1 ? "GND" : "N" + std::to_string(id);
+            nets.Put32(static_cast<uint32_t>(8 + name.size()));
+            nets.Put32(static_cast<uint32_t>(id));
+            nets.PutBytes(name);
+        }
+        m_counts_.nets = m_net_count_;
+
+        ByteWriter file;
+        file.PutBytes("XZZPCB");
+        file.PutZeros(0x40 - file.Size());  // Byte 0x10 is the XOR key once encrypted, so 0 in plain text
+        file.Put32(static_cast<uint32_t>(m_main_.Size()));
+        file.Append(m_main_);
+        const size_t net_offset = file.Size();
+        file.Patch32(0x28, static_cast<uint32_t>(net_offset - 0x20));  // Offsets in the header are relative to 0x20
+        file.Put32(static_cast<uint32_t>(nets.Size()));
+        file.Append(nets);
+
+        for (char& byte : file.Data()) {
+            byte = static_cast<char>(static_cast<uint8_t>(byte) ^ kXorKey);
+        }
+        return std::move(file.Data());
+    }
+
+    const Options& m_options_;
+    Counts& m_counts_;
+    std::mt19937 m_rng_;
+    size_t m_net_count_ = 0;
+    ByteWriter m_main_;
+    std::vector<PinSite> m_pin_sites_;
+};
+}  // namespace
+
+std::vector<char> Generate(const Options& options, Counts* counts)
+{
+    Counts local_counts;
+    Counts& out_counts = counts ? *counts : local_counts;
+    out_counts = Counts();
+    return Generator(options, out_counts).Run();
+}
+
+bool WriteFile(const std::string& path, const Options& options, Counts* counts)
+{
+    const std::vector<char> data = Generate(options, counts);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "SyntheticBoard: Cannot write " << path << std::endl;
+        return false;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+}  // namespace synthetic_board
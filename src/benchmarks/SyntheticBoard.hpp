@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Generates XZZ .pcb files for the benchmarks, so they run on the same board on every machine without shipping a
+// real (proprietary) one. The file goes through every loader stage a real file does: it is XOR-encrypted, its
+// components are DES-encrypted blocks, and its main data holds arcs, vias, traces, text, components and test pads,
+// followed by a net block. Layout is random but seeded: routes of short 45-degree trace runs between components
+// across four signal layers, vias at layer changes, and components with 2 to 64 pins.
+namespace synthetic_board {
+
+struct Options {
+    double scale = 1.0;  // Multiplies every element count
+    uint32_t seed = 12345;
+};
+
+// What a file holds, for the log and the result context
+struct Counts {
+    size_t components = 0;
+    size_t pins = 0;
+    size_t traces = 0;
+    size_t vias = 0;
+    size_t arcs = 0;
+    size_t text_labels = 0;
+    size_t test_pads = 0;
+    size_t nets = 0;
+};
+
+std::vector<char> Generate(const Options& options, Counts* counts = nullptr);
+bool WriteFile(const std::string& path, const Options& options, Counts* counts = nullptr);
+
+}  // namespace synthetic_board
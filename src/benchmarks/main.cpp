@@ -0,0 +1,231 @@
+// Benchmark suite: times the loader, hit testing, tile rendering and caches on a generated board (or a given one),
+// writes the results as JSON and compares them with a stored baseline.
+//   XZZPCB-Benchmarks [--baseline <baseline.json>] [--output <results.json>] [--tolerance 0.15] [--filter <text>]
+//                     [--repetitions N] [--warmup N] [--scale 1.0] [--board <board.pcb>] [--update-baseline]
+//                     [--self-tests] [--require-baseline]
+// --self-tests also runs the performance tests of utils/PerformanceTest.hpp, which check their results.
+// --require-baseline (the check_benchmarks target) fails unless every result has a baseline entry to compare with.
+// Exits with 1 when a result regressed beyond the tolerance or a self-test failed, 2 on bad arguments, setup errors
+// or, with --require-baseline, a missing baseline.
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "benchmarks/BenchmarkHarness.hpp"
+#include "benchmarks/Benchmarks.hpp"
+#include "benchmarks/SyntheticBoard.hpp"
+#include "core/BoardDataManager.hpp"
+#include "pcb/Board.hpp"
+#include "pcb/BoardLoaderFactory.hpp"
+#include "utils/PerformanceTest.hpp"
+
+namespace
+{
+struct Arguments {
+    std::string baseline_path;
+    std::string output_path;
+    std::string board_path;  // Empty: a generated board
+    double tolerance = -1.0;  // Negative: the baseline's
+    double scale = 1.0;
+    bool update_baseline = false;
+    bool self_tests = false;
+    bool require_baseline = false;
+    BenchmarkHarness::Options options;
+};
+
+void PrintUsage()
+{
+    std::cerr << "Usage: XZZPCB-Benchmarks [--baseline <baseline.json>] [--output <results.json>] [--tolerance 0.15] [--filter <text>]\n"
+                 "                         [--repetitions N] [--warmup N] [--scale 1.0] [--board <board.pcb>] [--update-baseline]\n"
+                 "                         [--self-tests] [--require-baseline]"
+              << std::endl;
+}
+
+bool ParseArguments(int argc, char* argv[], Arguments& arguments)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--update-baseline") {
+            arguments.update_baseline = true;
+            continue;
+        }
+        if (flag == "--self-tests") {
+            arguments.self_tests = true;
+            continue;
+        }
+        if (flag == "--require-baseline") {
+            arguments.require_baseline = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Benchmarks: Missing value for " << flag << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        char* end = nullptr;
+        if (flag == "--baseline") {
+            arguments.baseline_path = value;
+        } else if (flag == "--output") {
+            arguments.output_path = value;
+        } else if (flag == "--board") {
+            arguments.board_path = value;
+        } else if (flag == "--filter") {
+            arguments.options.filter = value;
+        } else if (flag == "--tolerance") {
+            arguments.tolerance = std::strtod(value.c_str(), &end);
+        } else if (flag == "--scale") {
+            arguments.scale = std::strtod(value.c_str(), &end);
+        } else if (flag == "--repetitions") {
+            arguments.options.repetitions = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (flag == "--warmup") {
+            arguments.options.warmup_repetitions = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else {
+            std::cerr << "Benchmarks: Unknown option " << flag << std::endl;
+            return false;
+        }
+        if (end && *end != '\0') {
+            std::cerr << "Benchmarks: Invalid value for " << flag << ": " << value << std::endl;
+            return false;
+        }
+    }
+    if ((arguments.update_baseline || arguments.require_baseline) && arguments.baseline_path.empty()) {
+        std::cerr << "Benchmarks: --update-baseline and --require-baseline need --baseline" << std::endl;
+        return false;
+    }
+    return arguments.options.repetitions > 0 && arguments.options.warmup_repetitions >= 0 && arguments.scale > 0.0;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Arguments arguments;
+    if (!ParseArguments(argc, argv, arguments)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Before the board is loaded, so their million-element boards are gone when the timings start
+    const int self_test_failures = arguments.self_tests ? performance_test::RunAllTests() : 0;
+
+    BenchmarkHarness harness;
+    std::filesystem::path generated_path;
+    if (arguments.board_path.empty()) {
+        generated_path = std::filesystem::temp_directory_path() / "xzzpcb_benchmark_board.pcb";
+        synthetic_board::Options board_options;
+        board_options.scale = arguments.scale;
+        synthetic_board::Counts counts;
+        if (!synthetic_board::WriteFile(generated_path.string(), board_options, &counts)) {
+            return 2;
+        }
+        arguments.board_path = generated_path.string();
+        std::cout << "Benchmarks: Generated board with " << counts.components << " components, " << counts.pins << " pins, " << counts.traces
+                  << " traces, " << counts.vias << " vias, " << counts.arcs << " arcs, " << counts.nets << " nets" << std::endl;
+
+        std::ostringstream scale;
+        scale << arguments.scale;
+        harness.SetContext("board", "synthetic");
+        harness.SetContext("scale", scale.str());
+    } else {
+        harness.SetContext("board", std::filesystem::path(arguments.board_path).filename().string());
+    }
+
+    // Loaded the way the viewer and tile server load it
+    benchmarks::Fixture fixture;
+    fixture.board_path = arguments.board_path;
+    BoardLoaderFactory loader_factory;
+    fixture.board = loader_factory.LoadBoard(arguments.board_path);
+    if (!fixture.board || !fixture.board->IsLoaded()) {
+        std::cerr << "Benchmarks: Failed to load " << arguments.board_path << std::endl;
+        return 2;
+    }
+    fixture.board_data_manager = std::make_shared<BoardDataManager>();
+    fixture.board->SetBoardDataManager(fixture.board_data_manager);
+    fixture.board_data_manager->SetBoard(fixture.board);
+    fixture.board_data_manager->RegenerateLayerColors(fixture.board);
+
+    benchmarks::RegisterLoaderBenchmarks(harness, fixture);
+    benchmarks::RegisterIndexBenchmarks(harness, fixture);
+    benchmarks::RegisterRenderBenchmarks(harness, fixture);
+    benchmarks::RegisterCacheBenchmarks(harness, fixture);
+
+    const std::vector<BenchmarkHarness::Result> results = harness.RunAll(arguments.options);
+    if (!generated_path.empty()) {
+        std::error_code error;
+        std::filesystem::remove(generated_path, error);
+    }
+    if (results.empty()) {
+        std::cerr << "Benchmarks: No benchmark matches " << arguments.options.filter << std::endl;
+        return 2;
+    }
+    benchmarks::PrintSubPixelSpeedups(results);
+
+    BenchmarkHarness::Baseline baseline;
+    bool has_baseline = false;
+    if (!arguments.baseline_path.empty() && std::filesystem::exists(arguments.baseline_path)) {
+        if (!BenchmarkHarness::ReadBaseline(arguments.baseline_path, baseline)) {
+            return 2;
+        }
+        has_baseline = true;
+    } else if (!arguments.baseline_path.empty() && !arguments.update_baseline) {
+        std::cerr << "Benchmarks: Baseline " << arguments.baseline_path << " not found" << std::endl;
+        return 2;
+    }
+    if (arguments.tolerance >= 0.0) {
+        baseline.tolerance = arguments.tolerance;
+    }
+
+    if (!arguments.output_path.empty() && !harness.WriteJson(arguments.output_path, results, baseline)) {
+        return 2;
+    }
+    if (arguments.update_baseline) {
+        // The baseline's tolerances are kept; its numbers are replaced
+        if (!harness.WriteJson(arguments.baseline_path, results, baseline)) {
+            return 2;
+        }
+        std::cout << "Benchmarks: Baseline " << arguments.baseline_path << " updated with " << results.size() << " results" << std::endl;
+        return self_test_failures > 0 ? 1 : 0;
+    }
+    if (arguments.require_baseline && baseline.median_ms.empty()) {
+        std::cerr << "Benchmarks: Baseline " << arguments.baseline_path << " has no results; record one with --update-baseline" << std::endl;
+        return 2;
+    }
+    if (!has_baseline) {
+        return self_test_failures > 0 ? 1 : 0;
+    }
+
+    // Numbers from another board or scale say nothing about this run
+    for (const auto& [key, value] : harness.GetContext()) {
+        const auto baseline_value = baseline.context.find(key);
+        if (!baseline.median_ms.empty() && (baseline_value == baseline.context.end() || baseline_value->second != value)) {
+            std::cerr << "Benchmarks: Baseline was measured with " << key << " = "
+                      << (baseline_value == baseline.context.end() ? "(unset)" : baseline_value->second) << ", this run has " << value
+                      << "; not comparing" << std::endl;
+            return 2;
+        }
+    }
+
+    const std::vector<BenchmarkHarness::Comparison> comparisons = BenchmarkHarness::Compare(results, baseline);
+    const int regressions = BenchmarkHarness::PrintComparison(comparisons);
+    if (arguments.require_baseline) {
+        const auto unmeasured = std::count_if(comparisons.begin(), comparisons.end(),
+                                              [](const BenchmarkHarness::Comparison& comparison) { return comparison.verdict == BenchmarkHarness::Verdict::kNew; });
+        if (unmeasured > 0) {
+            std::cerr << "Benchmarks: " << unmeasured << " result(s) have no baseline entry; record them with --update-baseline" << std::endl;
+            return 2;
+        }
+    }
+    if (self_test_failures > 0) {
+        std::cerr << "Benchmarks: " << self_test_failures << " self-test(s) failed" << std::endl;
+        return 1;
+    }
+    if (regressions > 0) {
+        std::cerr << "Benchmarks: " << regressions << " result(s) regressed beyond the tolerance" << std::endl;
+        return 1;
+    }
+    std::cout << "Benchmarks: No regressions" << std::endl;
+    return 0;
+}
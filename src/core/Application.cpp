@@ -1,5 +1,7 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <thread>
@@ -30,6 +32,7 @@
 #include "ui/MainMenuBar.hpp"
 #include "ui/windows/PCBViewerWindow.hpp"
 #include "ui/windows/PcbDetailsWindow.hpp"
+#include "ui/windows/SearchWindow.hpp"
 #include "ui/windows/SettingsWindow.hpp"
 #include "utils/StringUtils.hpp"
 #include "view/Camera.hpp"
@@ -39,6 +42,13 @@
 
 namespace
 {
+// Idle mode timings
+constexpr double kInputLingerSeconds = 0.5;   // Frames keep running this long after input (hover tooltips, ImGui fades)
+constexpr int kBackgroundPollIntervalMs = 50;  // While background work may finish
+constexpr int kCaretBlinkIntervalMs = 400;     // While a text field has focus, so its caret blinks
+constexpr int kIdleWakeIntervalMs = 1000;      // Otherwise; keeps the memory overlay and the like ticking
+constexpr double kIdleReportMinSeconds = 2.0;  // Shorter idle periods are not logged
+
 std::string GetAppConfigFilePath()
 {
     const char* CONFIG_FILENAME = "XZZPCBViewer_settings.ini";
@@ -78,6 +88,11 @@ Application::~Application()
     Shutdown();
 }
 
+std::string Application::GetConfigFilePath()
+{
+    return GetAppConfigFilePath();
+}
+
 void Application::LoadConfig()
 {
     m_config = std::make_unique<Config>();
@@ -91,6 +106,7 @@ void Application::LoadConfig()
     m_appName = m_config->GetString("application.name", m_appName);
     m_windowWidth = m_config->GetInt("window.width", m_windowWidth);
     m_windowHeight = m_config->GetInt("window.height", m_windowHeight);
+    m_idleModeEnabled = m_config->GetBool("application.idle_mode", m_idleModeEnabled);
 
     m_controlSettings = std::make_shared<ControlSettings>();
     m_controlSettings->LoadSettingsFromConfig(*m_config);
@@ -146,17 +162,6 @@ bool Application::InitializeUISubsystems()
         m_boardDataManager->LoadSettingsFromConfig(*m_config);
     }
 
-    // Register for settings change callbacks to handle board folding changes
-    if (m_boardDataManager) {
-        m_boardDataManager->RegisterSettingsChangeCallback([this]() {
-            std::cout << "Application: BoardDataManager settings changed, updating current board..." << std::endl;
-            if (m_currentBoard && m_currentBoard->IsLoaded()) {
-                std::cout << "Application: Applying folding state to current board" << std::endl;
-                m_currentBoard->UpdateFoldingState();
-            }
-        });
-    }
-
     // Initialize PCB Loader Factory
     m_boardLoaderFactory = std::make_unique<BoardLoaderFactory>();
     if (!m_boardLoaderFactory) {
@@ -173,10 +178,14 @@ bool Application::InitializeUISubsystems()
         std::cerr << "Failed to initialize PcbRenderer!" << std::endl;
         return false;
     }
+    // Finished frames wake the main loop while it waits for events
+    m_pcbRenderer->SetFrameReadyCallback([events = m_events.get()]() { events->PushWakeEvent(); });
 
     // Create SettingsWindow with Grid for font invalidation
     m_settingsWindow = CreateSettingsWindow(m_gridSettings, m_controlSettings, m_boardDataManager, m_clearColor, m_grid);
     m_pcbDetailsWindow = std::make_unique<PcbDetailsWindow>();
+    m_pcbDetailsWindow->SetBoardDataManager(m_boardDataManager);
+    m_searchWindow = std::make_unique<SearchWindow>(m_camera, m_viewport, m_boardDataManager);
 
     // Load font settings after SettingsWindow is created
     if (m_config && m_settingsWindow) {
@@ -190,6 +199,7 @@ bool Application::InitializeUISubsystems()
 
     m_settingsWindow->SetVisible(true);
     m_pcbDetailsWindow->SetVisible(false);
+    m_searchWindow->SetVisible(false);
 
     return true;
 }
@@ -376,6 +386,9 @@ int Application::Run()
     auto lastTime = std::chrono::high_resolution_clock::now();
 
     while (IsRunning()) {
+        // Blocks while nothing on screen can change; otherwise returns right away
+        WaitForActivity();
+
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - lastTime).count();
         lastTime = currentTime;
@@ -389,6 +402,9 @@ int Application::Run()
         // This eliminates the performance bottleneck from std::this_thread::sleep_for()
         // Target framerate setting is now used only for display/configuration purposes
     }
+    if (m_isIdle) {
+        EndIdlePeriod(std::chrono::steady_clock::now());
+    }
 
     Shutdown();
     return 0;
@@ -430,12 +446,17 @@ void Application::Shutdown()
     // Save file dialog bookmarks
     SaveFileDialogBookmarks();
 
+    if (m_config) {
+        m_config->SetBool("application.idle_mode", m_idleModeEnabled);
+    }
+
     if (m_config) {
         if (!m_config->SaveToFile(configFilePath)) {
             std::cerr << "Error: Failed to save config file to " << configFilePath << std::endl;
         }
     }
 
+    m_searchWindow.reset();
     m_pcbDetailsWindow.reset();
     m_settingsWindow.reset();
     m_pcbViewerWindow.reset();
@@ -495,6 +516,9 @@ ImGuiManager* Application::GetImGuiManager() const
 void Application::ProcessEvents()
 {
     m_events->ProcessEvents();
+    if (m_events->GetLastEventCount() > 0) {
+        m_lastInputTime = std::chrono::steady_clock::now();
+    }
 
     if (m_events->ShouldQuit()) {
         Quit();
@@ -504,6 +528,89 @@ void Application::ProcessEvents()
 void Application::Update(float deltaTime)
 {
     // (void)deltaTime;
+    if (m_boardDataManager) {
+        m_boardDataManager->PollBoardVariant();  // Publishes a folded or flipped board once the worker has built it
+    }
+}
+
+void Application::WaitForActivity()
+{
+    const int timeout_ms = GetIdleWaitTimeoutMs();
+    const auto wait_start = std::chrono::steady_clock::now();
+    if (timeout_ms <= 0) {
+        if (m_isIdle) {
+            EndIdlePeriod(wait_start);
+        }
+        return;
+    }
+
+    if (!m_isIdle) {
+        m_isIdle = true;
+        m_idleStartTime = wait_start;
+        m_idleWaitSeconds = 0.0;
+        m_idleFrames = 0;
+    }
+
+    const bool event_arrived = m_events->WaitForEvent(timeout_ms);
+    const auto wait_end = std::chrono::steady_clock::now();
+    m_idleWaitSeconds += std::chrono::duration<double>(wait_end - wait_start).count();
+    if (event_arrived) {
+        EndIdlePeriod(wait_end);
+    } else {
+        ++m_idleFrames;
+    }
+}
+
+int Application::GetIdleWaitTimeoutMs() const
+{
+    if (!m_idleModeEnabled || !m_events || !m_pcbRenderer || !ImGui::GetCurrentContext()) {
+        return 0;
+    }
+
+    const double seconds_since_input = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_lastInputTime).count();
+    if (seconds_since_input < kInputLingerSeconds || m_pcbRenderer->NeedsRedraw() || IsImGuiInputHeld()) {
+        return 0;
+    }
+
+    // Results of background work are picked up by polling, so it is polled at a low rate until it finishes.
+    // Frames finished by the render thread also push a wake event, so they are presented without waiting for a poll.
+    const bool search_index_pending = m_searchWindow && m_searchWindow->IsWindowVisible() && m_searchWindow->IsIndexBuildPending();
+    const bool board_variant_pending = m_boardDataManager && m_boardDataManager->IsBoardVariantPending();
+    if (m_pcbRenderer->HasPendingBackgroundWork() || search_index_pending || board_variant_pending) {
+        return kBackgroundPollIntervalMs;
+    }
+    if (ImGui::GetIO().WantTextInput) {
+        return kCaretBlinkIntervalMs;
+    }
+    return kIdleWakeIntervalMs;
+}
+
+bool Application::IsImGuiInputHeld() const
+{
+    const ImGuiIO& io = ImGui::GetIO();
+    if (std::any_of(std::begin(io.MouseDown), std::end(io.MouseDown), [](bool down) { return down; }) || ImGui::IsAnyItemActive()) {
+        return true;
+    }
+    // Held navigation keys pan, zoom and rotate every frame without further events
+    for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; ++key) {
+        if (ImGui::IsKeyDown(static_cast<ImGuiKey>(key))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Application::EndIdlePeriod(std::chrono::steady_clock::time_point end_time)
+{
+    m_isIdle = false;
+    const double idle_seconds = std::chrono::duration<double>(end_time - m_idleStartTime).count();
+    if (idle_seconds < kIdleReportMinSeconds) {
+        return;
+    }
+    // Time not spent blocked approximates the main thread's CPU use while idle
+    const double busy_percent = 100.0 * std::max(0.0, idle_seconds - m_idleWaitSeconds) / idle_seconds;
+    std::cout << "Application: Idle for " << idle_seconds << " s: " << m_idleFrames << " frames (" << m_idleFrames / idle_seconds
+              << " fps), main loop busy " << busy_percent << "% of the time" << std::endl;
 }
 
 void Application::ProcessGlobalKeyboardShortcuts()
@@ -581,6 +688,10 @@ void Application::ProcessGlobalKeyboardShortcuts()
         m_showFileDialogWindow = true;  // Set the flag to trigger dockable file dialog opening
         std::cout << "Global shortcut: Open file dialog triggered" << std::endl;
     }
+
+    if (IsKeybindActive(m_controlSettings->GetKeybind(InputAction::kOpenSearch), io)) {
+        m_showSearchRequested = true;
+    }
 }
 
 void Application::RenderUI()
@@ -642,6 +753,16 @@ void Application::RenderUI()
         m_showPcbDetailsRequested = false;  // Reset flag
     }
 
+    if (m_showSearchRequested) {
+        if (m_searchWindow)
+            m_searchWindow->SetVisible(true);
+        m_showSearchRequested = false;
+    }
+
+    if (m_pcbViewerWindow && m_mainMenuBar) {
+        m_pcbViewerWindow->SetMemoryOverlayVisible(m_mainMenuBar->IsMemoryOverlayShown());
+    }
+
 
 
     // --- PCBViewerWindow Rendering ---
@@ -665,10 +786,11 @@ void Application::RenderUI()
                                                 m_pcbRenderer.get(),
                                                 [&]() {  // This is the pcbRenderCallback lambda
                                                     bool baseComponentsValid = m_camera && m_viewport && m_grid;
-                                                    bool boardLoaded = m_currentBoard != nullptr;
+                                                    // The published snapshot: the folded or flipped variant when one is viewed
+                                                    std::shared_ptr<const Board> board = m_boardDataManager ? m_boardDataManager->GetBoard() : nullptr;
 
                                                     if (baseComponentsValid) {
-                                                        m_pcbRenderer->Render(boardLoaded ? m_currentBoard.get() : nullptr, m_camera.get(), m_viewport.get(), m_grid.get());
+                                                        m_pcbRenderer->Render(board, m_camera.get(), m_viewport.get(), m_grid.get());
                                                     } else {
                                                         // This case should ideally be handled by PcbRenderer::Render itself
                                                         // by drawing a placeholder if components are missing.
@@ -692,6 +814,10 @@ void Application::RenderUI()
         }
     }
 
+    if (m_searchWindow) {
+        m_searchWindow->Render();
+    }
+
     // --- File Dialog Window ---
     if (m_showFileDialogWindow && m_fileDialogInstance) {
         RenderFileDialog();
@@ -747,22 +873,20 @@ void Application::OpenPcbFile(const std::string& filePath)
     if (newBoard) {
         m_currentBoard = std::move(newBoard);
 
-        // Set up the BoardDataManager and ControlSettings references in the board
+        // Set up the BoardDataManager and ControlSettings references before the board is published: from then on
+        // it is read-only, and its folded/flipped variants are copied from it
+        if (m_controlSettings) {
+            m_currentBoard->SetControlSettings(m_controlSettings);
+        }
         if (m_boardDataManager) {
             m_currentBoard->SetBoardDataManager(m_boardDataManager);
-            m_boardDataManager->SetBoard(m_currentBoard);
+            m_boardDataManager->SetBoard(m_currentBoard);  // Also publishes the folded variant if folding is enabled
             m_boardDataManager->RegenerateLayerColors(m_currentBoard);
         }
-        if (m_controlSettings) {
-            m_currentBoard->SetControlSettings(m_controlSettings);
+        std::cout << "Application: " << m_currentBoard->GetMemoryReport().ToString() << std::endl;
 
-            // Apply folding if enabled
-            std::cout << "Application: Checking if board folding should be applied..." << std::endl;
-            if (m_boardDataManager->IsBoardFoldingEnabled()) {
-                std::cout << "Application: Board folding is enabled, applying to new board" << std::endl;
-                m_currentBoard->UpdateFoldingState();
-            }
-        }
+        // Windows start from the published snapshot (the folded variant when folding is enabled) and follow later ones
+        const std::shared_ptr<const Board> published_board = m_boardDataManager ? m_boardDataManager->GetBoard() : m_currentBoard;
 
         // Corrected window updates:
         if (m_pcbViewerWindow) {
@@ -773,11 +897,14 @@ void Application::OpenPcbFile(const std::string& filePath)
             // m_pcbViewerWindow->SetBoard(m_currentBoard); // Or similar method
         }
         if (m_pcbDetailsWindow) {
-            m_pcbDetailsWindow->SetBoard(m_currentBoard);  // Update details window
+            m_pcbDetailsWindow->SetBoard(published_board);  // Update details window
+        }
+        if (m_searchWindow) {
+            m_searchWindow->SetBoard(m_currentBoard);  // Indexes the loaded board; folds and flips reuse the index
         }
 
-        if (m_camera && m_viewport && m_currentBoard) {
-            BLRect board_bounds = m_currentBoard->GetBoundingBox(true);
+        if (m_camera && m_viewport && published_board) {
+            BLRect board_bounds = published_board->GetBoundingBox(true);
             std::cout << "Board Bounding Box for FocusOnRect: X=" << board_bounds.x << " Y=" << board_bounds.y << " W=" << board_bounds.w << " H=" << board_bounds.h << std::endl;
 
             m_camera->FocusOnRect(board_bounds, *m_viewport, 0.1f);
@@ -794,15 +921,6 @@ void Application::OpenPcbFile(const std::string& filePath)
             std::cout << "Board origin offset: " << m_currentBoard->origin_offset.x << ", " << m_currentBoard->origin_offset.y << std::endl;
         }
 
-        // Apply layer properties (colors, etc.) using BoardDataManager
-        if (m_boardDataManager) {
-            m_boardDataManager->RegenerateLayerColors(m_currentBoard);
-            m_boardDataManager->SetBoard(m_currentBoard);
-        } else {
-            std::cerr << "Application::OpenPcbFile: BoardDataManager is null, cannot apply layer properties or set board." << std::endl;
-            // Decide if a board should be considered valid if BoardDataManager is missing
-            // For now, proceed but log error. Or, could `return;` here.
-        }
     } else {
         std::cerr << "Failed to load PCB: " << filePath << std::endl;
         if (m_camera && m_viewport) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <memory>
 #include "../../external/ImGuiFileDialog/ImGuiFileDialog.h" // Better to forward declare if only pointer/reference is stored
@@ -22,6 +23,7 @@ class MainMenuBar;
 class PCBViewerWindow;
 class SettingsWindow;
 class PcbDetailsWindow;
+class SearchWindow;
 
 // Forward declarations for view and PCB data classes
 class Camera;
@@ -44,6 +46,9 @@ public:
     int Run();
     void Shutdown();
 
+    // Settings file, shared with the headless commands (see ExportCommand)
+    static std::string GetConfigFilePath();
+
     // State and control
     bool IsRunning() const;
     void Quit();
@@ -59,6 +64,7 @@ public:
     void SetQuitFileRequested(bool requested) { m_quitFileRequested = requested; }
     void SetShowSettingsRequested(bool requested) { m_showSettingsRequested = requested; }
     void SetShowPcbDetailsRequested(bool requested) { m_showPcbDetailsRequested = requested; }
+    void SetShowSearchRequested(bool requested) { m_showSearchRequested = requested; }
     void SetShowFileDialogWindow(bool show) { m_showFileDialogWindow = show; }
 
 private:
@@ -73,6 +79,12 @@ private:
     void Update(float deltaTime); // Add deltaTime if Application has timed updates
     void Render();
 
+    // Idle mode: when nothing on screen can change, the loop blocks for events instead of presenting at display rate
+    void WaitForActivity();
+    int GetIdleWaitTimeoutMs() const;  // 0 if the next frame should run right away
+    bool IsImGuiInputHeld() const;     // Keys/buttons held or widgets active: ImGui animates without new events
+    void EndIdlePeriod(std::chrono::steady_clock::time_point end_time);
+
     // UI Rendering Helper
     void RenderUI(); // New method to group UI rendering calls
     void ProcessGlobalKeyboardShortcuts(); // Process global keyboard shortcuts
@@ -118,6 +130,7 @@ private:
     std::unique_ptr<PCBViewerWindow> m_pcbViewerWindow;
     std::unique_ptr<SettingsWindow> m_settingsWindow;
     std::unique_ptr<PcbDetailsWindow> m_pcbDetailsWindow;
+    std::unique_ptr<SearchWindow> m_searchWindow;
     // No longer directly in Application: bool m_showDemoWindow; (handled by MainMenuBar)
     // No longer directly in Application: bool m_showLayerControls; (logic to be moved to SettingsWindow or similar)
     // No longer directly in Application: ImVec2 m_contentAreaPos; ImVec2 m_contentAreaSize; (handled by PCBViewerWindow)
@@ -132,9 +145,18 @@ private:
     // PCB Loader Factory
     std::unique_ptr<BoardLoaderFactory> m_boardLoaderFactory;
 
+    // Idle mode state and measurements for the current idle period
+    bool m_idleModeEnabled = true;
+    bool m_isIdle = false;
+    std::chrono::steady_clock::time_point m_lastInputTime;
+    std::chrono::steady_clock::time_point m_idleStartTime;
+    double m_idleWaitSeconds = 0.0;  // Blocked in WaitForEvent, i.e. not using the CPU
+    int m_idleFrames = 0;            // Frames run on timeouts (background polls, caret blink)
+
     // Menu action request flags
     bool m_quitFileRequested = false;
     bool m_showSettingsRequested = false;
     bool m_showPcbDetailsRequested = false;
+    bool m_showSearchRequested = false;
     bool m_showFileDialogWindow = false;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "core/BoardDataManager.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <mutex>
 
@@ -8,74 +10,237 @@
 #include "pcb/XZZPCBLoader.hpp"
 #include "utils/ColorUtils.hpp"
 
-BoardDataManager::BoardDataManager() : layer_hue_step_(30.0f)  // Default hue step in degrees
+BoardDataManager::BoardDataManager() : view_state_(std::make_shared<const ViewState>())
 {
 }
 
 BoardDataManager::~BoardDataManager()
 {
-    // Clean up any resources if needed
-    // For now, the default cleanup of member variables is sufficient
+    {
+        std::lock_guard<std::mutex> lock(variant_mutex_);
+        variant_worker_stopping_ = true;
+        variant_request_.reset();
+    }
+    variant_condition_.notify_all();
+    if (variant_worker_.joinable()) {
+        variant_worker_.join();  // Waits for a build in progress; its result is dropped
+    }
 }
 
-std::shared_ptr<const Board> BoardDataManager::GetBoard() const
+std::shared_ptr<const BoardDataManager::ViewState> BoardDataManager::GetViewState() const
 {
-    std::lock_guard<std::mutex> lock(board_mutex_);
-    return current_board_;
+    return std::atomic_load(&view_state_);
 }
 
-std::shared_ptr<Board> BoardDataManager::GetMutableBoard()
+std::shared_ptr<BoardDataManager::ViewState> BoardDataManager::CopyViewState() const
 {
-    std::lock_guard<std::mutex> lock(board_mutex_);
-    return current_board_;
+    // Writers hold write_mutex_, so the published state cannot change under the copy
+    return std::make_shared<ViewState>(*view_state_);
 }
 
-void BoardDataManager::SetBoard(std::shared_ptr<Board> board)
+void BoardDataManager::Publish(std::shared_ptr<ViewState> state)
+{
+    state->version = view_state_->version + 1;
+    std::atomic_store(&view_state_, std::shared_ptr<const ViewState>(std::move(state)));
+}
+
+void BoardDataManager::SelectBoardVariant(ViewState& state)
+{
+    std::shared_ptr<const Board> variant;
+    if (board_variants_.loaded) {
+        const bool folded = state.board_folding_enabled;
+        const bool flipped = folded && state.view_side == BoardSide::kBottom;
+        if (!folded) {
+            variant = board_variants_.loaded;
+            board_variants_.shown.reset();
+            if (variant_requested_) {
+                ++variant_request_id_;  // The build in flight is no longer wanted
+                variant_requested_ = false;
+            }
+        } else if (board_variants_.shown && board_variants_.shown_flipped == flipped) {
+            variant = board_variants_.shown;
+        } else {
+            // Keeps what is on screen until the worker publishes the variant
+            if (!variant_requested_ || variant_requested_flipped_ != flipped) {
+                RequestBoardVariant(flipped);
+            }
+            variant = state.board ? state.board : board_variants_.loaded;
+        }
+    }
+
+    if (variant != state.board) {
+        state.board = std::move(variant);
+        state.selected_element = nullptr;
+        state.box_selection.reset();
+        ++state.box_selection_revision;
+    }
+}
+
+void BoardDataManager::RequestBoardVariant(bool flipped)
 {
-    std::lock_guard<std::mutex> lock(board_mutex_);
-    current_board_ = board;
+    ++variant_request_id_;
+    variant_requested_ = true;
+    variant_requested_flipped_ = flipped;
 
-    // Initialize layer visibility vector to match the board's layer count
-    if (board) {
-        int layer_count = board->GetLayerCount();
-        layer_visibility_.resize(layer_count, true);  // Default all layers to visible
+    auto request = std::make_unique<VariantRequest>();
+    request->source = board_variants_.loaded;
+    request->flipped = flipped;
+    request->request_id = variant_request_id_;
+    {
+        std::lock_guard<std::mutex> lock(variant_mutex_);
+        variant_request_ = std::move(request);
+        if (!variant_worker_.joinable()) {
+            variant_worker_ = std::thread(&BoardDataManager::VariantWorkerLoop, this);
+        }
+    }
+    variant_condition_.notify_one();
+}
 
-        // Sync with board's current layer visibility
-        for (int i = 0; i < layer_count; ++i) {
-            layer_visibility_[i] = board->IsLayerVisible(i);
+void BoardDataManager::VariantWorkerLoop()
+{
+    while (true) {
+        std::unique_ptr<VariantRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(variant_mutex_);
+            variant_condition_.wait(lock, [this]() { return variant_worker_stopping_ || variant_request_; });
+            if (variant_worker_stopping_) {
+                return;
+            }
+            request = std::move(variant_request_);
         }
+        std::shared_ptr<const Board> variant = request->source->CreateGeometryVariant(true, request->flipped);
 
-        // CRITICAL FIX: Reset viewing side to Top when board folding is enabled
-        // This prevents persisted viewing side settings from interfering with board loading
-        if (pending_board_folding_enabled_) {
-            current_view_side_ = BoardSide::kTop;
+        {
+            std::lock_guard<std::mutex> lock(variant_mutex_);
+            variant_result_ = std::move(request);
+            variant_result_->source = std::move(variant);  // Picked up by PollBoardVariant
         }
+        variant_condition_.notify_all();
+    }
+}
 
-        // CRITICAL: Apply pending folding settings when a new board is loaded
-        // This ensures the board geometry matches the user's intended setting
-        // Note: ApplyPendingFoldingSettings will be called after the lock is released
-    } else {
-        layer_visibility_.clear();
+void BoardDataManager::WaitForBoardVariant()
+{
+    while (IsBoardVariantPending()) {
+        {
+            std::unique_lock<std::mutex> lock(variant_mutex_);
+            variant_condition_.wait(lock, [this]() { return variant_result_ || variant_worker_stopping_; });
+            if (variant_worker_stopping_) {
+                return;
+            }
+        }
+        PollBoardVariant();  // A result for an older request is dropped; the newer one follows
     }
+}
+
+bool BoardDataManager::IsBoardVariantPending() const
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return variant_requested_;
+}
+
+void BoardDataManager::PollBoardVariant()
+{
+    std::unique_ptr<VariantRequest> result;
+    {
+        std::lock_guard<std::mutex> lock(variant_mutex_);
+        result = std::move(variant_result_);
+    }
+    if (!result) {
+        return;
+    }
+
+    SettingsChangeCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (result->request_id != variant_request_id_) {
+            return;  // Another board was set or the view moved on meanwhile
+        }
+        variant_requested_ = false;
+        board_variants_.shown = std::move(result->source);  // Frees the variant shown before, once readers let go of it
+        board_variants_.shown_flipped = result->flipped;
+
+        auto state = CopyViewState();
+        SelectBoardVariant(*state);
+        Publish(std::move(state));
+        cb = settings_change_callback_;
+    }
+    if (cb) {
+        cb();
+    }
+}
+
+std::shared_ptr<const Board> BoardDataManager::GetBoard() const
+{
+    return GetViewState()->board;
+}
+
+std::shared_ptr<const Board> BoardDataManager::GetLoadedBoard() const
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return board_variants_.loaded;
+}
+
+void BoardDataManager::SetBoard(std::shared_ptr<Board> board)
+{
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto state = CopyViewState();
+        board_variants_ = BoardVariants();
+        board_variants_.loaded = board;
+        ++variant_request_id_;  // Drops a variant still being built from the previous board
+        variant_requested_ = false;
+
+        // Selections hold element pointers into the previous board
+        state->board.reset();
+        state->selected_element = nullptr;
+        state->box_selection.reset();
+        ++state->box_selection_revision;
+
+        // Initialize layer visibility to match the board's layer count, from the defaults the loader left
+        state->layer_visibility.clear();
+        if (board) {
+            const int layer_count = board->GetLayerCount();
+            state->layer_visibility.reserve(layer_count);
+            for (int i = 0; i < layer_count; ++i) {
+                state->layer_visibility.push_back(board->layers[i].IsVisible() ? 1 : 0);
+            }
+
+            // CRITICAL FIX: Reset viewing side to Top when board folding is enabled
+            // This prevents persisted viewing side settings from interfering with board loading
+            if (state->pending_board_folding_enabled) {
+                state->view_side = BoardSide::kTop;
+            }
+
+            // CRITICAL: Apply pending folding settings when a new board is loaded
+            // This ensures the board geometry matches the user's intended setting
+            if (state->has_pending_folding_change) {
+                state->board_folding_enabled = state->pending_board_folding_enabled;
+                state->has_pending_folding_change = false;
+                if (!state->board_folding_enabled) {
+                    state->view_side = BoardSide::kBoth;
+                }
+            }
+        }
 
-    // Apply pending folding settings after releasing the lock
-    if (board) {
-        ApplyPendingFoldingSettings();
+        SelectBoardVariant(*state);
+        Publish(std::move(state));
     }
 }
 
 void BoardDataManager::ClearBoard()
 {
-    std::lock_guard<std::mutex> lock(board_mutex_);
-    current_board_.reset();
+    SetBoard(nullptr);
 }
 
 void BoardDataManager::SetLayerHueStep(float hueStep)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        layer_hue_step_ = hueStep;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto state = CopyViewState();
+        state->layer_hue_step = hueStep;
+        Publish(std::move(state));
         cb = settings_change_callback_;
     }
     if (cb) {
@@ -85,14 +250,13 @@ void BoardDataManager::SetLayerHueStep(float hueStep)
 
 float BoardDataManager::GetLayerHueStep() const
 {
-    std::lock_guard<std::mutex> lock(board_mutex_);
-    return layer_hue_step_;
+    return GetViewState()->layer_hue_step;
 }
 
-BLRgba32 BoardDataManager::GetColorUnlocked(ColorType type) const
+BLRgba32 BoardDataManager::ViewState::GetColor(ColorType type) const
 {
-    auto it = color_map.find(type);
-    if (it != color_map.end()) {
+    auto it = colors.find(type);
+    if (it != colors.end()) {
         return it->second;
     }
     switch (type) {
@@ -126,48 +290,46 @@ BLRgba32 BoardDataManager::GetColorUnlocked(ColorType type) const
 
 BLRgba32 BoardDataManager::GetColor(ColorType type) const
 {
-    // Performance optimization: Use atomic read for frequently accessed colors
-    // Only lock for complex operations or when cache miss occurs
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return GetColorUnlocked(type);
+    // Performance optimization: Lock-free read of the published view state
+    return GetViewState()->GetColor(type);
 }
 
-// Performance optimization: Batch color retrieval to reduce mutex overhead
+// Performance optimization: Batch color retrieval from one snapshot
 void BoardDataManager::GetColors(const std::vector<ColorType>& types, std::unordered_map<ColorType, BLRgba32>& out_colors) const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    const std::shared_ptr<const ViewState> state = GetViewState();
     out_colors.clear();
     out_colors.reserve(types.size());
 
     for (ColorType type : types) {
-        out_colors[type] = GetColorUnlocked(type);
+        out_colors[type] = state->GetColor(type);
     }
 }
 
 void BoardDataManager::LoadColorsFromConfig(const Config& config)
 {
     static const ColorType all_types[] = {ColorType::kNetHighlight, ColorType::kSelectedElementHighlight, ColorType::kSilkscreen, ColorType::kComponentFill, ColorType::kComponentStroke, ColorType::kPinFill, ColorType::kPinStroke, ColorType::kBaseLayer, ColorType::kBoardEdges, ColorType::kGND, ColorType::kNC};
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    auto state = CopyViewState();
     for (ColorType type : all_types) {
         std::string key = "color." + std::string(::ColorTypeToString(type));
         if (config.HasKey(key)) {
             uint32_t rgba = static_cast<uint32_t>(config.GetInt(key, 0xFFFFFFFF));
-            color_map[type] = BLRgba32(rgba);
+            state->colors[type] = BLRgba32(rgba);
         } else {
-            color_map[type] = GetColorUnlocked(type);  // fallback to default, no lock
+            state->colors[type] = state->GetColor(type);  // fallback to default
         }
     }
+    Publish(std::move(state));
 }
 
 void BoardDataManager::SaveColorsToConfig(Config& config) const
 {
     static const ColorType all_types[] = {ColorType::kNetHighlight, ColorType::kSelectedElementHighlight, ColorType::kSilkscreen, ColorType::kComponentFill, ColorType::kComponentStroke, ColorType::kPinFill, ColorType::kPinStroke, ColorType::kBaseLayer, ColorType::kBoardEdges, ColorType::kGND, ColorType::kNC};
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    const std::shared_ptr<const ViewState> state = GetViewState();
     for (ColorType type : all_types) {
         std::string key = "color." + std::string(::ColorTypeToString(type));
-        auto it = color_map.find(type);
-        uint32_t rgba = (it != color_map.end()) ? it->second.value : GetColorUnlocked(type).value;
-        config.SetInt(key, static_cast<int>(rgba));
+        config.SetInt(key, static_cast<int>(state->GetColor(type).value));
     }
 }
 
@@ -177,51 +339,49 @@ void BoardDataManager::LoadSettingsFromConfig(const Config& config)
     LoadColorsFromConfig(config);
 
     // Load board folding setting
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    board_folding_enabled_ = config.GetBool("board.folding_enabled", false);
-    pending_board_folding_enabled_ = board_folding_enabled_; // Initialize pending to match current
-    has_pending_folding_change_ = false; // No pending changes on load
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    auto state = CopyViewState();
+    state->board_folding_enabled = config.GetBool("board.folding_enabled", false);
+    state->pending_board_folding_enabled = state->board_folding_enabled; // Initialize pending to match current
+    state->has_pending_folding_change = false; // No pending changes on load
 
     // Load rendering settings
-    board_outline_thickness_ = config.GetFloat("rendering.board_outline_thickness", 2.0f);
-    component_stroke_thickness_ = config.GetFloat("rendering.component_stroke_thickness", 0.33f);
-    pin_stroke_thickness_ = config.GetFloat("rendering.pin_stroke_thickness", 0.33f);
+    state->board_outline_thickness = config.GetFloat("rendering.board_outline_thickness", 2.0f);
+    state->component_stroke_thickness = config.GetFloat("rendering.component_stroke_thickness", 0.33f);
+    state->pin_stroke_thickness = config.GetFloat("rendering.pin_stroke_thickness", 0.33f);
 
     // Clamp values to reasonable ranges
-    if (board_outline_thickness_ < 0.01f) board_outline_thickness_ = 0.01f;
-    if (board_outline_thickness_ > 5.0f) board_outline_thickness_ = 5.0f;
-    if (component_stroke_thickness_ < 0.01f) component_stroke_thickness_ = 0.01f;
-    if (component_stroke_thickness_ > 2.0f) component_stroke_thickness_ = 2.0f;
-    if (pin_stroke_thickness_ < 0.01f) pin_stroke_thickness_ = 0.01f;
-    if (pin_stroke_thickness_ > 1.0f) pin_stroke_thickness_ = 1.0f;
+    state->board_outline_thickness = std::clamp(state->board_outline_thickness, 0.01f, 5.0f);
+    state->component_stroke_thickness = std::clamp(state->component_stroke_thickness, 0.01f, 2.0f);
+    state->pin_stroke_thickness = std::clamp(state->pin_stroke_thickness, 0.01f, 1.0f);
 
     // Load board view side setting
     int view_side_int = config.GetInt("board.view_side", static_cast<int>(BoardSide::kTop));
 
     // CRITICAL FIX: When board folding is enabled, always start with Top view
     // The persisted viewing side will be ignored to prevent interference with board loading
-    if (board_folding_enabled_) {
-        current_view_side_ = BoardSide::kTop;
+    if (state->board_folding_enabled) {
+        state->view_side = BoardSide::kTop;
     } else {
         // When folding is disabled, use persisted setting but ensure it's 'Both'
         if (view_side_int >= 0 && view_side_int <= 2) {
-            current_view_side_ = static_cast<BoardSide>(view_side_int);
+            state->view_side = static_cast<BoardSide>(view_side_int);
         } else {
             // If invalid, default to Top
-            current_view_side_ = BoardSide::kTop;
+            state->view_side = BoardSide::kTop;
         }
 
         // If folding is disabled, automatically set view side to 'Both'
-        if (current_view_side_ != BoardSide::kBoth) {
-            current_view_side_ = BoardSide::kBoth;
+        if (state->view_side != BoardSide::kBoth) {
+            state->view_side = BoardSide::kBoth;
         }
     }
 
-    // Load global horizontal mirror setting
-    // global_horizontal_mirror_ = config.GetBool("board.global_horizontal_mirror", false);
-
     // Load layer hue step
-    layer_hue_step_ = config.GetFloat("board.layer_hue_step", 30.0f);
+    state->layer_hue_step = config.GetFloat("board.layer_hue_step", 30.0f);
+
+    SelectBoardVariant(*state);
+    Publish(std::move(state));
 }
 
 void BoardDataManager::SaveSettingsToConfig(Config& config) const
@@ -230,49 +390,46 @@ void BoardDataManager::SaveSettingsToConfig(Config& config) const
     SaveColorsToConfig(config);
 
     // Save board folding setting (save the pending setting so it persists across sessions)
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    config.SetBool("board.folding_enabled", has_pending_folding_change_ ? pending_board_folding_enabled_ : board_folding_enabled_);
+    const std::shared_ptr<const ViewState> state = GetViewState();
+    config.SetBool("board.folding_enabled", state->has_pending_folding_change ? state->pending_board_folding_enabled : state->board_folding_enabled);
 
     // Save board view side setting
     // When board folding is enabled, we save the current viewing side for user convenience
     // When folding is disabled, we always save 'Both' since that's the only valid state
-    BoardSide side_to_save = current_view_side_;
-    if (!board_folding_enabled_ && side_to_save != BoardSide::kBoth) {
+    BoardSide side_to_save = state->view_side;
+    if (!state->board_folding_enabled && side_to_save != BoardSide::kBoth) {
         side_to_save = BoardSide::kBoth;  // Ensure consistency
     }
     config.SetInt("board.view_side", static_cast<int>(side_to_save));
 
-    // Save global horizontal mirror setting
-    // config.SetBool("board.global_horizontal_mirror", global_horizontal_mirror_);
-
     // Save rendering settings
-    config.SetFloat("rendering.board_outline_thickness", board_outline_thickness_);
-    config.SetFloat("rendering.component_stroke_thickness", component_stroke_thickness_);
-    config.SetFloat("rendering.pin_stroke_thickness", pin_stroke_thickness_);
+    config.SetFloat("rendering.board_outline_thickness", state->board_outline_thickness);
+    config.SetFloat("rendering.component_stroke_thickness", state->component_stroke_thickness);
+    config.SetFloat("rendering.pin_stroke_thickness", state->pin_stroke_thickness);
 
     // Save layer hue step
-    config.SetFloat("board.layer_hue_step", layer_hue_step_);
+    config.SetFloat("board.layer_hue_step", state->layer_hue_step);
 }
 
-void BoardDataManager::RegenerateLayerColors(const std::shared_ptr<Board>& board)
+void BoardDataManager::RegenerateLayerColors(const std::shared_ptr<const Board>& board)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
         if (!board)
             return;
 
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto state = CopyViewState();
         int layerCount = board->GetLayerCount();
-        layer_colors_.resize(layerCount);
+        state->layer_colors.resize(layerCount);
 
-        BLRgba32 baseColor = color_map.count(ColorType::kBaseLayer) ? color_map.at(ColorType::kBaseLayer) : GetColorUnlocked(ColorType::kBaseLayer);
-        float hueStep = layer_hue_step_;
+        BLRgba32 baseColor = state->GetColor(ColorType::kBaseLayer);
+        float hueStep = state->layer_hue_step;
 
         for (int i = 0; i < layerCount; ++i) {
-            BLRgba32 layerColor = color_utils::GenerateLayerColor(i, layerCount, baseColor, hueStep);
-            layer_colors_[i] = layerColor;
-            board->SetLayerColor(i, layerColor);
+            state->layer_colors[i] = color_utils::GenerateLayerColor(i, layerCount, baseColor, hueStep);
         }
+        Publish(std::move(state));
         cb = settings_change_callback_;
     }
     if (cb) {
@@ -284,9 +441,11 @@ void BoardDataManager::SetSelectedNetId(int netId)
 {
     NetIdChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (selected_net_id_ != netId) {
-            selected_net_id_ = netId;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (view_state_->selected_net_id != netId) {
+            auto state = CopyViewState();
+            state->selected_net_id = netId;
+            Publish(std::move(state));
             cb = net_id_change_callback_;
         }
     }
@@ -297,23 +456,27 @@ void BoardDataManager::SetSelectedNetId(int netId)
 
 int BoardDataManager::GetSelectedNetId() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return selected_net_id_;
+    return GetViewState()->selected_net_id;
 }
 
 void BoardDataManager::SetBoardFoldingEnabled(bool enabled)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-
-        // Store as pending setting instead of applying immediately
-        if (pending_board_folding_enabled_ != enabled) {
-            pending_board_folding_enabled_ = enabled;
-            has_pending_folding_change_ = (pending_board_folding_enabled_ != board_folding_enabled_);
-
-            // Only trigger UI update callback to refresh the settings display
-            // Do NOT change current board state or view side here
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        // Applied immediately: the folded variant is built on the variant worker and published when it is ready, so
+        // toggling no longer waits for the next board load
+        if (view_state_->board_folding_enabled != enabled || view_state_->has_pending_folding_change) {
+            auto state = CopyViewState();
+            state->board_folding_enabled = enabled;
+            state->pending_board_folding_enabled = enabled;
+            state->has_pending_folding_change = false;
+
+            // Same view side rules as loading a board with the setting applied
+            state->view_side = enabled ? BoardSide::kTop : BoardSide::kBoth;
+            SelectBoardVariant(*state);
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -324,48 +487,49 @@ void BoardDataManager::SetBoardFoldingEnabled(bool enabled)
 
 bool BoardDataManager::IsBoardFoldingEnabled() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return board_folding_enabled_;
+    return GetViewState()->board_folding_enabled;
 }
 
 bool BoardDataManager::GetPendingBoardFoldingEnabled() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return pending_board_folding_enabled_;
+    return GetViewState()->pending_board_folding_enabled;
 }
 
 bool BoardDataManager::HasPendingFoldingChange() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return has_pending_folding_change_;
+    return GetViewState()->has_pending_folding_change;
 }
 
 void BoardDataManager::ApplyPendingFoldingSettings()
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
 
-    if (!has_pending_folding_change_) {
+    if (!view_state_->has_pending_folding_change) {
         return;
     }
 
-
-    board_folding_enabled_ = pending_board_folding_enabled_;
-    has_pending_folding_change_ = false;
+    auto state = CopyViewState();
+    state->board_folding_enabled = state->pending_board_folding_enabled;
+    state->has_pending_folding_change = false;
 
     // NOW apply the view side logic when the setting is actually applied
-    if (!board_folding_enabled_ && current_view_side_ != BoardSide::kBoth) {
-        current_view_side_ = BoardSide::kBoth;
+    if (!state->board_folding_enabled && state->view_side != BoardSide::kBoth) {
+        state->view_side = BoardSide::kBoth;
     }
-
+    SelectBoardVariant(*state);
+    Publish(std::move(state));
 }
 
 void BoardDataManager::SetCurrentViewSide(BoardSide side)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (current_view_side_ != side) {
-            current_view_side_ = side;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (view_state_->view_side != side) {
+            auto state = CopyViewState();
+            state->view_side = side;
+            SelectBoardVariant(*state);
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -376,29 +540,27 @@ void BoardDataManager::SetCurrentViewSide(BoardSide side)
 
 BoardDataManager::BoardSide BoardDataManager::GetCurrentViewSide() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return current_view_side_;
+    return GetViewState()->view_side;
 }
 
 void BoardDataManager::ToggleViewSide()
 {
     SettingsChangeCallback cb;
-    std::shared_ptr<Board> board;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
+        std::lock_guard<std::mutex> lock(write_mutex_);
 
         // CRITICAL FIX: Board flipping should only work when folding is enabled
-        if (!board_folding_enabled_) {
+        if (!view_state_->board_folding_enabled) {
             return;
         }
 
         // CRITICAL FIX: Board flipping should only work when viewing Top or Bottom, not Both
-        if (current_view_side_ == BoardSide::kBoth) {
+        if (view_state_->view_side == BoardSide::kBoth) {
             return;
         }
 
         BoardSide next_side;
-        switch (current_view_side_) {
+        switch (view_state_->view_side) {
             case BoardSide::kTop:
                 next_side = BoardSide::kBottom;
                 break;
@@ -412,17 +574,14 @@ void BoardDataManager::ToggleViewSide()
                 break;
         }
 
-        current_view_side_ = next_side;
-        board = current_board_;
+        // Publishes the mirrored (or unmirrored) variant instead of transforming the shared board's elements
+        auto state = CopyViewState();
+        state->view_side = next_side;
+        SelectBoardVariant(*state);
+        Publish(std::move(state));
         cb = settings_change_callback_;
     }
 
-    // Apply actual coordinate transformation to board elements instead of visual-only mirroring
-    if (board) {
-        // Apply global transformation (mirroring) to all board elements
-        board->ApplyGlobalTransformation(true);
-    }
-
     if (cb) {
         cb();
     }
@@ -430,51 +589,48 @@ void BoardDataManager::ToggleViewSide()
 
 bool BoardDataManager::CanFlipBoard() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    const std::shared_ptr<const ViewState> state = GetViewState();
 
     // Board flipping is only allowed when:
     // 1. Board folding is enabled
     // 2. Currently viewing Top or Bottom side (not Both)
-    return board_folding_enabled_ &&
-           (current_view_side_ == BoardSide::kTop || current_view_side_ == BoardSide::kBottom);
+    return state->board_folding_enabled &&
+           (state->view_side == BoardSide::kTop || state->view_side == BoardSide::kBottom);
 }
 
-// SetGlobalHorizontalMirror and IsGlobalHorizontalMirrorEnabled methods removed
-// Coordinate transformations are now applied directly to element coordinates
-
 void BoardDataManager::RegisterNetIdChangeCallback(NetIdChangeCallback callback)
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     net_id_change_callback_ = callback;
 }
 
 void BoardDataManager::UnregisterNetIdChangeCallback()
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     net_id_change_callback_ = nullptr;
 }
 
 void BoardDataManager::RegisterSettingsChangeCallback(SettingsChangeCallback callback)
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     settings_change_callback_ = callback;
 }
 
 void BoardDataManager::UnregisterSettingsChangeCallback()
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     settings_change_callback_ = nullptr;
 }
 
 void BoardDataManager::RegisterLayerVisibilityChangeCallback(LayerVisibilityChangeCallback callback)
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     layer_visibility_change_callback_ = callback;
 }
 
 void BoardDataManager::UnregisterLayerVisibilityChangeCallback()
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
     layer_visibility_change_callback_ = nullptr;
 }
 
@@ -482,26 +638,18 @@ void BoardDataManager::SetLayerVisible(int layerId, bool visible)
 {
     LayerVisibilityChangeCallback layer_cb;
     SettingsChangeCallback settings_cb;
-    std::shared_ptr<Board> board;
 
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (layerId >= 0 && layerId < static_cast<int>(layer_visibility_.size())) {
-            layer_visibility_[layerId] = visible;
-            board = current_board_;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (layerId >= 0 && layerId < static_cast<int>(view_state_->layer_visibility.size())) {
+            auto state = CopyViewState();
+            state->layer_visibility[layerId] = visible ? 1 : 0;
+            Publish(std::move(state));
             layer_cb = layer_visibility_change_callback_;
             settings_cb = settings_change_callback_;
         }
     }
 
-    // Update board layer visibility outside of lock to avoid deadlock
-    if (board && layerId < board->GetLayerCount()) {
-        // Update board layer visibility directly (avoid calling SetLayerVisible to prevent recursion)
-        if (layerId >= 0 && layerId < static_cast<int>(board->layers.size())) {
-            board->layers[layerId].is_visible = visible;
-        }
-    }
-
     // Call callbacks outside of lock
     if (layer_cb) {
         layer_cb(layerId, visible);
@@ -515,8 +663,10 @@ void BoardDataManager::SetColor(ColorType type, BLRgba32 color)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        color_map[type] = color;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto state = CopyViewState();
+        state->colors[type] = color;
+        Publish(std::move(state));
         cb = settings_change_callback_;
     }
     if (cb) {
@@ -525,26 +675,27 @@ void BoardDataManager::SetColor(ColorType type, BLRgba32 color)
 }
 
 BLRgba32 BoardDataManager::GetLayerColor(int layer_id) const
+{
+    return GetViewState()->GetLayerColor(layer_id);
+}
+
+BLRgba32 BoardDataManager::ViewState::GetLayerColor(int layer_id) const
 {
     // 1-16: trace layers (apply hue rotation)
     if (layer_id >= 1 && layer_id <= 16) {
-        BLRgba32 base_color = color_map.count(ColorType::kBaseLayer) ? color_map.at(ColorType::kBaseLayer) : GetColorUnlocked(ColorType::kBaseLayer);
-        float hue_step = layer_hue_step_;
-        return color_utils::GenerateLayerColor(layer_id - 1, 16, base_color, hue_step);
+        return color_utils::GenerateLayerColor(layer_id - 1, 16, GetColor(ColorType::kBaseLayer), layer_hue_step);
     }
     // 17: silkscreen
     if (layer_id == 17) {
-        return color_map.count(ColorType::kSilkscreen) ? color_map.at(ColorType::kSilkscreen) : GetColorUnlocked(ColorType::kSilkscreen);
+        return GetColor(ColorType::kSilkscreen);
     }
     // 18-27: unused, but apply hue rotation
     if (layer_id >= 18 && layer_id <= 27) {
-        BLRgba32 base_color = color_map.count(ColorType::kBaseLayer) ? color_map.at(ColorType::kBaseLayer) : GetColorUnlocked(ColorType::kBaseLayer);
-        float hue_step = layer_hue_step_;
-        return color_utils::GenerateLayerColor(layer_id - 1, 16, base_color, hue_step);
+        return color_utils::GenerateLayerColor(layer_id - 1, 16, GetColor(ColorType::kBaseLayer), layer_hue_step);
     }
     // 28: board edges
     if (layer_id == 28) {
-        return color_map.count(ColorType::kBoardEdges) ? color_map.at(ColorType::kBoardEdges) : GetColorUnlocked(ColorType::kBoardEdges);
+        return GetColor(ColorType::kBoardEdges);
     }
     // fallback: default color
     return BLRgba32(0xFF888888);
@@ -552,11 +703,7 @@ BLRgba32 BoardDataManager::GetLayerColor(int layer_id) const
 
 bool BoardDataManager::IsLayerVisible(int layer_id) const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    if (layer_id >= 0 && layer_id < static_cast<int>(layer_visibility_.size())) {
-        return layer_visibility_[layer_id];
-    }
-    return true;  // Default to visible if layer not found
+    return GetViewState()->IsLayerVisible(layer_id);  // Defaults to visible if layer not found
 }
 
 void BoardDataManager::ToggleLayerVisibility(int layer_id)
@@ -566,10 +713,12 @@ void BoardDataManager::ToggleLayerVisibility(int layer_id)
     bool visible = false;
 
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (layer_id >= 0 && layer_id < static_cast<int>(layer_visibility_.size())) {
-            layer_visibility_[layer_id] = !layer_visibility_[layer_id];
-            visible = layer_visibility_[layer_id];
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (layer_id >= 0 && layer_id < static_cast<int>(view_state_->layer_visibility.size())) {
+            auto state = CopyViewState();
+            visible = !state->layer_visibility[layer_id];
+            state->layer_visibility[layer_id] = visible ? 1 : 0;
+            Publish(std::move(state));
             layer_cb = layer_visibility_change_callback_;
             settings_cb = settings_change_callback_;
         }
@@ -585,10 +734,10 @@ void BoardDataManager::ToggleLayerVisibility(int layer_id)
 
 std::vector<int> BoardDataManager::GetVisibleLayers() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
+    const std::shared_ptr<const ViewState> state = GetViewState();
     std::vector<int> visible_layers;
-    for (int i = 0; i < static_cast<int>(layer_visibility_.size()); ++i) {
-        if (layer_visibility_[i]) {
+    for (int i = 0; i < static_cast<int>(state->layer_visibility.size()); ++i) {
+        if (state->layer_visibility[i]) {
             visible_layers.push_back(i);
         }
     }
@@ -599,9 +748,11 @@ void BoardDataManager::SetLayerColor(int layer_id, BLRgba32 color)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (layer_id >= 0 && layer_id < static_cast<int>(layer_colors_.size())) {
-            layer_colors_[layer_id] = color;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (layer_id >= 0 && layer_id < static_cast<int>(view_state_->layer_colors.size())) {
+            auto state = CopyViewState();
+            state->layer_colors[layer_id] = color;
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -616,13 +767,15 @@ void BoardDataManager::SetBoardOutlineThickness(float thickness)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
+        std::lock_guard<std::mutex> lock(write_mutex_);
         // Clamp to reasonable range
         if (thickness < 0.01f) thickness = 0.01f;
         if (thickness > 5.0f) thickness = 5.0f;
 
-        if (board_outline_thickness_ != thickness) {
-            board_outline_thickness_ = thickness;
+        if (view_state_->board_outline_thickness != thickness) {
+            auto state = CopyViewState();
+            state->board_outline_thickness = thickness;
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -633,21 +786,22 @@ void BoardDataManager::SetBoardOutlineThickness(float thickness)
 
 float BoardDataManager::GetBoardOutlineThickness() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return board_outline_thickness_;
+    return GetViewState()->board_outline_thickness;
 }
 
 void BoardDataManager::SetComponentStrokeThickness(float thickness)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
+        std::lock_guard<std::mutex> lock(write_mutex_);
         // Clamp to reasonable range
         if (thickness < 0.01f) thickness = 0.01f;
         if (thickness > 2.0f) thickness = 2.0f;
 
-        if (component_stroke_thickness_ != thickness) {
-            component_stroke_thickness_ = thickness;
+        if (view_state_->component_stroke_thickness != thickness) {
+            auto state = CopyViewState();
+            state->component_stroke_thickness = thickness;
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -658,21 +812,22 @@ void BoardDataManager::SetComponentStrokeThickness(float thickness)
 
 float BoardDataManager::GetComponentStrokeThickness() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return component_stroke_thickness_;
+    return GetViewState()->component_stroke_thickness;
 }
 
 void BoardDataManager::SetPinStrokeThickness(float thickness)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
+        std::lock_guard<std::mutex> lock(write_mutex_);
         // Clamp to reasonable range
         if (thickness < 0.01f) thickness = 0.01f;
         if (thickness > 1.0f) thickness = 1.0f;
 
-        if (pin_stroke_thickness_ != thickness) {
-            pin_stroke_thickness_ = thickness;
+        if (view_state_->pin_stroke_thickness != thickness) {
+            auto state = CopyViewState();
+            state->pin_stroke_thickness = thickness;
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -683,8 +838,7 @@ void BoardDataManager::SetPinStrokeThickness(float thickness)
 
 float BoardDataManager::GetPinStrokeThickness() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return pin_stroke_thickness_;
+    return GetViewState()->pin_stroke_thickness;
 }
 
 
@@ -693,9 +847,11 @@ void BoardDataManager::SetSelectedElement(const Element* element)
 {
     SettingsChangeCallback cb;
     {
-        std::lock_guard<std::mutex> lock(net_mutex_);
-        if (selected_element_ != element) {
-            selected_element_ = element;
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (view_state_->selected_element != element) {
+            auto state = CopyViewState();
+            state->selected_element = element;
+            Publish(std::move(state));
             cb = settings_change_callback_;
         }
     }
@@ -706,11 +862,58 @@ void BoardDataManager::SetSelectedElement(const Element* element)
 
 const Element* BoardDataManager::GetSelectedElement() const
 {
-    std::lock_guard<std::mutex> lock(net_mutex_);
-    return selected_element_;
+    return GetViewState()->selected_element;
 }
 
 void BoardDataManager::ClearSelectedElement()
 {
     SetSelectedElement(nullptr);
 }
+
+void BoardDataManager::SetBoxSelection(BoxSelection elements)
+{
+    auto selection = std::make_shared<const BoxSelection>(std::move(elements));
+    SettingsChangeCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto state = CopyViewState();
+        state->box_selection = std::move(selection);
+        ++state->box_selection_revision;
+        Publish(std::move(state));
+        cb = settings_change_callback_;
+    }
+    if (cb) {
+        cb();
+    }
+}
+
+std::shared_ptr<const BoardDataManager::BoxSelection> BoardDataManager::GetBoxSelection() const
+{
+    static const std::shared_ptr<const BoxSelection> kEmptySelection = std::make_shared<const BoxSelection>();
+    const std::shared_ptr<const ViewState> state = GetViewState();
+    return state->box_selection ? state->box_selection : kEmptySelection;
+}
+
+uint64_t BoardDataManager::GetBoxSelectionRevision() const
+{
+    return GetViewState()->box_selection_revision;
+}
+
+void BoardDataManager::ClearBoxSelection()
+{
+    SettingsChangeCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (!view_state_->box_selection || view_state_->box_selection->empty()) {
+            return;
+        }
+        auto state = CopyViewState();
+        state->box_selection.reset();
+        ++state->box_selection_revision;
+        Publish(std::move(state));
+        cb = settings_change_callback_;
+    }
+    if (cb) {
+        cb();
+    }
+}
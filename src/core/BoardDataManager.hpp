@@ -1,8 +1,11 @@
 #pragma once // Added include guard
 
+#include <cstdint>
 #include <string>
 #include <memory>
-#include <mutex>     // For thread-safe access to the board
+#include <mutex>     // Serializes writers of the view state
+#include <condition_variable>
+#include <thread>
 #include <blend2d.h> // For BLRgba32
 #include <vector>
 #include <functional>
@@ -10,6 +13,8 @@
 
 // Forward declarations
 class Board;
+class Element;
+struct ElementInteractionInfo;
 
 // Include the PcbLoader header instead of forward declaration to avoid undefined class error
 #include "pcb/XZZPCBLoader.hpp"
@@ -20,16 +25,16 @@ public:
     BoardDataManager();
     ~BoardDataManager();
 
-    // Retrieves the currently loaded board (const version for read-only access)
+    // Retrieves the published board snapshot (see ViewState::board)
     // Returns a shared_ptr to the board, which might be nullptr if no board is loaded
     std::shared_ptr<const Board> GetBoard() const;
 
-    // Retrieves the currently loaded board (non-const version for modifications)
-    // Returns a shared_ptr to the board, which might be nullptr if no board is loaded
-    // Use this for operations that need to modify the board (e.g., folding, element updates)
-    std::shared_ptr<Board> GetMutableBoard();
+    // The board as loaded, which every published variant is a geometry copy of. Stays the same across folds and
+    // flips, so it identifies the loaded file for data derived from element identity rather than geometry.
+    std::shared_ptr<const Board> GetLoadedBoard() const;
 
-    // Sets the currently loaded board
+    // Sets the currently loaded board. The manager takes it over as the base of every geometry variant; the board
+    // must not be changed afterwards.
     void SetBoard(std::shared_ptr<Board> board);
 
     // Clears the currently loaded board
@@ -39,9 +44,10 @@ public:
     void SetLayerHueStep(float hue_step);
     float GetLayerHueStep() const;
 
-    void RegenerateLayerColors(const std::shared_ptr<Board> &board); // Re-applies coloring to the given board
+    void RegenerateLayerColors(const std::shared_ptr<const Board> &board); // Regenerates the layer colors for the given board
     BLRgba32 GetLayerColor(int layer_id) const;
     void SetLayerColor(int layer_id, BLRgba32 color);
+    // Layer visibility is indexed like Board::layers; LayerInfo::is_visible only holds the default after loading
     bool IsLayerVisible(int layer_id) const;
     void SetLayerVisible(int layer_id, bool visible);
     void ToggleLayerVisibility(int layer_id);
@@ -52,10 +58,18 @@ public:
     int GetSelectedNetId() const;
 
     // --- Selected Element Highlighting ---
-    void SetSelectedElement(const class Element* element);
-    const class Element* GetSelectedElement() const;
+    void SetSelectedElement(const Element* element);
+    const Element* GetSelectedElement() const;
     void ClearSelectedElement();
 
+    // --- Box Selection ---
+    // Published as an immutable snapshot so the renderer and details window can hold it without copying
+    using BoxSelection = std::vector<ElementInteractionInfo>;
+    void SetBoxSelection(BoxSelection elements);
+    std::shared_ptr<const BoxSelection> GetBoxSelection() const;  // Never null
+    uint64_t GetBoxSelectionRevision() const;                      // Bumped on every change
+    void ClearBoxSelection();
+
     // --- Board Folding ---
     void SetBoardFoldingEnabled(bool enabled);
     bool IsBoardFoldingEnabled() const;
@@ -71,11 +85,16 @@ public:
         kBoth     // Show both sides (default)
     };
 
-    void SetCurrentViewSide(BoardSide side);
+    void SetCurrentViewSide(BoardSide side);  // Viewing the bottom of a folded board publishes the flipped variant
     BoardSide GetCurrentViewSide() const;
     void ToggleViewSide();  // Toggles between Top <-> Bottom and flips the board
     bool CanFlipBoard() const;  // Checks if board flipping is currently allowed
 
+    // Folded variants are built on a worker; the UI thread polls for the result and publishes it (see ViewState)
+    bool IsBoardVariantPending() const;
+    void PollBoardVariant();
+    void WaitForBoardVariant();  // For headless callers that have no loop to poll from
+
     // --- Board Coordinate System ---
     // Global horizontal mirror methods removed - coordinate transformations now
     // applied directly to element coordinates when board flip state changes
@@ -114,10 +133,9 @@ public:
     void SetColor(ColorType type, BLRgba32 color);
     BLRgba32 GetColor(ColorType type) const;
 
-    // Performance optimization: Batch color retrieval to reduce mutex overhead
+    // Performance optimization: Batch color retrieval from one view state snapshot
     void GetColors(const std::vector<ColorType>& types, std::unordered_map<ColorType, BLRgba32>& out_colors) const;
 
-    std::unordered_map<ColorType, BLRgba32> color_map;
     void LoadColorsFromConfig(const class Config &config);
     void SaveColorsToConfig(class Config &config) const;
 
@@ -131,41 +149,96 @@ public:
     void SetPinStrokeThickness(float thickness);
     float GetPinStrokeThickness() const;
 
-
+    // --- View State Snapshots ---
+    // Performance optimization: Everything the renderer, hit testing and the windows read from the manager lives in
+    // one immutable, versioned ViewState. Setters copy the published state, change the copy and publish it
+    // atomically; getters load the published pointer without taking a lock, and a reader that needs several
+    // values consistent with each other (a frame) holds one state for as long as it likes.
+    // The board a state points at is read-only: folding and flipping publish another geometry variant of the
+    // loaded board instead of moving elements that readers on other threads may be walking. A variant is built on
+    // a worker; until it is published, board stays the one on screen, so it can lag the folding and view side.
+    struct ViewState {
+        uint64_t version = 0;                // Bumped by every publish
+        std::shared_ptr<const Board> board;  // Variant matching board_folding_enabled and view_side; may be null
+        std::vector<uint8_t> layer_visibility;  // By index into Board::layers
+        std::vector<BLRgba32> layer_colors;     // By index into Board::layers
+        std::unordered_map<ColorType, BLRgba32> colors;  // Configured colors; GetColor falls back to the defaults
+        float layer_hue_step = 30.0f;
+
+        int selected_net_id = -1;
+        const Element* selected_element = nullptr;           // Belongs to board
+        std::shared_ptr<const BoxSelection> box_selection;   // Belongs to board; null when empty
+        uint64_t box_selection_revision = 0;
+
+        bool board_folding_enabled = false;
+        bool pending_board_folding_enabled = false;  // Only differs while a change is pending
+        bool has_pending_folding_change = false;
+        BoardSide view_side = BoardSide::kBoth;
+
+        float board_outline_thickness = 0.1f;
+        float component_stroke_thickness = 0.05f;
+        float pin_stroke_thickness = 0.03f;
+
+        [[nodiscard]] BLRgba32 GetColor(ColorType type) const;
+        [[nodiscard]] BLRgba32 GetLayerColor(int layer_id) const;  // By layer ID, from the colors above
+        // Visible unless hidden; layers outside the list (another board's) count as visible
+        [[nodiscard]] bool IsLayerVisible(int layer_index) const
+        {
+            return layer_index < 0 || layer_index >= static_cast<int>(layer_visibility.size()) || layer_visibility[layer_index] != 0;
+        }
+    };
+    std::shared_ptr<const ViewState> GetViewState() const;  // Never null
 
     // Configuration persistence for all settings
     void LoadSettingsFromConfig(const class Config &config);
     void SaveSettingsToConfig(class Config &config) const;
 
 private:
-    std::shared_ptr<Board> current_board_; // Renamed from m_currentBoard
-    PcbLoader pcb_loader_;                 // Renamed from m_pcbLoader
-    mutable std::mutex board_mutex_;       // Renamed from m_boardMutex
-
-    float layer_hue_step_ = 15.0F;  // Renamed from m_layerHueStep
+    // Geometry variants of the loaded board. Only the loaded board and the folded variant on screen are kept: a
+    // variant that is no longer shown is freed, and viewing it again builds it again on the variant worker.
+    struct BoardVariants {
+        std::shared_ptr<const Board> loaded;  // As loaded: unfolded and not flipped
+        std::shared_ptr<const Board> shown;   // Folded variant on screen; null while the loaded board is
+        bool shown_flipped = false;
+    };
 
-    int selected_net_id_ = -1;     // Renamed from m_selectedNetId
-    const class Element* selected_element_ = nullptr;  // Currently selected individual element
-    mutable std::mutex net_mutex_; // Renamed from m_netMutex
+    // A variant for the worker to build; dropped when it is done if request_id is no longer the latest
+    struct VariantRequest {
+        std::shared_ptr<const Board> source;  // The loaded board; the built variant once it is done
+        bool flipped = false;
+        uint64_t request_id = 0;
+    };
 
-    bool board_folding_enabled_ = false; // Current board folding state (applied to loaded board)
-    bool pending_board_folding_enabled_ = false; // Pending board folding setting (will apply on next load)
-    bool has_pending_folding_change_ = false; // Whether there's a pending folding setting change
-    BoardSide current_view_side_ = BoardSide::kBoth; // Current board side being viewed
-    // global_horizontal_mirror_ removed - coordinate transformations now applied directly to elements
+    // Caller holds write_mutex_. Copies the published state for a setter to change; Publish bumps its version.
+    [[nodiscard]] std::shared_ptr<ViewState> CopyViewState() const;
+    void Publish(std::shared_ptr<ViewState> state);
+    // Points state->board at the variant its folding and view side call for, building it if needed; clears the
+    // selection when the variant changes, since selected elements belong to one variant
+    void SelectBoardVariant(ViewState& state);
+    // Caller holds write_mutex_. Queues a build of the folded variant, replacing a queued one.
+    void RequestBoardVariant(bool flipped);
+    void VariantWorkerLoop();
+
+    PcbLoader pcb_loader_;  // Renamed from m_pcbLoader
+
+    std::shared_ptr<const ViewState> view_state_;  // Only accessed through std::atomic_load/std::atomic_store
+    mutable std::mutex write_mutex_;               // Serializes writers; readers never take it
+    BoardVariants board_variants_;                 // Guarded by write_mutex_
+    uint64_t variant_request_id_ = 0;              // Guarded by write_mutex_; bumped whenever the wanted variant changes
+    bool variant_requested_ = false;               // Guarded by write_mutex_; a build for variant_request_id_ is queued or running
+    bool variant_requested_flipped_ = false;
+
+    // Performance optimization: Variants are deep copies of the board, too slow to build on the UI thread
+    std::thread variant_worker_;  // Started with the first request
+    std::mutex variant_mutex_;    // Guards the three below; never held while taking write_mutex_
+    std::condition_variable variant_condition_;
+    std::unique_ptr<VariantRequest> variant_request_;
+    std::unique_ptr<VariantRequest> variant_result_;
+    bool variant_worker_stopping_ = false;
 
-    std::vector<BLRgba32> layer_colors_;                             // Renamed from m_layerColors
-    std::vector<bool> layer_visibility_;                             // Renamed from m_layerVisibility
     NetIdChangeCallback net_id_change_callback_;                     // Renamed from m_netIdChangeCallback
     SettingsChangeCallback settings_change_callback_;                // Renamed from m_settingsChangeCallback
     LayerVisibilityChangeCallback layer_visibility_change_callback_; // Renamed from m_layerVisibilityChangeCallback
-
-    // New rendering settings
-    float board_outline_thickness_ = 0.1f;  // Default board outline thickness
-    float component_stroke_thickness_ = 0.05f;  // Default component stroke thickness
-    float pin_stroke_thickness_ = 0.03f;    // Default pin stroke thickness
-
-    BLRgba32 GetColorUnlocked(ColorType type) const;
 };
 
 // Helper for UI and config keys
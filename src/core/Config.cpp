@@ -19,6 +19,11 @@ Config::Config()
     // Threading configuration
     SetInt("rendering.threadCount", 0);  // 0 = auto-detect optimal
     SetBool("rendering.enableMultithreading", true);
+    SetBool("rendering.bandedRasterization", true);  // Parallel horizontal bands for board rendering
+    SetBool("rendering.overviewPyramid", true);      // Raster pyramid for zoomed-out views
+    SetBool("rendering.subPixelTraceDensity", true);  // Sub-pixel traces as a coverage raster (off: always stroked)
+    SetBool("rendering.subPixelPadPoints", true);     // Sub-pixel vias and pins as single-pixel points
+    SetBool("rendering.subPixelTextCulling", true);   // Skip text below a pixel
     // Default keybinds are initialized in ControlSettings,
     // Config will only store them if they are modified or explicitly saved.
 }
@@ -63,6 +63,10 @@ void ControlSettings::InitializeDefaultKeybinds()
     ControlSettings::m_keybinds[InputAction::kZoomOut] = KeyCombination(ImGuiKey_Minus);
     // Ctrl+O: open file
     ControlSettings::m_keybinds[InputAction::kOpenFile] = KeyCombination(ImGuiKey_O, true, false, false);  // Ctrl+O
+    // B: toggle box selection tool
+    ControlSettings::m_keybinds[InputAction::kToggleBoxSelect] = KeyCombination(ImGuiKey_B);
+    // Ctrl+K: search (Ctrl+F would also trigger the plain F flip binding)
+    ControlSettings::m_keybinds[InputAction::kOpenSearch] = KeyCombination(ImGuiKey_K, true, false, false);
 
     // It's a good idea to also map arrow keys and keypad +/- if desired as secondary defaults,
     // but the system should allow users to set these. For now, one primary default.
@@ -6,16 +6,27 @@
 
 #include "ImGuiManager.hpp"
 
-Events::Events() : m_should_quit_(false), m_imgui_manager_(nullptr) {}
+Events::Events() : m_should_quit_(false), m_imgui_manager_(nullptr)
+{
+    m_wake_event_type_ = SDL_RegisterEvents(1);
+    if (m_wake_event_type_ == 0) {
+        std::cerr << "Events: Failed to register the wake event type: " << SDL_GetError() << std::endl;
+    }
+}
 
 Events::~Events() {}
 
 void Events::ProcessEvents()
 {
     SDL_Event event;
+    m_last_event_count_ = 0;
 
     // Process all queued events at once
     while (SDL_PollEvent(&event)) {
+        if (m_wake_event_type_ != 0 && event.type == m_wake_event_type_) {
+            continue;  // Only ends a WaitForEvent(); not input
+        }
+        ++m_last_event_count_;
         // Let ImGui process events first
         if (m_imgui_manager_) {
             m_imgui_manager_->ProcessEvent(&event);
@@ -80,6 +91,27 @@ void Events::ProcessEvents()
     }
 }
 
+bool Events::WaitForEvent(int timeout_ms)
+{
+    return SDL_WaitEventTimeout(nullptr, timeout_ms);
+}
+
+int Events::GetLastEventCount() const
+{
+    return m_last_event_count_;
+}
+
+void Events::PushWakeEvent()
+{
+    if (m_wake_event_type_ == 0) {
+        return;  // The main loop still wakes up on its wait timeout
+    }
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = m_wake_event_type_;
+    SDL_PushEvent(&event);
+}
+
 bool Events::ShouldQuit() const
 {
     return m_should_quit_;
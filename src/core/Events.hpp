@@ -20,6 +20,13 @@ public:
     ~Events();
 
     void ProcessEvents();
+    // Blocks until an event is queued or timeout_ms passes, leaving the event for ProcessEvents().
+    // Returns true if an event arrived.
+    bool WaitForEvent(int timeout_ms);
+    // Events handled by the last ProcessEvents() call, wake events not included
+    int GetLastEventCount() const;
+    // Wakes a WaitForEvent() without counting as input; safe to call from any thread
+    void PushWakeEvent();
     bool ShouldQuit() const;
     void SetImGuiManager(ImGuiManager* imgui_manager);
 
@@ -28,6 +35,8 @@ public:
 
 private:
     bool m_should_quit_;
+    int m_last_event_count_ = 0;
+    Uint32 m_wake_event_type_ = 0;  // Registered user event type, 0 if registration failed
     ImGuiManager* m_imgui_manager_;
     std::function<void(WindowEventType)> m_window_event_callback_;
 };
@@ -0,0 +1,148 @@
+#include "ExportCommand.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/Application.hpp"
+#include "core/BoardDataManager.hpp"
+#include "core/Config.hpp"
+#include "pcb/Board.hpp"
+#include "pcb/BoardLoaderFactory.hpp"
+#include "render/BoardImageExporter.hpp"
+
+namespace export_command
+{
+namespace
+{
+struct Arguments {
+    std::string board_path;
+    std::string config_path;
+    std::string side;
+    BoardImageExporter::Options options;
+};
+
+void PrintUsage()
+{
+    std::cerr << "Usage: XZZPCB-Layer-Viewer --export <board.pcb> --out <directory> [--dpi 600] [--tile 1024] [--threads N]\n"
+                 "                           [--region x,y,w,h] [--side top|bottom|both] [--background AARRGGBB] [--config <settings.ini>]"
+              << std::endl;
+}
+
+bool ParseArguments(int argc, char* argv[], Arguments& arguments)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "ExportCommand: Missing value for " << flag << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        char* end = nullptr;
+        if (flag == "--export") {
+            arguments.board_path = value;
+        } else if (flag == "--out") {
+            arguments.options.output_directory = value;
+        } else if (flag == "--dpi") {
+            arguments.options.dpi = std::strtod(value.c_str(), &end);
+        } else if (flag == "--tile") {
+            arguments.options.tile_size = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (flag == "--threads") {
+            arguments.options.thread_count = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (flag == "--region") {
+            BLRect& region = arguments.options.world_region;
+            if (std::sscanf(value.c_str(), "%lf,%lf,%lf,%lf", &region.x, &region.y, &region.w, &region.h) != 4) {
+                std::cerr << "ExportCommand: --region expects x,y,w,h" << std::endl;
+                return false;
+            }
+        } else if (flag == "--side") {
+            arguments.side = value;
+        } else if (flag == "--background") {
+            arguments.options.background_color = BLRgba32(static_cast<uint32_t>(std::strtoul(value.c_str(), &end, 16)));
+        } else if (flag == "--config") {
+            arguments.config_path = value;
+        } else {
+            std::cerr << "ExportCommand: Unknown option " << flag << std::endl;
+            return false;
+        }
+        if (end && *end != '\0') {
+            std::cerr << "ExportCommand: Invalid value for " << flag << ": " << value << std::endl;
+            return false;
+        }
+    }
+    if (arguments.board_path.empty() || arguments.options.output_directory.empty()) {
+        return false;
+    }
+    return arguments.side.empty() || arguments.side == "top" || arguments.side == "bottom" || arguments.side == "both";
+}
+}  // namespace
+
+bool IsRequested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--export") {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Run(int argc, char* argv[])
+{
+    Arguments arguments;
+    if (!ParseArguments(argc, argv, arguments)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // The same settings the UI renders with
+    Config config;
+    const std::string config_path = arguments.config_path.empty() ? Application::GetConfigFilePath() : arguments.config_path;
+    if (!config.LoadFromFile(config_path)) {
+        std::cout << "ExportCommand: Config file " << config_path << " not found or failed to load. Using defaults." << std::endl;
+    }
+    auto board_data_manager = std::make_shared<BoardDataManager>();
+    board_data_manager->LoadSettingsFromConfig(config);
+
+    BoardLoaderFactory loader_factory;
+    std::shared_ptr<Board> board = loader_factory.LoadBoard(arguments.board_path);
+    if (!board || !board->IsLoaded()) {
+        std::cerr << "ExportCommand: Failed to load " << arguments.board_path << std::endl;
+        return 1;
+    }
+    board->SetBoardDataManager(board_data_manager);
+    board_data_manager->SetBoard(board);
+    board_data_manager->RegenerateLayerColors(board);
+    if (arguments.side == "top") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kTop);
+    } else if (arguments.side == "bottom") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kBottom);
+    } else if (arguments.side == "both") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kBoth);
+    }
+    board_data_manager->WaitForBoardVariant();  // Folded or flipped boards are built on a worker
+
+    std::mutex progress_mutex;
+    int last_percent = -1;
+    const BoardImageExporter::Result result =
+        BoardImageExporter::Export(board_data_manager, arguments.options, [&progress_mutex, &last_percent](int tiles_done, int tile_count) {
+            // Workers report out of order; only print when the percentage moves on
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            const int percent = tiles_done * 100 / tile_count;
+            if (percent > last_percent) {
+                last_percent = percent;
+                std::cout << "\rExportCommand: " << percent << "% (" << tiles_done << "/" << tile_count << " tiles)" << std::flush;
+            }
+        });
+    std::cout << std::endl;
+
+    if (!result.success) {
+        std::cerr << "ExportCommand: Export failed: " << result.error_message << std::endl;
+        return 1;
+    }
+    return 0;
+}
+}  // namespace export_command
@@ -0,0 +1,14 @@
+#pragma once
+
+// Headless board export from the command line; runs without opening a window:
+//   XZZPCB-Layer-Viewer --export <board.pcb> --out <directory> [--dpi 600] [--tile 1024] [--threads N]
+//                       [--region x,y,w,h] [--side top|bottom|both] [--background AARRGGBB] [--config <settings.ini>]
+// Colors, folding and rendering settings come from the UI's settings file unless --config names another.
+namespace export_command
+{
+// True if the arguments ask for an export rather than the UI
+bool IsRequested(int argc, char* argv[]);
+
+// Runs the export; returns the process exit code
+int Run(int argc, char* argv[]);
+}  // namespace export_command
@@ -1,5 +1,6 @@
 #include "ImGuiManager.hpp"
 
+#include <algorithm>
 #include <imgui.h>
 #include <iostream>
 
@@ -10,6 +11,13 @@
 #include "Renderer.hpp"
 #include "SDLRenderer.hpp"
 
+namespace
+{
+// The first frame after an idle wait would otherwise report the whole wait as its delta, and held-key
+// panning, zooming and rotation scale with it
+constexpr float kMaxFrameDeltaSeconds = 0.1f;
+}  // namespace
+
 ImGuiManager::ImGuiManager(Renderer* renderer) : m_renderer_(renderer), m_initialized_(false) {}
 
 ImGuiManager::~ImGuiManager()
@@ -66,6 +74,8 @@ void ImGuiManager::NewFrame()
 {
     ImGui_ImplSDLRenderer3_NewFrame();
     ImGui_ImplSDL3_NewFrame();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = std::min(io.DeltaTime, kMaxFrameDeltaSeconds);
     ImGui::NewFrame();
 }
 
@@ -29,6 +29,10 @@ const char* InputActionToString(InputAction action)
             return "Flip Board";
         case InputAction::kOpenFile:
             return "Open File";
+        case InputAction::kToggleBoxSelect:
+            return "Toggle Box Select";
+        case InputAction::kOpenSearch:
+            return "Open Search";
         default:
             return "Unknown Action";
     }
@@ -19,6 +19,8 @@ enum class InputAction : uint8_t {
     kResetView,
     kFlipBoard,
     kOpenFile,  // Open file dialog
+    kToggleBoxSelect,  // Switch between navigation and box selection
+    kOpenSearch,       // Open the search window
     // Add more actions as needed in the future
 
     kCount  // Special value to get the number of actions, keep it last
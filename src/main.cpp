@@ -1,4 +1,5 @@
 #include "core/Application.hpp"
+#include "core/ExportCommand.hpp"
 #include <memory> // For std::make_unique
 // Removed unnecessary includes like SDL.h, imgui.h, project-specific headers for UI elements, etc.
 // as main.cpp now only deals with the Application class lifecycle.
@@ -14,9 +15,10 @@
 #endif
 
 int main(int argc, char* args[]) {
-    // Suppress unused parameter warnings if argc and args are not used.
-    (void)argc;
-    (void)args;
+    // Headless commands run without creating the window
+    if (export_command::IsRequested(argc, args)) {
+        return export_command::Run(argc, args);
+    }
 
     auto app = std::make_unique<Application>();
 
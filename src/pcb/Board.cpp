@@ -1,7 +1,12 @@
 #include "pcb/Board.hpp"
 
 #include <algorithm>  // For std::sort
+#include <array>
+#include <atomic>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #include "core/BoardDataManager.hpp"   // Include for implementation
 #include "core/ControlSettings.hpp"    // Include for interaction priority settings
@@ -16,17 +21,23 @@
 #include "pcb/elements/Via.hpp"
 
 // Default constructor
-Board::Board() : m_is_loaded_(false)
+Board::Board() : m_is_loaded_(false), m_arena_(std::make_unique<BoardArena>()), m_interaction_view_(std::make_unique<InteractionViewCache>())
 {
     // Default initialization only
 }
 
 // Constructor that takes a file path - now just calls initialize
-Board::Board(const std::string& filePath) : file_path(filePath), m_is_loaded_(false)
+Board::Board(const std::string& filePath)
+    : file_path(filePath), m_is_loaded_(false), m_arena_(std::make_unique<BoardArena>()), m_interaction_view_(std::make_unique<InteractionViewCache>())
 {
     Initialize(filePath);
 }
 
+Board::~Board()
+{
+    ReleaseArenaElements();
+}
+
 // Performance optimization: Move constructor
 Board::Board(Board&& other) noexcept
     : board_name(std::move(other.board_name)),
@@ -42,7 +53,10 @@ Board::Board(Board&& other) noexcept
       m_board_data_manager_(std::move(other.m_board_data_manager_)),
       m_control_settings_(std::move(other.m_control_settings_)),
       m_is_folded_(other.m_is_folded_),
-      m_board_center_x_(other.m_board_center_x_)
+      m_board_center_x_(other.m_board_center_x_),
+      m_geometry_revision_(other.m_geometry_revision_),
+      m_arena_(std::move(other.m_arena_)),
+      m_interaction_view_(std::make_unique<InteractionViewCache>())
 {
     // Reset other object to valid but empty state
     other.width = 0.0;
@@ -51,12 +65,15 @@ Board::Board(Board&& other) noexcept
     other.m_is_loaded_ = false;
     other.m_is_folded_ = false;
     other.m_board_center_x_ = 0.0;
+    other.m_arena_ = std::make_unique<BoardArena>();
+    other.m_interaction_view_ = std::make_unique<InteractionViewCache>();  // Its lists point at our elements now
 }
 
 // Performance optimization: Move assignment operator
 Board& Board::operator=(Board&& other) noexcept
 {
     if (this != &other) {
+        ReleaseArenaElements();  // Before the arena that backs them is replaced
         board_name = std::move(other.board_name);
         file_path = std::move(other.file_path);
         width = other.width;
@@ -71,6 +88,9 @@ Board& Board::operator=(Board&& other) noexcept
         m_control_settings_ = std::move(other.m_control_settings_);
         m_is_folded_ = other.m_is_folded_;
         m_board_center_x_ = other.m_board_center_x_;
+        m_geometry_revision_ = other.m_geometry_revision_;
+        m_arena_ = std::move(other.m_arena_);
+        m_interaction_view_ = std::make_unique<InteractionViewCache>();
 
         // Reset other object to valid but empty state
         other.width = 0.0;
@@ -79,6 +99,8 @@ Board& Board::operator=(Board&& other) noexcept
         other.m_is_loaded_ = false;
         other.m_is_folded_ = false;
         other.m_board_center_x_ = 0.0;
+        other.m_arena_ = std::make_unique<BoardArena>();
+        other.m_interaction_view_ = std::make_unique<InteractionViewCache>();
     }
     return *this;
 }
@@ -106,11 +128,7 @@ bool Board::Initialize(const std::string& filePath)
         std::cerr << "Warning: Could not determine valid bounding box for normalization for file: " << filePath << std::endl;
     }
 
-    // Apply board folding if enabled in BoardDataManager
-    if (m_board_data_manager_ && m_board_data_manager_->IsBoardFoldingEnabled()) {
-		std::cout << "Board folding enabled. Applying folding..." << std::endl;
-        ApplyBoardFolding();
-    }
+    // Board folding is not applied here: BoardDataManager publishes a folded variant of the loaded board
 
     m_is_loaded_ = true;
     m_error_message_.clear();
@@ -224,23 +242,28 @@ std::string Board::GetLayerName(int layerIndex) const
     return "Invalid Layer Index";  // Or throw an exception
 }
 
-bool Board::IsLayerVisible(int layerIndex) const
+namespace
 {
-    if (layerIndex >= 0 && layerIndex < layers.size()) {
-        return layers[layerIndex].is_visible;
+// Layer visibility from one view state snapshot, so a walk over several layers sees a consistent set
+bool IsLayerVisibleIn(const Board& board, const BoardDataManager::ViewState* view_state, int layer_index)
+{
+    if (layer_index < 0 || layer_index >= static_cast<int>(board.layers.size())) {
+        return false;
     }
-    return false;  // Or throw an exception
+    return view_state ? view_state->IsLayerVisible(layer_index) : board.layers[layer_index].IsVisible();
 }
+}  // namespace
 
-void Board::SetLayerVisible(int layerIndex, bool visible)
+bool Board::IsLayerVisible(int layerIndex) const
 {
-    if (layerIndex >= 0 && layerIndex < layers.size()) {
-        layers[layerIndex].is_visible = visible;
-        // Note: We don't call BoardDataManager::SetLayerVisible here to avoid recursion
-        // The BoardDataManager should be the primary source of truth for layer visibility
-        // and will update the board's layer visibility directly when needed
-    }
-    // Else: handle error or do nothing for invalid index
+    const std::shared_ptr<const BoardDataManager::ViewState> view_state = m_board_data_manager_ ? m_board_data_manager_->GetViewState() : nullptr;
+    return IsLayerVisibleIn(*this, view_state.get(), layerIndex);
+}
+
+bool Board::IsLayerIdVisible(int layer_id) const
+{
+    const LayerInfo* layer = GetLayerById(layer_id);
+    return layer && IsLayerVisible(static_cast<int>(layer - layers.data()));
 }
 
 void Board::SetLayerColor(int layerIndex, BLRgba32 color)
@@ -288,7 +311,7 @@ BLRect Board::GetBoundingBox(bool include_invisible_layers) const
         return BLRect(0, 0, 0, 0);  // Layer 28 not defined, cannot determine outline.
     }
 
-    if (!include_invisible_layers && !outline_layer_info->IsVisible()) {
+    if (!include_invisible_layers && !IsLayerVisible(static_cast<int>(outline_layer_info - layers.data()))) {
         // Layer 28 is not visible and we are not including invisible layers.
         return BLRect(0, 0, 0, 0);
     }
@@ -340,7 +363,7 @@ BLRect Board::GetBoundingBox(bool include_invisible_layers) const
     return BLRect(min_x, min_y, max_x - min_x, max_y - min_y);
 }
 
-BoardPoint2D Board::NormalizeCoordinatesAndGetCenterOffset(const BLRect& original_bounds)
+BoardPoint2D Board::NormalizeCoordinatesAndGetCenterOffset(const BLRect& original_bounds, const BoardTransform& then)
 {
     if (original_bounds.w <= 0 || original_bounds.h <= 0) {
         // std::cerr << "NormalizeCoordinatesAndGetCenterOffset: Original bounds invalid, skipping normalization." << std::endl;
@@ -350,26 +373,12 @@ BoardPoint2D Board::NormalizeCoordinatesAndGetCenterOffset(const BLRect& origina
     double offset_x = original_bounds.x + original_bounds.w / 2.0;
     double offset_y = original_bounds.y + original_bounds.h / 2.0;
 
-    // std::cout << "Normalizing by offset: X=" << offset_x << ", Y=" << offset_y << std::endl;
+    BeginGeometryChange();
 
-    // Normalize all standalone elements in m_elementsByLayer
-    for (auto& layer_pair : m_elements_by_layer) {
-        for (auto& element_ptr : layer_pair.second) {
-            if (element_ptr) {
-                element_ptr->Translate(-offset_x, -offset_y);
-            }
-        }
-    }
+    // std::cout << "Normalizing by offset: X=" << offset_x << ", Y=" << offset_y << std::endl;
 
-    // Normalize Components and their sub-elements (pins, component graphics, component text labels)
-    // The Component::translate method should handle its children.
-    // for (auto &comp_ptr : m_elementsByLayer[Board::kCompLayer])
-    // {
-    //     if (comp_ptr)
-    //     {
-    //         comp_ptr->translate(-offset_x, -offset_y);
-    //     }
-    // }
+    // Normalize all elements in m_elements_by_layer; components carry their pins, labels and graphics along
+    TransformElements(BoardTransform::Translation(-offset_x, -offset_y).Then(then), BulkTransformFilter());
 
     // Update the board's own origin_offset to store this normalization offset
     this->origin_offset = {offset_x, offset_y};
@@ -406,21 +415,87 @@ ElementInteractionType GetElementInteractionType(const Element* element) {
     return ElementInteractionType::kTraces;
 }
 
-// --- Performance Optimized GetAllVisibleElementsForInteraction ---
-std::vector<ElementInteractionInfo> Board::GetAllVisibleElementsForInteraction() const
+// Board-owned interaction view state (see Board::GetInteractionView)
+struct Board::InteractionViewCache {
+    // A run of the full list whose elements all belong to one layer group
+    struct Range {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t group = 0;
+    };
+
+    std::mutex mutex;
+
+    // Inputs the full list was built from
+    bool valid = false;
+    uint64_t geometry_revision = 0;
+    size_t element_count = 0;
+    BoardDataManager::BoardSide view_side = BoardDataManager::BoardSide::kBoth;
+    std::array<int, static_cast<size_t>(ElementInteractionType::kCount)> priority_by_type{};
+
+    // Layer groups as (parent layer, own layer), sorted; an element is visible when both layers are
+    std::vector<std::pair<int, int>> groups;
+    std::vector<uint8_t> group_visible;
+    std::vector<Range> ranges;  // In full-list order
+    std::vector<std::pair<int, bool>> layer_visibility;  // (id, visible) of each layers entry at the last check
+
+    std::shared_ptr<const std::vector<ElementInteractionInfo>> all_elements;
+    std::shared_ptr<const std::vector<ElementInteractionInfo>> visible_elements;
+    uint64_t all_generation = 0;
+    uint64_t visible_generation = 0;
+};
+
+namespace
 {
-    // Performance optimization: Estimate capacity based on board complexity
-    size_t estimated_capacity = 1000;  // Base capacity
-    for (const auto& layer_pair : m_elements_by_layer) {
-        estimated_capacity += layer_pair.second.size();
+// Generations are drawn from one process-wide counter, so a generation never repeats across boards either
+uint64_t NextInteractionViewGeneration()
+{
+    static std::atomic<uint64_t> next_generation{1};
+    return next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool IsOnViewSide(BoardDataManager::BoardSide view_side, MountingSide side)
+{
+    return view_side == BoardDataManager::BoardSide::kBoth ||
+           (view_side == BoardDataManager::BoardSide::kTop && side == MountingSide::kTop) ||
+           (view_side == BoardDataManager::BoardSide::kBottom && side == MountingSide::kBottom);
+}
+}  // namespace
+
+Board::InteractionView Board::GetInteractionView(bool include_hidden_layers) const
+{
+    InteractionViewCache& cache = *m_interaction_view_;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    RefreshInteractionView(cache);
+    if (include_hidden_layers) {
+        return {cache.all_elements, cache.all_generation};
     }
+    return {cache.visible_elements, cache.visible_generation};
+}
 
-    std::vector<ElementInteractionInfo> result;
-    result.reserve(estimated_capacity);
+uint64_t Board::GetInteractionViewGeneration(bool include_hidden_layers) const
+{
+    InteractionViewCache& cache = *m_interaction_view_;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    RefreshInteractionView(cache);
+    return include_hidden_layers ? cache.all_generation : cache.visible_generation;
+}
 
-    // Performance optimization: Cache frequently accessed values
-    const BoardDataManager::BoardSide current_view_side = m_board_data_manager_ ?
-        m_board_data_manager_->GetCurrentViewSide() : BoardDataManager::BoardSide::kBoth;
+std::vector<ElementInteractionInfo> Board::GetAllVisibleElementsForInteraction() const
+{
+    return *GetInteractionView(false).elements;
+}
+
+std::vector<ElementInteractionInfo> Board::GetAllElementsForInteraction() const
+{
+    return *GetInteractionView(true).elements;
+}
+
+void Board::RefreshInteractionView(InteractionViewCache& cache) const
+{
+    // Performance optimization: Every check here is O(layers); the element walk only happens when the full list is stale
+    const std::shared_ptr<const BoardDataManager::ViewState> view_state = m_board_data_manager_ ? m_board_data_manager_->GetViewState() : nullptr;
+    const BoardDataManager::BoardSide view_side = view_state ? view_state->view_side : BoardDataManager::BoardSide::kBoth;
 
     // Performance optimization: Use static default priority order to avoid repeated allocation
     static const std::array<ElementInteractionType, static_cast<size_t>(ElementInteractionType::kCount)> default_priority_order = {
@@ -430,158 +505,197 @@ std::vector<ElementInteractionInfo> Board::GetAllVisibleElementsForInteraction()
         ElementInteractionType::kVias,
         ElementInteractionType::kTextLabels
     };
-
     const auto& priority_order = m_control_settings_ ?
         m_control_settings_->GetElementPriorityOrder() : default_priority_order;
 
-    // Performance optimization: Collect elements directly into result vector with proper ordering
-    std::vector<ElementInteractionInfo> all_elements;
-    all_elements.reserve(estimated_capacity);
+    std::array<int, static_cast<size_t>(ElementInteractionType::kCount)> priority_by_type;
+    priority_by_type.fill(static_cast<int>(ElementInteractionType::kCount));  // Default to lowest priority
+    for (size_t i = 0; i < priority_order.size(); ++i) {
+        priority_by_type[static_cast<size_t>(priority_order[i])] = static_cast<int>(i);
+    }
 
-    // 1. Iterate through standalone elements grouped by layer (excluding components - they're handled separately)
+    // Elements are only added while loading, which does not bump the geometry revision
+    size_t element_count = 0;
     for (const auto& layer_pair : m_elements_by_layer) {
-        const LayerInfo* layer_info = GetLayerById(layer_pair.first);
-        if (layer_info && layer_info->IsVisible()) {
-            for (const auto& element_ptr : layer_pair.second) {
-                if (element_ptr && element_ptr->IsVisible())  // Assuming Element base has isVisible()
-                {
-                    // Skip components - they will be handled in the component-specific section with proper priority
-                    const Component* comp = dynamic_cast<const Component*>(element_ptr.get());
-                    if (comp) {
-                        continue;  // Skip components here
-                    }
+        element_count += layer_pair.second.size();
+    }
 
-                    // Apply board side filtering for silkscreen elements when board folding is enabled
-                    bool should_include_element = true;
-                    if (layer_pair.first == Board::kSilkscreenLayer && current_view_side != BoardDataManager::BoardSide::kBoth) {
-                        // Only apply side filtering to silkscreen elements that have board side assigned
-                        if (element_ptr->HasBoardSideAssigned()) {
-                            MountingSide element_side = element_ptr->GetBoardSide();
-                            if ((current_view_side == BoardDataManager::BoardSide::kTop && element_side != MountingSide::kTop) ||
-                                (current_view_side == BoardDataManager::BoardSide::kBottom && element_side != MountingSide::kBottom)) {
-                                should_include_element = false;
-                            }
-                        }
-                    }
+    bool rebuild_visible = false;
+    if (!cache.valid || cache.geometry_revision != m_geometry_revision_ || cache.element_count != element_count ||
+        cache.view_side != view_side || cache.priority_by_type != priority_by_type) {
+        cache.valid = true;
+        cache.geometry_revision = m_geometry_revision_;
+        cache.element_count = element_count;
+        cache.view_side = view_side;
+        cache.priority_by_type = priority_by_type;
+        RebuildInteractionView(cache);
+        cache.all_generation = NextInteractionViewGeneration();
+        cache.layer_visibility.clear();
+        rebuild_visible = true;
+    }
 
-                    if (should_include_element) {
-                        all_elements.push_back({element_ptr.get(), nullptr});
-                    }
-                }
+    // Layer visibility lives in the BoardDataManager's view state; compare against the last check
+    auto is_index_visible = [&](size_t index) { return IsLayerVisibleIn(*this, view_state.get(), static_cast<int>(index)); };
+    bool visibility_changed = cache.layer_visibility.size() != layers.size();
+    for (size_t i = 0; !visibility_changed && i < layers.size(); ++i) {
+        visibility_changed = cache.layer_visibility[i].first != layers[i].GetId() || cache.layer_visibility[i].second != is_index_visible(i);
+    }
+    if (visibility_changed) {
+        cache.layer_visibility.clear();
+        cache.layer_visibility.reserve(layers.size());
+        for (size_t i = 0; i < layers.size(); ++i) {
+            cache.layer_visibility.emplace_back(layers[i].GetId(), is_index_visible(i));
+        }
+
+        auto is_id_visible = [&](int layer_id) {
+            const LayerInfo* layer = GetLayerById(layer_id);
+            return layer && is_index_visible(static_cast<size_t>(layer - layers.data()));
+        };
+        for (size_t group = 0; group < cache.groups.size(); ++group) {
+            const uint8_t visible = (is_id_visible(cache.groups[group].first) && is_id_visible(cache.groups[group].second)) ? 1 : 0;
+            if (visible != cache.group_visible[group]) {
+                cache.group_visible[group] = visible;
+                rebuild_visible = true;
             }
-        } else {
         }
     }
 
-    // 2. Iterate through components in both top and bottom component layers
-    std::vector<int> component_layers = {Board::kTopCompLayer, Board::kBottomCompLayer};
+    if (rebuild_visible) {
+        // Splice the visible groups' ranges out of the full list; order is preserved because ranges are in list order
+        const std::vector<ElementInteractionInfo>& all_elements = *cache.all_elements;
+        auto visible_elements = std::make_shared<std::vector<ElementInteractionInfo>>();
+        size_t visible_count = 0;
+        for (const auto& range : cache.ranges) {
+            if (cache.group_visible[range.group]) {
+                visible_count += range.end - range.begin;
+            }
+        }
+        visible_elements->reserve(visible_count);
+        for (const auto& range : cache.ranges) {
+            if (cache.group_visible[range.group]) {
+                visible_elements->insert(visible_elements->end(), all_elements.begin() + range.begin, all_elements.begin() + range.end);
+            }
+        }
+        cache.visible_elements = std::move(visible_elements);
+        cache.visible_generation = NextInteractionViewGeneration();
+    }
+}
+
+void Board::RebuildInteractionView(InteractionViewCache& cache) const
+{
+    const BoardDataManager::BoardSide view_side = cache.view_side;
+    const auto& priority_by_type = cache.priority_by_type;
+
+    struct KeyedElement {
+        ElementInteractionInfo info;
+        uint32_t group = 0;
+        int priority = 0;
+    };
+
+    // Performance optimization: Estimate capacity based on board complexity
+    size_t estimated_capacity = 1000;  // Base capacity
+    for (const auto& layer_pair : m_elements_by_layer) {
+        estimated_capacity += layer_pair.second.size();
+    }
+    std::vector<KeyedElement> keyed_elements;
+    keyed_elements.reserve(estimated_capacity);
+
+    // Groups are numbered in discovery order here and ranked by layer ids below
+    std::map<std::pair<int, int>, uint32_t> group_ids;
+    std::vector<std::pair<int, int>> discovered_groups;
+    auto group_for = [&](int parent_layer, int own_layer) {
+        auto [it, inserted] = group_ids.emplace(std::make_pair(parent_layer, own_layer), static_cast<uint32_t>(discovered_groups.size()));
+        if (inserted) {
+            discovered_groups.emplace_back(parent_layer, own_layer);
+        }
+        return it->second;
+    };
+    auto add = [&](const Element* element, const Component* parent, uint32_t group, ElementInteractionType type) {
+        keyed_elements.push_back({{element, parent}, group, priority_by_type[static_cast<size_t>(type)]});
+    };
+
+    // 1. Standalone elements grouped by layer (components are handled separately with their pins and labels)
+    for (const auto& layer_pair : m_elements_by_layer) {
+        const uint32_t group = group_for(layer_pair.first, layer_pair.first);
+        for (const auto& element_ptr : layer_pair.second) {
+            if (!element_ptr || !element_ptr->IsVisible() || element_ptr->GetElementType() == ElementType::kComponent) {
+                continue;
+            }
+            // Side filtering only applies to silkscreen elements that have a board side assigned
+            if (layer_pair.first == Board::kSilkscreenLayer && element_ptr->HasBoardSideAssigned() &&
+                !IsOnViewSide(view_side, element_ptr->GetBoardSide())) {
+                continue;
+            }
+            add(element_ptr.get(), nullptr, group, GetElementInteractionType(element_ptr.get()));
+        }
+    }
 
-    for (int comp_layer_id : component_layers) {
+    // 2. Components in both component layers, each followed by its pins and text labels (same side filtering as RenderPipeline)
+    for (int comp_layer_id : {Board::kTopCompLayer, Board::kBottomCompLayer}) {
         auto comp_layer_it = m_elements_by_layer.find(comp_layer_id);
         if (comp_layer_it == m_elements_by_layer.end()) {
             continue;
         }
 
         for (const auto& element_ptr : comp_layer_it->second) {
-            if (!element_ptr)
+            if (!element_ptr || element_ptr->GetElementType() != ElementType::kComponent) {
                 continue;
-            // Try to cast to Component
-            const Component* comp = dynamic_cast<const Component*>(element_ptr.get());
-            if (!comp)
+            }
+            const auto* comp = static_cast<const Component*>(element_ptr.get());
+            if (!IsOnViewSide(view_side, comp->side)) {
                 continue;
-
-            const LayerInfo* comp_layer_info = GetLayerById(comp->layer);  // Component's primary layer
-
-            // Apply board side filtering for components (same logic as RenderPipeline.cpp)
-            bool should_include_component = true;
-            if (current_view_side != BoardDataManager::BoardSide::kBoth) {
-                if (current_view_side == BoardDataManager::BoardSide::kTop && comp->side != MountingSide::kTop) {
-                    should_include_component = false;
-                } else if (current_view_side == BoardDataManager::BoardSide::kBottom && comp->side != MountingSide::kBottom) {
-                    should_include_component = false;
-                }
             }
 
-            // Also check individual layer visibility
-            if (should_include_component && comp_layer_info && comp_layer_info->IsVisible()) {
-                // Add Pins of the component (with board side filtering)
-                for (const auto& pin_ptr : comp->pins) {
-                    if (!pin_ptr)
-                        continue;
-
-                    // Apply board side filtering for pins based on their parent component's side
-                    bool should_include_pin = true;
-                    if (current_view_side != BoardDataManager::BoardSide::kBoth) {
-                        if (current_view_side == BoardDataManager::BoardSide::kTop && comp->side != MountingSide::kTop) {
-                            should_include_pin = false;
-                        } else if (current_view_side == BoardDataManager::BoardSide::kBottom && comp->side != MountingSide::kBottom) {
-                            should_include_pin = false;
-                        }
-                    }
-
-                    if (should_include_pin) {
-                        const LayerInfo* pin_layer_info = GetLayerById(pin_ptr->GetLayerId());
-                        if (pin_ptr->IsVisible() && pin_layer_info && pin_layer_info->IsVisible()) {
-                            all_elements.push_back({pin_ptr.get(), comp});
-                        }
-                    }
+            for (const auto& pin_ptr : comp->pins) {
+                if (pin_ptr && pin_ptr->IsVisible()) {
+                    add(pin_ptr.get(), comp, group_for(comp->layer, pin_ptr->GetLayerId()), ElementInteractionType::kPins);
                 }
-
-                // Add the Component itself to the interaction list
-                all_elements.push_back({comp, nullptr});
-
-                // Add TextLabels of the component (with board side filtering)
-                for (const auto& label_ptr : comp->text_labels) {
-                    if (!label_ptr)
-                        continue;
-
-                    // Apply board side filtering for text labels based on their parent component's side
-                    bool should_include_label = true;
-                    if (current_view_side != BoardDataManager::BoardSide::kBoth) {
-                        if (current_view_side == BoardDataManager::BoardSide::kTop && comp->side != MountingSide::kTop) {
-                            should_include_label = false;
-                        } else if (current_view_side == BoardDataManager::BoardSide::kBottom && comp->side != MountingSide::kBottom) {
-                            should_include_label = false;
-                        }
-                    }
-
-                    if (should_include_label) {
-                        const LayerInfo* label_layer_info = GetLayerById(label_ptr->GetLayerId());
-                        if (label_ptr->IsVisible() && label_layer_info && label_layer_info->IsVisible()) {
-                            all_elements.push_back({label_ptr.get(), comp});
-                        } else {
-                        }
-                    }
+            }
+            add(comp, nullptr, group_for(comp->layer, comp->layer), ElementInteractionType::kComponents);
+            for (const auto& label_ptr : comp->text_labels) {
+                if (label_ptr && label_ptr->IsVisible()) {
+                    add(label_ptr.get(), comp, group_for(comp->layer, label_ptr->GetLayerId()), ElementInteractionType::kTextLabels);
                 }
-            } else {
             }
         }
     }
 
-    // Sort elements by priority order
-    std::sort(all_elements.begin(), all_elements.end(),
-        [&priority_order](const ElementInteractionInfo& a, const ElementInteractionInfo& b) {
-            ElementInteractionType type_a = GetElementInteractionType(a.element);
-            ElementInteractionType type_b = GetElementInteractionType(b.element);
-
-            // Find priority indices for both types
-            int priority_a = static_cast<int>(ElementInteractionType::kCount);  // Default to lowest priority
-            int priority_b = static_cast<int>(ElementInteractionType::kCount);
-
-            for (size_t i = 0; i < priority_order.size(); ++i) {
-                if (priority_order[i] == type_a) {
-                    priority_a = static_cast<int>(i);
-                }
-                if (priority_order[i] == type_b) {
-                    priority_b = static_cast<int>(i);
-                }
-            }
+    // Rank groups by (parent layer, own layer); std::map iterates in key order
+    std::vector<uint32_t> group_rank(discovered_groups.size());
+    cache.groups.clear();
+    cache.groups.reserve(group_ids.size());
+    for (const auto& [key, id] : group_ids) {
+        group_rank[id] = static_cast<uint32_t>(cache.groups.size());
+        cache.groups.push_back(key);
+    }
+    cache.group_visible.assign(cache.groups.size(), 0);
+
+    // Performance optimization: Counting sort into (priority, group) buckets, so every group becomes one contiguous
+    // range per priority that layer visibility can splice in or out. Lower priority index comes first; within one
+    // priority elements are ordered by group rank, and only within one group do they keep board order.
+    const size_t group_count = cache.groups.size();
+    const size_t bucket_count = (static_cast<size_t>(ElementInteractionType::kCount) + 1) * group_count;
+    std::vector<uint32_t> bucket_offsets(bucket_count + 1, 0);
+    for (auto& keyed : keyed_elements) {
+        keyed.group = group_rank[keyed.group];
+        ++bucket_offsets[static_cast<size_t>(keyed.priority) * group_count + keyed.group + 1];
+    }
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        bucket_offsets[bucket + 1] += bucket_offsets[bucket];
+    }
 
-            // Lower index = higher priority (should come first)
-            return priority_a < priority_b;
-        });
+    cache.ranges.clear();
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        if (bucket_offsets[bucket + 1] != bucket_offsets[bucket]) {
+            cache.ranges.push_back({bucket_offsets[bucket], bucket_offsets[bucket + 1], static_cast<uint32_t>(bucket % group_count)});
+        }
+    }
 
-    return all_elements;
+    auto all_elements = std::make_shared<std::vector<ElementInteractionInfo>>(keyed_elements.size());
+    for (const auto& keyed : keyed_elements) {
+        (*all_elements)[bucket_offsets[static_cast<size_t>(keyed.priority) * group_count + keyed.group]++] = keyed.info;
+    }
+    cache.all_elements = std::move(all_elements);
 }
 
 const Net* Board::GetNetById(int net_id) const
@@ -662,6 +776,7 @@ void Board::CleanDuplicateOutlineSegments()
 
         if (element_center_x < center_x) {
             top_side_elements.push_back(std::move(element_ptr));
+        } else {
         }
     }
 
@@ -742,81 +857,27 @@ void Board::ApplyBoardFolding()
         return;  // Already folded
     }
 
+    BeginGeometryChange();
+
     // Detect the center axis
     m_board_center_x_ = DetectBoardCenterAxis();
 
     // First pass: Assign board sides to silkscreen elements based on their position
     AssignSilkscreenElementSides(m_board_center_x_);
 
-    // Mirror traces and other elements from right side to left side
-    for (auto& layer_pair : m_elements_by_layer) {
-        int layer_id = layer_pair.first;
-
-        // Skip component layer (handled separately) and board outline layer
-        if (layer_id == Board::kBottomCompLayer || layer_id == Board::kTopCompLayer || layer_id == 28) continue;
-
-        for (auto& element_ptr : layer_pair.second) {
-            if (!element_ptr) continue;
-
-            // Check if element is on the right side (bottom layer)
-            BLRect bounds = element_ptr->GetBoundingBox(nullptr);
-            double element_center_x = bounds.x + bounds.w / 2.0;
-            
-            if (element_center_x > m_board_center_x_) {
-                // Perform element-specific geometric mirroring
-                if (auto trace = dynamic_cast<Trace*>(element_ptr.get())) {
-                    // For traces: Mirror both endpoints across the center axis
-                    trace->x1 = 2 * m_board_center_x_ - trace->x1;
-                    trace->x2 = 2 * m_board_center_x_ - trace->x2;
-                    // Y coordinates remain unchanged in horizontal mirroring
-                } 
-                else if (auto arc = dynamic_cast<Arc*>(element_ptr.get())) {
-                    // For arcs: Mirror center point and adjust angles
-                    arc->center.x_ax = 2 * m_board_center_x_ - arc->center.x_ax;
-
-                    // For horizontal mirroring, transform angles and swap start/end
-                    // Original arc from start_angle to end_angle becomes
-                    // arc from (180° - end_angle) to (180° - start_angle)
-                    double original_start = arc->start_angle;
-                    double original_end = arc->end_angle;
-
-                    arc->start_angle = 180.0 - original_end;
-                    arc->end_angle = 180.0 - original_start;
-
-                    // Normalize angles to [0, 360) range
-                    while (arc->start_angle < 0) arc->start_angle += 360.0;
-                    while (arc->end_angle < 0) arc->end_angle += 360.0;
-                    while (arc->start_angle >= 360.0) arc->start_angle -= 360.0;
-                    while (arc->end_angle >= 360.0) arc->end_angle -= 360.0;
-                }
-                else if (auto via = dynamic_cast<Via*>(element_ptr.get())) {
-                    // For vias: Simply mirror the center point
-                    via->x = 2 * m_board_center_x_ - via->x;
-                    // Y coordinate remains unchanged
-                }
-                else if (auto text = dynamic_cast<TextLabel*>(element_ptr.get())) {
-                    // For text labels: Mirror position and flip horizontal alignment
-                    text->coords.x_ax = 2 * m_board_center_x_ - text->coords.x_ax;
-                    // Optionally flip text direction/alignment if needed
-                    // text->horizontal_alignment = FlipAlignment(text->horizontal_alignment);
-                }
-                else if (auto comp = dynamic_cast<Component*>(element_ptr.get())) {
-                    // For components: Use the component's Mirror method
-                    comp->Mirror(m_board_center_x_);
-                }
-                else if (auto pin = dynamic_cast<Pin*>(element_ptr.get())) {
-					pin->Mirror(m_board_center_x_);
-				}
-				else{
-                    // For any other element types: Use the generic Translate method
-                    // This is a fallback for element types we haven't specifically handled
-                    double mirrored_x = 2 * m_board_center_x_ - element_center_x;
-                    double offset_x = mirrored_x - element_center_x;
-                    element_ptr->Translate(offset_x, 0.0);
-                }
+    // Mirror traces and other elements from right side to left side in one bulk pass. The component layers are
+    // handled separately and the board outline stays put.
+    const double center_x = m_board_center_x_;
+    TransformElements(
+        BoardTransform::MirrorX(center_x),
+        [center_x](int layer_id, const Element& element) {
+            if (layer_id == Board::kBottomCompLayer || layer_id == Board::kTopCompLayer || layer_id == 28) {
+                return false;
             }
-        }
-    }
+            // Elements right of the axis are on the bottom side
+            const BLRect bounds = element.GetBoundingBox(nullptr);
+            return bounds.x + bounds.w / 2.0 > center_x;
+        });
 
     // Handle components separately
     AssignComponentSidesAndFold(m_board_center_x_);
@@ -827,81 +888,383 @@ void Board::ApplyBoardFolding()
     m_is_folded_ = true;
 }
 
-void Board::RevertBoardFolding()
+void Board::ApplyGlobalTransformation(bool mirror_horizontally)
 {
-    if (!m_is_folded_) return;  // Not folded
+    if (!mirror_horizontally) {
+        return;
+    }
+
+    // Get board bounds to determine the center axis for mirroring. Hidden outline layers count too: a variant is
+    // built once and must not depend on what happened to be visible at that moment.
+    BLRect board_bounds = GetBoundingBox(true);
+    if (board_bounds.w <= 0 && board_bounds.h <= 0) {
+        return;
+    }
+
+    double center_x = board_bounds.x + board_bounds.w / 2.0;
 
-    // This is a simplified revert - in a full implementation, you'd need to
-    // store the original positions and restore them
-    // For now, we'll just mark as unfolded and let the board be reloaded
-    m_is_folded_ = false;
+    BeginGeometryChange();
 
+    // Mirror every element except pins stored on the pin layers, which belong to components and move with them.
+    // Only components are mirrored on the component layers.
+    TransformElements(
+        BoardTransform::MirrorX(center_x),
+        [](int layer_id, const Element& element) {
+            if (layer_id == Board::kTopPinsLayer || layer_id == Board::kBottomPinsLayer) {
+                return false;
+            }
+            return (layer_id != Board::kTopCompLayer && layer_id != Board::kBottomCompLayer) || element.GetElementType() == ElementType::kComponent;
+        });
+}
+
+// --- Geometry Variants ---
+
+namespace
+{
+// Copy of one element; component copies bring their pins and labels along. Folding assigns board sides, which
+// the element copy constructors leave out.
+std::unique_ptr<Element> CloneElement(const Element& element)
+{
+    std::unique_ptr<Element> copy;
+    switch (element.GetElementType()) {
+        case ElementType::kTrace:
+            copy = std::make_unique<Trace>(static_cast<const Trace&>(element));
+            break;
+        case ElementType::kArc:
+            copy = std::make_unique<Arc>(static_cast<const Arc&>(element));
+            break;
+        case ElementType::kVia:
+            copy = std::make_unique<Via>(static_cast<const Via&>(element));
+            break;
+        case ElementType::kTextLabel:
+            copy = std::make_unique<TextLabel>(static_cast<const TextLabel&>(element));
+            copy->SetVisible(element.IsVisible());
+            break;
+        case ElementType::kPin:
+            copy = std::make_unique<Pin>(static_cast<const Pin&>(element));
+            break;
+        case ElementType::kComponent:
+            copy = std::make_unique<Component>(static_cast<const Component&>(element));
+            break;
+        default:
+            return nullptr;  // No other element types are created by the loaders
+    }
+    if (element.HasBoardSideAssigned()) {
+        copy->SetBoardSide(element.GetBoardSide());
+    }
+    return copy;
 }
+}  // namespace
 
-void Board::UpdateFoldingState()
+std::shared_ptr<Board> Board::CreateGeometryVariant(bool folded, bool flipped) const
 {
+    auto variant = std::make_shared<Board>();
+    variant->board_name = board_name;
+    variant->file_path = file_path;
+    variant->width = width;
+    variant->height = height;
+    variant->origin_offset = origin_offset;
+    variant->layers = layers;
+    variant->m_nets = m_nets;
+    variant->m_is_loaded_ = m_is_loaded_;
+    variant->m_error_message_ = m_error_message_;
+    variant->m_board_data_manager_ = m_board_data_manager_;
+    variant->m_control_settings_ = m_control_settings_;
+    variant->m_geometry_revision_ = m_geometry_revision_;
+
+    // Performance optimization: The copies are carved out of the variant's own arena, like a load would
+    {
+        BoardArena::Scope arena_scope(variant->m_arena_.get());
+        variant->m_elements_by_layer.reserve(m_elements_by_layer.size());
+        for (const auto& [layer_id, elements] : m_elements_by_layer) {
+            auto& copies = variant->m_elements_by_layer[layer_id];
+            copies.reserve(elements.size());
+            for (const auto& element_ptr : elements) {
+                if (element_ptr) {
+                    if (auto copy = CloneElement(*element_ptr)) {
+                        copies.push_back(std::move(copy));
+                    }
+                }
+            }
+        }
+    }
 
-    if (!m_board_data_manager_) {
-        return;
+    if (folded) {
+        variant->ApplyBoardFolding();
     }
+    if (flipped) {
+        variant->ApplyGlobalTransformation(true);
+    }
+    return variant;
+}
 
-    bool should_be_folded = m_board_data_manager_->IsBoardFoldingEnabled();
+// --- Bulk Transforms ---
 
-    if (should_be_folded && !m_is_folded_) {
-        ApplyBoardFolding();
-    } else if (!should_be_folded && m_is_folded_) {
-        RevertBoardFolding();
-    } else {
+namespace
+{
+// Elements per work item: large enough to amortize scheduling, small enough to balance uneven layers
+constexpr size_t kBulkTransformChunkSize = 16384;
+}  // namespace
+
+bool Board::ApplyBulkTransform(const BoardTransform& transform)
+{
+    if (!transform.IsRigid()) {
+        std::cerr << "Board: Bulk transform rejected, only rotations, reflections and translations are supported" << std::endl;
+        return false;
     }
+
+    BeginGeometryChange();
+    const size_t skipped = TransformElements(transform, BulkTransformFilter());
+    if (skipped > 0) {
+        std::cerr << "Board: Bulk transform skipped " << skipped << " elements of unsupported types" << std::endl;
+    }
+    return true;
 }
 
-void Board::ApplyGlobalTransformation(bool mirror_horizontally)
+size_t Board::TransformElements(const BoardTransform& transform, const BulkTransformFilter& filter)
 {
-    if (!mirror_horizontally) {
-        return;
+    // Chunks never span layers, so each one knows the layer id the filter needs
+    struct Chunk {
+        int layer_id = 0;
+        std::vector<std::unique_ptr<Element>>* elements = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        size_t skipped = 0;
+    };
+    std::vector<Chunk> chunks;
+    for (auto& [layer_id, elements] : m_elements_by_layer) {
+        for (size_t begin = 0; begin < elements.size(); begin += kBulkTransformChunkSize) {
+            Chunk chunk;
+            chunk.layer_id = layer_id;
+            chunk.elements = &elements;
+            chunk.begin = begin;
+            chunk.end = std::min(begin + kBulkTransformChunkSize, elements.size());
+            chunks.push_back(std::move(chunk));
+        }
     }
 
-    // Get board bounds to determine the center axis for mirroring
-    BLRect board_bounds = GetBoundingBox(false);
-    if (board_bounds.w <= 0 && board_bounds.h <= 0) {
+    std::atomic<size_t> next_chunk {0};
+    auto worker = [&]() {
+        for (size_t index = next_chunk++; index < chunks.size(); index = next_chunk++) {
+            Chunk& chunk = chunks[index];
+            chunk.skipped = transform.ApplyToRange(chunk.layer_id, *chunk.elements, chunk.begin, chunk.end, filter);
+        }
+    };
+
+    // The calling thread works too; small boards never start a helper
+    const size_t worker_count = std::min<size_t>(chunks.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> helpers;
+    for (size_t i = 1; i < worker_count; ++i) {
+        helpers.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& helper : helpers) {
+        helper.get();
+    }
+
+    size_t skipped = 0;
+    for (const Chunk& chunk : chunks) {
+        skipped += chunk.skipped;
+    }
+    return skipped;
+}
+
+// --- Geometry Change Tracking ---
+
+void Board::BeginGeometryChange()
+{
+    ++m_geometry_revision_;
+}
+
+// --- Element Storage ---
+
+namespace
+{
+// Destroys an arena element without the delete expression, so nothing goes back to the heap per element
+template <typename T>
+void DestroyArenaElement(const BoardArena& arena, std::unique_ptr<T>& element_ptr)
+{
+    if (!element_ptr || !arena.Contains(element_ptr.get())) {
+        return;  // Heap elements are deleted normally with their owner
+    }
+    T* element = element_ptr.release();
+    const auto is_inline = [](const std::string& text) { return BoardMemoryReport::GetStringHeapBytes(text) == 0; };
+    switch (element->GetElementType()) {
+        case ElementType::kTrace:
+        case ElementType::kArc:
+            return;  // Plain coordinates: their destructors have nothing to do
+        case ElementType::kVia:
+            if (is_inline(static_cast<const Via*>(static_cast<const Element*>(element))->optional_text)) {
+                return;
+            }
+            break;
+        case ElementType::kPin: {
+            const auto* pin = static_cast<const Pin*>(static_cast<const Element*>(element));
+            if (is_inline(pin->diode_reading)) {
+                return;  // Short names live inside the object: nothing to free
+            }
+            break;
+        }
+        case ElementType::kTextLabel: {
+            const auto* label = static_cast<const TextLabel*>(static_cast<const Element*>(element));
+            if (is_inline(label->text_content)) {
+                return;
+            }
+            break;
+        }
+        case ElementType::kComponent: {
+            auto* comp = static_cast<Component*>(static_cast<Element*>(element));
+            for (auto& pin_ptr : comp->pins) {
+                DestroyArenaElement(arena, pin_ptr);
+            }
+            for (auto& label_ptr : comp->text_labels) {
+                DestroyArenaElement(arena, label_ptr);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    element->~T();  // Virtual: frees strings that outgrew their inline buffer and component vectors
+}
+}  // namespace
+
+void Board::ReleaseArenaElements()
+{
+    // Performance optimization: Tearing down a loaded board makes no per-element free calls; the chunks go back
+    // when the arena is destroyed
+    if (!m_arena_ || m_arena_->GetChunkCount() == 0) {
         return;
     }
+    for (auto& [layer_id, elements] : m_elements_by_layer) {
+        for (auto& element_ptr : elements) {
+            DestroyArenaElement(*m_arena_, element_ptr);
+        }
+    }
+}
 
-    double center_x = board_bounds.x + board_bounds.w / 2.0;
+// --- Memory Accounting ---
 
-    // Mirror non-component elements in all layers
-    for (auto& layer_pair : m_elements_by_layer) {
-        int layer_id = layer_pair.first;
+namespace
+{
+template <typename T>
+size_t GetVectorHeapBytes(const std::vector<T>& values)
+{
+    return values.capacity() * sizeof(T);
+}
 
-        // Skip component layers and pin layers - they're handled separately
-        if (layer_id == Board::kTopCompLayer || layer_id == Board::kBottomCompLayer ||
-            layer_id == Board::kTopPinsLayer || layer_id == Board::kBottomPinsLayer) {
-            continue;
+// Node-based containers: the stored value plus the node's next pointer and cached hash, and the bucket array
+template <typename Map>
+size_t GetUnorderedMapOverheadBytes(const Map& map)
+{
+    return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*)) + map.bucket_count() * sizeof(void*);
+}
+
+void AccountElement(BoardMemoryReport& report, const Element& element)
+{
+    const ElementType type = element.GetElementType();
+    BoardMemoryReport::TypeUsage& usage = report.element_types[static_cast<size_t>(type)];
+    ++usage.count;
+    // Owning slot in the layer or component vector, and the allocation tag in front of the object
+    usage.object_bytes += sizeof(std::unique_ptr<Element>) + Element::kAllocationHeaderSize;
+
+    switch (type) {
+        case ElementType::kTrace:
+            usage.object_bytes += sizeof(Trace);
+            break;
+        case ElementType::kArc:
+            usage.object_bytes += sizeof(Arc);
+            break;
+        case ElementType::kVia: {
+            const auto& via = static_cast<const Via&>(element);
+            usage.object_bytes += sizeof(Via);
+            usage.string_bytes += BoardMemoryReport::GetStringHeapBytes(via.optional_text);
+            break;
+        }
+        case ElementType::kTextLabel: {
+            const auto& label = static_cast<const TextLabel&>(element);
+            usage.object_bytes += sizeof(TextLabel);
+            usage.string_bytes += BoardMemoryReport::GetStringHeapBytes(label.text_content);  // Font family is interned
+            break;
+        }
+        case ElementType::kPin: {
+            const auto& pin = static_cast<const Pin&>(element);
+            usage.object_bytes += sizeof(Pin);
+            usage.string_bytes += BoardMemoryReport::GetStringHeapBytes(pin.diode_reading);  // Pin name is interned
+            break;
+        }
+        case ElementType::kComponent: {
+            const auto& comp = static_cast<const Component&>(element);
+            usage.object_bytes += sizeof(Component);
+            usage.string_bytes += BoardMemoryReport::GetStringHeapBytes(comp.reference_designator) + BoardMemoryReport::GetStringHeapBytes(comp.value);
+            // The pointer slots are counted with the pins and labels themselves
+            usage.vector_bytes += GetVectorHeapBytes(comp.graphical_elements) +
+                                  (comp.pins.capacity() - comp.pins.size()) * sizeof(std::unique_ptr<Pin>) +
+                                  (comp.text_labels.capacity() - comp.text_labels.size()) * sizeof(std::unique_ptr<TextLabel>);
+            for (const auto& pin_ptr : comp.pins) {
+                if (pin_ptr) {
+                    AccountElement(report, *pin_ptr);
+                }
+            }
+            for (const auto& label_ptr : comp.text_labels) {
+                if (label_ptr) {
+                    AccountElement(report, *label_ptr);
+                }
+            }
+            break;
         }
+        default:
+            // Types without a concrete class here are counted at their base size
+            usage.object_bytes += sizeof(Element);
+            break;
+    }
+}
+}  // namespace
 
-        for (auto& element_ptr : layer_pair.second) {
-            if (!element_ptr) continue;
+BoardMemoryReport Board::GetMemoryReport() const
+{
+    BoardMemoryReport report;
 
-            // Apply mirror transformation to non-component elements (traces, arcs, vias, etc.)
-            element_ptr->Mirror(center_x);
+    report.layer_container_bytes = GetUnorderedMapOverheadBytes(m_elements_by_layer);
+    for (const auto& [layer_id, elements] : m_elements_by_layer) {
+        // Occupied slots are counted with their elements; only the spare capacity belongs to the container
+        report.layer_container_bytes += (elements.capacity() - elements.size()) * sizeof(std::unique_ptr<Element>);
+        for (const auto& element_ptr : elements) {
+            if (element_ptr) {
+                AccountElement(report, *element_ptr);
+            }
         }
     }
 
-    // Components are stored in m_elements_by_layer at component layers
-    // Mirror components in both top and bottom component layers
-    std::vector<int> component_layers = {Board::kTopCompLayer, Board::kBottomCompLayer};
+    report.net_bytes = GetUnorderedMapOverheadBytes(m_nets);
+    for (const auto& [net_id, net] : m_nets) {
+        report.net_bytes += BoardMemoryReport::GetStringHeapBytes(net.GetName());
+    }
+
+    report.layer_info_bytes = GetVectorHeapBytes(layers);
+    for (const LayerInfo& layer : layers) {
+        report.layer_info_bytes += BoardMemoryReport::GetStringHeapBytes(layer.name);
+    }
 
-    for (int comp_layer : component_layers) {
-        auto comp_layer_it = m_elements_by_layer.find(comp_layer);
-        if (comp_layer_it == m_elements_by_layer.end()) continue;
+    report.other_string_bytes = BoardMemoryReport::GetStringHeapBytes(board_name) + BoardMemoryReport::GetStringHeapBytes(file_path) +
+                                BoardMemoryReport::GetStringHeapBytes(m_error_message_);
 
-        for (auto& element_ptr : comp_layer_it->second) {
-            if (!element_ptr) continue;
+    if (m_arena_) {
+        report.arena_slack_bytes = m_arena_->GetReservedBytes() - m_arena_->GetUsedBytes();
+    }
 
-            // Check if this element is a Component
-            if (auto comp_ptr = dynamic_cast<Component*>(element_ptr.get())) {
-                comp_ptr->Mirror(center_x);
-            }
+    if (m_interaction_view_) {
+        InteractionViewCache& cache = *m_interaction_view_;
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        report.interaction_view_bytes = GetVectorHeapBytes(cache.groups) + GetVectorHeapBytes(cache.group_visible) + GetVectorHeapBytes(cache.ranges) +
+                                        GetVectorHeapBytes(cache.layer_visibility);
+        if (cache.all_elements) {
+            report.interaction_view_bytes += sizeof(*cache.all_elements) + GetVectorHeapBytes(*cache.all_elements);
+        }
+        if (cache.visible_elements && cache.visible_elements != cache.all_elements) {
+            report.interaction_view_bytes += sizeof(*cache.visible_elements) + GetVectorHeapBytes(*cache.visible_elements);
         }
     }
+
+    return report;
 }
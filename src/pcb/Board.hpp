@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>  // For std::unique_ptr
 #include <string>
@@ -9,6 +10,9 @@
 
 #include <blend2d.h>  // Added for BLRgba32
 
+#include "BoardArena.hpp"
+#include "BoardMemoryReport.hpp"
+#include "BoardTransform.hpp"
 #include "elements/Element.hpp"    // Base class for all elements
 #include "elements/Net.hpp"        // Nets are metadata
 
@@ -42,6 +46,8 @@ public:
     Board(Board&& other) noexcept;
     Board& operator=(Board&& other) noexcept;
 
+    ~Board();  // Out of line: the interaction view cache is only complete in Board.cpp; destroys arena elements in place
+
     // Delete copy constructor and assignment to prevent expensive copies
     Board(const Board&) = delete;
     Board& operator=(const Board&) = delete;
@@ -83,7 +89,7 @@ public:
         int id = 0;        // Original ID from file if applicable, or internal ID
         std::string name;  // e.g., "TopLayer", "BottomLayer", "SilkscreenTop"
         LayerType type = LayerType::kOther;
-        bool is_visible = true;
+        bool is_visible = true;  // Default after loading; BoardDataManager's view state holds the live visibility
         // Removed color field
         // double thickness; // Optional: physical thickness of the layer
 
@@ -149,14 +155,33 @@ public:
     [[nodiscard]] const Net* GetNetById(int net_id) const;
     [[nodiscard]] const LayerInfo* GetLayerById(int layer_id) const;
 
+    // Performance optimization: One board-owned, priority-sorted interaction list shared by every consumer.
+    // The full list (side filtering applied, layer visibility ignored) is only rebuilt when the geometry revision,
+    // element count, view side or priority order changes. It is laid out as one contiguous range per priority and
+    // layer group, so a layer visibility toggle splices the visible list together from those ranges without
+    // re-walking the board. Each list carries a generation that changes exactly when its contents change and never
+    // repeats across boards: a consumer that remembers it can skip rebuilding its derived state.
+    // Lists are immutable snapshots; a consumer may keep one after the board moved on.
+    struct InteractionView {
+        std::shared_ptr<const std::vector<ElementInteractionInfo>> elements;
+        uint64_t generation = 0;
+    };
+    [[nodiscard]] InteractionView GetInteractionView(bool include_hidden_layers = false) const;
+    // Cheap (O(layers)) check for consumers that only need to know whether their copy is current
+    [[nodiscard]] uint64_t GetInteractionViewGeneration(bool include_hidden_layers = false) const;
+
+    // Copies of the shared views above
     [[nodiscard]] std::vector<ElementInteractionInfo> GetAllVisibleElementsForInteraction() const;
+    // Same priority order and side filtering, but ignoring layer visibility; for indices that mask layers themselves
+    [[nodiscard]] std::vector<ElementInteractionInfo> GetAllElementsForInteraction() const;
 
     // --- Layer Access Methods ---
     [[nodiscard]] std::vector<Board::LayerInfo> GetLayers() const;
     [[nodiscard]] int GetLayerCount() const;
     [[nodiscard]] std::string GetLayerName(int layer_index) const;  // Consider returning const&
+    // Visibility comes from the BoardDataManager's view state (the loaded default without a manager)
     [[nodiscard]] bool IsLayerVisible(int layer_index) const;
-    void SetLayerVisible(int layer_index, bool visible);
+    [[nodiscard]] bool IsLayerIdVisible(int layer_id) const;  // By layer id; false for layers the board lacks
     void SetLayerColor(int layer_index, BLRgba32 color);
 
     // --- Loading Status Methods ---
@@ -168,18 +193,23 @@ public:
     [[nodiscard]] BLRect GetBoundingBox(bool include_invisible_layers = false) const;
 
     // Normalizes all element coordinates so the center of their collective bounding box is (0,0)
-    // Returns the offset that was applied (original center).
-    BoardPoint2D NormalizeCoordinatesAndGetCenterOffset(const BLRect& original_bounds);
+    // Returns the offset that was applied (original center). then, if given, is fused into the same pass.
+    BoardPoint2D NormalizeCoordinatesAndGetCenterOffset(const BLRect& original_bounds, const BoardTransform& then = BoardTransform());
+
+    // --- Bulk Transforms ---
+    // Performance optimization: Applies transform to every element in one fused pass (see BoardTransform), with
+    // the layers split into chunks that worker threads process in parallel. Returns false without changing
+    // anything for transforms that would scale or shear, since widths, radii and pad sizes are not transformed.
+    bool ApplyBulkTransform(const BoardTransform& transform);
 
     // --- Board Folding Methods ---
     // Detects the central axis where the board should be folded (for butterfly layouts)
     double DetectBoardCenterAxis() const;
 
-    // Applies board folding transformation to convert butterfly layout to stacked layout
+    // Applies board folding transformation to convert butterfly layout to stacked layout. One way only: the
+    // unfolded layout stays available as the board the folded variant was built from (see CreateGeometryVariant).
     void ApplyBoardFolding();
-
-    // Reverts board folding transformation to restore butterfly layout
-    void RevertBoardFolding();
+    [[nodiscard]] bool IsFolded() const { return m_is_folded_; }
 
     // Checks if a board outline segment belongs to the top side (left of center axis)
     bool SegmentBelongsToTopSide(const BoardPoint2D& p1, const BoardPoint2D& p2, double center_x) const;
@@ -193,13 +223,32 @@ public:
     // Assigns board sides to silkscreen elements based on their position relative to center axis
     void AssignSilkscreenElementSides(double center_x);
 
-    // Updates folding state based on BoardDataManager setting
-    void UpdateFoldingState();
-
     // --- Global Transformation Methods ---
     // Applies global coordinate transformation (mirroring) to all board elements
     void ApplyGlobalTransformation(bool mirror_horizontally);
 
+    // --- Geometry Change Tracking ---
+    // Every operation that moves elements (normalization, folding, mirroring) bumps the geometry revision, so
+    // caches keyed by (board, revision) see the change. Published boards never change, so this only concerns code
+    // that holds a board before it is published.
+    [[nodiscard]] uint64_t GetGeometryRevision() const { return m_geometry_revision_; }
+
+    // --- Geometry Variants ---
+    // A board is read-only once BoardDataManager publishes it, so any number of threads may read it without locks.
+    // Folding and flipping instead build a variant: a deep copy of this board's elements into the variant's own
+    // arena, with the folding and/or the horizontal flip applied to the copy before anyone else can see it.
+    // Meant to be called on the board as loaded (unfolded and not flipped). Takes time in proportion to the board,
+    // so BoardDataManager calls it on its variant worker.
+    [[nodiscard]] std::shared_ptr<Board> CreateGeometryVariant(bool folded, bool flipped) const;
+
+    // --- Element Storage ---
+    // Arena for elements that live as long as the board; loaders allocate through a BoardArena::Scope on it
+    [[nodiscard]] BoardArena& GetArena() { return *m_arena_; }
+
+    // --- Memory Accounting ---
+    // Walks every element, string and cache the board owns; O(elements), meant for diagnostics and the HUD
+    [[nodiscard]] BoardMemoryReport GetMemoryReport() const;
+
     // Methods for board-level operations (e.g., calculate extents)
     // void calculateBoardDimensions();
 
@@ -214,4 +263,24 @@ private:
     // Board folding state
     bool m_is_folded_ = false;
     double m_board_center_x_ = 0.0;  // Cached center axis for folding
+
+    // Geometry change tracking (see GetGeometryRevision)
+    uint64_t m_geometry_revision_ = 0;
+
+    // Backing memory of the elements allocated while loading (see GetArena); moves with the elements
+    std::unique_ptr<BoardArena> m_arena_;
+    void ReleaseArenaElements();  // Destroys arena elements in place and empties their owning pointers
+
+    // Interaction view cache (see GetInteractionView); every board owns its own, moves never share one
+    struct InteractionViewCache;
+    std::unique_ptr<InteractionViewCache> m_interaction_view_;
+
+    void RefreshInteractionView(InteractionViewCache& cache) const;  // Caller holds cache.mutex
+    void RebuildInteractionView(InteractionViewCache& cache) const;
+
+    // Runs transform over the elements accepted by filter (all when empty). Returns how many accepted elements
+    // were skipped because the bulk path has no layout for their type.
+    size_t TransformElements(const BoardTransform& transform, const BulkTransformFilter& filter);
+
+    void BeginGeometryChange();
 };
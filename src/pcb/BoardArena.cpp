@@ -0,0 +1,86 @@
+#include "BoardArena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+thread_local BoardArena* t_current_arena = nullptr;
+
+uintptr_t AlignUp(uintptr_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+}  // namespace
+
+BoardArena::BoardArena(size_t chunk_size) : m_chunk_size_(chunk_size) {}
+
+BoardArena::~BoardArena() = default;
+
+void BoardArena::AddChunk(size_t min_size)
+{
+    Chunk chunk;
+    chunk.size = std::max(m_chunk_size_, min_size);
+    chunk.data.reset(new std::byte[chunk.size]);  // Default-initialized: pages are only touched when used
+
+    const auto begin = reinterpret_cast<uintptr_t>(chunk.data.get());
+    const std::pair<uintptr_t, uintptr_t> range(begin, begin + chunk.size);
+    m_sorted_ranges_.insert(std::upper_bound(m_sorted_ranges_.begin(), m_sorted_ranges_.end(), range), range);
+
+    m_cursor_ = chunk.data.get();
+    m_limit_ = m_cursor_ + chunk.size;
+    m_reserved_bytes_ += chunk.size;
+    m_chunks_.push_back(std::move(chunk));
+}
+
+void* BoardArena::Allocate(size_t size, size_t alignment)
+{
+    uintptr_t address = AlignUp(reinterpret_cast<uintptr_t>(m_cursor_), alignment);
+    if (!m_cursor_ || address + size > reinterpret_cast<uintptr_t>(m_limit_)) {
+        // The rest of the current chunk is abandoned; oversized requests get a chunk of their own
+        AddChunk(size + alignment);
+        address = AlignUp(reinterpret_cast<uintptr_t>(m_cursor_), alignment);
+    }
+    m_cursor_ = reinterpret_cast<std::byte*>(address + size);
+    m_used_bytes_ += size;
+    return reinterpret_cast<void*>(address);
+}
+
+std::string_view BoardArena::CopyString(std::string_view text)
+{
+    auto* chars = static_cast<char*>(Allocate(text.size() + 1, alignof(char)));
+    if (!text.empty()) {
+        std::memcpy(chars, text.data(), text.size());
+    }
+    chars[text.size()] = '\0';
+    m_string_bytes_ += text.size() + 1;
+    return {chars, text.size()};
+}
+
+bool BoardArena::Contains(const void* ptr) const
+{
+    const auto address = reinterpret_cast<uintptr_t>(ptr);
+    auto it = std::upper_bound(m_sorted_ranges_.begin(), m_sorted_ranges_.end(), address,
+                               [](uintptr_t value, const std::pair<uintptr_t, uintptr_t>& range) { return value < range.first; });
+    if (it == m_sorted_ranges_.begin()) {
+        return false;
+    }
+    --it;
+    return address < it->second;
+}
+
+BoardArena* BoardArena::GetCurrent()
+{
+    return t_current_arena;
+}
+
+BoardArena::Scope::Scope(BoardArena* arena) : m_previous_(t_current_arena)
+{
+    t_current_arena = arena;
+}
+
+BoardArena::Scope::~Scope()
+{
+    t_current_arena = m_previous_;
+}
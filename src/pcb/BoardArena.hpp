@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Performance optimization: Monotonic arena for objects that live exactly as long as their board.
+// Loaders open a Scope on the board's arena; while it is active, every Element allocated on that thread
+// (std::make_unique<Trace>, component pins, ...) is carved out of large chunks instead of the general heap
+// (see Element::operator new, which tags each allocation with where it came from). Deleting an arena element runs
+// its destructor but returns no memory; the board destroys its arena elements in place on teardown and the memory
+// goes back one chunk at a time.
+// The arena also stores string bytes (CopyString) for tables that hand out string_views into it.
+//
+// Not thread-safe: one thread allocates at a time, which is what a Scope on the loading thread gives.
+class BoardArena
+{
+public:
+    static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+
+    explicit BoardArena(size_t chunk_size = kDefaultChunkSize);
+    ~BoardArena();
+
+    BoardArena(const BoardArena&) = delete;
+    BoardArena& operator=(const BoardArena&) = delete;
+    BoardArena(BoardArena&&) = delete;  // Elements point into the chunks; the board holds the arena by pointer
+    BoardArena& operator=(BoardArena&&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+    // Copies text into the arena followed by a NUL, so view.data() is also a C string; the view stays valid until
+    // the arena is destroyed
+    std::string_view CopyString(std::string_view text);
+
+    // Whether ptr points into one of this arena's chunks (binary search over the chunks, no locking)
+    [[nodiscard]] bool Contains(const void* ptr) const;
+
+    [[nodiscard]] size_t GetChunkCount() const { return m_chunks_.size(); }
+    [[nodiscard]] size_t GetReservedBytes() const { return m_reserved_bytes_; }
+    [[nodiscard]] size_t GetUsedBytes() const { return m_used_bytes_; }
+    [[nodiscard]] size_t GetStringBytes() const { return m_string_bytes_; }
+
+    // Arena that Element allocations on the calling thread go to, or null for the general heap
+    static BoardArena* GetCurrent();
+
+    // Routes Element allocations on the calling thread to arena until destroyed; scopes nest
+    class Scope
+    {
+    public:
+        explicit Scope(BoardArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        BoardArena* m_previous_;
+    };
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    void AddChunk(size_t min_size);
+
+    size_t m_chunk_size_;
+    std::vector<Chunk> m_chunks_;
+    std::vector<std::pair<uintptr_t, uintptr_t>> m_sorted_ranges_;  // [begin, end) of every chunk, by address
+    std::byte* m_cursor_ = nullptr;  // Next free byte of the newest chunk
+    std::byte* m_limit_ = nullptr;
+    size_t m_reserved_bytes_ = 0;
+    size_t m_used_bytes_ = 0;
+    size_t m_string_bytes_ = 0;
+};
@@ -0,0 +1,107 @@
+#include "BoardMemoryReport.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+double ToMegabytes(size_t bytes)
+{
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+}  // namespace
+
+size_t BoardMemoryReport::GetElementCount() const
+{
+    size_t count = 0;
+    for (const TypeUsage& usage : element_types) {
+        count += usage.count;
+    }
+    return count;
+}
+
+size_t BoardMemoryReport::GetElementBytes() const
+{
+    size_t bytes = 0;
+    for (const TypeUsage& usage : element_types) {
+        bytes += usage.GetTotalBytes();
+    }
+    return bytes;
+}
+
+size_t BoardMemoryReport::GetStringBytes() const
+{
+    size_t bytes = other_string_bytes;
+    for (const TypeUsage& usage : element_types) {
+        bytes += usage.string_bytes;
+    }
+    return bytes;
+}
+
+size_t BoardMemoryReport::GetVectorBytes() const
+{
+    size_t bytes = layer_container_bytes;
+    for (const TypeUsage& usage : element_types) {
+        bytes += usage.vector_bytes;
+    }
+    return bytes;
+}
+
+size_t BoardMemoryReport::GetCacheBytes() const
+{
+    return interaction_view_bytes;
+}
+
+size_t BoardMemoryReport::GetTotalBytes() const
+{
+    return GetElementBytes() + layer_container_bytes + net_bytes + layer_info_bytes + other_string_bytes + GetCacheBytes() + arena_slack_bytes;
+}
+
+std::string BoardMemoryReport::ToString() const
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Board memory: " << ToMegabytes(GetTotalBytes()) << " MB for " << GetElementCount() << " elements\n";
+    for (size_t i = 0; i < kElementTypeCount; ++i) {
+        const TypeUsage& usage = element_types[i];
+        if (usage.count == 0) {
+            continue;
+        }
+        ss << "  " << std::left << std::setw(12) << ElementTypeToString(static_cast<ElementType>(i)) << std::right << std::setw(10) << usage.count << "  "
+           << ToMegabytes(usage.GetTotalBytes()) << " MB (objects " << ToMegabytes(usage.object_bytes) << ", strings " << ToMegabytes(usage.string_bytes)
+           << ", vectors " << ToMegabytes(usage.vector_bytes) << ")\n";
+    }
+    ss << "  Strings " << ToMegabytes(GetStringBytes()) << " MB, vectors " << ToMegabytes(GetVectorBytes()) << " MB, nets " << ToMegabytes(net_bytes)
+       << " MB, layers " << ToMegabytes(layer_info_bytes) << " MB, arena slack " << ToMegabytes(arena_slack_bytes) << " MB\n";
+    ss << "  Caches " << ToMegabytes(GetCacheBytes()) << " MB (interaction view " << ToMegabytes(interaction_view_bytes) << ")";
+    return ss.str();
+}
+
+const char* BoardMemoryReport::ElementTypeToString(ElementType type)
+{
+    switch (type) {
+        case ElementType::kNone:
+            return "None";
+        case ElementType::kTrace:
+            return "Traces";
+        case ElementType::kVia:
+            return "Vias";
+        case ElementType::kArc:
+            return "Arcs";
+        case ElementType::kPin:
+            return "Pins";
+        case ElementType::kTextLabel:
+            return "Text Labels";
+        case ElementType::kComponentGraphic:
+            return "Graphics";
+        case ElementType::kComponent:
+            return "Components";
+    }
+    return "Unknown";
+}
+
+size_t BoardMemoryReport::GetStringHeapBytes(const std::string& text)
+{
+    static const size_t kInlineCapacity = std::string().capacity();
+    return text.capacity() > kInlineCapacity ? text.capacity() + 1 : 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "elements/Element.hpp"
+
+// Heap and object bytes a loaded board holds, broken down by element type (see Board::GetMemoryReport).
+// Sizes are what the containers request, without allocator bookkeeping, so totals slightly undercount the process.
+struct BoardMemoryReport {
+    static constexpr size_t kElementTypeCount = static_cast<size_t>(ElementType::kComponent) + 1;
+
+    struct TypeUsage {
+        size_t count = 0;
+        size_t object_bytes = 0;  // sizeof of the elements, plus the pointer slot that owns each one and its allocation tag
+        size_t string_bytes = 0;  // Heap buffers of their strings (short strings live inside the object)
+        size_t vector_bytes = 0;  // Heap buffers of their vectors (component pin/label/segment lists)
+
+        [[nodiscard]] size_t GetTotalBytes() const { return object_bytes + string_bytes + vector_bytes; }
+    };
+
+    std::array<TypeUsage, kElementTypeCount> element_types {};
+
+    size_t layer_container_bytes = 0;   // Per-layer element vectors and their map nodes
+    size_t net_bytes = 0;               // Net map nodes, buckets and names
+    size_t layer_info_bytes = 0;        // Layer descriptions and names
+    size_t other_string_bytes = 0;      // Board name, file path, error message
+    size_t interaction_view_bytes = 0;  // Shared interaction lists and layer group ranges
+    size_t arena_slack_bytes = 0;       // Arena chunk space not handed out (alignment, chunk tails)
+
+    [[nodiscard]] const TypeUsage& GetUsage(ElementType type) const { return element_types[static_cast<size_t>(type)]; }
+    [[nodiscard]] size_t GetElementCount() const;
+    [[nodiscard]] size_t GetElementBytes() const;  // Objects, strings and vectors of all elements
+    [[nodiscard]] size_t GetStringBytes() const;   // Element, net, layer and board strings
+    [[nodiscard]] size_t GetVectorBytes() const;   // Element-owned vectors plus the layer containers
+    [[nodiscard]] size_t GetCacheBytes() const;    // State derived from the elements that could be rebuilt
+    [[nodiscard]] size_t GetTotalBytes() const;
+
+    [[nodiscard]] std::string ToString() const;
+
+    static const char* ElementTypeToString(ElementType type);
+    // Heap bytes behind a string; zero while it fits the small-string buffer
+    static size_t GetStringHeapBytes(const std::string& text);
+};
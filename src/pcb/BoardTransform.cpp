@@ -0,0 +1,161 @@
+#include "BoardTransform.hpp"
+
+#include <cmath>
+
+#include "Board.hpp"
+#include "elements/Arc.hpp"
+#include "elements/Component.hpp"
+#include "elements/Pin.hpp"
+#include "elements/TextLabel.hpp"
+#include "elements/Trace.hpp"
+#include "elements/Via.hpp"
+#include "utils/Constants.hpp"
+
+namespace
+{
+constexpr double kRigidTolerance = 1e-9;
+
+// Same normalization as Arc::Mirror, so mirrored angles match it exactly
+double NormalizeArcAngle(double angle)
+{
+    while (angle < 0) angle += 360.0;
+    while (angle >= 360.0) angle -= 360.0;
+    return angle;
+}
+
+// Direction of the transformed x axis in degrees; exact for the axis-aligned matrices mirrors produce
+double GetImageAngleDegrees(const AffineTransform2D& matrix)
+{
+    if (matrix.m10 == 0.0) {
+        return matrix.m00 >= 0.0 ? 0.0 : 180.0;
+    }
+    return std::atan2(matrix.m10, matrix.m00) * 180.0 / kPi;
+}
+
+}  // namespace
+
+// --- AffineTransform2D ---
+
+AffineTransform2D AffineTransform2D::Translation(double dx, double dy)
+{
+    return {1.0, 0.0, dx, 0.0, 1.0, dy};
+}
+
+AffineTransform2D AffineTransform2D::MirrorX(double center_axis)
+{
+    return {-1.0, 0.0, 2 * center_axis, 0.0, 1.0, 0.0};
+}
+
+AffineTransform2D AffineTransform2D::Then(const AffineTransform2D& next) const
+{
+    return {next.m00 * m00 + next.m01 * m10, next.m00 * m01 + next.m01 * m11, next.m00 * m02 + next.m01 * m12 + next.m02,
+            next.m10 * m00 + next.m11 * m10, next.m10 * m01 + next.m11 * m11, next.m10 * m02 + next.m11 * m12 + next.m12};
+}
+
+bool AffineTransform2D::IsRigid() const
+{
+    return std::abs(m00 * m00 + m10 * m10 - 1.0) <= kRigidTolerance && std::abs(m01 * m01 + m11 * m11 - 1.0) <= kRigidTolerance &&
+           std::abs(m00 * m01 + m10 * m11) <= kRigidTolerance;
+}
+
+// --- BoardTransform ---
+
+BoardTransform BoardTransform::Translation(double dx, double dy)
+{
+    const AffineTransform2D translation = AffineTransform2D::Translation(dx, dy);
+    return {translation, translation};
+}
+
+BoardTransform BoardTransform::MirrorX(double center_axis)
+{
+    const AffineTransform2D mirror = AffineTransform2D::MirrorX(center_axis);
+    return {mirror, mirror.GetLinearPart()};
+}
+
+BoardTransform BoardTransform::FromMatrix(const AffineTransform2D& matrix)
+{
+    return {matrix, matrix};
+}
+
+BoardTransform BoardTransform::Then(const BoardTransform& next) const
+{
+    return {global.Then(next.global), component_attached.Then(next.component_attached)};
+}
+
+size_t BoardTransform::ApplyToRange(int layer_id, std::vector<std::unique_ptr<Element>>& elements, size_t begin, size_t end,
+                                    const BulkTransformFilter& filter) const
+{
+    // Local copies: the matrices could alias the coordinates written below, which would force a reload per point
+    const AffineTransform2D global_matrix = global;
+    const AffineTransform2D attached_matrix = component_attached;
+    size_t unsupported_count = 0;
+
+    // Arc angles follow the global matrix: a rotation by theta adds theta, a reflection whose x axis maps to theta
+    // turns angle a into theta - a and reverses the sweep (theta = 180 reproduces Arc::Mirror)
+    const double theta = GetImageAngleDegrees(global_matrix);
+    const bool reflects = global_matrix.GetDeterminant() < 0.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        Element* element = elements[i].get();
+        if (!element || (filter && !filter(layer_id, *element))) {
+            continue;
+        }
+
+        switch (element->GetElementType()) {
+            case ElementType::kTrace: {
+                auto* trace = static_cast<Trace*>(element);
+                global_matrix.Apply(trace->x1, trace->y1);
+                global_matrix.Apply(trace->x2, trace->y2);
+                break;
+            }
+            case ElementType::kArc: {
+                auto* arc = static_cast<Arc*>(element);
+                global_matrix.Apply(arc->center);
+                if (reflects) {
+                    const double original_start = arc->start_angle;
+                    const double original_end = arc->end_angle;
+                    arc->start_angle = NormalizeArcAngle(theta - original_end);
+                    arc->end_angle = NormalizeArcAngle(theta - original_start);
+                } else if (theta != 0.0) {
+                    arc->start_angle = NormalizeArcAngle(arc->start_angle + theta);
+                    arc->end_angle = NormalizeArcAngle(arc->end_angle + theta);
+                }
+                break;
+            }
+            case ElementType::kVia: {
+                auto* via = static_cast<Via*>(element);
+                global_matrix.Apply(via->x, via->y);
+                break;
+            }
+            case ElementType::kTextLabel:
+                global_matrix.Apply(static_cast<TextLabel*>(element)->coords);
+                break;
+            case ElementType::kPin:
+                global_matrix.Apply(static_cast<Pin*>(element)->coords);
+                break;
+            case ElementType::kComponent: {
+                auto* comp = static_cast<Component*>(element);
+                global_matrix.Apply(comp->center_x, comp->center_y);
+                for (auto& pin_ptr : comp->pins) {
+                    if (pin_ptr) {
+                        global_matrix.Apply(pin_ptr->coords);
+                    }
+                }
+                for (auto& label_ptr : comp->text_labels) {
+                    if (label_ptr) {
+                        attached_matrix.Apply(label_ptr->coords);
+                    }
+                }
+                for (auto& segment : comp->graphical_elements) {
+                    attached_matrix.Apply(segment.start);
+                    attached_matrix.Apply(segment.end);
+                }
+                break;
+            }
+            default:
+                ++unsupported_count;
+                continue;
+        }
+    }
+    return unsupported_count;
+}
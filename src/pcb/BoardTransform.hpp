@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "utils/Vec2.hpp"
+
+// Forward declarations
+class Element;
+struct ElementInteractionInfo;
+
+// Row-major 2D affine matrix: x' = m00 * x + m01 * y + m02, y' = m10 * x + m11 * y + m12
+struct AffineTransform2D {
+    double m00 = 1.0, m01 = 0.0, m02 = 0.0;
+    double m10 = 0.0, m11 = 1.0, m12 = 0.0;
+
+    static AffineTransform2D Translation(double dx, double dy);
+    static AffineTransform2D MirrorX(double center_axis);  // Reflection across the vertical line x = center_axis
+
+    // Pure translations and mirrors reproduce the element Translate/Mirror methods bit for bit
+    void Apply(double& x, double& y) const
+    {
+        const double px = x;
+        const double py = y;
+        x = (m00 * px + m01 * py) + m02;
+        y = (m10 * px + m11 * py) + m12;
+    }
+    void Apply(Vec2& point) const { Apply(point.x_ax, point.y_ax); }
+
+    // This transform followed by next
+    [[nodiscard]] AffineTransform2D Then(const AffineTransform2D& next) const;
+    [[nodiscard]] AffineTransform2D GetLinearPart() const { return {m00, m01, 0.0, m10, m11, 0.0}; }
+    [[nodiscard]] double GetDeterminant() const { return m00 * m11 - m01 * m10; }
+    // Rotation and/or reflection plus translation: lengths, widths and radii are preserved
+    [[nodiscard]] bool IsRigid() const;
+};
+
+// Chooses the top-level elements a bulk transform touches; a component always carries its children along
+using BulkTransformFilter = std::function<bool(int layer_id, const Element& element)>;
+
+// Performance optimization: One transform for every coordinate of a board, applied in a single fused pass
+// (see Board::ApplyBulkTransform) instead of one virtual Translate/Mirror call per element per operation.
+//
+// Component text labels and graphical segments get their own matrix: Component::Translate moves them with the
+// board, while Component::Mirror reflects them about the component frame (x -> -x). Building transforms from
+// Translation and MirrorX steps keeps both behaviors, so a fused normalize + mirror lands where the two separate
+// passes did.
+struct BoardTransform {
+    AffineTransform2D global;              // Element coordinates, component centers and pins
+    AffineTransform2D component_attached;  // Component text labels and graphical segments
+
+    static BoardTransform Translation(double dx, double dy);
+    static BoardTransform MirrorX(double center_axis);
+    static BoardTransform FromMatrix(const AffineTransform2D& matrix);  // Attached geometry follows the matrix too
+
+    // This transform followed by next
+    [[nodiscard]] BoardTransform Then(const BoardTransform& next) const;
+    [[nodiscard]] bool IsRigid() const { return global.IsRigid() && component_attached.IsRigid(); }
+
+    // Transforms the elements [begin, end) of one layer in place, dispatching on the element type instead of
+    // calling virtual Translate/Mirror. Safe to run concurrently on disjoint ranges. Returns the number of accepted
+    // elements of types it has no layout for; those are left untouched.
+    size_t ApplyToRange(int layer_id, std::vector<std::unique_ptr<Element>>& elements, size_t begin, size_t end,
+                        const BulkTransformFilter& filter) const;
+};
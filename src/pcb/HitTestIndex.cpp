@@ -0,0 +1,766 @@
+#include "pcb/HitTestIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+#include "pcb/elements/Component.hpp"
+#include "pcb/elements/Pin.hpp"
+#include "pcb/elements/Trace.hpp"
+#include "pcb/elements/Via.hpp"
+#include "utils/Constants.hpp"
+#include "utils/GeometryUtils.hpp"
+
+namespace
+{
+// Target average number of indexed records per grid cell
+constexpr double kTargetEntriesPerCell = 4.0;
+constexpr int kMaxCellsPerAxis = 2048;
+// Elements covering more cells than this go to the shared oversized bucket instead of being duplicated
+constexpr int kMaxCellsPerElement = 16;
+constexpr uint32_t kNoRank = std::numeric_limits<uint32_t>::max();
+
+// Oriented pad record in world coordinates, before packing
+struct PadRecord {
+    double cx = 0.0;
+    double cy = 0.0;
+    double cos_r = 1.0;
+    double sin_r = 0.0;
+    double half_w = 0.0;
+    double half_h = 0.0;
+    double corner_radius = 0.0;
+    bool is_box = false;
+};
+
+PadRecord MakeRoundPad(double cx, double cy, double radius)
+{
+    PadRecord pad;
+    pad.cx = cx;
+    pad.cy = cy;
+    pad.corner_radius = radius;
+    return pad;
+}
+
+// Mirrors Pin::IsHit: inverse rotation only when significant, then per-shape local test
+PadRecord MakePinPad(const Pin& pin)
+{
+    PadRecord pad;
+    pad.cx = pin.coords.x_ax;
+    pad.cy = pin.coords.y_ax;
+    if (std::abs(pin.rotation) > 1e-6) {
+        const double rotation_rad = -pin.rotation * (kPi / 180.0);
+        pad.cos_r = std::cos(rotation_rad);
+        pad.sin_r = std::sin(rotation_rad);
+    }
+
+    std::visit(
+        [&pad](const auto& shape) {
+            using T = std::decay_t<decltype(shape)>;
+            if constexpr (std::is_same_v<T, CirclePad>) {
+                pad.corner_radius = shape.radius;
+            } else if constexpr (std::is_same_v<T, RectanglePad>) {
+                pad.half_w = shape.width / 2.0;
+                pad.half_h = shape.height / 2.0;
+                pad.is_box = true;
+            } else if constexpr (std::is_same_v<T, CapsulePad>) {
+                // Capsule = segment along local X rounded by half the height
+                pad.corner_radius = shape.height / 2.0;
+                const double rect_length = shape.width - shape.height;
+                pad.half_w = rect_length > 0 ? rect_length / 2.0 : 0.0;
+            }
+        },
+        pin.pad_shape);
+    return pad;
+}
+
+// Mirrors Via::IsHit radius fallback
+PadRecord MakeViaPad(const Via& via)
+{
+    double max_radius = std::max(via.pad_radius_from, via.pad_radius_to);
+    if (max_radius == 0 && via.drill_diameter > 0)
+        max_radius = via.drill_diameter / 2.0;
+    else if (max_radius == 0)
+        max_radius = 0.1;
+    return MakeRoundPad(via.x, via.y, max_radius);
+}
+
+// Mirrors Component::IsHit: rotated body rectangle
+PadRecord MakeComponentPad(const Component& component)
+{
+    PadRecord pad;
+    pad.cx = component.center_x;
+    pad.cy = component.center_y;
+    const double rotation_rad = -component.rotation * (kPi / 180.0);
+    pad.cos_r = std::cos(rotation_rad);
+    pad.sin_r = std::sin(rotation_rad);
+    pad.half_w = component.width / 2.0;
+    pad.half_h = component.height / 2.0;
+    pad.is_box = true;
+    return pad;
+}
+
+// Tight world bounds of an oriented pad (rotated box grown by the corner radius)
+BLRect PadBounds(const PadRecord& pad)
+{
+    const double reach_x = std::abs(pad.cos_r) * pad.half_w + std::abs(pad.sin_r) * pad.half_h + pad.corner_radius;
+    const double reach_y = std::abs(pad.sin_r) * pad.half_w + std::abs(pad.cos_r) * pad.half_h + pad.corner_radius;
+    return BLRect(pad.cx - reach_x, pad.cy - reach_y, reach_x * 2.0, reach_y * 2.0);
+}
+
+double TraceRadius(const Trace& trace)
+{
+    // Same minimum thickness as geometry_utils::IsPointNearLineSegment
+    return (trace.width > 0 ? trace.width : 1.0) / 2.0;
+}
+
+BLRect TraceBounds(const Trace& trace)
+{
+    const double radius = TraceRadius(trace);
+    const double min_x = std::min(trace.x1, trace.x2) - radius;
+    const double min_y = std::min(trace.y1, trace.y2) - radius;
+    const double max_x = std::max(trace.x1, trace.x2) + radius;
+    const double max_y = std::max(trace.y1, trace.y2) + radius;
+    return BLRect(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+
+// First position in the rank-sorted run [begin, end) whose rank is >= limit
+size_t RankLimit(const std::vector<uint32_t>& ranks, size_t begin, size_t end, uint32_t limit)
+{
+    if (limit == kNoRank || begin == end || ranks[end - 1] < limit) {
+        return end;
+    }
+    return static_cast<size_t>(std::lower_bound(ranks.begin() + static_cast<std::ptrdiff_t>(begin), ranks.begin() + static_cast<std::ptrdiff_t>(end), limit) - ranks.begin());
+}
+
+// Liang-Barsky: does segment (x1,y1)-(x2,y2) cross the box [min, max]?
+bool SegmentIntersectsBox(double x1, double y1, double x2, double y2, double min_x, double min_y, double max_x, double max_y)
+{
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    const double p[4] = {-dx, dx, -dy, dy};
+    const double q[4] = {x1 - min_x, max_x - x1, y1 - min_y, max_y - y1};
+    double t0 = 0.0;
+    double t1 = 1.0;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0) {
+            if (q[i] < 0.0) {
+                return false;
+            }
+            continue;
+        }
+        const double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Above this fraction of grid cells, a rectangle query scans per-rank bounds linearly instead of walking cells
+constexpr double kLinearRectScanCellFraction = 0.25;
+}  // namespace
+
+void HitTestIndex::Clear()
+{
+    m_entries_.clear();
+    m_entry_group_.clear();
+    m_group_layers_.clear();
+    m_group_visible_.clear();
+    m_entry_min_x_.clear();
+    m_entry_min_y_.clear();
+    m_entry_max_x_.clear();
+    m_entry_max_y_.clear();
+    m_entry_cells_.clear();
+    m_cells_x_ = 0;
+    m_cells_y_ = 0;
+    m_cell_count_ = 0;
+
+    m_segment_bucket_start_.clear();
+    m_segment_x1_.clear();
+    m_segment_y1_.clear();
+    m_segment_x2_.clear();
+    m_segment_y2_.clear();
+    m_segment_radius_.clear();
+    m_segment_rank_.clear();
+
+    m_pad_bucket_start_.clear();
+    m_pad_cx_.clear();
+    m_pad_cy_.clear();
+    m_pad_cos_.clear();
+    m_pad_sin_.clear();
+    m_pad_half_w_.clear();
+    m_pad_half_h_.clear();
+    m_pad_corner_radius_.clear();
+    m_pad_box_mask_.clear();
+    m_pad_rank_.clear();
+
+    m_generic_bucket_start_.clear();
+    m_generic_rank_.clear();
+    m_generic_bounds_.clear();
+}
+
+void HitTestIndex::Build(const std::vector<ElementInteractionInfo>& entries)
+{
+    Clear();
+    m_entries_ = entries;
+    if (m_entries_.empty()) {
+        return;
+    }
+
+    // Assign layer visibility groups; all groups start visible until SyncLayerVisibility()
+    m_entry_group_.resize(m_entries_.size());
+    std::unordered_map<uint64_t, uint32_t> group_by_layers;
+    for (size_t i = 0; i < m_entries_.size(); ++i) {
+        const ElementInteractionInfo& info = m_entries_[i];
+        int primary_layer = info.element ? info.element->GetLayerId() : 0;
+        int secondary_layer = primary_layer;
+        if (info.element && info.element->GetElementType() == ElementType::kComponent) {
+            primary_layer = secondary_layer = static_cast<const Component*>(info.element)->layer;
+        } else if (info.parent_component) {
+            primary_layer = info.parent_component->layer;
+        }
+
+        const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(primary_layer)) << 32) | static_cast<uint32_t>(secondary_layer);
+        auto [it, inserted] = group_by_layers.try_emplace(key, static_cast<uint32_t>(m_group_layers_.size()));
+        if (inserted) {
+            m_group_layers_.emplace_back(primary_layer, secondary_layer);
+        }
+        m_entry_group_[i] = it->second;
+    }
+    m_group_visible_.assign(m_group_layers_.size(), 1);
+
+    // Pass 1: classify every entry and compute its world bounds
+    struct Staged {
+        PackedKind kind = PackedKind::kNone;
+        BLRect bounds;
+        PadRecord pad;
+    };
+    std::vector<Staged> staged(m_entries_.size());
+
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+
+    for (size_t i = 0; i < m_entries_.size(); ++i) {
+        const ElementInteractionInfo& info = m_entries_[i];
+        Staged& stage = staged[i];
+        if (!info.element) {
+            continue;
+        }
+
+        switch (info.element->GetElementType()) {
+            case ElementType::kTrace: {
+                const auto* trace = static_cast<const Trace*>(info.element);
+                stage.kind = PackedKind::kSegment;
+                stage.bounds = TraceBounds(*trace);
+                break;
+            }
+            case ElementType::kVia:
+                stage.kind = PackedKind::kPad;
+                stage.pad = MakeViaPad(*static_cast<const Via*>(info.element));
+                stage.bounds = PadBounds(stage.pad);
+                break;
+            case ElementType::kPin:
+                stage.kind = PackedKind::kPad;
+                stage.pad = MakePinPad(*static_cast<const Pin*>(info.element));
+                stage.bounds = PadBounds(stage.pad);
+                break;
+            case ElementType::kComponent:
+                stage.kind = PackedKind::kPad;
+                stage.pad = MakeComponentPad(*static_cast<const Component*>(info.element));
+                stage.bounds = PadBounds(stage.pad);
+                break;
+            case ElementType::kTextLabel:
+                // TextLabel::IsHit never reports a hit
+                break;
+            default:
+                stage.kind = PackedKind::kGeneric;
+                stage.bounds = info.element->GetBoundingBox(info.parent_component);
+                break;
+        }
+
+        if (stage.kind == PackedKind::kNone || !std::isfinite(stage.bounds.x) || !std::isfinite(stage.bounds.y) || !std::isfinite(stage.bounds.w) ||
+            !std::isfinite(stage.bounds.h)) {
+            stage.kind = PackedKind::kNone;
+            continue;
+        }
+        min_x = std::min(min_x, stage.bounds.x);
+        min_y = std::min(min_y, stage.bounds.y);
+        max_x = std::max(max_x, stage.bounds.x + stage.bounds.w);
+        max_y = std::max(max_y, stage.bounds.y + stage.bounds.h);
+    }
+
+    if (min_x > max_x || min_y > max_y) {
+        min_x = min_y = 0.0;
+        max_x = max_y = 1.0;
+    }
+
+    // Size the grid for roughly kTargetEntriesPerCell records per cell with square cells
+    const double extent_w = std::max(max_x - min_x, 1e-3);
+    const double extent_h = std::max(max_y - min_y, 1e-3);
+    const double target_cells = std::max(1.0, static_cast<double>(m_entries_.size()) / kTargetEntriesPerCell);
+    m_cell_size_ = std::max(std::sqrt((extent_w * extent_h) / target_cells), 1e-6);
+    m_cell_size_ = std::max({m_cell_size_, extent_w / kMaxCellsPerAxis, extent_h / kMaxCellsPerAxis});
+    m_inv_cell_size_ = 1.0 / m_cell_size_;
+    m_origin_x_ = min_x;
+    m_origin_y_ = min_y;
+    m_cells_x_ = std::clamp(static_cast<int>(std::ceil(extent_w * m_inv_cell_size_)), 1, kMaxCellsPerAxis);
+    m_cells_y_ = std::clamp(static_cast<int>(std::ceil(extent_h * m_inv_cell_size_)), 1, kMaxCellsPerAxis);
+    m_cell_count_ = static_cast<size_t>(m_cells_x_) * static_cast<size_t>(m_cells_y_);
+
+    // Per-rank bounds and bucket spans for rectangle queries
+    const float kNaN = std::numeric_limits<float>::quiet_NaN();
+    m_entry_min_x_.assign(m_entries_.size(), kNaN);
+    m_entry_min_y_.assign(m_entries_.size(), kNaN);
+    m_entry_max_x_.assign(m_entries_.size(), kNaN);
+    m_entry_max_y_.assign(m_entries_.size(), kNaN);
+    m_entry_cells_.assign(m_entries_.size(), CellSpan {kOversizedSpan, 0, 0, 0});
+    for (size_t i = 0; i < staged.size(); ++i) {
+        const Staged& stage = staged[i];
+        if (stage.kind == PackedKind::kNone) {
+            continue;
+        }
+        m_entry_min_x_[i] = static_cast<float>(stage.bounds.x - m_origin_x_);
+        m_entry_min_y_[i] = static_cast<float>(stage.bounds.y - m_origin_y_);
+        m_entry_max_x_[i] = static_cast<float>(stage.bounds.x + stage.bounds.w - m_origin_x_);
+        m_entry_max_y_[i] = static_cast<float>(stage.bounds.y + stage.bounds.h - m_origin_y_);
+        CellRange range;
+        if (ComputeCellRange(stage.bounds, 0.0, range) && (range.max_x - range.min_x + 1) * (range.max_y - range.min_y + 1) <= kMaxCellsPerElement) {
+            m_entry_cells_[i] = CellSpan {static_cast<uint16_t>(range.min_x), static_cast<uint16_t>(range.min_y), static_cast<uint16_t>(range.max_x),
+                                          static_cast<uint16_t>(range.max_y)};
+        }
+    }
+
+    // Pass 2: count records per bucket (CSR offsets), one extra slot for the oversized bucket
+    const size_t bucket_count = m_cell_count_ + 1;
+    m_segment_bucket_start_.assign(bucket_count + 1, 0);
+    m_pad_bucket_start_.assign(bucket_count + 1, 0);
+    m_generic_bucket_start_.assign(bucket_count + 1, 0);
+
+    auto bucket_starts_for = [this](PackedKind kind) -> std::vector<uint32_t>& {
+        if (kind == PackedKind::kSegment)
+            return m_segment_bucket_start_;
+        if (kind == PackedKind::kPad)
+            return m_pad_bucket_start_;
+        return m_generic_bucket_start_;
+    };
+
+    // Calls fn(bucket) for every bucket an element's bounds fall into
+    auto for_each_bucket = [this](const BLRect& bounds, auto&& fn) {
+        CellRange range;
+        if (!ComputeCellRange(bounds, 0.0, range)) {
+            fn(m_cell_count_);
+            return;
+        }
+        const int span = (range.max_x - range.min_x + 1) * (range.max_y - range.min_y + 1);
+        if (span > kMaxCellsPerElement) {
+            fn(m_cell_count_);
+            return;
+        }
+        for (int cy = range.min_y; cy <= range.max_y; ++cy) {
+            for (int cx = range.min_x; cx <= range.max_x; ++cx) {
+                fn(static_cast<size_t>(cy) * static_cast<size_t>(m_cells_x_) + static_cast<size_t>(cx));
+            }
+        }
+    };
+
+    for (const Staged& stage : staged) {
+        if (stage.kind == PackedKind::kNone) {
+            continue;
+        }
+        std::vector<uint32_t>& starts = bucket_starts_for(stage.kind);
+        for_each_bucket(stage.bounds, [&starts](size_t bucket) { ++starts[bucket + 1]; });
+    }
+
+    for (std::vector<uint32_t>* starts : {&m_segment_bucket_start_, &m_pad_bucket_start_, &m_generic_bucket_start_}) {
+        for (size_t b = 1; b < starts->size(); ++b) {
+            (*starts)[b] += (*starts)[b - 1];
+        }
+    }
+
+    const size_t segment_total = m_segment_bucket_start_.back();
+    m_segment_x1_.resize(segment_total);
+    m_segment_y1_.resize(segment_total);
+    m_segment_x2_.resize(segment_total);
+    m_segment_y2_.resize(segment_total);
+    m_segment_radius_.resize(segment_total);
+    m_segment_rank_.resize(segment_total);
+
+    const size_t pad_total = m_pad_bucket_start_.back();
+    m_pad_cx_.resize(pad_total);
+    m_pad_cy_.resize(pad_total);
+    m_pad_cos_.resize(pad_total);
+    m_pad_sin_.resize(pad_total);
+    m_pad_half_w_.resize(pad_total);
+    m_pad_half_h_.resize(pad_total);
+    m_pad_corner_radius_.resize(pad_total);
+    m_pad_box_mask_.resize(pad_total);
+    m_pad_rank_.resize(pad_total);
+
+    const size_t generic_total = m_generic_bucket_start_.back();
+    m_generic_rank_.resize(generic_total);
+    m_generic_bounds_.resize(generic_total);
+
+    // Pass 3: fill in rank order so every bucket run is sorted by priority
+    std::vector<uint32_t> segment_cursor(m_segment_bucket_start_.begin(), m_segment_bucket_start_.end() - 1);
+    std::vector<uint32_t> pad_cursor(m_pad_bucket_start_.begin(), m_pad_bucket_start_.end() - 1);
+    std::vector<uint32_t> generic_cursor(m_generic_bucket_start_.begin(), m_generic_bucket_start_.end() - 1);
+
+    for (size_t i = 0; i < staged.size(); ++i) {
+        const Staged& stage = staged[i];
+        const auto rank = static_cast<uint32_t>(i);
+        switch (stage.kind) {
+            case PackedKind::kSegment: {
+                const auto* trace = static_cast<const Trace*>(m_entries_[i].element);
+                const auto x1 = static_cast<float>(trace->x1 - m_origin_x_);
+                const auto y1 = static_cast<float>(trace->y1 - m_origin_y_);
+                const auto x2 = static_cast<float>(trace->x2 - m_origin_x_);
+                const auto y2 = static_cast<float>(trace->y2 - m_origin_y_);
+                const auto radius = static_cast<float>(TraceRadius(*trace));
+                for_each_bucket(stage.bounds, [&](size_t bucket) {
+                    const uint32_t slot = segment_cursor[bucket]++;
+                    m_segment_x1_[slot] = x1;
+                    m_segment_y1_[slot] = y1;
+                    m_segment_x2_[slot] = x2;
+                    m_segment_y2_[slot] = y2;
+                    m_segment_radius_[slot] = radius;
+                    m_segment_rank_[slot] = rank;
+                });
+                break;
+            }
+            case PackedKind::kPad: {
+                const PadRecord& pad = stage.pad;
+                for_each_bucket(stage.bounds, [&](size_t bucket) {
+                    const uint32_t slot = pad_cursor[bucket]++;
+                    m_pad_cx_[slot] = static_cast<float>(pad.cx - m_origin_x_);
+                    m_pad_cy_[slot] = static_cast<float>(pad.cy - m_origin_y_);
+                    m_pad_cos_[slot] = static_cast<float>(pad.cos_r);
+                    m_pad_sin_[slot] = static_cast<float>(pad.sin_r);
+                    m_pad_half_w_[slot] = static_cast<float>(pad.half_w);
+                    m_pad_half_h_[slot] = static_cast<float>(pad.half_h);
+                    m_pad_corner_radius_[slot] = static_cast<float>(pad.corner_radius);
+                    m_pad_box_mask_[slot] = pad.is_box ? 0xFFFFFFFFu : 0u;
+                    m_pad_rank_[slot] = rank;
+                });
+                break;
+            }
+            case PackedKind::kGeneric:
+                for_each_bucket(stage.bounds, [&](size_t bucket) {
+                    const uint32_t slot = generic_cursor[bucket]++;
+                    m_generic_rank_[slot] = rank;
+                    m_generic_bounds_[slot] = stage.bounds;
+                });
+                break;
+            case PackedKind::kNone:
+                break;
+        }
+    }
+}
+
+bool HitTestIndex::ComputeCellRange(const BLRect& bounds, double margin, CellRange& range) const
+{
+    if (m_cell_count_ == 0) {
+        return false;
+    }
+    const double grid_w = m_cells_x_ * m_cell_size_;
+    const double grid_h = m_cells_y_ * m_cell_size_;
+    const double local_min_x = bounds.x - margin - m_origin_x_;
+    const double local_min_y = bounds.y - margin - m_origin_y_;
+    const double local_max_x = bounds.x + bounds.w + margin - m_origin_x_;
+    const double local_max_y = bounds.y + bounds.h + margin - m_origin_y_;
+    if (local_max_x < 0.0 || local_max_y < 0.0 || local_min_x > grid_w || local_min_y > grid_h) {
+        return false;
+    }
+
+    range.min_x = std::clamp(static_cast<int>(std::floor(local_min_x * m_inv_cell_size_)), 0, m_cells_x_ - 1);
+    range.min_y = std::clamp(static_cast<int>(std::floor(local_min_y * m_inv_cell_size_)), 0, m_cells_y_ - 1);
+    range.max_x = std::clamp(static_cast<int>(std::floor(local_max_x * m_inv_cell_size_)), 0, m_cells_x_ - 1);
+    range.max_y = std::clamp(static_cast<int>(std::floor(local_max_y * m_inv_cell_size_)), 0, m_cells_y_ - 1);
+    return true;
+}
+
+void HitTestIndex::SyncLayerVisibility(const Board& board)
+{
+    auto is_layer_visible = [&board](int layer_id) { return board.IsLayerIdVisible(layer_id); };
+    for (size_t g = 0; g < m_group_layers_.size(); ++g) {
+        const auto& [primary_layer, secondary_layer] = m_group_layers_[g];
+        const bool visible = is_layer_visible(primary_layer) && (secondary_layer == primary_layer || is_layer_visible(secondary_layer));
+        m_group_visible_[g] = visible ? 1 : 0;
+    }
+}
+
+HitTestIndex::Hit HitTestIndex::MakeHit(uint32_t rank) const
+{
+    const ElementInteractionInfo& info = m_entries_[rank];
+    return Hit {rank, info.element, info.parent_component};
+}
+
+void HitTestIndex::ScanBucket(size_t bucket, float local_x, float local_y, const Vec2& world_pos, float tolerance, uint32_t& best_rank) const
+{
+    // Segments
+    {
+        const size_t begin = m_segment_bucket_start_[bucket];
+        const size_t end = RankLimit(m_segment_rank_, begin, m_segment_bucket_start_[bucket + 1], best_rank);
+        for (size_t i = begin; i < end; ++i) {
+            i = geometry_utils::FindFirstSegmentHit(m_segment_x1_.data(), m_segment_y1_.data(), m_segment_x2_.data(), m_segment_y2_.data(),
+                                                    m_segment_radius_.data(), i, end, local_x, local_y, tolerance);
+            if (i < end && IsRankVisible(m_segment_rank_[i])) {
+                best_rank = m_segment_rank_[i];
+                break;
+            }
+        }
+    }
+
+    // Pads
+    {
+        const size_t begin = m_pad_bucket_start_[bucket];
+        const size_t end = RankLimit(m_pad_rank_, begin, m_pad_bucket_start_[bucket + 1], best_rank);
+        for (size_t i = begin; i < end; ++i) {
+            i = geometry_utils::FindFirstPadHit(m_pad_cx_.data(), m_pad_cy_.data(), m_pad_cos_.data(), m_pad_sin_.data(), m_pad_half_w_.data(),
+                                                m_pad_half_h_.data(), m_pad_corner_radius_.data(), m_pad_box_mask_.data(), i, end, local_x, local_y, tolerance);
+            if (i < end && IsRankVisible(m_pad_rank_[i])) {
+                best_rank = m_pad_rank_[i];
+                break;
+            }
+        }
+    }
+
+    // Generic fallback
+    const size_t begin = m_generic_bucket_start_[bucket];
+    const size_t end = RankLimit(m_generic_rank_, begin, m_generic_bucket_start_[bucket + 1], best_rank);
+    for (size_t i = begin; i < end; ++i) {
+        const BLRect& bounds = m_generic_bounds_[i];
+        if (world_pos.x_ax < bounds.x - tolerance || world_pos.x_ax > bounds.x + bounds.w + tolerance || world_pos.y_ax < bounds.y - tolerance ||
+            world_pos.y_ax > bounds.y + bounds.h + tolerance || !IsRankVisible(m_generic_rank_[i])) {
+            continue;
+        }
+        const ElementInteractionInfo& info = m_entries_[m_generic_rank_[i]];
+        if (info.element->IsHit(world_pos, tolerance, info.parent_component)) {
+            best_rank = m_generic_rank_[i];
+            return;
+        }
+    }
+}
+
+bool HitTestIndex::FindBestHit(const Vec2& world_pos, float tolerance, Hit& out_hit) const
+{
+    if (m_cell_count_ == 0) {
+        return false;
+    }
+
+    const auto local_x = static_cast<float>(world_pos.x_ax - m_origin_x_);
+    const auto local_y = static_cast<float>(world_pos.y_ax - m_origin_y_);
+    uint32_t best_rank = kNoRank;
+
+    ScanBucket(m_cell_count_, local_x, local_y, world_pos, tolerance, best_rank);
+
+    CellRange range;
+    if (ComputeCellRange(BLRect(world_pos.x_ax, world_pos.y_ax, 0.0, 0.0), tolerance, range)) {
+        for (int cy = range.min_y; cy <= range.max_y && best_rank != 0; ++cy) {
+            for (int cx = range.min_x; cx <= range.max_x && best_rank != 0; ++cx) {
+                ScanBucket(static_cast<size_t>(cy) * static_cast<size_t>(m_cells_x_) + static_cast<size_t>(cx), local_x, local_y, world_pos, tolerance,
+                           best_rank);
+            }
+        }
+    }
+
+    if (best_rank == kNoRank) {
+        return false;
+    }
+    out_hit = MakeHit(best_rank);
+    return true;
+}
+
+void HitTestIndex::InsertSortedUnique(const Hit& hit, Hit* out_hits, size_t capacity, size_t& count)
+{
+    // Small fixed buffer: linear insertion keeps it sorted without allocating
+    size_t pos = count;
+    while (pos > 0 && out_hits[pos - 1].rank > hit.rank) {
+        --pos;
+    }
+    if (pos > 0 && out_hits[pos - 1].rank == hit.rank) {
+        return;  // Element spans several cells
+    }
+    if (pos >= capacity) {
+        return;  // Lower priority than everything kept so far
+    }
+    const size_t last = std::min(count, capacity - 1);
+    for (size_t i = last; i > pos; --i) {
+        out_hits[i] = out_hits[i - 1];
+    }
+    out_hits[pos] = hit;
+    count = std::min(count + 1, capacity);
+}
+
+void HitTestIndex::CollectBucket(size_t bucket, float local_x, float local_y, const Vec2& world_pos, float tolerance, Hit* out_hits, size_t capacity,
+                                 size_t& count) const
+{
+    // Once the buffer is full only hits ranked above the current last entry can still be kept
+    auto limit = [&]() { return count >= capacity ? out_hits[capacity - 1].rank : kNoRank; };
+
+    const size_t segment_end = m_segment_bucket_start_[bucket + 1];
+    for (size_t i = m_segment_bucket_start_[bucket]; i < segment_end; ++i) {
+        const size_t end = RankLimit(m_segment_rank_, i, segment_end, limit());
+        i = geometry_utils::FindFirstSegmentHit(m_segment_x1_.data(), m_segment_y1_.data(), m_segment_x2_.data(), m_segment_y2_.data(),
+                                                m_segment_radius_.data(), i, end, local_x, local_y, tolerance);
+        if (i >= end) {
+            break;
+        }
+        if (IsRankVisible(m_segment_rank_[i])) {
+            InsertSortedUnique(MakeHit(m_segment_rank_[i]), out_hits, capacity, count);
+        }
+    }
+
+    const size_t pad_end = m_pad_bucket_start_[bucket + 1];
+    for (size_t i = m_pad_bucket_start_[bucket]; i < pad_end; ++i) {
+        const size_t end = RankLimit(m_pad_rank_, i, pad_end, limit());
+        i = geometry_utils::FindFirstPadHit(m_pad_cx_.data(), m_pad_cy_.data(), m_pad_cos_.data(), m_pad_sin_.data(), m_pad_half_w_.data(),
+                                            m_pad_half_h_.data(), m_pad_corner_radius_.data(), m_pad_box_mask_.data(), i, end, local_x, local_y, tolerance);
+        if (i >= end) {
+            break;
+        }
+        if (IsRankVisible(m_pad_rank_[i])) {
+            InsertSortedUnique(MakeHit(m_pad_rank_[i]), out_hits, capacity, count);
+        }
+    }
+
+    const size_t generic_end = RankLimit(m_generic_rank_, m_generic_bucket_start_[bucket], m_generic_bucket_start_[bucket + 1], limit());
+    for (size_t i = m_generic_bucket_start_[bucket]; i < generic_end; ++i) {
+        const BLRect& bounds = m_generic_bounds_[i];
+        if (world_pos.x_ax < bounds.x - tolerance || world_pos.x_ax > bounds.x + bounds.w + tolerance || world_pos.y_ax < bounds.y - tolerance ||
+            world_pos.y_ax > bounds.y + bounds.h + tolerance || !IsRankVisible(m_generic_rank_[i])) {
+            continue;
+        }
+        const ElementInteractionInfo& info = m_entries_[m_generic_rank_[i]];
+        if (info.element->IsHit(world_pos, tolerance, info.parent_component)) {
+            InsertSortedUnique(MakeHit(m_generic_rank_[i]), out_hits, capacity, count);
+        }
+    }
+}
+
+size_t HitTestIndex::FindHits(const Vec2& world_pos, float tolerance, Hit* out_hits, size_t capacity) const
+{
+    if (m_cell_count_ == 0 || out_hits == nullptr || capacity == 0) {
+        return 0;
+    }
+
+    const auto local_x = static_cast<float>(world_pos.x_ax - m_origin_x_);
+    const auto local_y = static_cast<float>(world_pos.y_ax - m_origin_y_);
+    size_t count = 0;
+
+    CollectBucket(m_cell_count_, local_x, local_y, world_pos, tolerance, out_hits, capacity, count);
+
+    CellRange range;
+    if (ComputeCellRange(BLRect(world_pos.x_ax, world_pos.y_ax, 0.0, 0.0), tolerance, range)) {
+        for (int cy = range.min_y; cy <= range.max_y; ++cy) {
+            for (int cx = range.min_x; cx <= range.max_x; ++cx) {
+                CollectBucket(static_cast<size_t>(cy) * static_cast<size_t>(m_cells_x_) + static_cast<size_t>(cx), local_x, local_y, world_pos, tolerance,
+                              out_hits, capacity, count);
+            }
+        }
+    }
+    return count;
+}
+
+bool HitTestIndex::IsRankInRect(uint32_t rank, float min_x, float min_y, float max_x, float max_y, RectMode mode) const
+{
+    // NaN bounds (unindexed entries) fail every comparison
+    const bool inside = m_entry_min_x_[rank] >= min_x && m_entry_max_x_[rank] <= max_x && m_entry_min_y_[rank] >= min_y && m_entry_max_y_[rank] <= max_y;
+    if (inside || mode == RectMode::kFullyInside) {
+        return inside;
+    }
+    if (!(m_entry_min_x_[rank] <= max_x && m_entry_max_x_[rank] >= min_x && m_entry_min_y_[rank] <= max_y && m_entry_max_y_[rank] >= min_y)) {
+        return false;
+    }
+
+    // Bounds overlap; a diagonal trace's bounds can touch the rectangle while the trace itself does not
+    const ElementInteractionInfo& info = m_entries_[rank];
+    if (info.element->GetElementType() != ElementType::kTrace) {
+        return true;
+    }
+    const auto* trace = static_cast<const Trace*>(info.element);
+    const double radius = TraceRadius(*trace);
+    return SegmentIntersectsBox(trace->x1 - m_origin_x_, trace->y1 - m_origin_y_, trace->x2 - m_origin_x_, trace->y2 - m_origin_y_, min_x - radius,
+                                min_y - radius, max_x + radius, max_y + radius);
+}
+
+size_t HitTestIndex::FindInRect(const BLRect& world_rect, RectMode mode, std::vector<Hit>& out_hits) const
+{
+    out_hits.clear();
+    if (m_cell_count_ == 0) {
+        return 0;
+    }
+
+    const auto min_x = static_cast<float>(world_rect.x - m_origin_x_);
+    const auto min_y = static_cast<float>(world_rect.y - m_origin_y_);
+    const auto max_x = static_cast<float>(world_rect.x + world_rect.w - m_origin_x_);
+    const auto max_y = static_cast<float>(world_rect.y + world_rect.h - m_origin_y_);
+
+    CellRange range;
+    const bool overlaps_grid = ComputeCellRange(world_rect, 0.0, range);
+    const size_t range_cells = overlaps_grid ? static_cast<size_t>(range.max_x - range.min_x + 1) * static_cast<size_t>(range.max_y - range.min_y + 1) : 0;
+
+    // Performance optimization: Large rectangles touch most buckets anyway; a sequential pass over the per-rank
+    // SoA bounds is cache friendly, needs no de-duplication and already yields priority order.
+    if (static_cast<double>(range_cells) >= static_cast<double>(m_cell_count_) * kLinearRectScanCellFraction) {
+        const auto entry_count = static_cast<uint32_t>(m_entries_.size());
+        for (uint32_t rank = 0; rank < entry_count; ++rank) {
+            if (IsRankVisible(rank) && IsRankInRect(rank, min_x, min_y, max_x, max_y, mode)) {
+                out_hits.push_back(MakeHit(rank));
+            }
+        }
+        return out_hits.size();
+    }
+
+    // Entries spanning several cells are reported only from the first cell of their span inside the query range
+    auto visit_bucket = [&](size_t bucket, int cell_x, int cell_y) {
+        auto visit_ranks = [&](const std::vector<uint32_t>& starts, const std::vector<uint32_t>& ranks) {
+            for (uint32_t i = starts[bucket]; i < starts[bucket + 1]; ++i) {
+                const uint32_t rank = ranks[i];
+                if (cell_x >= 0) {
+                    const CellSpan& span = m_entry_cells_[rank];
+                    if (std::max<int>(span.min_x, range.min_x) != cell_x || std::max<int>(span.min_y, range.min_y) != cell_y) {
+                        continue;
+                    }
+                }
+                if (IsRankVisible(rank) && IsRankInRect(rank, min_x, min_y, max_x, max_y, mode)) {
+                    out_hits.push_back(MakeHit(rank));
+                }
+            }
+        };
+        visit_ranks(m_segment_bucket_start_, m_segment_rank_);
+        visit_ranks(m_pad_bucket_start_, m_pad_rank_);
+        visit_ranks(m_generic_bucket_start_, m_generic_rank_);
+    };
+
+    visit_bucket(m_cell_count_, -1, -1);
+    if (overlaps_grid) {
+        for (int cy = range.min_y; cy <= range.max_y; ++cy) {
+            for (int cx = range.min_x; cx <= range.max_x; ++cx) {
+                visit_bucket(static_cast<size_t>(cy) * static_cast<size_t>(m_cells_x_) + static_cast<size_t>(cx), cx, cy);
+            }
+        }
+    }
+
+    std::sort(out_hits.begin(), out_hits.end(), [](const Hit& a, const Hit& b) { return a.rank < b.rank; });
+    return out_hits.size();
+}
+
+size_t HitTestIndex::GetMemoryUsageBytes() const
+{
+    auto bytes = [](const auto& vec) { return vec.capacity() * sizeof(typename std::decay_t<decltype(vec)>::value_type); };
+    return bytes(m_entries_) + bytes(m_entry_group_) + bytes(m_group_layers_) + bytes(m_group_visible_) + bytes(m_entry_min_x_) + bytes(m_entry_min_y_) +
+           bytes(m_entry_max_x_) + bytes(m_entry_max_y_) + bytes(m_entry_cells_) + bytes(m_segment_bucket_start_) + bytes(m_segment_x1_) + bytes(m_segment_y1_) + bytes(m_segment_x2_) + bytes(m_segment_y2_) +
+           bytes(m_segment_radius_) + bytes(m_segment_rank_) + bytes(m_pad_bucket_start_) + bytes(m_pad_cx_) + bytes(m_pad_cy_) + bytes(m_pad_cos_) +
+           bytes(m_pad_sin_) + bytes(m_pad_half_w_) + bytes(m_pad_half_h_) + bytes(m_pad_corner_radius_) + bytes(m_pad_box_mask_) + bytes(m_pad_rank_) +
+           bytes(m_generic_bucket_start_) + bytes(m_generic_rank_) + bytes(m_generic_bounds_);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pcb/Board.hpp"  // For ElementInteractionInfo
+#include "utils/Vec2.hpp"
+
+// Performance optimization: Packed, allocation-free hit testing for hover and click picking.
+//
+// Built from the priority-sorted list of Board::GetInteractionView(true). An element's
+// position in that list is its rank; lower rank wins. Geometry is packed per uniform-grid cell into SoA float
+// arrays (segments for traces, oriented pads for pins/vias/components) and tested with the SIMD kernels in
+// geometry_utils. Every cell run stays sorted by rank, so a query can stop at the first hit of each run and
+// skip anything ranked below the best hit found so far. Arcs and other shapes without a packed kernel fall
+// back to Element::IsHit after an AABB test. Text labels never report hits and are not indexed.
+//
+// Every record belongs to a layer visibility group: its own layer, or for pins and labels the pair
+// (parent component layer, own layer). Hidden layers are masked per group at query time, so a layer
+// toggle is SyncLayerVisibility() over a handful of groups instead of an O(board) rebuild.
+//
+// Point queries touch only pre-sized arrays and never allocate. Rectangle queries (box selection) reuse the same
+// grid, or a linear pass over per-rank bounds when the rectangle covers most of the board.
+class HitTestIndex
+{
+public:
+    struct Hit {
+        uint32_t rank = 0;  // Position in the interaction list; lower = higher priority
+        const Element* element = nullptr;
+        const Component* parent_component = nullptr;
+    };
+
+    // Box selection semantics
+    enum class RectMode : uint8_t {
+        kFullyInside,  // Element bounds entirely inside the rectangle
+        kTouching      // Element touches the rectangle (traces by centerline, everything else by bounds)
+    };
+
+    HitTestIndex() = default;
+
+    // entries must already be in interaction priority order
+    void Build(const std::vector<ElementInteractionInfo>& entries);
+    void Clear();
+
+    [[nodiscard]] bool IsEmpty() const { return m_entries_.empty(); }
+    [[nodiscard]] size_t GetEntryCount() const { return m_entries_.size(); }
+    [[nodiscard]] const std::vector<ElementInteractionInfo>& GetEntries() const { return m_entries_; }
+
+    // Re-reads layer visibility from the board and updates the group mask. Layers the board does not know are hidden,
+    // matching Board::GetAllVisibleElementsForInteraction(). Cost is O(groups), independent of the element count.
+    void SyncLayerVisibility(const Board& board);
+    [[nodiscard]] size_t GetLayerGroupCount() const { return m_group_layers_.size(); }
+
+    // Highest-priority element under world_pos. Returns false if nothing is hit.
+    bool FindBestHit(const Vec2& world_pos, float tolerance, Hit& out_hit) const;
+
+    // Every element under world_pos, sorted by priority and de-duplicated, written to caller storage.
+    // Returns the number written (at most capacity; lowest-priority hits are dropped first).
+    size_t FindHits(const Vec2& world_pos, float tolerance, Hit* out_hits, size_t capacity) const;
+
+    // Every visible element selected by world_rect, sorted by priority. out_hits is cleared first and keeps its
+    // capacity, so callers that reuse it do not reallocate. Returns the number of hits.
+    size_t FindInRect(const BLRect& world_rect, RectMode mode, std::vector<Hit>& out_hits) const;
+
+    // Memory footprint of the packed arrays, for diagnostics
+    [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+private:
+    // Uniform grid over the board; bucket index m_cell_count_ is the "oversized" bucket tested by every query
+    struct CellRange {
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+    };
+
+    enum class PackedKind : uint8_t {
+        kNone,
+        kSegment,
+        kPad,
+        kGeneric
+    };
+
+    // Grid cells an entry was bucketed into; min_x == kOversizedSpan marks the oversized bucket
+    struct CellSpan {
+        uint16_t min_x = 0;
+        uint16_t min_y = 0;
+        uint16_t max_x = 0;
+        uint16_t max_y = 0;
+    };
+    static constexpr uint16_t kOversizedSpan = 0xFFFF;
+
+    // Cells overlapped by bounds grown by margin, clamped to the grid. False if entirely outside.
+    bool ComputeCellRange(const BLRect& bounds, double margin, CellRange& range) const;
+    Hit MakeHit(uint32_t rank) const;
+    [[nodiscard]] bool IsRankVisible(uint32_t rank) const { return m_group_visible_[m_entry_group_[rank]] != 0; }
+
+    // Scans one bucket and lowers best_rank to the first hit ranked above it
+    void ScanBucket(size_t bucket, float local_x, float local_y, const Vec2& world_pos, float tolerance, uint32_t& best_rank) const;
+    // Collects hits in one bucket into a sorted fixed-capacity buffer
+    void CollectBucket(size_t bucket, float local_x, float local_y, const Vec2& world_pos, float tolerance,
+                       Hit* out_hits, size_t capacity, size_t& count) const;
+    static void InsertSortedUnique(const Hit& hit, Hit* out_hits, size_t capacity, size_t& count);
+    // Rectangle test for one entry; rect coordinates are local (relative to the grid origin)
+    bool IsRankInRect(uint32_t rank, float min_x, float min_y, float max_x, float max_y, RectMode mode) const;
+
+    std::vector<ElementInteractionInfo> m_entries_;
+
+    // Layer visibility groups: group id per rank, (primary, secondary) layer ids per group, and the query mask
+    std::vector<uint32_t> m_entry_group_;
+    std::vector<std::pair<int, int>> m_group_layers_;
+    std::vector<uint8_t> m_group_visible_;
+
+    // Per-rank local bounds (SoA, NaN for entries that are not indexed) and bucket spans, for rectangle queries
+    std::vector<float> m_entry_min_x_;
+    std::vector<float> m_entry_min_y_;
+    std::vector<float> m_entry_max_x_;
+    std::vector<float> m_entry_max_y_;
+    std::vector<CellSpan> m_entry_cells_;
+
+    // Grid parameters; packed coordinates are relative to (m_origin_x_, m_origin_y_) to keep float precision
+    double m_origin_x_ = 0.0;
+    double m_origin_y_ = 0.0;
+    double m_cell_size_ = 1.0;
+    double m_inv_cell_size_ = 1.0;
+    int m_cells_x_ = 0;
+    int m_cells_y_ = 0;
+    size_t m_cell_count_ = 0;
+
+    // Segments (traces), CSR by bucket
+    std::vector<uint32_t> m_segment_bucket_start_;
+    std::vector<float> m_segment_x1_;
+    std::vector<float> m_segment_y1_;
+    std::vector<float> m_segment_x2_;
+    std::vector<float> m_segment_y2_;
+    std::vector<float> m_segment_radius_;
+    std::vector<uint32_t> m_segment_rank_;
+
+    // Oriented pads (pins, vias, component bodies), CSR by bucket
+    std::vector<uint32_t> m_pad_bucket_start_;
+    std::vector<float> m_pad_cx_;
+    std::vector<float> m_pad_cy_;
+    std::vector<float> m_pad_cos_;
+    std::vector<float> m_pad_sin_;
+    std::vector<float> m_pad_half_w_;
+    std::vector<float> m_pad_half_h_;
+    std::vector<float> m_pad_corner_radius_;
+    std::vector<uint32_t> m_pad_box_mask_;
+    std::vector<uint32_t> m_pad_rank_;
+
+    // Everything else (arcs, unknown types): AABB prefilter + virtual IsHit, CSR by bucket
+    std::vector<uint32_t> m_generic_bucket_start_;
+    std::vector<uint32_t> m_generic_rank_;
+    std::vector<BLRect> m_generic_bounds_;  // Indexed by position in m_generic_rank_
+};
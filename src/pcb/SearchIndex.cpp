@@ -0,0 +1,585 @@
+#include "pcb/SearchIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <iostream>
+
+#include "pcb/Board.hpp"
+#include "pcb/elements/Component.hpp"
+#include "pcb/elements/Pin.hpp"
+#include "pcb/elements/TextLabel.hpp"
+
+namespace
+{
+// Upper bound on candidates each pass scores, so one-letter prefixes or very common trigrams stay fast.
+// Prefix candidates are visited in lexicographic order, which keeps the shortest completions.
+constexpr size_t kMaxCandidatesPerPass = 65536;
+
+// Fuzzy matching evaluates at most this many edit distances, best trigram overlap first
+constexpr size_t kMaxFuzzyCandidates = 32768;
+
+// Longest query the fuzzy pass accepts; edit distance rows live on the stack
+constexpr size_t kMaxFuzzyQueryLength = 48;
+
+// Score tiers; each match type lives in [tier, tier + 1)
+constexpr float kExactTier = 0.0f;
+constexpr float kPrefixTier = 1.0f;
+constexpr float kWordStartTier = 1.5f;  // Substring that starts a word ("s5" in "pp3v3_s5")
+constexpr float kSubstringTier = 2.0f;
+constexpr float kFuzzyTier = 3.0f;
+
+inline char ToLowerAscii(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+inline uint32_t PackTrigram(const char* p)
+{
+    return (static_cast<uint32_t>(static_cast<unsigned char>(p[0])) << 16) | (static_cast<uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(p[2]));
+}
+
+// Distinct trigrams of text, sorted ascending, appended to out (cleared first)
+void CollectTrigrams(std::string_view text, std::vector<uint32_t>& out)
+{
+    out.clear();
+    if (text.size() < 3) {
+        return;
+    }
+    for (size_t i = 0; i + 3 <= text.size(); ++i) {
+        out.push_back(PackTrigram(text.data() + i));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// Small tie-breaks inside a tier: shorter texts first, then kinds in declaration order
+inline float TieBreak(size_t extra_chars, SearchIndex::EntryKind kind)
+{
+    return static_cast<float>(std::min<size_t>(extra_chars, 255)) / 512.0f + static_cast<float>(kind) / 4096.0f;
+}
+
+// Optimal string alignment distance (edits plus adjacent transpositions), or max_distance + 1 once it is exceeded
+size_t BoundedEditDistance(std::string_view a, std::string_view b, size_t max_distance)
+{
+    constexpr size_t kRowSize = kMaxFuzzyQueryLength + 8;
+    if (a.size() >= kRowSize || b.size() >= kRowSize) {
+        return max_distance + 1;
+    }
+
+    std::array<uint8_t, kRowSize> prev_prev {};
+    std::array<uint8_t, kRowSize> prev {};
+    std::array<uint8_t, kRowSize> current {};
+    for (size_t j = 0; j <= b.size(); ++j) {
+        prev[j] = static_cast<uint8_t>(j);
+    }
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        current[0] = static_cast<uint8_t>(i);
+        uint8_t row_min = current[0];
+        for (size_t j = 1; j <= b.size(); ++j) {
+            const uint8_t cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            uint8_t value = std::min({static_cast<uint8_t>(prev[j] + 1), static_cast<uint8_t>(current[j - 1] + 1), static_cast<uint8_t>(prev[j - 1] + cost)});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                value = std::min(value, static_cast<uint8_t>(prev_prev[j - 2] + 1));
+            }
+            current[j] = value;
+            row_min = std::min(row_min, value);
+        }
+        if (row_min > max_distance) {
+            return max_distance + 1;
+        }
+        prev_prev = prev;
+        prev = current;
+    }
+    return prev[b.size()];
+}
+}  // namespace
+
+std::vector<SearchIndex::Source> SearchIndex::CollectSources(const Board& board)
+{
+    std::vector<Source> sources;
+
+    for (const auto& [layer_id, elements] : board.m_elements_by_layer) {
+        uint32_t element_index = 0;
+        for (const auto& element_ptr : elements) {
+            if (!element_ptr) {
+                continue;
+            }
+            const uint32_t index = element_index++;
+            if (element_ptr->GetElementType() == ElementType::kComponent) {
+                const auto* comp = static_cast<const Component*>(element_ptr.get());
+                const ElementLocation comp_location {layer_id, index, -1};
+                sources.push_back(Source {EntryKind::kComponentRef, {}, comp->reference_designator, comp_location, -1});
+                sources.push_back(Source {EntryKind::kComponentValue, {}, comp->value, comp_location, -1});
+                sources.push_back(Source {EntryKind::kComponentFootprint, {}, comp->footprint_name, comp_location, -1});
+                for (size_t pin_index = 0; pin_index < comp->pins.size(); ++pin_index) {
+                    const Pin* pin = comp->pins[pin_index].get();
+                    if (!pin) {
+                        continue;
+                    }
+                    const ElementLocation pin_location {layer_id, index, static_cast<int32_t>(pin_index)};
+                    sources.push_back(Source {EntryKind::kPin, comp->reference_designator, pin->pin_name, pin_location, pin->GetNetId()});
+                    sources.push_back(Source {EntryKind::kDiodeReading, {}, pin->diode_reading, pin_location, pin->GetNetId()});
+                }
+                for (size_t label_index = 0; label_index < comp->text_labels.size(); ++label_index) {
+                    if (const auto& label_ptr = comp->text_labels[label_index]) {
+                        sources.push_back(Source {EntryKind::kTextLabel, {}, label_ptr->text_content,
+                                                  ElementLocation {layer_id, index, static_cast<int32_t>(label_index)}, label_ptr->GetNetId()});
+                    }
+                }
+            } else if (element_ptr->GetElementType() == ElementType::kTextLabel) {
+                const auto* label = static_cast<const TextLabel*>(element_ptr.get());
+                sources.push_back(Source {EntryKind::kTextLabel, {}, label->text_content, ElementLocation {layer_id, index, -1}, label->GetNetId()});
+            }
+        }
+    }
+
+    for (const auto& [net_id, net] : board.m_nets) {
+        sources.push_back(Source {EntryKind::kNet, {}, net.GetName(), ElementLocation {}, net_id});
+    }
+
+    return sources;
+}
+
+const Element* SearchIndex::ResolveElement(uint32_t entry, const Board& board, const Component** out_parent) const
+{
+    if (out_parent) {
+        *out_parent = nullptr;
+    }
+    const ElementLocation& location = m_locations_[entry];
+    if (location.layer_id < 0) {
+        return nullptr;
+    }
+    const auto layer_it = board.m_elements_by_layer.find(location.layer_id);
+    if (layer_it == board.m_elements_by_layer.end()) {
+        return nullptr;
+    }
+    const auto& elements = layer_it->second;
+
+    // Variants hold no null elements, so element_index is a direct position in them; the loaded board only has
+    // nulls if a loader left some, and those are found by the walk below
+    if (location.element_index < elements.size() && elements[location.element_index]) {
+        if (const Element* element = MatchElement(entry, *elements[location.element_index], out_parent)) {
+            return element;
+        }
+    }
+
+    // Folding drops outline segments, which shifts what follows them; look for the element in the rest of the layer
+    for (const auto& element_ptr : elements) {
+        if (element_ptr) {
+            if (const Element* element = MatchElement(entry, *element_ptr, out_parent)) {
+                return element;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const Element* SearchIndex::MatchElement(uint32_t entry, const Element& candidate, const Component** out_parent) const
+{
+    const std::string_view text = GetText(entry);
+    const int32_t child_index = m_locations_[entry].child_index;
+
+    if (candidate.GetElementType() == ElementType::kTextLabel) {
+        const auto& label = static_cast<const TextLabel&>(candidate);
+        return m_kinds_[entry] == EntryKind::kTextLabel && child_index < 0 && label.text_content == text ? &label : nullptr;
+    }
+    if (candidate.GetElementType() != ElementType::kComponent) {
+        return nullptr;
+    }
+
+    const auto& comp = static_cast<const Component&>(candidate);
+    const Element* element = nullptr;
+    switch (m_kinds_[entry]) {
+        case EntryKind::kComponentRef:
+            return comp.reference_designator == text ? &comp : nullptr;
+        case EntryKind::kComponentValue:
+            return comp.value == text ? &comp : nullptr;
+        case EntryKind::kComponentFootprint:
+            return comp.footprint_name == text ? &comp : nullptr;
+        case EntryKind::kPin:
+        case EntryKind::kDiodeReading: {
+            if (child_index < 0 || static_cast<size_t>(child_index) >= comp.pins.size() || !comp.pins[child_index]) {
+                return nullptr;
+            }
+            const Pin& pin = *comp.pins[child_index];
+            if (m_kinds_[entry] == EntryKind::kDiodeReading) {
+                element = pin.diode_reading == text ? &pin : nullptr;
+            } else {
+                // "REF.PIN", or just the pin name for a component without reference designator
+                const std::string_view ref = comp.reference_designator;
+                const std::string_view pin_name = pin.pin_name;
+                const bool matches = ref.empty() ? pin_name == text
+                                                 : text.size() == ref.size() + 1 + pin_name.size() && text.compare(0, ref.size(), ref) == 0 &&
+                                                       text[ref.size()] == '.' && text.substr(ref.size() + 1) == pin_name;
+                element = matches ? &pin : nullptr;
+            }
+            break;
+        }
+        case EntryKind::kTextLabel:
+            if (child_index < 0 || static_cast<size_t>(child_index) >= comp.text_labels.size() || !comp.text_labels[child_index]) {
+                return nullptr;
+            }
+            element = comp.text_labels[child_index]->text_content == text ? comp.text_labels[child_index].get() : nullptr;
+            break;
+        case EntryKind::kNet:
+            return nullptr;
+    }
+    if (element && out_parent) {
+        *out_parent = &comp;
+    }
+    return element;
+}
+
+void SearchIndex::Build(const std::vector<Source>& sources, const std::atomic<bool>* cancelled)
+{
+    const auto is_cancelled = [cancelled]() { return cancelled && cancelled->load(std::memory_order_relaxed); };
+
+    Clear();
+
+    size_t text_bytes = 0;
+    size_t entry_count = 0;
+    for (const Source& source : sources) {
+        if (!source.text.empty()) {
+            text_bytes += source.text.size() + (source.prefix.empty() ? 0 : source.prefix.size() + 1);
+            entry_count++;
+        }
+    }
+    if (text_bytes > UINT32_MAX || entry_count > UINT32_MAX) {
+        std::cerr << "SearchIndex: Board text exceeds index limits, search disabled" << std::endl;
+        return;
+    }
+
+    m_text_.reserve(text_bytes);
+    m_text_offsets_.reserve(entry_count + 1);
+    m_kinds_.reserve(entry_count);
+    m_locations_.reserve(entry_count);
+    m_net_ids_.reserve(entry_count);
+
+    m_text_offsets_.push_back(0);
+    for (const Source& source : sources) {
+        if (source.text.empty()) {
+            continue;
+        }
+        if (!source.prefix.empty()) {
+            m_text_.append(source.prefix);
+            m_text_.push_back('.');
+        }
+        m_text_.append(source.text);
+        m_text_offsets_.push_back(static_cast<uint32_t>(m_text_.size()));
+        m_kinds_.push_back(source.kind);
+        m_locations_.push_back(source.location);
+        m_net_ids_.push_back(source.net_id);
+    }
+    m_lower_text_.resize(m_text_.size());
+    std::transform(m_text_.begin(), m_text_.end(), m_lower_text_.begin(), ToLowerAscii);
+
+    if (is_cancelled()) {
+        Clear();
+        return;
+    }
+
+    // Prefix order
+    m_sorted_entries_.resize(entry_count);
+    for (size_t i = 0; i < entry_count; ++i) {
+        m_sorted_entries_[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(m_sorted_entries_.begin(), m_sorted_entries_.end(), [this](uint32_t a, uint32_t b) {
+        const std::string_view text_a = GetLowerText(a);
+        const std::string_view text_b = GetLowerText(b);
+        return text_a != text_b ? text_a < text_b : a < b;
+    });
+
+    if (is_cancelled()) {
+        Clear();
+        return;
+    }
+
+    // Trigram postings: sort (trigram, entry) pairs, then compress into CSR. Entries were appended in
+    // ascending order, so every posting list comes out sorted.
+    std::vector<uint64_t> pairs;
+    pairs.reserve(m_lower_text_.size());
+    std::vector<uint32_t> trigrams;
+    for (size_t entry = 0; entry < entry_count; ++entry) {
+        CollectTrigrams(GetLowerText(static_cast<uint32_t>(entry)), trigrams);
+        for (uint32_t trigram : trigrams) {
+            pairs.push_back((static_cast<uint64_t>(trigram) << 32) | entry);
+        }
+    }
+    if (is_cancelled()) {
+        Clear();
+        return;
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    m_postings_.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        const auto trigram = static_cast<uint32_t>(pairs[i] >> 32);
+        if (m_trigram_keys_.empty() || m_trigram_keys_.back() != trigram) {
+            m_trigram_keys_.push_back(trigram);
+            m_trigram_offsets_.push_back(static_cast<uint32_t>(i));
+        }
+        m_postings_[i] = static_cast<uint32_t>(pairs[i]);
+    }
+    m_trigram_offsets_.push_back(static_cast<uint32_t>(m_postings_.size()));
+}
+
+void SearchIndex::Clear()
+{
+    m_lower_text_.clear();
+    m_text_.clear();
+    m_text_offsets_.clear();
+    m_kinds_.clear();
+    m_locations_.clear();
+    m_net_ids_.clear();
+    m_sorted_entries_.clear();
+    m_trigram_keys_.clear();
+    m_trigram_offsets_.clear();
+    m_postings_.clear();
+    m_fuzzy_counts_.clear();
+    m_fuzzy_touched_.clear();
+}
+
+void SearchIndex::Search(std::string_view query, QueryMode mode, size_t max_results, std::vector<Result>& out_results) const
+{
+    out_results.clear();
+
+    while (!query.empty() && std::isspace(static_cast<unsigned char>(query.front()))) {
+        query.remove_prefix(1);
+    }
+    while (!query.empty() && std::isspace(static_cast<unsigned char>(query.back()))) {
+        query.remove_suffix(1);
+    }
+    if (IsEmpty() || query.empty() || max_results == 0) {
+        return;
+    }
+
+    std::string lower_query(query);
+    std::transform(lower_query.begin(), lower_query.end(), lower_query.begin(), ToLowerAscii);
+
+    if (mode != QueryMode::kFuzzy) {
+        SearchPrefix(lower_query, out_results);
+    }
+    if ((mode == QueryMode::kAll || mode == QueryMode::kSubstring) && lower_query.size() >= 3) {
+        SearchSubstring(lower_query, true, out_results);
+    }
+    if ((mode == QueryMode::kFuzzy || (mode == QueryMode::kAll && out_results.size() < max_results)) && lower_query.size() >= 3) {
+        SearchFuzzy(lower_query, mode == QueryMode::kAll, out_results);
+    }
+
+    const size_t keep = std::min(max_results, out_results.size());
+    std::partial_sort(out_results.begin(), out_results.begin() + static_cast<std::ptrdiff_t>(keep), out_results.end(), [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score < b.score : a.entry < b.entry;
+    });
+    out_results.resize(keep);
+}
+
+void SearchIndex::SearchPrefix(std::string_view query, std::vector<Result>& out_results) const
+{
+    auto it = std::lower_bound(m_sorted_entries_.begin(), m_sorted_entries_.end(), query, [this](uint32_t entry, std::string_view value) {
+        return GetLowerText(entry) < value;
+    });
+
+    for (size_t visited = 0; it != m_sorted_entries_.end() && visited < kMaxCandidatesPerPass; ++it, ++visited) {
+        const std::string_view text = GetLowerText(*it);
+        if (text.compare(0, query.size(), query) != 0) {
+            break;
+        }
+        const bool exact = text.size() == query.size();
+        out_results.push_back(Result {*it, exact ? MatchType::kExact : MatchType::kPrefix,
+                                      (exact ? kExactTier : kPrefixTier) + TieBreak(text.size() - query.size(), m_kinds_[*it])});
+    }
+}
+
+void SearchIndex::SearchSubstring(std::string_view query, bool skip_prefix_matches, std::vector<Result>& out_results) const
+{
+    std::vector<uint32_t> trigrams;
+    CollectTrigrams(query, trigrams);
+
+    // Every trigram must occur; intersect the rarest lists first and verify the survivors against the text
+    struct PostingList {
+        const uint32_t* begin;
+        const uint32_t* end;
+    };
+    std::vector<PostingList> lists;
+    lists.reserve(trigrams.size());
+    for (uint32_t trigram : trigrams) {
+        size_t count = 0;
+        const uint32_t* postings = FindPostings(trigram, count);
+        if (count == 0) {
+            return;
+        }
+        lists.push_back(PostingList {postings, postings + count});
+    }
+    std::sort(lists.begin(), lists.end(), [](const PostingList& a, const PostingList& b) { return (a.end - a.begin) < (b.end - b.begin); });
+
+    // Beyond three lists the text verification is cheaper than more intersection
+    const size_t filter_lists = std::min<size_t>(lists.size(), 3);
+    std::array<const uint32_t*, 3> cursors {};
+    for (size_t i = 1; i < filter_lists; ++i) {
+        cursors[i] = lists[i].begin;
+    }
+
+    size_t verified = 0;
+    for (const uint32_t* p = lists[0].begin; p != lists[0].end && verified < kMaxCandidatesPerPass; ++p) {
+        const uint32_t entry = *p;
+        bool in_all = true;
+        for (size_t i = 1; i < filter_lists && in_all; ++i) {
+            cursors[i] = std::lower_bound(cursors[i], lists[i].end, entry);
+            in_all = cursors[i] != lists[i].end && *cursors[i] == entry;
+        }
+        if (!in_all) {
+            continue;
+        }
+
+        ++verified;
+        const std::string_view text = GetLowerText(entry);
+        const size_t pos = text.find(query);
+        if (pos == std::string_view::npos || (skip_prefix_matches && pos == 0)) {
+            continue;
+        }
+        const bool word_start = pos == 0 || !std::isalnum(static_cast<unsigned char>(text[pos - 1]));
+        out_results.push_back(Result {entry, pos == 0 ? MatchType::kPrefix : MatchType::kSubstring,
+                                      (pos == 0 ? kPrefixTier : (word_start ? kWordStartTier : kSubstringTier)) + TieBreak(text.size() - query.size(), m_kinds_[entry])});
+    }
+}
+
+void SearchIndex::SearchFuzzy(std::string_view query, bool skip_substring_matches, std::vector<Result>& out_results) const
+{
+    if (query.size() > kMaxFuzzyQueryLength) {
+        return;
+    }
+    const size_t max_distance = query.size() <= 4 ? 1 : (query.size() <= 8 ? 2 : 3);
+
+    std::vector<uint32_t> trigrams;
+    CollectTrigrams(query, trigrams);
+    if (trigrams.empty()) {
+        return;
+    }
+
+    // Count shared trigrams per entry; only entries sharing at least one are candidates
+    if (m_fuzzy_counts_.size() != GetEntryCount()) {
+        m_fuzzy_counts_.assign(GetEntryCount(), 0);
+    }
+    m_fuzzy_touched_.clear();
+    for (uint32_t trigram : trigrams) {
+        size_t count = 0;
+        const uint32_t* postings = FindPostings(trigram, count);
+        for (size_t i = 0; i < count; ++i) {
+            if (m_fuzzy_counts_[postings[i]]++ == 0) {
+                m_fuzzy_touched_.push_back(postings[i]);
+            }
+        }
+    }
+
+    // Visit candidates by descending overlap so the evaluation budget goes to the most promising ones.
+    // An edit touches at most three trigrams, so fewer shared trigrams than that rules a candidate out.
+    const size_t max_count = trigrams.size();
+    const size_t min_count = max_count > 3 * max_distance ? max_count - 3 * max_distance : 1;
+    std::vector<size_t> level_start(max_count + 2, 0);
+    for (uint32_t entry : m_fuzzy_touched_) {
+        level_start[max_count - m_fuzzy_counts_[entry] + 1]++;
+    }
+    for (size_t level = 1; level < level_start.size(); ++level) {
+        level_start[level] += level_start[level - 1];
+    }
+    std::vector<uint32_t> ordered(m_fuzzy_touched_.size());
+    for (uint32_t entry : m_fuzzy_touched_) {
+        ordered[level_start[max_count - m_fuzzy_counts_[entry]]++] = entry;
+    }
+
+    size_t evaluated = 0;
+    for (uint32_t entry : ordered) {
+        if (m_fuzzy_counts_[entry] < min_count || evaluated >= kMaxFuzzyCandidates) {
+            break;
+        }
+        const std::string_view text = GetLowerText(entry);
+        const size_t length_difference = text.size() > query.size() ? text.size() - query.size() : query.size() - text.size();
+        if (length_difference > max_distance) {
+            continue;
+        }
+        if (skip_substring_matches && text.find(query) != std::string_view::npos) {
+            continue;
+        }
+        ++evaluated;
+        const size_t distance = BoundedEditDistance(query, text, max_distance);
+        if (distance <= max_distance) {
+            out_results.push_back(Result {entry, MatchType::kFuzzy,
+                                          kFuzzyTier + static_cast<float>(distance) / static_cast<float>(max_distance + 1) +
+                                              TieBreak(length_difference, m_kinds_[entry])});
+        }
+    }
+
+    // Leave the scratch zeroed for the next query
+    for (uint32_t entry : m_fuzzy_touched_) {
+        m_fuzzy_counts_[entry] = 0;
+    }
+}
+
+const uint32_t* SearchIndex::FindPostings(uint32_t trigram, size_t& out_count) const
+{
+    const auto it = std::lower_bound(m_trigram_keys_.begin(), m_trigram_keys_.end(), trigram);
+    if (it == m_trigram_keys_.end() || *it != trigram) {
+        out_count = 0;
+        return nullptr;
+    }
+    const size_t key_index = static_cast<size_t>(it - m_trigram_keys_.begin());
+    out_count = m_trigram_offsets_[key_index + 1] - m_trigram_offsets_[key_index];
+    return m_postings_.data() + m_trigram_offsets_[key_index];
+}
+
+std::string_view SearchIndex::GetText(uint32_t entry) const
+{
+    return std::string_view(m_text_).substr(m_text_offsets_[entry], m_text_offsets_[entry + 1] - m_text_offsets_[entry]);
+}
+
+std::string_view SearchIndex::GetLowerText(uint32_t entry) const
+{
+    return std::string_view(m_lower_text_).substr(m_text_offsets_[entry], m_text_offsets_[entry + 1] - m_text_offsets_[entry]);
+}
+
+const char* SearchIndex::EntryKindToString(EntryKind kind)
+{
+    switch (kind) {
+        case EntryKind::kComponentRef:
+            return "Component";
+        case EntryKind::kNet:
+            return "Net";
+        case EntryKind::kPin:
+            return "Pin";
+        case EntryKind::kComponentValue:
+            return "Value";
+        case EntryKind::kComponentFootprint:
+            return "Footprint";
+        case EntryKind::kTextLabel:
+            return "Label";
+        case EntryKind::kDiodeReading:
+            return "Diode Reading";
+    }
+    return "Unknown";
+}
+
+const char* SearchIndex::MatchTypeToString(MatchType match)
+{
+    switch (match) {
+        case MatchType::kExact:
+            return "Exact";
+        case MatchType::kPrefix:
+            return "Prefix";
+        case MatchType::kSubstring:
+            return "Substring";
+        case MatchType::kFuzzy:
+            return "Fuzzy";
+    }
+    return "Unknown";
+}
+
+size_t SearchIndex::GetMemoryUsageBytes() const
+{
+    return m_lower_text_.capacity() + m_text_.capacity() + m_text_offsets_.capacity() * sizeof(uint32_t) + m_kinds_.capacity() * sizeof(EntryKind) +
+           m_locations_.capacity() * sizeof(ElementLocation) + m_net_ids_.capacity() * sizeof(int) +
+           m_sorted_entries_.capacity() * sizeof(uint32_t) + m_trigram_keys_.capacity() * sizeof(uint32_t) + m_trigram_offsets_.capacity() * sizeof(uint32_t) +
+           m_postings_.capacity() * sizeof(uint32_t) + m_fuzzy_counts_.capacity() * sizeof(uint16_t) + m_fuzzy_touched_.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward declarations
+class Board;
+class Component;
+class Element;
+
+// Performance optimization: In-memory full-text index over the searchable strings of a board.
+//
+// Covers component reference designators, values and footprints, net names, pins ("REF.PIN"), text labels and
+// pin diode readings. All text is stored lowercase in one contiguous blob next to an original-case copy with the
+// same offsets. Three query paths share it:
+//   - prefix:    binary search over entries sorted by text
+//   - substring: trigram posting lists (CSR), intersected rarest-first and verified against the blob
+//   - fuzzy:     trigram overlap selects candidates, a bounded edit distance ranks them
+// Results are ranked exact > prefix > word-start substring > substring > fuzzy, then by length and kind.
+//
+// Building happens in two steps so the expensive part can run off the UI thread: CollectSources() walks the board
+// on the owning thread and only records string views, Build() copies, sorts and indexes them anywhere. Indexed
+// strings are never modified by geometry operations (folding, mirroring), so the views stay valid while a build
+// runs as long as the board itself is kept alive.
+//
+// Entries do not hold element pointers but the element's location in the board (layer, position in the layer,
+// pin or label position in the component). Geometry variants copy the layers in order, so one index built from the
+// loaded board serves every folded or flipped variant of it; ResolveElement() finds an entry's element in whichever
+// variant is on screen.
+class SearchIndex
+{
+public:
+    // Declaration order is also the ranking tie-break: earlier kinds are listed first
+    enum class EntryKind : uint8_t {
+        kComponentRef,
+        kNet,
+        kPin,
+        kComponentValue,
+        kComponentFootprint,
+        kTextLabel,
+        kDiodeReading,
+    };
+
+    enum class MatchType : uint8_t {
+        kExact,
+        kPrefix,
+        kSubstring,
+        kFuzzy,
+    };
+
+    enum class QueryMode : uint8_t {
+        kAll,        // Exact, prefix and substring matches, topped up with fuzzy matches
+        kPrefix,
+        kSubstring,  // Includes prefix matches, since every prefix is also a substring
+        kFuzzy,
+    };
+
+    // Where an entry's element lives. element_index counts only the non-null elements of the layer, matching the
+    // copies of a geometry variant.
+    struct ElementLocation {
+        int layer_id = -1;  // -1 for nets
+        uint32_t element_index = 0;
+        int32_t child_index = -1;  // Pin (kPin, kDiodeReading) or label (kTextLabel) inside a component, else -1
+    };
+
+    // One searchable string. Views point into the Board; text is prefixed with "prefix." when prefix is not empty.
+    struct Source {
+        EntryKind kind = EntryKind::kComponentRef;
+        std::string_view prefix;
+        std::string_view text;
+        ElementLocation location;
+        int net_id = -1;
+    };
+
+    struct Result {
+        uint32_t entry = 0;
+        MatchType match = MatchType::kExact;
+        float score = 0.0f;  // Lower is better
+    };
+
+    SearchIndex() = default;
+
+    // Gathers every searchable string of the board without copying any text
+    static std::vector<Source> CollectSources(const Board& board);
+
+    // Copies and indexes the sources. Safe to call on a worker thread. Once cancelled is set the build stops at its
+    // next step and leaves the index empty.
+    void Build(const std::vector<Source>& sources, const std::atomic<bool>* cancelled = nullptr);
+    void Clear();
+
+    // Ranked matches for query (case-insensitive), best first. out_results is cleared first. Queries shorter than
+    // three characters have no trigrams and only use prefix matching. Not reentrant: uses per-index scratch space.
+    void Search(std::string_view query, QueryMode mode, size_t max_results, std::vector<Result>& out_results) const;
+
+    [[nodiscard]] bool IsEmpty() const { return m_kinds_.empty(); }
+    [[nodiscard]] size_t GetEntryCount() const { return m_kinds_.size(); }
+
+    // Original-case text of an entry
+    [[nodiscard]] std::string_view GetText(uint32_t entry) const;
+    [[nodiscard]] EntryKind GetKind(uint32_t entry) const { return m_kinds_[entry]; }
+    [[nodiscard]] int GetNetId(uint32_t entry) const { return m_net_ids_[entry]; }
+
+    // The entry's component, pin or label in board, which must be the indexed board or a geometry variant of it.
+    // out_parent receives the component owning a pin or label (nullptr otherwise). Returns nullptr for nets and for
+    // elements the variant does not have, e.g. an outline-layer label dropped by folding.
+    [[nodiscard]] const Element* ResolveElement(uint32_t entry, const Board& board, const Component** out_parent = nullptr) const;
+
+    static const char* EntryKindToString(EntryKind kind);
+    static const char* MatchTypeToString(MatchType match);
+
+    // Memory footprint of the index arrays, for diagnostics
+    [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+private:
+    [[nodiscard]] std::string_view GetLowerText(uint32_t entry) const;
+    [[nodiscard]] const uint32_t* FindPostings(uint32_t trigram, size_t& out_count) const;
+    // candidate (a top-level element) if it holds the entry's element at the entry's child index, else nullptr
+    [[nodiscard]] const Element* MatchElement(uint32_t entry, const Element& candidate, const Component** out_parent) const;
+
+    void SearchPrefix(std::string_view query, std::vector<Result>& out_results) const;
+    void SearchSubstring(std::string_view query, bool skip_prefix_matches, std::vector<Result>& out_results) const;
+    void SearchFuzzy(std::string_view query, bool skip_substring_matches, std::vector<Result>& out_results) const;
+
+    // Per-entry data (SoA)
+    std::string m_lower_text_;  // All entries, lowercase, back to back
+    std::string m_text_;        // Same layout, original case
+    std::vector<uint32_t> m_text_offsets_;  // Entry count + 1
+    std::vector<EntryKind> m_kinds_;
+    std::vector<ElementLocation> m_locations_;
+    std::vector<int> m_net_ids_;
+
+    // Entries ordered by lowercase text, for prefix ranges
+    std::vector<uint32_t> m_sorted_entries_;
+
+    // Trigram posting lists: m_postings_[m_trigram_offsets_[i] .. m_trigram_offsets_[i + 1]) for m_trigram_keys_[i]
+    std::vector<uint32_t> m_trigram_keys_;
+    std::vector<uint32_t> m_trigram_offsets_;
+    std::vector<uint32_t> m_postings_;
+
+    // Fuzzy query scratch, sized to the entry count on first use
+    mutable std::vector<uint16_t> m_fuzzy_counts_;
+    mutable std::vector<uint32_t> m_fuzzy_touched_;
+};
@@ -0,0 +1,119 @@
+#include "StringInterner.hpp"
+
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+// Symbol names are short; smaller chunks keep the idle footprint down
+constexpr size_t kStorageChunkSize = 64 * 1024;
+
+// Index of the highest set bit; value must not be 0
+uint32_t HighestBit(uint32_t value)
+{
+    uint32_t bit = 0;
+    for (uint32_t shift = 16; shift > 0; shift /= 2) {
+        if (value >= (1U << shift)) {
+            value >>= shift;
+            bit += shift;
+        }
+    }
+    return bit;
+}
+}  // namespace
+
+StringInterner::StringInterner() : m_storage_(kStorageChunkSize)
+{
+    const std::string_view empty = m_storage_.CopyString({});
+    AppendString(empty);
+    m_symbols_.emplace(empty, kEmptySymbol);
+}
+
+StringInterner::~StringInterner()
+{
+    for (auto& chunk : m_string_chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+void StringInterner::AppendString(std::string_view stored)
+{
+    const uint32_t symbol = m_symbol_count_.load(std::memory_order_relaxed);
+    const uint32_t slot = symbol + kFirstChunkSize;
+    const uint32_t chunk_bit = HighestBit(slot);
+    std::atomic<std::string_view*>& chunk = m_string_chunks_[chunk_bit - kFirstChunkBits];
+    std::string_view* strings = chunk.load(std::memory_order_relaxed);
+    if (!strings) {
+        strings = new std::string_view[size_t(1) << chunk_bit];
+        chunk.store(strings, std::memory_order_relaxed);  // Published by the count below
+    }
+    strings[slot - (1U << chunk_bit)] = stored;
+    m_symbol_count_.store(symbol + 1, std::memory_order_release);
+}
+
+SymbolId StringInterner::Intern(std::string_view text)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex_);
+        auto it = m_symbols_.find(text);
+        if (it != m_symbols_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex_);
+    auto it = m_symbols_.find(text);  // Another thread may have interned it meanwhile
+    if (it != m_symbols_.end()) {
+        return it->second;
+    }
+    const auto symbol = static_cast<SymbolId>(m_symbol_count_.load(std::memory_order_relaxed));
+    if (symbol >= UINT32_MAX - kFirstChunkSize) {
+        std::cerr << "StringInterner: Symbol space exhausted" << std::endl;
+        return kInvalidSymbol;
+    }
+    const std::string_view stored = m_storage_.CopyString(text);
+    AppendString(stored);
+    m_symbols_.emplace(stored, symbol);
+    return symbol;
+}
+
+SymbolId StringInterner::Find(std::string_view text) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex_);
+    auto it = m_symbols_.find(text);
+    return it != m_symbols_.end() ? it->second : kInvalidSymbol;
+}
+
+std::string_view StringInterner::GetString(SymbolId symbol) const
+{
+    if (symbol >= m_symbol_count_.load(std::memory_order_acquire)) {
+        return {};
+    }
+    const uint32_t slot = symbol + kFirstChunkSize;
+    const uint32_t chunk_bit = HighestBit(slot);
+    return m_string_chunks_[chunk_bit - kFirstChunkBits].load(std::memory_order_relaxed)[slot - (1U << chunk_bit)];
+}
+
+size_t StringInterner::GetSymbolCount() const
+{
+    return m_symbol_count_.load(std::memory_order_acquire);
+}
+
+size_t StringInterner::GetMemoryUsageBytes() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex_);
+    size_t string_table_bytes = 0;
+    for (uint32_t i = 0; i < kMaxChunks; ++i) {
+        if (m_string_chunks_[i].load(std::memory_order_relaxed)) {
+            string_table_bytes += (size_t(kFirstChunkSize) << i) * sizeof(std::string_view);
+        }
+    }
+    return m_storage_.GetReservedBytes() + string_table_bytes +
+           m_symbols_.size() * (sizeof(std::pair<const std::string_view, SymbolId>) + 2 * sizeof(void*)) + m_symbols_.bucket_count() * sizeof(void*);
+}
+
+StringInterner& StringInterner::Global()
+{
+    static StringInterner* interner = new StringInterner();
+    return *interner;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "BoardArena.hpp"
+
+// 32-bit handle of an interned string: equal strings always get the same symbol
+using SymbolId = uint32_t;
+
+// Performance optimization: Names that repeat across a board (pin names like "1" or "A1", footprints, font
+// families) are stored once and referred to by a 32-bit symbol, so equality and hashing in caches and hot paths
+// are integer operations. Symbols are process-wide and never released: the same name gets the same symbol on
+// every board, which keeps keys of caches that outlive a board valid. String bytes live in an arena and are
+// NUL-terminated, so the views handed out are stable and usable as C strings.
+// Thread-safe: GetString takes no lock, Intern and Find take a shared lock, interning a new string an exclusive one.
+class StringInterner
+{
+public:
+    static constexpr SymbolId kEmptySymbol = 0;  // The empty string; interned up front
+    static constexpr SymbolId kInvalidSymbol = UINT32_MAX;
+
+    StringInterner();
+    ~StringInterner();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    SymbolId Intern(std::string_view text);
+    // kInvalidSymbol if text was never interned
+    [[nodiscard]] SymbolId Find(std::string_view text) const;
+    // Lock-free; every InternedString read comes through here
+    [[nodiscard]] std::string_view GetString(SymbolId symbol) const;
+
+    [[nodiscard]] size_t GetSymbolCount() const;
+    [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+    // The interner every InternedString uses; intentionally never destroyed, so views outlive static teardown
+    static StringInterner& Global();
+
+private:
+    // Performance optimization: Strings by symbol live in chunks that never move, chunk i holding
+    // kFirstChunkSize << i entries, so a reader indexes them without a lock: an entry is written before
+    // m_symbol_count_ is published past it, and neither the entry nor its chunk changes afterwards.
+    static constexpr uint32_t kFirstChunkBits = 10;
+    static constexpr uint32_t kFirstChunkSize = 1U << kFirstChunkBits;
+    static constexpr uint32_t kMaxChunks = 32 - kFirstChunkBits;  // Up to UINT32_MAX - kFirstChunkSize symbols
+
+    void AppendString(std::string_view stored);  // Under the exclusive lock
+
+    mutable std::shared_mutex m_mutex_;  // Guards m_storage_, m_symbols_ and appending
+    BoardArena m_storage_;
+    std::unordered_map<std::string_view, SymbolId> m_symbols_;
+    std::atomic<std::string_view*> m_string_chunks_[kMaxChunks] {};
+    std::atomic<uint32_t> m_symbol_count_ {0};
+};
+
+// A string stored as its global symbol: 4 bytes in the owning object, compared and hashed as an integer.
+// Reads resolve the symbol through StringInterner::Global().
+class InternedString
+{
+public:
+    InternedString() = default;
+    explicit InternedString(std::string_view text) : m_symbol_(StringInterner::Global().Intern(text)) {}
+
+    [[nodiscard]] SymbolId GetSymbol() const { return m_symbol_; }
+    [[nodiscard]] bool empty() const { return m_symbol_ == StringInterner::kEmptySymbol; }
+
+    [[nodiscard]] std::string_view view() const { return StringInterner::Global().GetString(m_symbol_); }
+    [[nodiscard]] const char* c_str() const { return view().data(); }
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+    operator std::string_view() const { return view(); }  // Implicit, so code that only reads the text is unchanged
+
+    bool operator==(const InternedString& other) const { return m_symbol_ == other.m_symbol_; }
+    bool operator!=(const InternedString& other) const { return m_symbol_ != other.m_symbol_; }
+    // Orders by text, for sorted displays
+    bool operator<(const InternedString& other) const { return view() < other.view(); }
+
+private:
+    SymbolId m_symbol_ = StringInterner::kEmptySymbol;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const InternedString& text)
+{
+    return os << text.view();
+}
+
+namespace std
+{
+template <>
+struct hash<InternedString> {
+    size_t operator()(const InternedString& text) const noexcept { return hash<SymbolId> {}(text.GetSymbol()); }
+};
+}  // namespace std
@@ -1,6 +1,7 @@
 #include "XZZPCBLoader.hpp"
 
 #include <algorithm>  // For std::search
+#include <chrono>
 #include <cstdint>
 #include <cstring>  // For std::memcpy
 #include <fstream>
@@ -73,24 +74,44 @@ void PcbLoader::DefineStandardLayers(Board& board)
 
 std::unique_ptr<Board> PcbLoader::LoadFromFile(const std::string& filePath)
 {
+    // Phase timing for SetProfile: each call adds the time since the previous one to a profile field
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point phase_start {};
+    if (profile_) {
+        *profile_ = LoadProfile();
+        phase_start = Clock::now();
+    }
+    auto end_phase = [this, &phase_start](double LoadProfile::*phase_seconds) {
+        if (profile_) {
+            const Clock::time_point now = Clock::now();
+            profile_->*phase_seconds += std::chrono::duration<double>(now - phase_start).count();
+            phase_start = now;
+        }
+    };
+
     std::vector<char> fileData;
     if (!ReadFileData(filePath, fileData)) {
         // Consider logging an error here
         return nullptr;
     }
+    end_phase(&LoadProfile::read_seconds);
 
     if (!VerifyFormat(fileData)) {
         // Consider logging an error here
         return nullptr;
     }
+    end_phase(&LoadProfile::verify_seconds);
 
     if (!DecryptFileDataIfNeeded(fileData)) {
         // Consider logging an error here
         return nullptr;
     }
+    end_phase(&LoadProfile::xor_seconds);
 
     auto board = std::make_unique<Board>();
     board->file_path = filePath;
+    // Every element parsed below lives exactly as long as the board: allocate them from its arena
+    BoardArena::Scope arena_scope(&board->GetArena());
     // board->board_name = extract from file path or header?
     DefineStandardLayers(*board);
 
@@ -102,14 +123,17 @@ std::unique_ptr<Board> PcbLoader::LoadFromFile(const std::string& filePath)
     if (!ParseHeader(fileData, *board, mainDataOffset, netDataOffset, imageDataOffset, mainDataBlocksSize)) {
         return nullptr;  // Error parsing header
     }
+    end_phase(&LoadProfile::header_seconds);
 
     if (!ParseMainDataBlocks(fileData, *board, mainDataOffset, mainDataBlocksSize)) {
         return nullptr;  // Error parsing main data blocks
     }
+    end_phase(&LoadProfile::main_blocks_seconds);
 
     if (!ParseNetBlock(fileData, *board, netDataOffset)) {
         return nullptr;  // Error parsing net block
     }
+    end_phase(&LoadProfile::net_seconds);
 
     // Handle post-v6 data if present (diode readings)
     static const std::vector<uint8_t> v6_marker = {0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
@@ -119,12 +143,18 @@ std::unique_ptr<Board> PcbLoader::LoadFromFile(const std::string& filePath)
             // Optional: log error but continue, as this might be auxiliary data
         }
     }
+    end_phase(&LoadProfile::post_v6_seconds);
 
     // Board is populated. Now calculate its bounds and normalize coordinates.
     BLRect original_extents = board->GetBoundingBox(true);  // Use layer 28 traces, include even if layer 28 is initially hidden
 
+    // Apply global coordinate mirroring to correct coordinate system mismatch
+    // This is a static transformation applied at load time, separate from interactive transformations
+    // Performance optimization: It is fused into the normalization pass, so every coordinate is touched once
+    const BoardTransform mirroring = GetGlobalCoordinateMirroring(*board, original_extents);
+
     if (original_extents.w > 0 || original_extents.h > 0) {  // Allow for 1D lines to still have a center
-        board->origin_offset = board->NormalizeCoordinatesAndGetCenterOffset(original_extents);
+        board->origin_offset = board->NormalizeCoordinatesAndGetCenterOffset(original_extents, mirroring);
         // Store the calculated dimensions on the board object itself
         board->width = original_extents.w;
         board->height = original_extents.h;
@@ -136,14 +166,16 @@ std::unique_ptr<Board> PcbLoader::LoadFromFile(const std::string& filePath)
         // std::cerr << "Warning: Could not determine board bounds from layer 28 outline." << std::endl;
     }
 
+    // NormalizeCoordinatesAndGetCenterOffset skips degenerate (1D) outlines; mirror on its own then
+    if (!(original_extents.w > 0 && original_extents.h > 0)) {
+        board->ApplyBulkTransform(mirroring);
+    }
+    end_phase(&LoadProfile::normalize_seconds);
+
     // The Board::Board(filePath) constructor is responsible for setting m_isLoaded.
     // By reaching this point in the loader, we assume the loading process itself was successful
     // in terms of reading and parsing data into the board structure.
 
-    // Apply global coordinate mirroring to correct coordinate system mismatch
-    // This is a static transformation applied at load time, separate from interactive transformations
-    ApplyGlobalCoordinateMirroring(*board);
-
     // Pin orientations are now read directly from PCB files as rotation data
     // No need for heuristic orientation processing
     return board;
@@ -221,6 +253,7 @@ bool PcbLoader::DecryptFileDataIfNeeded(std::vector<char>& fileData)
 // This method is specifically for DES-decrypting component data blocks.
 void PcbLoader::DecryptComponentBlock(std::vector<char>& blockData)
 {
+    const std::chrono::steady_clock::time_point decrypt_start = profile_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {};
     std::ostringstream key_hex_stream;
     key_hex_stream.str().reserve(16);  // DES key is 8 bytes = 16 hex chars
 
@@ -263,6 +296,9 @@ void PcbLoader::DecryptComponentBlock(std::vector<char>& blockData)
         p += 8;
     }
     blockData = decrypted_data;  // Replace original with decrypted version
+    if (profile_) {
+        profile_->des_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - decrypt_start).count();
+    }
 }
 
 std::string PcbLoader::ReadCB2312String(const char* data, size_t length)
@@ -383,6 +419,7 @@ bool PcbLoader::ParseMainDataBlocks(const std::vector<char>& fileData, Board& bo
             }
 
             const char* blockDataStart = &fileData[currentOffset];
+            const std::chrono::steady_clock::time_point block_start = profile_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {};
 
             switch (blockType) {
                 case 0x01:  // Arc
@@ -414,6 +451,11 @@ bool PcbLoader::ParseMainDataBlocks(const std::vector<char>& fileData, Board& bo
                     // std::cout << "Skipping unknown block type 0x" << std::hex << (int)blockType << std::dec << " of size " << blockSize << std::endl;
                     break;
             }
+            if (profile_) {
+                LoadProfile::BlockTiming& timing = profile_->blocks[blockType];
+                ++timing.count;
+                timing.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - block_start).count();
+            }
             currentOffset += blockSize;
         }
         return true;
@@ -670,7 +712,7 @@ void PcbLoader::ParseComponent(const char* rawComponentData, uint32_t componentB
     localOffset += pad_size_len;
 
     Component comp(comp_footprint_name_str, "", part_x, part_y);
-    comp.footprint_name = comp_footprint_name_str;
+    comp.footprint_name = InternedString(comp_footprint_name_str);
 	comp.rotation = part_rotation;
 
 
@@ -752,7 +794,7 @@ void PcbLoader::ParseComponent(const char* rawComponentData, uint32_t componentB
                 auto label_ptr = std::make_unique<TextLabel>(lbl_text, Vec2(lbl_x, lbl_y), lbl_layer, lbl_font_size, lbl_font_scale);
                 // label_ptr->scale = lbl_font_scale; // Now passed in constructor
                 label_ptr->SetVisible(visible);
-                label_ptr->font_family = font_family_str;  // Make sure to set all relevant fields
+                label_ptr->font_family = InternedString(font_family_str);  // Make sure to set all relevant fields
                 label_ptr->rotation = rotation_degrees;    // Make sure to set all relevant fields
                 // label.ps06_flag = ps06_flag; // ps06_flag is removed
                 comp.text_labels.push_back(std::move(label_ptr));
@@ -902,7 +944,7 @@ void PcbLoader::ParseComponent(const char* rawComponentData, uint32_t componentB
                 if (diode_readings_type_ == 1 && !comp.reference_designator.empty() && !current_pin_object_ptr->pin_name.empty()) {
                     auto comp_it = diode_readings_.find(comp.reference_designator);
                     if (comp_it != diode_readings_.end()) {
-                        auto pin_it = comp_it->second.find(current_pin_object_ptr->pin_name);
+                        auto pin_it = comp_it->second.find(pin_name_str);
                         if (pin_it != comp_it->second.end()) {
                             current_pin_object_ptr->diode_reading = pin_it->second;
                         }
@@ -917,11 +959,9 @@ void PcbLoader::ParseComponent(const char* rawComponentData, uint32_t componentB
                     // }
                 }
 
-                // Update initial_width, initial_height, long_side, short_side from the final pad_shape
+                // Update width and height from the final pad_shape
                 // This also needs to use current_pin_object_ptr:
                 std::tie(current_pin_object_ptr->width, current_pin_object_ptr->height) = Pin::GetDimensionsFromShape(current_pin_object_ptr->pad_shape);
-                current_pin_object_ptr->long_side = std::max(current_pin_object_ptr->width, current_pin_object_ptr->height);
-                current_pin_object_ptr->short_side = std::min(current_pin_object_ptr->width, current_pin_object_ptr->height);
                 current_pin_object_ptr->coords.x_ax = pin_x;
                 current_pin_object_ptr->coords.y_ax = pin_y;
                 current_pin_object_ptr->rotation = pin_rotation;  // Assign the rotation data from file
@@ -939,7 +979,7 @@ void PcbLoader::ParseComponent(const char* rawComponentData, uint32_t componentB
     // If component reference designator is still not set (e.g. from type 0x06 text label), try to use footprint name or make a generic one.
     if (comp.reference_designator.empty()) {
         if (!comp.footprint_name.empty()) {
-            comp.reference_designator = comp.footprint_name + "?";  // e.g. "0805?"
+            comp.reference_designator = comp.footprint_name.str() + "?";  // e.g. "0805?"
         } else {
             static int unnamed_comp_counter = 0;
             std::ostringstream ss;
@@ -1160,66 +1200,26 @@ bool PcbLoader::ParseNetBlock(const std::vector<char>& fileData, Board& board, u
     }
 }
 
-void PcbLoader::ApplyGlobalCoordinateMirroring(Board& board)
+BoardTransform PcbLoader::GetGlobalCoordinateMirroring(const Board& board, const BLRect& normalization_bounds)
 {
-    // Apply a static global X-coordinate mirror to correct coordinate system mismatch
+    // A static global X-coordinate mirror corrects the coordinate system mismatch
     // between board files and physical layout. This is separate from interactive transformations.
 
     // Get board bounds to determine the center axis for mirroring
     BLRect board_bounds = board.GetBoundingBox(false);
     if (board_bounds.w <= 0 && board_bounds.h <= 0) {
         // No valid bounds, skip mirroring
-        return;
+        return BoardTransform();
     }
 
+    // The mirror runs after normalization, so its axis is expressed in normalized coordinates
     double center_x = board_bounds.x + board_bounds.w / 2.0;
-
-    // Mirror all elements across the center axis
-    for (auto& layer_pair : board.m_elements_by_layer) {
-        for (auto& element_ptr : layer_pair.second) {
-            if (!element_ptr) continue;
-
-            // Apply element-specific mirroring
-            if (auto trace = dynamic_cast<Trace*>(element_ptr.get())) {
-                // Mirror trace endpoints
-                trace->x1 = 2 * center_x - trace->x1;
-                trace->x2 = 2 * center_x - trace->x2;
-            }
-            else if (auto arc = dynamic_cast<Arc*>(element_ptr.get())) {
-                // Mirror arc center and adjust angles
-                arc->center.x_ax = 2 * center_x - arc->center.x_ax;
-
-                // For horizontal mirroring, transform angles and swap start/end
-                // Original arc from start_angle to end_angle becomes
-                // arc from (180° - end_angle) to (180° - start_angle)
-                double original_start = arc->start_angle;
-                double original_end = arc->end_angle;
-
-                arc->start_angle = 180.0 - original_end;
-                arc->end_angle = 180.0 - original_start;
-
-                // Normalize angles to [0, 360)
-                while (arc->start_angle < 0) arc->start_angle += 360.0;
-                while (arc->end_angle < 0) arc->end_angle += 360.0;
-                while (arc->start_angle >= 360.0) arc->start_angle -= 360.0;
-                while (arc->end_angle >= 360.0) arc->end_angle -= 360.0;
-            }
-            else if (auto via = dynamic_cast<Via*>(element_ptr.get())) {
-                // Mirror via position
-                via->x = 2 * center_x - via->x;
-            }
-            else if (auto text = dynamic_cast<TextLabel*>(element_ptr.get())) {
-                // Mirror text position
-                text->coords.x_ax = 2 * center_x - text->coords.x_ax;
-            }
-            else if (auto comp = dynamic_cast<Component*>(element_ptr.get())) {
-                // Mirror component using its Mirror method
-                comp->Mirror(center_x);
-            }
-        }
+    if (normalization_bounds.w > 0 && normalization_bounds.h > 0) {
+        center_x -= normalization_bounds.x + normalization_bounds.w / 2.0;
     }
 
-    std::cout << "Applied global coordinate mirroring around center axis X=" << center_x << std::endl;
+    std::cout << "Applying global coordinate mirroring around center axis X=" << center_x << std::endl;
+    return BoardTransform::MirrorX(center_x);
 }
 
 // Implementations for parsePostV6Block, and element-specific parsers (parseArc, parseVia, etc.) will follow.
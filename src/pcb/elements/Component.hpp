@@ -26,13 +26,13 @@ struct LineSegment {
     int layer = 0;  // If segments can be on different layers relative to component
 };
 
-enum class ComponentElementType  // Renamed from ComponentType to avoid conflict if Element has ElementType
+enum class ComponentElementType : uint8_t  // Renamed from ComponentType to avoid conflict if Element has ElementType
 {
     kSmd,
     kThroughHole,
     kOther
 };
-enum class MountingSide {
+enum class MountingSide : uint8_t {
     kTop,
     kBottom,
     // Both // Consider if 'Both' is valid for a single component instance
@@ -71,10 +71,6 @@ public:
           is_tall_component(other.is_tall_component),
           is_qfp(other.is_qfp),
           is_connector(other.is_connector),
-          left_edge_pin_indices(other.left_edge_pin_indices),
-          right_edge_pin_indices(other.right_edge_pin_indices),
-          top_edge_pin_indices(other.top_edge_pin_indices),
-          bottom_edge_pin_indices(other.bottom_edge_pin_indices),
           layer(other.layer),
           side(other.side),
           type(other.type),
@@ -104,7 +100,7 @@ public:
     // Member Data
     std::string reference_designator;  // e.g., "R1", "U100"
     std::string value;                 // e.g., "10k", "ATMEGA328P"
-    std::string footprint_name;        // e.g., "0805", "TQFP32"
+    InternedString footprint_name;     // e.g., "0805", "TQFP32"; repeats across most components
 
     // Position and Orientation (typically of the component's geometric center)
     // Vec2 center; // Preferring separate center_x, center_y for now to match existing
@@ -149,12 +145,6 @@ public:
     bool is_qfp = false;             // Quad Flat Package (pins on all four sides)
     bool is_connector = false;       // Often has many pins along one or two edges
 
-    // Indices of pins located on the primary edges of the pin bounding box
-    std::vector<size_t> left_edge_pin_indices {};
-    std::vector<size_t> right_edge_pin_indices {};
-    std::vector<size_t> top_edge_pin_indices {};
-    std::vector<size_t> bottom_edge_pin_indices {};
-
     int layer = 0;  // Primary layer the component resides on
     MountingSide side = MountingSide::kTop;
     ComponentElementType type = ComponentElementType::kSmd;  // Renamed enum type
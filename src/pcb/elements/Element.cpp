@@ -1,9 +1,53 @@
 #include "pcb/elements/Element.hpp"
+
+#include <cstddef>
+#include <new>
+
+#include "pcb/BoardArena.hpp"
+#include "pcb/elements/Arc.hpp"
 #include "pcb/elements/Component.hpp"  // For MountingSide enum definition
+#include "pcb/elements/Pin.hpp"
+#include "pcb/elements/TextLabel.hpp"
+#include "pcb/elements/Trace.hpp"
+#include "pcb/elements/Via.hpp"
+
+namespace
+{
+// Written in front of every Element allocation (see Element::operator new)
+constexpr uint64_t kHeapAllocationTag = 0x48454150;   // "HEAP"
+constexpr uint64_t kArenaAllocationTag = 0x4152454E;  // "AREN"
+
+// The header only keeps objects 8-byte aligned
+static_assert(alignof(Trace) <= Element::kAllocationHeaderSize && alignof(Arc) <= Element::kAllocationHeaderSize &&
+                  alignof(Via) <= Element::kAllocationHeaderSize && alignof(Pin) <= Element::kAllocationHeaderSize &&
+                  alignof(TextLabel) <= Element::kAllocationHeaderSize && alignof(Component) <= Element::kAllocationHeaderSize,
+              "Element allocation header is smaller than an element's alignment");
+}  // namespace
 
 // Element constructor implementation
 Element::Element(int layer_id, ElementType type, int net_id) 
-    : m_layer_id_(layer_id), m_type_(type), m_net_id_(net_id), m_board_side_(MountingSide::kTop)
+    : m_layer_id_(layer_id), m_net_id_(net_id), m_type_(type), m_board_side_(MountingSide::kTop)
 {
     // Default initialization - board side defaults to top
 }
+
+void* Element::operator new(size_t size)
+{
+    BoardArena* arena = BoardArena::GetCurrent();
+    const size_t block_size = size + kAllocationHeaderSize;
+    void* block = arena ? arena->Allocate(block_size, kAllocationHeaderSize) : ::operator new(block_size);
+    *static_cast<uint64_t*>(block) = arena ? kArenaAllocationTag : kHeapAllocationTag;
+    return static_cast<std::byte*>(block) + kAllocationHeaderSize;
+}
+
+void Element::operator delete(void* ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+    void* block = static_cast<std::byte*>(ptr) - kAllocationHeaderSize;
+    if (*static_cast<const uint64_t*>(block) == kArenaAllocationTag) {
+        return;  // Released with the arena's chunks
+    }
+    ::operator delete(block, size + kAllocationHeaderSize);
+}
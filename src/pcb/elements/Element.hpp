@@ -1,6 +1,8 @@
 #ifndef ELEMENT_HPP
 #define ELEMENT_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include <blend2d.h>  // For BLRect
@@ -12,7 +14,7 @@ class Board;
 class Component;  // Added: Parent component context for pins
 
 // Forward declaration for MountingSide enum (defined in Component.hpp)
-enum class MountingSide;
+enum class MountingSide : uint8_t;
 
 // Performance optimization: Use uint8_t for smaller memory footprint
 enum class ElementType : uint8_t {
@@ -70,10 +72,18 @@ public:
     Element(Element&&) = delete;
     Element& operator=(Element&&) = delete;
 
+    // Performance optimization: Elements come from the calling thread's BoardArena while a BoardArena::Scope is
+    // active (board loading); deleting one of those only runs the destructor, the arena owns the memory. Every
+    // allocation starts with a tag word saying where it came from, so delete needs no lookup and no lock.
+    static constexpr size_t kAllocationHeaderSize = sizeof(uint64_t);  // Keeps objects 8-byte aligned
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
 private:
+    // Performance optimization: Byte-sized fields are grouped after the ints so the header packs into 24 bytes
     int m_layer_id_;
-    ElementType m_type_;
     int m_net_id_;
+    ElementType m_type_;
     bool m_is_globally_visible_ {true};
 
     // Board side assignment for folding feature (only used for silkscreen elements)
@@ -13,27 +13,17 @@
 #include "utils/GeometryUtils.hpp"     // For geometry_utils:: functions
 
 // Helper to get world coordinates of pin center and its world rotation
-std::pair<Vec2, double> Pin::GetPinWorldTransform(const Pin& pin, const Component* parentComponent)
+std::pair<Vec2, double> Pin::GetPinWorldTransform(const Pin& pin, const Component* /*parentComponent*/)
 {
-    if (!parentComponent) {
-        // Pin is standalone or context is missing. Treat its coords as world, 0 rotation.
-        return {{pin.coords.x_ax, pin.coords.y_ax}, pin.rotation};
-    }
-
-    double comp_rot_rad = parentComponent->rotation * (kPi / 180.0);
-    double cos_comp = std::cos(comp_rot_rad);
-    double sin_comp = std::sin(comp_rot_rad);
-
-    // Pin's own coordinates (x_coord, y_coord) are global
-    double world_x = parentComponent->center_x + (pin.coords.x_ax * cos_comp - pin.coords.y_ax * sin_comp);
-    double world_y = parentComponent->center_y + (pin.coords.x_ax * sin_comp + pin.coords.y_ax * cos_comp);
-
-    double world_rotation_deg = parentComponent->rotation + pin.rotation;  // Pin's own rotation is added to component's
-    world_rotation_deg = fmod(world_rotation_deg, 360.0);
+    // Pin coordinates and rotation are stored in board space (the loader writes absolute positions and
+    // Component::Mirror / Pin::IsHit / RenderPin all treat them as global), so the parent component
+    // contributes no additional transform. Composing the component transform here would place the
+    // pin's bounding box away from where it is drawn and hit-tested.
+    double world_rotation_deg = fmod(pin.rotation, 360.0);
     if (world_rotation_deg < 0)
         world_rotation_deg += 360.0;
 
-    return {{world_x, world_y}, world_rotation_deg};
+    return {{pin.coords.x_ax, pin.coords.y_ax}, world_rotation_deg};
 }
 
 BLRect Pin::GetBoundingBox(const Component* parentComponent) const
@@ -4,11 +4,13 @@
 #include <cmath>      // For std::min/max in constructor helper
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "Element.hpp"  // Include base class
+#include "pcb/StringInterner.hpp"
 #include "utils/Vec2.hpp"            // For Vec2
 
 // Forward declare Component because Pin needs to know about it for context in virtual methods
@@ -53,17 +55,15 @@ enum class LocalEdge : std::uint8_t {
 class Pin : public Element
 {  // Inherit from Element
 public:
-    Pin(Vec2 coords, std::string name, PadShape shape, int layer, int net_id = -1, PinOrientation orientation = PinOrientation::kNatural, int side = 0)
+    Pin(Vec2 coords, std::string_view name, PadShape shape, int layer, int net_id = -1, PinOrientation orientation = PinOrientation::kNatural, int side = 0)
         : Element(layer, ElementType::kPin, net_id),  // Call base constructor
           coords(coords),
-          pin_name(std::move(name)),
           pad_shape(shape),
-          orientation(orientation),
-          long_side(std::max(width, height)),
-          short_side(std::min(width, height)),
-          side(side)
+          side(side),
+          pin_name(name),
+          orientation(orientation)
     {
-        // Initialize width, height, long_side, short_side from pad_shape
+        // Initialize width and height from pad_shape
         std::tie(width, height) = GetDimensionsFromShape(pad_shape);
     }
 
@@ -71,18 +71,16 @@ public:
     Pin(const Pin& other)
         : Element(other.GetLayerId(), other.GetElementType(), other.GetNetId()),  // Initialize Element base
           coords(other.coords),
-          pin_name(other.pin_name),
           pad_shape(other.pad_shape),
-          local_edge(other.local_edge),
-          side(other.side),
           diode_reading(other.diode_reading),
-          orientation(other.orientation),
           rotation(other.rotation),
+          side(other.side),
+          debug_color(other.debug_color),
+          pin_name(other.pin_name),
+          local_edge(other.local_edge),
+          orientation(other.orientation),
           width(other.width),
-          height(other.height),
-          long_side(other.long_side),
-          short_side(other.short_side),
-          debug_color(other.debug_color)
+          height(other.height)
     {
         // Element's m_isGloballyVisible is initialized to true by its constructor.
         // If the copied pin should inherit the source pin's visibility state, set it explicitly.
@@ -101,22 +99,26 @@ public:
     // --- Pin-specific Member Data ---
     // get world transform
     static std::pair<Vec2, double> GetPinWorldTransform(const Pin& pin, const Component* parent_component);
+    // The center stays double: traces end on pin centers and are stored in double, and geometry variants mirror
+    // both with the same double arithmetic, so the two keep meeting exactly
     Vec2 coords {};
-    std::string pin_name;
     PadShape pad_shape;
-    LocalEdge local_edge = LocalEdge::kUnknown;
-
-    int side = 0;  // e.g., 0 for top, 1 for bottom
     std::string diode_reading;
-    PinOrientation orientation = PinOrientation::kNatural;  // DEPRECATED: Use rotation instead
     double rotation = 0.0;  // Degrees - actual rotation data from PCB file
-
-    double width = 0.0;
-    double height = 0.0;
-    double long_side = 0.0;   // DEPRECATED: Used for old orientation logic
-    double short_side = 0.0;  // DEPRECATED: Used for old orientation logic
     // layer and net_id are in Element
 
+    // Performance optimization: The 4- and 1-byte fields share the tail of the object instead of each being padded
+    // out to 8 bytes between doubles (one pin per pad makes this the most numerous element type)
+    int side = 0;  // e.g., 0 for top, 1 for bottom
+    BLRgba32 debug_color = BLRgba32(0, 0, 0, 0);
+    InternedString pin_name;  // e.g. "1", "A1": a handful of names shared by every pin of a board
+    LocalEdge local_edge = LocalEdge::kUnknown;
+    PinOrientation orientation = PinOrientation::kNatural;  // DEPRECATED: Use rotation instead
+    // Pad extent cached from pad_shape for culling and sorting; float is plenty for a pad size and packs into the
+    // tail. Outlines and hit tests use pad_shape itself.
+    float width = 0.0f;
+    float height = 0.0f;
+
     // --- Pin-specific Getters & Helpers ---
     [[nodiscard]] std::string GetEdgeName() const
     {
@@ -217,16 +219,14 @@ public:
             pad_shape);
     }
 
-    BLRgba32 debug_color = BLRgba32(0, 0, 0, 0);
-
     // DEPRECATED: This method was used for old orientation logic
     // Now that we have actual rotation data from the file, this is no longer needed
     [[deprecated("Use rotation field instead of orientation-based dimension swapping")]]
     void SetDimensionsForOrientation()
     {
         // Ensure long_side is width, short_side is height
-        long_side = std::max(width, height);
-        short_side = std::min(width, height);
+        const double long_side = std::max(width, height);
+        const double short_side = std::min(width, height);
         if (orientation == PinOrientation::kHorizontal) {
             if (std::holds_alternative<RectanglePad>(pad_shape)) {
                 pad_shape = RectanglePad {long_side, short_side};
@@ -242,8 +242,6 @@ public:
         } else {
             // Natural: use pad_shape
             std::tie(width, height) = GetDimensionsFromShape(pad_shape);
-            long_side = std::max(width, height);
-            short_side = std::min(width, height);
         }
     }
 };
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "Element.hpp"  // Include base class
+#include "pcb/StringInterner.hpp"
 
 #include "utils/Vec2.hpp"  // For Vec2
 // #include <cstdint> // No longer strictly needed
@@ -21,7 +23,7 @@ public:
               double font_size_val,
               double scale_val = 1.0,
               double rotation_val = 0.0,
-              const std::string& font_family_val = "",
+              std::string_view font_family_val = {},
               int net_id_val = -1)                                 // Net ID typically -1 for text
         : Element(layer_id, ElementType::kTextLabel, net_id_val),  // Call base constructor
           text_content(std::move(content)),
@@ -61,7 +63,7 @@ public:
     double scale = 1.0;
     double rotation = 0.0;
     // int ps06_flag = 0; // Retain if its meaning/use is found
-    std::string font_family;
+    InternedString font_family;  // Shared by nearly every label of a board
     // layer, net_id, is_visible are in Element
 
     // --- TextLabel-specific Getters ---
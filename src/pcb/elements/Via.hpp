@@ -15,9 +15,9 @@ public:
           y(y_coord),
           layer_from(start_layer),
           layer_to(end_layer),
-          drill_diameter(drill_dia),
-          pad_radius_from(radius_start_layer),
-          pad_radius_to(radius_end_layer),
+          drill_diameter(static_cast<float>(drill_dia)),
+          pad_radius_from(static_cast<float>(radius_start_layer)),
+          pad_radius_to(static_cast<float>(radius_end_layer)),
           optional_text(text)
     {
         {
@@ -47,14 +47,18 @@ public:
     void Mirror(double center_axis) override;
 
     // --- Via-specific Member Data ---
+    // The center stays double: traces end on via centers and are stored in double, and geometry variants mirror
+    // both with the same double arithmetic, so the two keep meeting exactly
     double x = 0.0;
     double y = 0.0;
     // int layer = 30; // This 'layer' member was a bit ambiguous for vias; m_layerId from Element now holds primary layer
     int layer_from = 0;
     int layer_to = 0;
-    double drill_diameter = 0.2;
-    double pad_radius_from = 0.0;
-    double pad_radius_to = 0.0;
+    // Performance optimization: Sizes are float, which resolves far below a micron at via scale; with the layer pair
+    // they fill two 8-byte slots instead of three doubles
+    float drill_diameter = 0.2f;
+    float pad_radius_from = 0.0f;
+    float pad_radius_to = 0.0f;
     std::string optional_text;
     // net_id is in Element
 
@@ -259,7 +259,5 @@ private:
 
         // Update cached dimensions
         std::tie(pin.width, pin.height) = pin.GetDimensions();
-        pin.long_side = std::max(pin.width, pin.height);
-        pin.short_side = std::min(pin.width, pin.height);
     }
 };
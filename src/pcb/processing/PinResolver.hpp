@@ -334,10 +334,8 @@ private:
             printf("Pin %zu was not accepted and is now in original state\n", pin_idx_to_rotate);
             // Explicitly update cached width/height members if swapPinDimensions modified them directly
             // and they are not solely derived from pad_shape on demand.
-            // The current swapPinDimensions updates pin.width/height/long_side/short_side.
+            // The current swapPinDimensions updates pin.width/height.
             std::tie(pin.width, pin.height) = pin.GetDimensions();  // Re-cache from restored shape
-            pin.long_side = std::max(pin.width, pin.height);
-            pin.short_side = std::min(pin.width, pin.height);
             return false;
         }
 
@@ -369,7 +367,5 @@ private:
 
         // Update cached dimensions
         std::tie(pin.width, pin.height) = pin.GetDimensions();
-        pin.long_side = std::max(pin.width, pin.height);
-        pin.short_side = std::min(pin.width, pin.height);
     }
 };
@@ -1,8 +1,206 @@
 #include "BLPathCache.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
 namespace path_cache {
 
+namespace
+{
+// Bytes Blend2D keeps per path besides its vertex and command arrays
+constexpr size_t kPathImplOverheadBytes = 64;
+// Map node of one entry: key, entry, next pointer and cached hash
+constexpr size_t kEntryOverheadBytes = sizeof(PathCacheKey) + 2 * sizeof(void*);
+}  // namespace
+
 // Global path cache instance
 BLPathCache g_path_cache;
+std::mutex g_path_cache_mutex;
+
+BLPathCache::BLPathCache(size_t byte_budget) : m_byte_budget_(byte_budget) {}
+
+BLPathCache::~BLPathCache() = default;
+
+const BLPath& BLPathCache::GetStrokedPath(const PathCacheKey& key, const BLPath& original_path, const BLStrokeOptions& stroke_options)
+{
+    auto [it, inserted] = m_cache_.try_emplace(key);
+    Entry& entry = it->second;
+    if (!inserted) {
+        ++m_cache_hits_;
+        if (m_lru_head_ != &entry) {
+            Unlink(&entry);
+            LinkFront(&entry);
+        }
+        return entry.stroked_path;
+    }
+
+    ++m_cache_misses_;
+    entry.key = &it->first;
+
+    BLApproximationOptions approx_opts = blDefaultApproximationOptions;
+    approx_opts.flattenMode = BL_FLATTEN_MODE_DEFAULT;
+    approx_opts.flattenTolerance = GetFlattenTolerance(key.zoom_bucket);
+    if (entry.stroked_path.addStrokedPath(original_path, stroke_options, approx_opts) != BL_SUCCESS) {
+        // Return original path as fallback
+        entry.stroked_path = original_path;
+    }
+    entry.stroked_path.shrink();
+
+    entry.bytes = GetPathBytes(entry.stroked_path) + kEntryOverheadBytes;
+    m_total_bytes_ += entry.bytes;
+    LinkFront(&entry);
+    EvictToBudget(&entry);
+    return entry.stroked_path;
+}
+
+void BLPathCache::Invalidate(const PathCacheKey& key)
+{
+    auto it = m_cache_.find(key);
+    if (it != m_cache_.end()) {
+        Erase(&it->second);
+    }
+}
+
+void BLPathCache::Clear()
+{
+    m_cache_.clear();
+    m_lru_head_ = nullptr;
+    m_lru_tail_ = nullptr;
+    m_total_bytes_ = 0;
+    m_cache_hits_ = 0;
+    m_cache_misses_ = 0;
+    m_evictions_ = 0;
+}
+
+void BLPathCache::SetByteBudget(size_t byte_budget)
+{
+    m_byte_budget_ = byte_budget;
+    EvictToBudget(nullptr);
+}
+
+BLPathCache::CacheStats BLPathCache::GetStats() const
+{
+    CacheStats stats;
+    stats.total_entries = m_cache_.size();
+    stats.total_bytes = m_total_bytes_;
+    stats.byte_budget = m_byte_budget_;
+    stats.cache_hits = m_cache_hits_;
+    stats.cache_misses = m_cache_misses_;
+    stats.evictions = m_evictions_;
+
+    size_t total_requests = m_cache_hits_ + m_cache_misses_;
+    stats.hit_ratio = total_requests > 0 ? static_cast<double>(m_cache_hits_) / total_requests : 0.0;
+    return stats;
+}
+
+int32_t BLPathCache::GetZoomBucket(double zoom)
+{
+    if (!(zoom > 0.0)) {
+        return 0;
+    }
+    return static_cast<int32_t>(std::floor(std::log2(zoom) * kZoomBucketsPerOctave));
+}
+
+double BLPathCache::GetFlattenTolerance(int32_t zoom_bucket)
+{
+    // The tolerance stays kBaseFlattenTolerance on screen: it shrinks in world units as the zoom grows
+    return kBaseFlattenTolerance / std::exp2(static_cast<double>(zoom_bucket) / kZoomBucketsPerOctave);
+}
+
+PathCacheKey BLPathCache::CreateTraceKey(uint64_t trace_id, double thickness, BLStrokeCap start_cap, BLStrokeCap end_cap, int32_t zoom_bucket)
+{
+    static const InternedString kTraceKind("trace");
+    PathCacheKey key;
+    key.kind = kTraceKind.GetSymbol();
+    key.owner_id = trace_id;
+    key.thickness_microns = static_cast<int32_t>(std::lround(thickness * 1000.0));
+    key.zoom_bucket = zoom_bucket;
+    key.start_cap = start_cap;
+    key.end_cap = end_cap;
+    return key;
+}
+
+PathCacheKey BLPathCache::CreateTraceKey(double start_x, double start_y, double end_x, double end_y, double thickness, BLStrokeCap start_cap,
+                                         BLStrokeCap end_cap, int32_t zoom_bucket)
+{
+    // Adding 0.0 turns -0.0 into 0.0, so keys that compare equal also hash equal
+    const double points[4] = {start_x + 0.0, start_y + 0.0, end_x + 0.0, end_y + 0.0};
+    uint64_t trace_id = 0;
+    for (const double coordinate : points) {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &coordinate, sizeof(bits));
+        trace_id ^= bits + 0x9e3779b97f4a7c15ULL + (trace_id << 6) + (trace_id >> 2);
+    }
+    PathCacheKey key = CreateTraceKey(trace_id, thickness, start_cap, end_cap, zoom_bucket);
+    std::copy(std::begin(points), std::end(points), std::begin(key.points));
+    return key;
+}
+
+PathCacheKey BLPathCache::CreateComponentKey(uint64_t component_id, InternedString element_name, double thickness, uint32_t transform_hash,
+                                             int32_t zoom_bucket)
+{
+    static const InternedString kComponentKind("component");
+    PathCacheKey key;
+    key.kind = kComponentKind.GetSymbol();
+    key.owner_id = component_id;
+    key.part = element_name.GetSymbol();
+    key.thickness_microns = static_cast<int32_t>(std::lround(thickness * 1000.0));
+    key.zoom_bucket = zoom_bucket;
+    key.transform_hash = transform_hash;
+    return key;
+}
+
+void BLPathCache::LinkFront(Entry* entry)
+{
+    entry->lru_prev = nullptr;
+    entry->lru_next = m_lru_head_;
+    if (m_lru_head_) {
+        m_lru_head_->lru_prev = entry;
+    } else {
+        m_lru_tail_ = entry;
+    }
+    m_lru_head_ = entry;
+}
+
+void BLPathCache::Unlink(Entry* entry)
+{
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        m_lru_head_ = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        m_lru_tail_ = entry->lru_prev;
+    }
+    entry->lru_prev = nullptr;
+    entry->lru_next = nullptr;
+}
+
+void BLPathCache::Erase(Entry* entry)
+{
+    Unlink(entry);
+    m_total_bytes_ -= entry->bytes;
+    const PathCacheKey key = *entry->key;  // Copied: the map node that holds it is what gets erased
+    m_cache_.erase(key);
+}
+
+void BLPathCache::EvictToBudget(const Entry* keep)
+{
+    // The entry just handed out stays even if it alone exceeds the budget
+    while (m_total_bytes_ > m_byte_budget_ && m_lru_tail_ && m_lru_tail_ != keep) {
+        Erase(m_lru_tail_);
+        ++m_evictions_;
+    }
+}
+
+size_t BLPathCache::GetPathBytes(const BLPath& path)
+{
+    // One point plus one command byte per vertex
+    return kPathImplOverheadBytes + path.capacity() * (sizeof(BLPoint) + sizeof(uint8_t));
+}
 
 } // namespace path_cache
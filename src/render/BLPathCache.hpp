@@ -1,220 +1,139 @@
 #pragma once
 
 #include <blend2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <unordered_map>
-#include <string>
-#include <memory>
-#include <chrono>
+
+#include "pcb/StringInterner.hpp"
 
 namespace path_cache {
 
 // Cache key for path operations
+// Performance optimization: Plain words only (kind symbol, owner id, part symbol, zoom bucket, quantized stroke, end
+// points), so a lookup hashes and compares a few words and no string is built per element
 struct PathCacheKey {
-    std::string element_id;
-    double thickness;
-    BLStrokeCap start_cap;
-    BLStrokeCap end_cap;
-    uint32_t transform_hash;  // Hash of transformation matrix
-    
+    SymbolId kind = StringInterner::kEmptySymbol;  // "trace", "component", ...
+    uint64_t owner_id = 0;                         // Trace/component the path belongs to; a hash of points for traces
+    SymbolId part = StringInterner::kEmptySymbol;  // Sub-element name within the owner, if any
+    // A trace's end points, so two traces whose points hash to the same owner_id never share an outline. Left at
+    // zero by keys whose owner_id is already unique.
+    double points[4] = {0.0, 0.0, 0.0, 0.0};
+    int32_t thickness_microns = 0;                 // Stroke width in thousandths of a world unit
+    int32_t zoom_bucket = 0;                       // See BLPathCache::GetZoomBucket; sets the flattening tolerance
+    uint32_t transform_hash = 0;                   // Hash of transformation matrix
+    BLStrokeCap start_cap = BL_STROKE_CAP_ROUND;
+    BLStrokeCap end_cap = BL_STROKE_CAP_ROUND;
+
     bool operator==(const PathCacheKey& other) const {
-        return element_id == other.element_id &&
-               std::abs(thickness - other.thickness) < 0.001 &&
-               start_cap == other.start_cap &&
-               end_cap == other.end_cap &&
-               transform_hash == other.transform_hash;
+        return kind == other.kind && owner_id == other.owner_id && part == other.part &&
+               thickness_microns == other.thickness_microns && zoom_bucket == other.zoom_bucket &&
+               transform_hash == other.transform_hash && start_cap == other.start_cap && end_cap == other.end_cap &&
+               points[0] == other.points[0] && points[1] == other.points[1] && points[2] == other.points[2] && points[3] == other.points[3];
     }
 };
 
 // Hash function for PathCacheKey
 struct PathCacheKeyHash {
     std::size_t operator()(const PathCacheKey& key) const {
-        std::size_t h1 = std::hash<std::string>{}(key.element_id);
-        std::size_t h2 = std::hash<double>{}(key.thickness);
-        std::size_t h3 = std::hash<int>{}(static_cast<int>(key.start_cap));
-        std::size_t h4 = std::hash<int>{}(static_cast<int>(key.end_cap));
-        std::size_t h5 = std::hash<uint32_t>{}(key.transform_hash);
-        
-        // Combine hashes
-        return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3) ^ (h5 << 4);
-    }
-};
-
-// Cached path entry
-struct CachedPath {
-    BLPath original_path;
-    BLPath stroked_path;
-    BLStrokeOptions stroke_options;
-    std::chrono::steady_clock::time_point last_used;
-    bool is_valid;
-    
-    CachedPath() : is_valid(false) {
-        last_used = std::chrono::steady_clock::now();
-    }
-    
-    void UpdateLastUsed() {
-        last_used = std::chrono::steady_clock::now();
-    }
-    
-    bool IsExpired(std::chrono::milliseconds max_age) const {
-        auto now = std::chrono::steady_clock::now();
-        return (now - last_used) > max_age;
+        uint64_t h = key.owner_id;
+        auto mix = [&h](uint64_t value) {
+            h ^= value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        };
+        mix((static_cast<uint64_t>(key.kind) << 32) | key.part);
+        mix((static_cast<uint64_t>(static_cast<uint32_t>(key.thickness_microns)) << 32) | static_cast<uint32_t>(key.zoom_bucket));
+        mix((static_cast<uint64_t>(key.transform_hash) << 16) | (static_cast<uint64_t>(key.start_cap) << 8) | key.end_cap);
+        return static_cast<std::size_t>(h);
     }
 };
 
 // High-performance path cache for Blend2D operations
+// Performance optimization: Entries sit on an intrusive least-recently-used list, so a hit or an eviction is O(1),
+// and the cache is bounded by the bytes its paths hold rather than by entry count.
+// Not thread-safe; a returned path stays valid until the next call that can insert or evict.
 class BLPathCache {
-private:
-    std::unordered_map<PathCacheKey, CachedPath, PathCacheKeyHash> m_cache_;
-    std::chrono::milliseconds m_max_age_;
-    size_t m_max_entries_;
-    mutable size_t m_cache_hits_;
-    mutable size_t m_cache_misses_;
-    
-    // Clean up expired entries
-    void CleanupExpired() {
-        auto now = std::chrono::steady_clock::now();
-        auto it = m_cache_.begin();
-        while (it != m_cache_.end()) {
-            if (it->second.IsExpired(m_max_age_)) {
-                it = m_cache_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-    
-    // Remove least recently used entries if cache is full
-    void EvictLRU() {
-        if (m_cache_.size() <= m_max_entries_) {
-            return;
-        }
-        
-        // Find oldest entry
-        auto oldest_it = m_cache_.begin();
-        for (auto it = m_cache_.begin(); it != m_cache_.end(); ++it) {
-            if (it->second.last_used < oldest_it->second.last_used) {
-                oldest_it = it;
-            }
-        }
-        
-        if (oldest_it != m_cache_.end()) {
-            m_cache_.erase(oldest_it);
-        }
-    }
-
 public:
-    explicit BLPathCache(size_t max_entries = 1000, std::chrono::milliseconds max_age = std::chrono::minutes(5))
-        : m_max_age_(max_age), m_max_entries_(max_entries), m_cache_hits_(0), m_cache_misses_(0) {}
-    
+    static constexpr size_t kDefaultByteBudget = 32 * 1024 * 1024;
+    // Flattening tolerance of zoom bucket 0, in world units; each bucket is a quarter octave of zoom
+    static constexpr double kBaseFlattenTolerance = 0.2;
+    static constexpr int kZoomBucketsPerOctave = 4;
+
+    explicit BLPathCache(size_t byte_budget = kDefaultByteBudget);
+    ~BLPathCache();
+
+    BLPathCache(const BLPathCache&) = delete;
+    BLPathCache& operator=(const BLPathCache&) = delete;
+
     // Get or create a stroked path
-    const BLPath& GetStrokedPath(const PathCacheKey& key, const BLPath& original_path,
-                                const BLStrokeOptions& stroke_options) {
-        // Check if path is in cache
-        auto it = m_cache_.find(key);
-        if (it != m_cache_.end() && it->second.is_valid && !it->second.IsExpired(m_max_age_)) {
-            it->second.UpdateLastUsed();
-            ++m_cache_hits_;
-            return it->second.stroked_path;
-        }
-
-        ++m_cache_misses_;
-
-        // Create new cached entry
-        CachedPath& cached = m_cache_[key];
-        cached.original_path = original_path;
-        cached.stroke_options = stroke_options;
-
-        // Generate stroked path using correct Blend2D API
-        cached.stroked_path.clear();
-
-        // Use BLPath::addStrokedPath method (correct API)
-        BLApproximationOptions approx_opts;
-        approx_opts.flattenMode = BL_FLATTEN_MODE_DEFAULT;
-        approx_opts.flattenTolerance = 0.2;
-        BLResult result = cached.stroked_path.addStrokedPath(cached.original_path, stroke_options, approx_opts);
-
-        if (result == BL_SUCCESS) {
-            cached.is_valid = true;
-            cached.UpdateLastUsed();
-        } else {
-            cached.is_valid = false;
-            // Return original path as fallback
-            cached.stroked_path = original_path;
-        }
-
-        // Cleanup if needed
-        EvictLRU();
-
-        return cached.stroked_path;
-    }
-    
-    // Invalidate a specific cache entry
-    void Invalidate(const PathCacheKey& key) {
-        auto it = m_cache_.find(key);
-        if (it != m_cache_.end()) {
-            it->second.is_valid = false;
-        }
-    }
-    
-    // Clear all cache entries
-    void Clear() {
-        m_cache_.clear();
-        m_cache_hits_ = 0;
-        m_cache_misses_ = 0;
-    }
-    
-    // Perform maintenance (cleanup expired entries)
-    void Maintenance() {
-        CleanupExpired();
-        EvictLRU();
-    }
-    
+    const BLPath& GetStrokedPath(const PathCacheKey& key, const BLPath& original_path, const BLStrokeOptions& stroke_options);
+
+    // Drop a specific cache entry
+    void Invalidate(const PathCacheKey& key);
+
+    // Clear all cache entries and statistics
+    void Clear();
+
+    // Evicts least recently used entries until the cache fits the new budget
+    void SetByteBudget(size_t byte_budget);
+    [[nodiscard]] size_t GetByteBudget() const { return m_byte_budget_; }
+
     // Get cache statistics
     struct CacheStats {
-        size_t total_entries;
-        size_t cache_hits;
-        size_t cache_misses;
-        double hit_ratio;
+        size_t total_entries = 0;
+        size_t total_bytes = 0;
+        size_t byte_budget = 0;
+        size_t cache_hits = 0;
+        size_t cache_misses = 0;
+        size_t evictions = 0;
+        double hit_ratio = 0.0;
     };
-    
-    CacheStats GetStats() const {
-        CacheStats stats;
-        stats.total_entries = m_cache_.size();
-        stats.cache_hits = m_cache_hits_;
-        stats.cache_misses = m_cache_misses_;
-        
-        size_t total_requests = m_cache_hits_ + m_cache_misses_;
-        stats.hit_ratio = total_requests > 0 ? static_cast<double>(m_cache_hits_) / total_requests : 0.0;
-        
-        return stats;
-    }
-    
+
+    [[nodiscard]] CacheStats GetStats() const;
+
+    // Zoom bucket for a camera zoom: paths flattened for one bucket look the same across it
+    static int32_t GetZoomBucket(double zoom);
+    static double GetFlattenTolerance(int32_t zoom_bucket);
+
     // Generate cache key for trace elements
-    static PathCacheKey CreateTraceKey(const std::string& trace_id, double thickness, 
-                                      BLStrokeCap start_cap, BLStrokeCap end_cap) {
-        PathCacheKey key;
-        key.element_id = "trace_" + trace_id;
-        key.thickness = thickness;
-        key.start_cap = start_cap;
-        key.end_cap = end_cap;
-        key.transform_hash = 0;  // No transform for basic traces
-        return key;
-    }
-    
+    static PathCacheKey CreateTraceKey(uint64_t trace_id, double thickness, BLStrokeCap start_cap, BLStrokeCap end_cap, int32_t zoom_bucket = 0);
+    // Trace key from the segment itself: equal only for the same end points, whatever their hash
+    static PathCacheKey CreateTraceKey(double start_x, double start_y, double end_x, double end_y, double thickness, BLStrokeCap start_cap,
+                                       BLStrokeCap end_cap, int32_t zoom_bucket);
+
     // Generate cache key for component elements
-    static PathCacheKey CreateComponentKey(const std::string& component_id, const std::string& element_id,
-                                          double thickness, uint32_t transform_hash = 0) {
-        PathCacheKey key;
-        key.element_id = "comp_" + component_id + "_" + element_id;
-        key.thickness = thickness;
-        key.start_cap = BL_STROKE_CAP_ROUND;
-        key.end_cap = BL_STROKE_CAP_ROUND;
-        key.transform_hash = transform_hash;
-        return key;
-    }
+    static PathCacheKey CreateComponentKey(uint64_t component_id, InternedString element_name, double thickness, uint32_t transform_hash = 0,
+                                           int32_t zoom_bucket = 0);
+
+private:
+    struct Entry {
+        BLPath stroked_path;
+        size_t bytes = 0;
+        const PathCacheKey* key = nullptr;  // Points at the map node's key, which never moves
+        Entry* lru_prev = nullptr;          // Towards the most recently used entry
+        Entry* lru_next = nullptr;
+    };
+
+    void LinkFront(Entry* entry);
+    void Unlink(Entry* entry);
+    void Erase(Entry* entry);
+    void EvictToBudget(const Entry* keep);
+    static size_t GetPathBytes(const BLPath& path);
+
+    std::unordered_map<PathCacheKey, Entry, PathCacheKeyHash> m_cache_;
+    Entry* m_lru_head_ = nullptr;  // Most recently used
+    Entry* m_lru_tail_ = nullptr;  // Next to evict
+    size_t m_byte_budget_;
+    size_t m_total_bytes_ = 0;
+    size_t m_cache_hits_ = 0;
+    size_t m_cache_misses_ = 0;
+    size_t m_evictions_ = 0;
 };
 
 // Global path cache instance
 extern BLPathCache g_path_cache;
+// Guards g_path_cache: band workers and tile renderers draw on several threads. Copy a returned path (reference
+// counted, so the copy is cheap) before unlocking; another thread's insert may evict the entry.
+extern std::mutex g_path_cache_mutex;
 
 } // namespace path_cache
@@ -0,0 +1,174 @@
+#include "BoardImageExporter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TileRenderer.hpp"
+#include "core/BoardDataManager.hpp"
+#include "pcb/Board.hpp"
+#include "view/Camera.hpp"
+#include "view/GridSettings.hpp"
+
+namespace
+{
+std::string GetTileFileName(int column, int row)
+{
+    return std::to_string(column) + "_" + std::to_string(row) + ".png";
+}
+
+bool WriteManifest(const std::filesystem::path& path, const BoardImageExporter::Options& options, const BLRect& region, const BoardImageExporter::Result& result)
+{
+    std::ofstream manifest(path);
+    if (!manifest) {
+        return false;
+    }
+    manifest << "{\n"
+             << "  \"width\": " << result.image_width << ",\n"
+             << "  \"height\": " << result.image_height << ",\n"
+             << "  \"tile_size\": " << options.tile_size << ",\n"
+             << "  \"columns\": " << result.columns << ",\n"
+             << "  \"rows\": " << result.rows << ",\n"
+             << "  \"dpi\": " << options.dpi << ",\n"
+             << "  \"world_region\": [" << region.x << ", " << region.y << ", " << region.w << ", " << region.h << "],\n"
+             << "  \"tile_pattern\": \"{column}_{row}.png\"\n"
+             << "}\n";
+    return static_cast<bool>(manifest);
+}
+}  // namespace
+
+double BoardImageExporter::GetPixelsPerWorldUnit(double dpi)
+{
+    return dpi / static_cast<double>(GridSettings::InchesToWorldUnits(1.0F));
+}
+
+BoardImageExporter::Result BoardImageExporter::Export(const std::shared_ptr<BoardDataManager>& board_data_manager, const Options& options,
+                                                      const ProgressCallback& progress)
+{
+    Result result;
+    const auto export_start = std::chrono::steady_clock::now();
+
+    // One snapshot for the whole export: later UI changes do not mix into it
+    const std::shared_ptr<const BoardDataManager::ViewState> view_state = board_data_manager ? board_data_manager->GetViewState() : nullptr;
+    const std::shared_ptr<const Board> board = view_state ? view_state->board : nullptr;
+    if (!board || !board->IsLoaded()) {
+        result.error_message = "No board loaded";
+        return result;
+    }
+    if (options.tile_size < 16 || options.tile_size > 8192) {
+        result.error_message = "Tile size must be between 16 and 8192 pixels";
+        return result;
+    }
+
+    // Camera zoom is a float; the same value places every tile, so tiles line up exactly
+    Camera camera;
+    camera.SetZoom(static_cast<float>(GetPixelsPerWorldUnit(options.dpi)));
+    const double zoom = camera.GetZoom();
+    if (!(options.dpi > 0.0) || std::abs(zoom - GetPixelsPerWorldUnit(options.dpi)) > 1e-6 * zoom) {
+        result.error_message = "DPI outside the supported zoom range";
+        return result;
+    }
+
+    BLRect region = options.world_region;
+    if (!(region.w > 0.0) || !(region.h > 0.0)) {
+        region = board->GetBoundingBox(false);
+    }
+    const double image_width = std::ceil(region.w * zoom);
+    const double image_height = std::ceil(region.h * zoom);
+    if (!(image_width >= 1.0) || !(image_height >= 1.0) || image_width > kMaxImageSide || image_height > kMaxImageSide) {
+        result.error_message = "Export size out of range";
+        return result;
+    }
+    result.image_width = static_cast<int>(image_width);
+    result.image_height = static_cast<int>(image_height);
+    result.columns = (result.image_width + options.tile_size - 1) / options.tile_size;
+    result.rows = (result.image_height + options.tile_size - 1) / options.tile_size;
+
+    const std::filesystem::path output_directory(options.output_directory);
+    std::error_code error;
+    std::filesystem::create_directories(output_directory, error);
+    if (error) {
+        result.error_message = "Cannot create " + output_directory.string() + ": " + error.message();
+        return result;
+    }
+
+    const int tile_count = result.columns * result.rows;
+    int thread_count = options.thread_count > 0 ? options.thread_count : static_cast<int>(std::thread::hardware_concurrency());
+    thread_count = std::clamp(thread_count, 1, tile_count);
+
+    std::cout << "BoardImageExporter: " << result.image_width << "x" << result.image_height << " px at " << options.dpi << " DPI, " << tile_count << " tiles on "
+              << thread_count << " threads" << std::endl;
+
+    std::atomic<int> next_tile {0};
+    std::atomic<int> tiles_done {0};
+    std::atomic<bool> failed {false};
+    std::mutex error_mutex;
+
+    auto worker = [&]() {
+        TileRenderer tile_renderer;
+        if (!tile_renderer.Initialize(options.tile_size, board_data_manager, options.background_color)) {
+            failed = true;
+            return;
+        }
+
+        for (int tile_index = next_tile++; tile_index < tile_count && !failed; tile_index = next_tile++) {
+            const int column = tile_index % result.columns;
+            const int row = tile_index / result.columns;
+            const int tile_x = column * options.tile_size;
+            const int tile_y = row * options.tile_size;
+            const int tile_width = std::min(options.tile_size, result.image_width - tile_x);
+            const int tile_height = std::min(options.tile_size, result.image_height - tile_y);
+
+            const BLPoint tile_origin(region.x + tile_x / zoom, region.y + tile_y / zoom);
+            const BLImage& tile_image = tile_renderer.Render(*board, tile_origin, zoom, tile_width, tile_height, view_state);
+
+            const std::filesystem::path tile_path = output_directory / GetTileFileName(column, row);
+            if (tile_image.writeToFile(tile_path.string().c_str()) != BL_SUCCESS) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!failed.exchange(true)) {
+                    result.error_message = "Failed to write " + tile_path.string();
+                }
+                return;
+            }
+
+            const int done = ++tiles_done;
+            if (progress) {
+                progress(done, tile_count);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(thread_count));
+    for (int i = 0; i < thread_count; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    result.tiles_written = tiles_done;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - export_start).count();
+    if (failed) {
+        if (result.error_message.empty()) {
+            result.error_message = "Failed to set up a tile renderer";
+        }
+        return result;
+    }
+    if (!WriteManifest(output_directory / "manifest.json", options, region, result)) {
+        result.error_message = "Failed to write the manifest";
+        return result;
+    }
+
+    result.success = true;
+    std::cout << "BoardImageExporter: Wrote " << result.tiles_written << " tiles to " << output_directory.string() << " in " << result.elapsed_ms << " ms"
+              << std::endl;
+    return result;
+}
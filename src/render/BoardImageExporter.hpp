@@ -0,0 +1,54 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+class BoardDataManager;
+
+// Headless export of a board region at print resolution (repair documentation, posters), far beyond the size of
+// the viewport image. The output is a directory of PNG tiles plus a manifest.json describing the grid:
+//   <output_directory>/manifest.json
+//   <output_directory>/<column>_<row>.png
+// Performance optimization: Workers each own a TileRenderer (a RenderPipeline and a tile-sized RenderContext),
+// take tiles from a shared counter and write them as soon as they are drawn, so memory stays at one tile per
+// worker whatever the output size, and tiles render in parallel.
+// The board, layer visibility, colors, folding and view side are those of the BoardDataManager's published view
+// state, i.e. what the UI shows.
+class BoardImageExporter
+{
+public:
+    struct Options {
+        std::string output_directory;
+        BLRect world_region {0, 0, 0, 0};  // World units; empty exports the bounds of the visible layers
+        double dpi = 600.0;                // World units are converted with GridSettings::InchesToWorldUnits
+        int tile_size = 1024;              // Pixels per tile side
+        int thread_count = 0;              // Tiles rendered at once; 0 uses the hardware concurrency
+        BLRgba32 background_color = BLRgba32(0xFF000000);
+    };
+
+    struct Result {
+        bool success = false;
+        std::string error_message;
+        int image_width = 0;  // Of the whole export, in pixels
+        int image_height = 0;
+        int columns = 0;
+        int rows = 0;
+        int tiles_written = 0;
+        double elapsed_ms = 0.0;
+    };
+
+    // Called from worker threads after each tile, with the tiles finished so far and the total
+    using ProgressCallback = std::function<void(int tiles_done, int tile_count)>;
+
+    static Result Export(const std::shared_ptr<BoardDataManager>& board_data_manager, const Options& options,
+                         const ProgressCallback& progress = nullptr);
+
+    // Output pixels per world unit at a DPI
+    static double GetPixelsPerWorldUnit(double dpi);
+
+    // Largest export side, in pixels; tile coordinates and the manifest stay within int
+    static constexpr int kMaxImageSide = 1 << 30;
+};
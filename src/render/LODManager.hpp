@@ -80,18 +80,7 @@ public:
         }
         
         // Determine LOD based on zoom level
-        LODLevel zoom_lod;
-        if (zoom < m_settings_.very_low_threshold) {
-            zoom_lod = LODLevel::kVeryLow;
-        } else if (zoom < m_settings_.low_threshold) {
-            zoom_lod = LODLevel::kLow;
-        } else if (zoom < m_settings_.medium_threshold) {
-            zoom_lod = LODLevel::kMedium;
-        } else if (zoom < m_settings_.high_threshold) {
-            zoom_lod = LODLevel::kHigh;
-        } else {
-            zoom_lod = LODLevel::kVeryHigh;
-        }
+        LODLevel zoom_lod = GetZoomLOD(zoom);
         
         // Adjust LOD based on scene complexity
         LODLevel complexity_lod = zoom_lod;
@@ -109,6 +98,20 @@ public:
         return complexity_lod;
     }
     
+    // LOD level for a zoom alone, without the scene complexity and interactive adjustments
+    LODLevel GetZoomLOD(double zoom) const {
+        if (zoom < m_settings_.very_low_threshold) {
+            return LODLevel::kVeryLow;
+        } else if (zoom < m_settings_.low_threshold) {
+            return LODLevel::kLow;
+        } else if (zoom < m_settings_.medium_threshold) {
+            return LODLevel::kMedium;
+        } else if (zoom < m_settings_.high_threshold) {
+            return LODLevel::kHigh;
+        }
+        return LODLevel::kVeryHigh;
+    }
+
     // Apply LOD settings to Blend2D context
     void ApplyLODToContext(BLContext& ctx, LODLevel lod) const {
         const LODSettings::QualitySettings* quality = GetQualitySettings(lod);
@@ -0,0 +1,207 @@
+#include "OverviewPyramid.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "TileRenderer.hpp"
+#include "pcb/Board.hpp"
+
+namespace
+{
+void HashCombine(uint64_t& seed, uint64_t value)
+{
+    seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2);
+}
+}  // namespace
+
+size_t OverviewPyramid::Levels::SelectLevel(double zoom) const
+{
+    size_t level = 0;
+    while (level + 1 < m_levels_.size() && std::ldexp(m_base_zoom_, -static_cast<int>(level + 1)) >= zoom) {
+        ++level;
+    }
+    return level;
+}
+
+size_t OverviewPyramid::Levels::GetMemoryUsageBytes() const
+{
+    size_t bytes = 0;
+    for (const BLImage& level : m_levels_) {
+        bytes += static_cast<size_t>(level.width()) * static_cast<size_t>(level.height()) * 4;
+    }
+    return bytes;
+}
+
+OverviewPyramid::~OverviewPyramid()
+{
+    Clear();
+}
+
+std::shared_ptr<const OverviewPyramid::Levels> OverviewPyramid::Acquire(const std::shared_ptr<const Board>& board,
+                                                                        const std::shared_ptr<const BoardDataManager::ViewState>& view_state,
+                                                                        const std::shared_ptr<BoardDataManager>& board_data_manager, double zoom,
+                                                                        int viewport_max_side)
+{
+    PollPendingBuild();
+    if (!board || !board->IsLoaded() || !view_state) {
+        return nullptr;
+    }
+
+    if (m_bounds_board_.lock() != board || m_bounds_revision_ != board->GetGeometryRevision()) {
+        const BLRect outline = board->GetBoundingBox(true);
+        const double padding = std::max(outline.w, outline.h) * kBoundsPadding;
+        m_bounds_ = BLRect(outline.x - padding, outline.y - padding, outline.w + 2.0 * padding, outline.h + 2.0 * padding);
+        m_bounds_board_ = board;
+        m_bounds_revision_ = board->GetGeometryRevision();
+    }
+    if (!(m_bounds_.w > 0.0) || !(m_bounds_.h > 0.0)) {
+        return nullptr;
+    }
+    const int base_side = GetBaseSide(viewport_max_side);
+    const double base_zoom = base_side / std::max(m_bounds_.w, m_bounds_.h);
+    if (zoom > base_zoom) {
+        return nullptr;
+    }
+
+    const uint64_t key = MakeKey(*board, *view_state, base_side);
+    for (size_t i = 0; i < m_pyramids_.size(); ++i) {
+        if (m_pyramids_[i]->m_key_ == key && m_pyramids_[i]->m_board_.lock() == board) {
+            std::rotate(m_pyramids_.begin(), m_pyramids_.begin() + static_cast<std::ptrdiff_t>(i), m_pyramids_.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+            return m_pyramids_.front();
+        }
+    }
+
+    if (m_pending_) {
+        // One build at a time; a configuration the user already left is cancelled, and the current one starts
+        // once it has wound down
+        if (m_pending_->key != key) {
+            m_pending_->cancelled->store(true, std::memory_order_relaxed);
+        }
+        return nullptr;
+    }
+
+    auto pending = std::make_unique<PendingBuild>();
+    pending->key = key;
+    pending->cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<std::atomic<bool>> cancelled = pending->cancelled;
+    const BLRect bounds = m_bounds_;
+    pending->result = std::async(std::launch::async, [board, view_state, board_data_manager, bounds, base_zoom, key, cancelled]() {
+        return Build(board, view_state, board_data_manager, bounds, base_zoom, key, *cancelled);
+    });
+    m_pending_ = std::move(pending);
+    return nullptr;
+}
+
+bool OverviewPyramid::PollPendingBuild()
+{
+    if (!m_pending_ || m_pending_->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+
+    std::unique_ptr<PendingBuild> pending = std::move(m_pending_);
+    std::shared_ptr<Levels> levels = pending->result.get();
+    if (!levels || pending->cancelled->load(std::memory_order_relaxed)) {
+        return false;
+    }
+    while (m_pyramids_.size() >= kMaxPyramids) {
+        m_pyramids_.pop_back();
+    }
+    m_pyramids_.insert(m_pyramids_.begin(), std::move(levels));
+    return true;
+}
+
+void OverviewPyramid::Clear()
+{
+    if (m_pending_) {
+        // The worker stops at its next tile; PollPendingBuild() drops its result
+        m_pending_->cancelled->store(true, std::memory_order_relaxed);
+    }
+    m_pyramids_.clear();
+}
+
+int OverviewPyramid::GetBaseSide(int viewport_max_side)
+{
+    int side = kMinBaseSide;
+    while (side < viewport_max_side && side < kMaxBaseSide) {
+        side *= 2;
+    }
+    return side;
+}
+
+uint64_t OverviewPyramid::MakeKey(const Board& board, const BoardDataManager::ViewState& view_state, int base_side)
+{
+    // Everything RenderBoard reads from the view state; the box selection overlay is drawn on top separately
+    uint64_t key = reinterpret_cast<uintptr_t>(&board);
+    HashCombine(key, board.GetGeometryRevision());
+    HashCombine(key, static_cast<uint64_t>(base_side));
+    HashCombine(key, static_cast<uint64_t>(view_state.view_side));
+    HashCombine(key, static_cast<uint64_t>(static_cast<int64_t>(view_state.selected_net_id)));
+    HashCombine(key, reinterpret_cast<uintptr_t>(view_state.selected_element));
+    HashCombine(key, static_cast<uint64_t>(view_state.board_outline_thickness * 1000.0f));
+    HashCombine(key, static_cast<uint64_t>(view_state.component_stroke_thickness * 1000.0f));
+    HashCombine(key, static_cast<uint64_t>(view_state.pin_stroke_thickness * 1000.0f));
+    for (size_t i = 0; i < board.layers.size(); ++i) {
+        HashCombine(key, view_state.IsLayerVisible(static_cast<int>(i)) ? 1 : 0);
+        HashCombine(key, view_state.GetLayerColor(board.layers[i].GetId()).value);
+    }
+    for (int type = 0; type <= static_cast<int>(BoardDataManager::ColorType::kNC); ++type) {
+        HashCombine(key, view_state.GetColor(static_cast<BoardDataManager::ColorType>(type)).value);
+    }
+    return key;
+}
+
+std::shared_ptr<OverviewPyramid::Levels> OverviewPyramid::Build(std::shared_ptr<const Board> board, std::shared_ptr<const BoardDataManager::ViewState> view_state,
+                                                                std::shared_ptr<BoardDataManager> board_data_manager, const BLRect& bounds, double base_zoom,
+                                                                uint64_t key, const std::atomic<bool>& cancelled)
+{
+    const auto build_start = std::chrono::steady_clock::now();
+    auto levels = std::make_shared<Levels>();
+    levels->m_board_ = board;
+    levels->m_key_ = key;
+    levels->m_base_zoom_ = base_zoom;
+    const int width = std::max(1, static_cast<int>(std::ceil(bounds.w * levels->m_base_zoom_)));
+    const int height = std::max(1, static_cast<int>(std::ceil(bounds.h * levels->m_base_zoom_)));
+    levels->m_world_bounds_ = BLRect(bounds.x, bounds.y, width / levels->m_base_zoom_, height / levels->m_base_zoom_);
+
+    // Level 0, drawn in tiles on a transparent background so the grid shows through like with vectors
+    BLImage base(width, height, BL_FORMAT_PRGB32);
+    TileRenderer tile_renderer;
+    if (!tile_renderer.Initialize(kBuildTileSize, board_data_manager, BLRgba32(0))) {
+        return nullptr;
+    }
+    BLContext base_ctx(base);
+    base_ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+    for (int tile_y = 0; tile_y < height; tile_y += kBuildTileSize) {
+        for (int tile_x = 0; tile_x < width; tile_x += kBuildTileSize) {
+            if (cancelled.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            const BLPoint origin(bounds.x + tile_x / levels->m_base_zoom_, bounds.y + tile_y / levels->m_base_zoom_);
+            const int tile_width = std::min(kBuildTileSize, width - tile_x);
+            const int tile_height = std::min(kBuildTileSize, height - tile_y);
+            base_ctx.blitImage(BLPointI(tile_x, tile_y), tile_renderer.Render(*board, origin, levels->m_base_zoom_, tile_width, tile_height, view_state));
+        }
+    }
+    base_ctx.end();
+    levels->m_levels_.push_back(std::move(base));
+
+    // Each level halves the previous one; bilinear sampling at exactly half size averages 2x2 texels
+    while (std::max(levels->m_levels_.back().width(), levels->m_levels_.back().height()) / 2 >= kMinLevelSide) {
+        const BLImage& previous = levels->m_levels_.back();
+        BLImage level((previous.width() + 1) / 2, (previous.height() + 1) / 2, BL_FORMAT_PRGB32);
+        BLContext level_ctx(level);
+        level_ctx.clearAll();  // The odd last row and column are only partly covered
+        level_ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+        level_ctx.setHint(BL_CONTEXT_HINT_PATTERN_QUALITY, BL_PATTERN_QUALITY_BILINEAR);
+        level_ctx.blitImage(BLRect(0, 0, previous.width() / 2.0, previous.height() / 2.0), previous);
+        level_ctx.end();
+        levels->m_levels_.push_back(std::move(level));
+    }
+
+    const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+    std::cout << "OverviewPyramid: Built " << width << "x" << height << " with " << levels->m_levels_.size() << " levels in " << build_ms << " ms ("
+              << levels->GetMemoryUsageBytes() / (1024 * 1024) << " MB)" << std::endl;
+    return levels;
+}
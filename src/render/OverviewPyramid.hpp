@@ -0,0 +1,101 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "core/BoardDataManager.hpp"
+
+class Board;
+
+// Performance optimization: Multi-resolution raster of the whole board for zoomed-out views.
+// At the fit-to-board zoom nearly every trace, pin and label is smaller than a pixel, yet drawing them as
+// vectors costs as much as at any other zoom. The pyramid renders the board once (in tiles, off the rendering
+// thread) at about the viewport's resolution and halves it level by level; while the camera zoom is at or
+// below the base level's resolution, frames blit the nearest level with bilinear filtering instead, which
+// costs the same whatever the board holds.
+//
+// A pyramid belongs to one view configuration: board variant and geometry revision, layer visibility, colors,
+// selection and view side. The last few configurations are kept, so toggling a layer back is instant.
+//
+// Usage, once per frame on the rendering thread:
+//   Acquire() - null while the zoom is above the threshold. Below it, returns the configuration's pyramid if
+//               built; otherwise starts building it on a worker and returns null, and the frame renders
+//               vectors as before.
+class OverviewPyramid
+{
+public:
+    static constexpr int kMinBaseSide = 512;   // Pixels; base side is the viewport's larger side rounded up to a power of two
+    static constexpr int kMaxBaseSide = 4096;  // ~85 MB per pyramid with all levels
+    static constexpr int kMinLevelSide = 32;   // Levels stop halving below this
+    static constexpr int kBuildTileSize = 1024;
+    static constexpr size_t kMaxPyramids = 3;  // Configurations kept at once
+    static constexpr double kBoundsPadding = 0.02;  // Of the board outline, for copper and silkscreen just past it
+
+    // Immutable once published
+    class Levels
+    {
+    public:
+        [[nodiscard]] const BLRect& GetWorldBounds() const { return m_world_bounds_; }
+        [[nodiscard]] double GetBaseZoom() const { return m_base_zoom_; }  // Pixels per world unit of level 0
+        [[nodiscard]] size_t GetLevelCount() const { return m_levels_.size(); }
+        // Coarsest level that still has at least one texel per screen pixel at zoom
+        [[nodiscard]] size_t SelectLevel(double zoom) const;
+        [[nodiscard]] const BLImage& GetLevel(size_t index) const { return m_levels_[index]; }
+        [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+    private:
+        friend class OverviewPyramid;
+
+        std::weak_ptr<const Board> m_board_;
+        uint64_t m_key_ = 0;
+        BLRect m_world_bounds_ {};
+        double m_base_zoom_ = 0.0;
+        std::vector<BLImage> m_levels_;  // Level 0 is the full resolution
+    };
+
+    OverviewPyramid() = default;
+    ~OverviewPyramid();
+    OverviewPyramid(const OverviewPyramid&) = delete;
+    OverviewPyramid& operator=(const OverviewPyramid&) = delete;
+
+    // view_state's board must be board. board_data_manager supplies the settings the view state does not hold.
+    // zoom is the camera's; the threshold is the base level's resolution, so a level is never magnified.
+    std::shared_ptr<const Levels> Acquire(const std::shared_ptr<const Board>& board, const std::shared_ptr<const BoardDataManager::ViewState>& view_state,
+                                          const std::shared_ptr<BoardDataManager>& board_data_manager, double zoom, int viewport_max_side);
+
+    // Publishes a finished build; true if a new pyramid became available (a frame drawn now would use it)
+    bool PollPendingBuild();
+    [[nodiscard]] bool IsBuildPending() const { return m_pending_ != nullptr; }
+
+    // Drops all pyramids and cancels a pending build
+    void Clear();
+
+    // Base side for a viewport: a power of two, so small resizes do not rebuild
+    static int GetBaseSide(int viewport_max_side);
+
+private:
+    struct PendingBuild {
+        uint64_t key = 0;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::future<std::shared_ptr<Levels>> result;  // Null if cancelled or the board was empty
+    };
+
+    static uint64_t MakeKey(const Board& board, const BoardDataManager::ViewState& view_state, int base_side);
+    static std::shared_ptr<Levels> Build(std::shared_ptr<const Board> board, std::shared_ptr<const BoardDataManager::ViewState> view_state,
+                                         std::shared_ptr<BoardDataManager> board_data_manager, const BLRect& bounds, double base_zoom, uint64_t key,
+                                         const std::atomic<bool>& cancelled);
+
+    // Padded board outline bounds, recomputed when the board or its geometry changes
+    std::weak_ptr<const Board> m_bounds_board_;
+    uint64_t m_bounds_revision_ = 0;
+    BLRect m_bounds_ {};
+
+    std::vector<std::shared_ptr<const Levels>> m_pyramids_;  // Most recently used first
+    std::unique_ptr<PendingBuild> m_pending_;
+};
@@ -5,12 +5,40 @@
 #include "render/RenderPipeline.hpp"
 #include "view/Camera.hpp"    // For camera parameters
 #include "view/Grid.hpp"      // For Grid rendering, if PcbRenderer calls it directly
+#include "view/GridSettings.hpp"
 #include "view/Viewport.hpp"  // For viewport parameters
                               // Otherwise, RenderPipeline might handle Grid.
 #include "core/Config.hpp"    // For configuration settings
+#include <chrono>
 #include <iostream>
 #include <thread>
 
+namespace
+{
+// While background work is pending the render thread polls it this often, to draw its result promptly
+constexpr std::chrono::milliseconds kBackgroundPollInterval(50);
+}  // namespace
+
+struct PcbRenderer::FrameRequest {
+    enum class Kind {
+        kScene,        // Grid and board
+        kPlaceholder,  // Camera, viewport or grid missing
+        kBlank         // Viewport has no area
+    };
+
+    Kind kind = Kind::kScene;
+    std::shared_ptr<const Board> board;  // Kept alive until the frame is done
+    Camera camera;
+    Viewport viewport;
+    GridSettings grid_settings;
+    int width = 0;  // Target image size (scene requests)
+    int height = 0;
+    bool render_grid = false;
+    bool render_board = false;
+    bool interactive = false;
+    bool invalidate_rendering_state = false;
+};
+
 PcbRenderer::PcbRenderer()
     : m_grid_dirty_(true),
       m_board_dirty_(true),
@@ -39,10 +67,18 @@ bool PcbRenderer::Initialize(int initial_width, int initial_height, std::shared_
     // Determine thread count from configuration or use optimal default
     int thread_count = 0;
     bool multithreading_enabled = true;
+    bool banded_rasterization_enabled = true;
+    bool overview_pyramid_enabled = true;
+    SubPixelBatch::Options sub_pixel_options;
 
     if (config) {
         thread_count = config->GetInt("rendering.threadCount", 0);
         multithreading_enabled = config->GetBool("rendering.enableMultithreading", true);
+        banded_rasterization_enabled = config->GetBool("rendering.bandedRasterization", true);
+        overview_pyramid_enabled = config->GetBool("rendering.overviewPyramid", true);
+        sub_pixel_options.trace_density = config->GetBool("rendering.subPixelTraceDensity", true);
+        sub_pixel_options.pad_points = config->GetBool("rendering.subPixelPadPoints", true);
+        sub_pixel_options.text_culling = config->GetBool("rendering.subPixelTextCulling", true);
     }
 
     // If multithreading is disabled, force single-threaded
@@ -62,6 +98,8 @@ bool PcbRenderer::Initialize(int initial_width, int initial_height, std::shared_
     }
     m_render_context_->OptimizeForStatic();  // Default to static
     m_is_interactive_optimized_ = false;
+    m_requested_width_ = initial_width;
+    m_requested_height_ = initial_height;
     m_render_pipeline_ = std::make_unique<RenderPipeline>();
     if (!m_render_pipeline_->Initialize(*m_render_context_)) {  // Pass the RenderContext by reference
         std::cerr << "PcbRenderer Error: Failed to initialize RenderPipeline." << std::endl;
@@ -70,6 +108,9 @@ bool PcbRenderer::Initialize(int initial_width, int initial_height, std::shared_
         m_render_pipeline_.reset();
         return false;
     }
+    m_render_pipeline_->SetBandedRasterizationEnabled(multithreading_enabled && banded_rasterization_enabled);
+    m_render_pipeline_->SetOverviewPyramidEnabled(overview_pyramid_enabled);
+    m_render_pipeline_->SetSubPixelCulling(sub_pixel_options);
 
     // Set the BoardDataManager in the RenderContext
     m_render_context_->SetBoardDataManager(m_board_data_manager_);
@@ -84,10 +125,8 @@ bool PcbRenderer::Initialize(int initial_width, int initial_height, std::shared_
             this->MarkBoardDirty();
             this->MarkGridDirty();
             // Invalidate the RenderPipeline's cached rendering state when settings change
-            // This ensures color changes are immediately visible
-            if (m_render_pipeline_) {
-                m_render_pipeline_->InvalidateRenderingStateCache();
-            }
+            // This ensures color changes are immediately visible (done by the render thread with the next request)
+            m_rendering_state_invalidated_ = true;
         });
         m_board_data_manager_->RegisterLayerVisibilityChangeCallback([this](int layer_id, bool visible) {
             this->MarkBoardDirty();  // Layer visibility changes require board redraw
@@ -101,6 +140,11 @@ bool PcbRenderer::Initialize(int initial_width, int initial_height, std::shared_
     std::cout << "  - Viewport: " << initial_width << "x" << initial_height << std::endl;
     std::cout << "  - Hardware threads available: " << std::thread::hardware_concurrency() << std::endl;
     std::cout << "  - Multithreading enabled: " << (multithreading_enabled ? "Yes" : "No") << std::endl;
+    std::cout << "  - Banded rasterization: " << (m_render_pipeline_->IsBandedRasterizationEnabled() ? "Yes" : "No") << std::endl;
+    std::cout << "  - Sub-pixel culling: traces " << (sub_pixel_options.trace_density ? "Yes" : "No") << ", pads " << (sub_pixel_options.pad_points ? "Yes" : "No")
+              << ", text " << (sub_pixel_options.text_culling ? "Yes" : "No") << std::endl;
+
+    StartRenderThread();
     return true;
 }
 
@@ -113,6 +157,9 @@ void PcbRenderer::Shutdown()
         m_board_data_manager_->UnregisterLayerVisibilityChangeCallback();
     }
 
+    // The render thread uses the pipeline and context until it is joined
+    StopRenderThread();
+
     if (m_render_pipeline_) {
         m_render_pipeline_->Shutdown();
         m_render_pipeline_.reset();
@@ -121,10 +168,11 @@ void PcbRenderer::Shutdown()
         m_render_context_->Shutdown();
         m_render_context_.reset();
     }
+    m_presented_image_.reset();
     // std::cout << "PcbRenderer shutdown." << std::endl;
 }
 
-void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewport* viewport, const Grid* grid)
+void PcbRenderer::Render(std::shared_ptr<const Board> board, const Camera* camera, const Viewport* viewport, const Grid* grid)
 {
     m_frame_rendered_this_cycle_ = false;  // Reset at the start of each Render call
 
@@ -134,8 +182,6 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
                 m_interactive_frames_counter_++;
             }
             if (m_interactive_frames_counter_ >= kInteractiveThreshold && !m_is_interactive_optimized_) {
-                if (m_render_context_)
-                    m_render_context_->OptimizeForInteractive();
                 m_is_interactive_optimized_ = true;
                 // std::cout << "Switched to OptimizeForInteractive" << std::endl;
             }
@@ -144,18 +190,12 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
                 m_interactive_frames_counter_ = 0;
             }
             if (m_is_interactive_optimized_) {
-                if (m_render_context_)
-                    m_render_context_->OptimizeForStatic();
                 m_is_interactive_optimized_ = false;
                 // std::cout << "Switched to OptimizeForStatic" << std::endl;
             }
         }
     } else {  // No camera, ensure static optimization and reset counters
-        if (m_is_interactive_optimized_) {
-            if (m_render_context_)
-                m_render_context_->OptimizeForStatic();
-            m_is_interactive_optimized_ = false;
-        }
+        m_is_interactive_optimized_ = false;
         m_interactive_frames_counter_ = 0;
     }
 
@@ -167,9 +207,9 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
     if (!camera || !viewport || !grid) {
         // Only redraw placeholder if needed or if it's the first time
         if (m_needs_redraw_signal_) {
-            m_render_context_->BeginFrame();
-            BLContext& ctx = m_render_context_->GetBlend2DContext();
-            ctx.fillAll(BLRgba32(0xFF111111));
+            auto request = std::make_unique<FrameRequest>();
+            request->kind = FrameRequest::Kind::kPlaceholder;
+            SubmitRequest(std::move(request));
             std::cerr << "PcbRenderer::Render Warning: Missing critical components (camera, viewport, or grid). Rendering placeholder." << std::endl;
             if (!camera)
                 std::cerr << "  - Camera is null" << std::endl;
@@ -177,10 +217,9 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
                 std::cerr << "  - Viewport is null" << std::endl;
             if (!grid)
                 std::cerr << "  - Grid is null" << std::endl;
-            m_render_context_->EndFrame();
-            m_frame_rendered_this_cycle_ = true;
             m_needs_redraw_signal_ = false;  //
         }
+        PresentLatestFrame();
         return;
     }
 
@@ -190,32 +229,227 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
     if (viewportWidth <= 0 || viewportHeight <= 0) {
         std::cerr << "PcbRenderer::Render Error: Invalid viewport dimensions (" << viewportWidth << "x" << viewportHeight << "). Skipping render." << std::endl;
         // Optionally, render a small placeholder or clear the existing image if it's differently sized
-        if (m_needs_redraw_signal_ && m_render_context_->GetImageWidth() > 0 && m_render_context_->GetImageHeight() > 0) {  // Check if context has an image
-            m_render_context_->BeginFrame();
-            m_render_context_->GetBlend2DContext().fillAll(BLRgba32(0xFF000000));  // Fill black
-            m_render_context_->EndFrame();
-            m_frame_rendered_this_cycle_ = true;
+        if (m_needs_redraw_signal_) {
+            auto request = std::make_unique<FrameRequest>();
+            request->kind = FrameRequest::Kind::kBlank;  // Filled black if the context has an image
+            SubmitRequest(std::move(request));
             m_needs_redraw_signal_ = false;  // Consumed the redraw signal
         }
+        PresentLatestFrame();
         return;
     }
 
     if (m_viewport_resized_signal_) {
-        std::cout << "PcbRenderer::Render: Viewport size (" << viewportWidth << "x" << viewportHeight << ") differs from RenderContext image size (" << m_render_context_->GetImageWidth() << "x"
-                  << m_render_context_->GetImageHeight() << "). Resizing context." << std::endl;
-        if (!m_render_context_->ResizeImage(viewportWidth, viewportHeight)) {
-            std::cerr << "PcbRenderer::Render Error: Failed to resize RenderContext image to match viewport. Skipping render." << std::endl;
-            m_viewport_resized_signal_ = false;  // Acknowledge signal even on failure
-            return;
-        }
+        std::cout << "PcbRenderer::Render: Viewport size (" << viewportWidth << "x" << viewportHeight << ") differs from requested image size (" << m_requested_width_ << "x"
+                  << m_requested_height_ << "). Resizing context." << std::endl;
+        m_requested_width_ = viewportWidth;  // The render thread resizes the context before the next frame
+        m_requested_height_ = viewportHeight;
         m_full_redraw_needed_ = true;        // Force full redraw after resize
         m_viewport_resized_signal_ = false;  // Acknowledge signal
     }
 
-    // If nothing needs to be redrawn, just return.
-    if (!m_grid_dirty_ && !m_board_dirty_ && !m_full_redraw_needed_ && !m_needs_redraw_signal_) {
+    // Request a frame only if something needs to be redrawn
+    if (m_grid_dirty_ || m_board_dirty_ || m_full_redraw_needed_ || m_needs_redraw_signal_) {
+        auto request = std::make_unique<FrameRequest>();
+        request->kind = FrameRequest::Kind::kScene;
+        request->board = std::move(board);
+        request->camera = *camera;
+        request->viewport = *viewport;
+        request->grid_settings = grid->GetSettings();
+        request->width = viewportWidth;
+        request->height = viewportHeight;
+        request->render_grid = m_grid_dirty_ || m_full_redraw_needed_;
+        request->render_board = m_board_dirty_ || m_full_redraw_needed_;
+        request->interactive = m_is_interactive_optimized_;
+        request->invalidate_rendering_state = m_rendering_state_invalidated_;
+        SubmitRequest(std::move(request));
+
+        // Reset flags once the frame is requested
+        m_grid_dirty_ = false;
+        m_board_dirty_ = false;
+        m_full_redraw_needed_ = false;
+        m_rendering_state_invalidated_ = false;
+        m_needs_redraw_signal_ = false;  // Consumed the redraw signal
+    }
+
+    PresentLatestFrame();
+}
+
+void PcbRenderer::SubmitRequest(std::unique_ptr<FrameRequest> request)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_request_mutex_);
+        if (m_pending_request_) {
+            // The older request never started: this one supersedes it, but must still redraw what it would have
+            request->render_grid = request->render_grid || m_pending_request_->render_grid;
+            request->render_board = request->render_board || m_pending_request_->render_board;
+            request->invalidate_rendering_state = request->invalidate_rendering_state || m_pending_request_->invalidate_rendering_state;
+            ++m_dropped_requests_;
+        }
+        m_pending_request_ = std::move(request);
+    }
+    m_request_cv_.notify_one();
+}
+
+bool PcbRenderer::PresentLatestFrame()
+{
+    std::lock_guard<std::mutex> lock(m_frame_mutex_);
+    if (m_published_frame_id_ == m_presented_frame_id_) {
+        return false;
+    }
+    m_presented_image_ = m_published_image_;  // Reference counted, no pixels are copied
+    m_presented_frame_id_ = m_published_frame_id_;
+    m_frame_rendered_this_cycle_ = true;
+    return true;
+}
+
+bool PcbRenderer::HasPendingBackgroundWork() const
+{
+    if (m_background_work_pending_.load()) {
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_request_mutex_);
+        if (m_pending_request_ || m_render_in_progress_) {
+            return true;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_frame_mutex_);
+    return m_published_frame_id_ != m_presented_frame_id_;
+}
+
+void PcbRenderer::SetFrameReadyCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(m_request_mutex_);
+    m_frame_ready_callback_ = std::move(callback);
+}
+
+path_cache::BLPathCache::CacheStats PcbRenderer::GetPathCacheStats() const
+{
+    std::lock_guard<std::mutex> lock(m_frame_mutex_);
+    return m_published_path_stats_;
+}
+
+void PcbRenderer::StartRenderThread()
+{
+    m_render_grid_settings_ = std::make_shared<GridSettings>();
+    m_render_grid_ = std::make_unique<Grid>(m_render_grid_settings_);
+    m_stop_render_thread_ = false;
+    m_render_thread_ = std::thread(&PcbRenderer::RenderThreadMain, this);
+}
+
+void PcbRenderer::StopRenderThread()
+{
+    if (!m_render_thread_.joinable()) {
         return;
     }
+    {
+        std::lock_guard<std::mutex> lock(m_request_mutex_);
+        m_stop_render_thread_ = true;
+        m_pending_request_.reset();
+    }
+    m_request_cv_.notify_one();
+    m_render_thread_.join();
+
+    if (m_dropped_requests_ > 0) {
+        std::cout << "PcbRenderer: " << m_dropped_requests_ << " frame requests were superseded before rendering" << std::endl;
+    }
+    m_render_grid_.reset();
+    m_render_grid_settings_.reset();
+}
+
+void PcbRenderer::RenderThreadMain()
+{
+    std::unique_ptr<FrameRequest> last_request;  // Drawn again when background work finishes
+
+    while (true) {
+        std::unique_ptr<FrameRequest> request;
+        std::function<void()> frame_ready_callback;
+        {
+            std::unique_lock<std::mutex> lock(m_request_mutex_);
+            const auto has_request = [this] { return m_stop_render_thread_ || m_pending_request_ != nullptr; };
+            if (m_render_pipeline_->HasPendingBackgroundWork()) {
+                m_request_cv_.wait_for(lock, kBackgroundPollInterval, has_request);
+            } else {
+                m_request_cv_.wait(lock, has_request);
+            }
+            if (m_stop_render_thread_) {
+                break;
+            }
+            request = std::move(m_pending_request_);
+            m_render_in_progress_ = request != nullptr;
+            frame_ready_callback = m_frame_ready_callback_;
+        }
+
+        // Background work that finished meanwhile is drawn by this frame, or by a redraw of the last scene
+        const bool background_work_done = m_render_pipeline_->PollBackgroundWork();
+        if (!request && background_work_done && last_request && last_request->kind == FrameRequest::Kind::kScene) {
+            request = std::make_unique<FrameRequest>(*last_request);
+            request->render_grid = true;
+            request->render_board = true;
+            request->invalidate_rendering_state = false;
+            std::lock_guard<std::mutex> lock(m_request_mutex_);
+            m_render_in_progress_ = true;
+        }
+        if (!request) {
+            m_background_work_pending_ = m_render_pipeline_->HasPendingBackgroundWork();
+            continue;
+        }
+
+        RenderFrame(*request);
+        PublishFrame();
+        // Cleared in this order, so HasPendingBackgroundWork() never sees a gap between frame and background work
+        m_background_work_pending_ = m_render_pipeline_->HasPendingBackgroundWork();
+        {
+            std::lock_guard<std::mutex> lock(m_request_mutex_);
+            m_render_in_progress_ = false;
+        }
+        if (frame_ready_callback) {
+            frame_ready_callback();
+        }
+        last_request = std::move(request);
+    }
+}
+
+void PcbRenderer::RenderFrame(FrameRequest& request)
+{
+    if (request.kind == FrameRequest::Kind::kScene &&
+        (m_render_context_->GetImageWidth() != request.width || m_render_context_->GetImageHeight() != request.height)) {
+        if (!m_render_context_->ResizeImage(request.width, request.height)) {
+            std::cerr << "PcbRenderer::RenderFrame Error: Failed to resize RenderContext image to match viewport. Skipping render." << std::endl;
+            return;
+        }
+        request.render_grid = true;  // Force full redraw after resize
+        request.render_board = true;
+    }
+
+    if (request.invalidate_rendering_state) {
+        m_render_pipeline_->InvalidateRenderingStateCache();
+    }
+    if (request.interactive) {
+        m_render_context_->OptimizeForInteractive();
+    } else {
+        m_render_context_->OptimizeForStatic();
+    }
+
+    if (request.kind == FrameRequest::Kind::kPlaceholder) {
+        m_render_context_->BeginFrame();
+        m_render_context_->GetBlend2DContext().fillAll(BLRgba32(0xFF111111));
+        m_render_context_->EndFrame();
+        return;
+    }
+    if (request.kind == FrameRequest::Kind::kBlank) {
+        if (m_render_context_->GetImageWidth() > 0 && m_render_context_->GetImageHeight() > 0) {  // Check if context has an image
+            m_render_context_->BeginFrame();
+            m_render_context_->GetBlend2DContext().fillAll(BLRgba32(0xFF000000));  // Fill black
+            m_render_context_->EndFrame();
+        }
+        return;
+    }
+
+    // request.board is a published snapshot: folding, flipping and layer visibility publish new state instead of
+    // changing it, so it is drawn without locking
+    *m_render_grid_settings_ = request.grid_settings;
 
     m_render_context_->BeginFrame();
     BLContext& bl_ctx = m_render_context_->GetBlend2DContext();
@@ -223,47 +457,47 @@ void PcbRenderer::Render(const Board* board, const Camera* camera, const Viewpor
     try {
         // Pass the dirty flags to the pipeline execution
         m_render_pipeline_->BeginScene(bl_ctx);
-        m_render_pipeline_->Execute(bl_ctx, board, *camera, *viewport, *grid, m_grid_dirty_ || m_full_redraw_needed_, m_board_dirty_ || m_full_redraw_needed_);
+        m_render_pipeline_->Execute(bl_ctx, request.board.get(), request.camera, request.viewport, *m_render_grid_, request.render_grid, request.render_board);
         m_render_pipeline_->EndScene();
-
-        // Reset flags after successful rendering
-        m_grid_dirty_ = false;
-        m_board_dirty_ = false;
-        m_full_redraw_needed_ = false;
-        m_frame_rendered_this_cycle_ = true;
-        m_needs_redraw_signal_ = false;  // Consumed the redraw signal
     } catch (const std::exception& e) {
-        std::cerr << "PcbRenderer::Render Exception: " << e.what() << std::endl;
+        std::cerr << "PcbRenderer::RenderFrame Exception: " << e.what() << std::endl;
     } catch (...) {
-        std::cerr << "PcbRenderer::Render: Unknown exception during rendering" << std::endl;
+        std::cerr << "PcbRenderer::RenderFrame: Unknown exception during rendering" << std::endl;
     }
 
     m_render_context_->EndFrame();
 }
 
-const BLImage& PcbRenderer::GetRenderedImage() const
+void PcbRenderer::PublishFrame()
 {
-    if (!m_render_context_) {
-        // This case should ideally not happen if used correctly (after init)
-        // Return a static empty BLImage or throw an exception
-        static BLImage emptyImage;
-        std::cerr << "PcbRenderer Error: GetRenderedImage called when RenderContext is null." << std::endl;
-        return emptyImage;
+    path_cache::BLPathCache::CacheStats path_stats;
+    {
+        std::lock_guard<std::mutex> path_cache_lock(path_cache::g_path_cache_mutex);
+        path_stats = path_cache::g_path_cache.GetStats();
     }
 
-    // Return the rendered image - no need for verbose logging every frame
-    return m_render_context_->GetTargetImage();
+    std::lock_guard<std::mutex> lock(m_frame_mutex_);
+    m_published_image_ = m_render_context_->GetFrontImage();  // Reference counted; the next BeginFrame() detaches
+    m_published_path_stats_ = path_stats;
+    ++m_published_frame_id_;
+}
+
+const BLImage& PcbRenderer::GetRenderedImage() const
+{
+    // Empty until the render thread finished its first frame
+    return m_presented_image_;
 }
 
 void PcbRenderer::OnViewportResized(int newWidth, int newHeight)
 {
     // This function is called by PCBViewerWindow when ImGui reports a content region size change.
     // We signal the Render() method to handle the actual resize and full redraw.
+    // Compared with the size last requested: the presented frame may lag behind it.
     if (m_render_context_) {
-        if (m_render_context_->GetImageWidth() != newWidth || m_render_context_->GetImageHeight() != newHeight) {
+        if (m_requested_width_ != newWidth || m_requested_height_ != newHeight) {
             NotifyViewportResizedEvent();  // Signal that viewport resize is needed
-                                           // The actual m_renderContext->ResizeImage will happen in the Render() method
-                                           // based on m_viewportResizedSignal
+                                           // The render thread resizes the context before drawing the next
+                                           // frame requested by Render()
         }
     } else {
         std::cerr << "PcbRenderer Warning: OnViewportResized called but RenderContext is not initialized." << std::endl;
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <blend2d.h> // For BLImage
 
+#include "render/BLPathCache.hpp"  // For the published path cache statistics
+
 // Forward declarations
 class RenderContext; // The Blend2D-focused RenderContext
 class RenderPipeline;
@@ -12,7 +20,13 @@ class Viewport;
 class Grid;             // Added forward declaration for Grid
 class BoardDataManager; // Added forward declaration
 class Config;           // Added forward declaration for Config
+class GridSettings;
 
+// Performance optimization: Rendering runs on a dedicated render thread, so the UI never waits for rasterization.
+// Render() (UI thread) copies camera, viewport and grid settings into a frame request and hands it over; a newer
+// request replaces one the render thread has not started yet. The render thread draws into the back image of
+// the double-buffered RenderContext and publishes each finished frame; the UI presents the newest one.
+// The RenderContext, RenderPipeline and the global path cache belong to the render thread once it runs.
 class PcbRenderer
 {
 public:
@@ -29,10 +43,11 @@ public:
     void Shutdown();
 
     // Main rendering method
-    // Renders the PCB and grid to an internal BLImage managed by RenderContext.
-    void Render(const Board *board, const Camera *camera, const Viewport *viewport, const Grid *grid); // Added Grid
+    // Requests a frame of the PCB and grid if anything changed, and picks up the newest frame the render thread
+    // finished. The board is shared with the render thread until that frame is done.
+    void Render(std::shared_ptr<const Board> board, const Camera *camera, const Viewport *viewport, const Grid *grid); // Added Grid
 
-    // Access the rendered image
+    // Access the rendered image: the frame presented by the last Render() call
     [[nodiscard]] const BLImage& GetRenderedImage() const;
     // Potentially a method to notify of viewport size changes to resize the BLImage
     void OnViewportResized(int new_width, int new_height);
@@ -63,11 +78,33 @@ public:
     [[nodiscard]] bool WasFrameJustRendered() const { return m_frame_rendered_this_cycle_; }
     [[nodiscard]] bool NeedsRedraw() const { return m_needs_redraw_signal_; }
 
+    // True while a requested frame is not presented yet or the render thread waits for background work
+    // (pre-stroked geometry builds) whose result it will draw; the main loop keeps calling Render() meanwhile.
+    [[nodiscard]] bool HasPendingBackgroundWork() const;
+
+    // Called on the render thread whenever a frame was published, e.g. to wake an idle main loop
+    void SetFrameReadyCallback(std::function<void()> callback);
+
+    // Path cache statistics as of the last published frame (the cache itself belongs to the render thread)
+    [[nodiscard]] path_cache::BLPathCache::CacheStats GetPathCacheStats() const;
+
     // Performance monitoring
     [[nodiscard]] bool IsMultithreaded() const;
     [[nodiscard]] int GetThreadCount() const;
 
 private:
+    struct FrameRequest;  // Everything a frame is drawn from, copied on the UI thread (see PcbRenderer.cpp)
+
+    void SubmitRequest(std::unique_ptr<FrameRequest> request);
+    bool PresentLatestFrame();  // True if a newer frame was picked up
+
+    // Render thread
+    void StartRenderThread();
+    void StopRenderThread();
+    void RenderThreadMain();
+    void RenderFrame(FrameRequest& request);
+    void PublishFrame();
+
     std::unique_ptr<RenderContext> m_render_context_;
     std::unique_ptr<RenderPipeline> m_render_pipeline_;
     std::shared_ptr<BoardDataManager> m_board_data_manager_;
@@ -83,5 +120,33 @@ private:
     // For OptimizeForStatic/Interactive switching
     int m_interactive_frames_counter_ = 0;
     static const int kInteractiveThreshold = 2;  // Frames of continuous camera change
-    bool m_is_interactive_optimized_ = false;
+    bool m_is_interactive_optimized_ = false;    // Passed to the render thread with each request
+
+    // UI thread state
+    bool m_rendering_state_invalidated_ = false;  // Colors etc. changed; the next request invalidates the pipeline's cache
+    int m_requested_width_ = 0;                   // Target size of the frames requested from now on
+    int m_requested_height_ = 0;
+    uint64_t m_presented_frame_id_ = 0;
+    BLImage m_presented_image_;  // Shares pixels with the published frame; never written to
+
+    // Request hand-over, guarded by m_request_mutex_
+    std::thread m_render_thread_;
+    mutable std::mutex m_request_mutex_;
+    std::condition_variable m_request_cv_;
+    std::unique_ptr<FrameRequest> m_pending_request_;  // Newest request the render thread has not started
+    bool m_render_in_progress_ = false;
+    bool m_stop_render_thread_ = false;
+    size_t m_dropped_requests_ = 0;  // Requests replaced before they were started
+    std::function<void()> m_frame_ready_callback_;
+    std::atomic<bool> m_background_work_pending_ {false};
+
+    // Owned by the render thread: a Grid is drawn from settings copied out of each request
+    std::shared_ptr<GridSettings> m_render_grid_settings_;
+    std::unique_ptr<Grid> m_render_grid_;
+
+    // Newest finished frame, guarded by m_frame_mutex_
+    mutable std::mutex m_frame_mutex_;
+    BLImage m_published_image_;
+    uint64_t m_published_frame_id_ = 0;
+    path_cache::BLPathCache::CacheStats m_published_path_stats_;
 };
\ No newline at end of file
@@ -28,40 +28,32 @@ int GetOptimalThreadCount(int width, int height) {
 }
 
 bool RenderContext::Initialize(int width, int height, int thread_count) {
-    // Create a new BLImage with the specified dimensions
-    m_target_image_ = BLImage(width, height, BL_FORMAT_PRGB32);
-    
+    // Create the back and front BLImages with the specified dimensions
+    m_target_images_[0] = BLImage(width, height, BL_FORMAT_PRGB32);
+    m_target_images_[1] = BLImage(width, height, BL_FORMAT_PRGB32);
+
     // Check if image creation was successful
-    if (m_target_image_.empty()) {
+    if (m_target_images_[0].empty() || m_target_images_[1].empty()) {
         std::cerr << "RenderContext: Failed to create BLImage" << std::endl;
         return false;
     }
-    
+
     m_image_width_ = width;
     m_image_height_ = height;
+    m_back_index_ = 0;
 
     // Use adaptive thread count based on viewport size
     int optimal_threads = GetOptimalThreadCount(width, height);
     thread_count = (thread_count <= 0) ? optimal_threads : thread_count;
 
-    // Configure Blend2D multithreading if requested
+    // Blend2D multithreading is configured whenever the context begins on a back image
     if (thread_count > 1) {
-        BLContextCreateInfo createInfo = {};
-        createInfo.threadCount = static_cast<uint32_t>(thread_count);
-        
-        // Add gradient hints for better work distribution
-        createInfo.flags = BL_CONTEXT_CREATE_FLAG_FALLBACK_TO_SYNC;
-
-        BLResult err = m_bl_context_.begin(m_target_image_, createInfo);
         m_thread_count_ = thread_count;
-
         std::cout << "RenderContext: Initialized with " << thread_count 
                   << " threads for Blend2D async rendering" << std::endl;
     } else {
         // Single-threaded (synchronous) rendering
-        BLResult err = m_bl_context_.begin(m_target_image_);
         m_thread_count_ = 1;
-
         std::cout << "RenderContext: Initialized with single-threaded (synchronous) rendering" << std::endl;
     }
     
@@ -73,7 +65,8 @@ void RenderContext::Shutdown()
     if (m_bl_context_.isValid()) {  // Check if context is active before ending
         m_bl_context_.end();
     }
-    m_target_image_.reset();  // Release the image data
+    m_target_images_[0].reset();  // Release the image data
+    m_target_images_[1].reset();
     m_image_width_ = 0;
     m_image_height_ = 0;
     // std::cout << "RenderContext shutdown." << std::endl;
@@ -81,11 +74,29 @@ void RenderContext::Shutdown()
 
 void RenderContext::BeginFrame()
 {
-    if (!m_bl_context_.isValid() || m_target_image_.empty()) {
+    BLImage& back_image = m_target_images_[m_back_index_];
+    if (back_image.empty()) {
         std::cerr << "RenderContext::BeginFrame Error: Context not initialized or image empty." << std::endl;
         return;
     }
 
+    BLResult err = BL_SUCCESS;
+    if (m_thread_count_ > 1) {
+        BLContextCreateInfo createInfo = {};
+        createInfo.threadCount = static_cast<uint32_t>(m_thread_count_);
+
+        // Add gradient hints for better work distribution
+        createInfo.flags = BL_CONTEXT_CREATE_FLAG_FALLBACK_TO_SYNC;
+        err = m_bl_context_.begin(back_image, createInfo);
+    } else {
+        err = m_bl_context_.begin(back_image);
+    }
+    if (err != BL_SUCCESS) {
+        std::cerr << "RenderContext::BeginFrame Error: Failed to begin BLContext: " << err << std::endl;
+        return;
+    }
+    ApplyQualitySettings();
+
     // Only clear if specifically requested
     if (m_clear_on_begin_frame_) {
         m_bl_context_.setCompOp(BL_COMP_OP_SRC_COPY);  // Ensure overwrite
@@ -99,15 +110,13 @@ void RenderContext::BeginFrame()
 
 void RenderContext::EndFrame()
 {
-    // For multithreaded contexts, we need to ensure all rendering is complete
-    // before the frame is considered done
-    if (IsMultithreaded()) {
-        // Force synchronization to ensure all async operations complete
-        FlushSync();
-    } else {
-        // For single-threaded contexts, this is typically a no-op
-        // as rendering is synchronous
+    if (!m_bl_context_.isValid()) {
+        return;  // BeginFrame failed; keep showing the previous front image
     }
+
+    // Ending waits for all async rendering, so the frame is complete before it becomes the front image
+    m_bl_context_.end();
+    m_back_index_ ^= 1;
 }
 
 BLContext& RenderContext::GetBlend2DContext()
@@ -117,12 +126,17 @@ BLContext& RenderContext::GetBlend2DContext()
 
 const BLImage& RenderContext::GetTargetImage() const
 {
-    return m_target_image_;
+    return m_target_images_[m_back_index_];
 }
 
 BLImage& RenderContext::GetTargetImage()
 {
-    return m_target_image_;
+    return m_target_images_[m_back_index_];
+}
+
+const BLImage& RenderContext::GetFrontImage() const
+{
+    return m_target_images_[m_back_index_ ^ 1];
 }
 
 bool RenderContext::ResizeImage(int newWidth, int newHeight)
@@ -136,60 +150,55 @@ bool RenderContext::ResizeImage(int newWidth, int newHeight)
         m_bl_context_.end();  // End context before resizing image
     }
 
-    BLImage newImage;
-    BLResult err = newImage.create(newWidth, newHeight, BL_FORMAT_PRGB32);
-    if (err != BL_SUCCESS) {
-        std::cerr << "RenderContext::ResizeImage Error: Failed to create new BLImage: " << err << std::endl;
-        // Attempt to restart context on old image if it was valid
-        if (!m_target_image_.empty()) {
-            m_bl_context_.begin(m_target_image_);
+    BLImage newImages[2];
+    for (BLImage& newImage : newImages) {
+        BLResult err = newImage.create(newWidth, newHeight, BL_FORMAT_PRGB32);
+        if (err != BL_SUCCESS) {
+            std::cerr << "RenderContext::ResizeImage Error: Failed to create new BLImage: " << err << std::endl;
+            return false;  // Old images are kept
         }
-        return false;
     }
 
-    m_target_image_ = newImage;  // Assign new image
+    m_target_images_[0] = newImages[0];  // Assign new images
+    m_target_images_[1] = newImages[1];
+    m_back_index_ = 0;
     m_image_width_ = newWidth;
     m_image_height_ = newHeight;
-
-    // Re-begin context on the new image with same threading configuration
-    if (m_thread_count_ > 1) {
-        BLContextCreateInfo createInfo = {};
-        createInfo.threadCount = static_cast<uint32_t>(m_thread_count_);
-        err = m_bl_context_.begin(m_target_image_, createInfo);
-    } else {
-        err = m_bl_context_.begin(m_target_image_);
-    }
-
-    if (err != BL_SUCCESS) {
-        std::cerr << "RenderContext::ResizeImage Error: Failed to begin BLContext on new image: " << err << std::endl;
-        m_target_image_.reset();  // Failed, so invalidate
-        return false;
-    }
     std::cout << "RenderContext image resized to " << newWidth << "x" << newHeight << std::endl;
     return true;
 }
 
 void RenderContext::OptimizeForStatic()
 {
-    // Use these settings when rendering static content
-    m_bl_context_.setCompOp(BL_COMP_OP_SRC_OVER);
-    m_bl_context_.setFillRule(BL_FILL_RULE_NON_ZERO);
-
-    BLApproximationOptions precisionOptions = blDefaultApproximationOptions;
-    precisionOptions.flattenTolerance = 0.1;   // Default is 0.3; smaller is more precise
-    // Note: simplifyTolerance was removed from BLApproximationOptions in newer Blend2D versions
-    m_bl_context_.setApproximationOptions(precisionOptions);
+    m_interactive_quality_ = false;
+    if (m_bl_context_.isValid()) {
+        ApplyQualitySettings();
+    }
 }
 
 void RenderContext::OptimizeForInteractive()
 {
-    // Use these for dynamic/interactive content
-    m_bl_context_.setCompOp(BL_COMP_OP_SRC_OVER);
+    m_interactive_quality_ = true;
+    if (m_bl_context_.isValid()) {
+        ApplyQualitySettings();
+    }
+}
 
-    BLApproximationOptions speedOptions = blDefaultApproximationOptions;
-    speedOptions.flattenTolerance = 0.5;   // Larger tolerance for speed
+void RenderContext::ApplyQualitySettings()
+{
+    BLApproximationOptions approximationOptions = blDefaultApproximationOptions;
     // Note: simplifyTolerance was removed from BLApproximationOptions in newer Blend2D versions
-    m_bl_context_.setApproximationOptions(speedOptions);
+    if (m_interactive_quality_) {
+        // Use these for dynamic/interactive content
+        m_bl_context_.setCompOp(BL_COMP_OP_SRC_OVER);
+        approximationOptions.flattenTolerance = 0.5;   // Larger tolerance for speed
+    } else {
+        // Use these settings when rendering static content
+        m_bl_context_.setCompOp(BL_COMP_OP_SRC_OVER);
+        m_bl_context_.setFillRule(BL_FILL_RULE_NON_ZERO);
+        approximationOptions.flattenTolerance = 0.1;   // Default is 0.3; smaller is more precise
+    }
+    m_bl_context_.setApproximationOptions(approximationOptions);
 }
 
 void RenderContext::SetBoardDataManager(std::shared_ptr<BoardDataManager> board_data_manager)
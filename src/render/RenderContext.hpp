@@ -7,6 +7,10 @@
 // Forward declarations (if any become necessary)
 // struct SDL_Window; // No longer needed directly by RenderContext
 
+// Performance optimization: Double-buffered off-screen target. A frame is drawn into the back image between
+// BeginFrame() and EndFrame(), which then makes it the front image, so the last finished frame stays intact
+// while the next one is rendered. Readers that keep a BLImage reference to a front image are safe even when it
+// becomes the back image again: beginning a context on a shared image detaches it first.
 class RenderContext
 {
 public:
@@ -23,19 +27,20 @@ public:
     void Shutdown();
 
     // Frame operations for the Blend2D context
-    void BeginFrame();  // Clears the BLImage
-    void EndFrame();    // Finalizes BLContext operations if any (might be a no-op)
+    void BeginFrame();  // Begins the context on the back image and clears it
+    void EndFrame();    // Ends the context (waiting for async rendering) and swaps the images
 
     // Accessors for Blend2D resources
     BLContext& GetBlend2DContext();
-    [[nodiscard]] const BLImage& GetTargetImage() const;  // Read-only access to the image
+    [[nodiscard]] const BLImage& GetTargetImage() const;  // Back image: the frame being rendered
     BLImage& GetTargetImage();                            // Writable access if needed, e.g., for direct manipulation or resizing
+    [[nodiscard]] const BLImage& GetFrontImage() const;   // Last finished frame
 
     // Add public getters for image dimensions
     [[nodiscard]] int GetImageWidth() const { return m_image_width_; }
     [[nodiscard]] int GetImageHeight() const { return m_image_height_; }
 
-    // Potentially a method to resize the off-screen image
+    // Recreates both images; the next frame is drawn at the new size
     bool ResizeImage(int new_width, int new_height);
 
     // Set the clear color for BeginFrame
@@ -50,7 +55,7 @@ public:
     // Control whether BeginFrame does a full clear
     void SetClearOnBeginFrame(bool should_clear) { m_clear_on_begin_frame_ = should_clear; }
 
-    // Performance optimization methods
+    // Performance optimization methods (kept across frames, applied whenever the context begins)
     void OptimizeForStatic();
     void OptimizeForInteractive();
 
@@ -65,9 +70,12 @@ public:
     int GetThreadCount() const { return m_thread_count_; }
 
 private:
+    void ApplyQualitySettings();
+
     // Blend2D resources
-    BLImage m_target_image_;  // The off-screen image for PCB rendering
-    BLContext m_bl_context_;  // Blend2D rendering context targeting m_targetImage
+    BLImage m_target_images_[2];  // The off-screen images for PCB rendering, back and front
+    int m_back_index_ = 0;        // Image the next frame is drawn into
+    BLContext m_bl_context_;      // Blend2D rendering context, active on the back image during a frame
     // No longer managing SDL_Window* or SDL_Renderer*
     // SDL_Window* m_window = nullptr;
     // SDL_Renderer* m_renderer = nullptr;
@@ -77,5 +85,6 @@ private:
     int m_thread_count_ = 1;  // Number of threads for Blend2D context
     float m_clear_color_[4] = {0.0F, 0.0F, 0.0F, 0.0F};  // Default clear color (transparent black)
     bool m_clear_on_begin_frame_ = true;                 // Whether to clear on BeginFrame
+    bool m_interactive_quality_ = false;                 // OptimizeForInteractive() rather than OptimizeForStatic()
     std::shared_ptr<BoardDataManager> m_board_data_manager_;
 };
@@ -29,6 +29,10 @@ static constexpr double kDefaultComponentMinDimension = 0.1;
 static constexpr int kSilkscreenLayerId = 17;
 static constexpr int kBoardOutlineLayerId = 28;
 
+// Banded rasterization tuning
+static constexpr int kMinRasterBandHeight = 64;              // Pixels; below this a band is not worth a context
+static constexpr double kRasterBandCullMarginPixels = 2.0;  // Cull padding around each band, in pixels
+
 // Forward declaration for use in RenderPin's lambda
 static void RenderCapsule(BLContext& ctx, double width, double height, double x_coord, double y_coord, const BLRgba32& fill_color, const BLRgba32& stroke_color);
 
@@ -103,6 +107,8 @@ void RenderPipeline::Shutdown()
     // }
     // m_stages.clear();
     m_font_face_cache_.clear();
+    m_stroked_geometry_cache_.Clear();
+    m_overview_pyramid_.Clear();
 
     std::cout << "RenderPipeline shutdown." << std::endl;
     m_initialized_ = false;
@@ -154,6 +160,7 @@ void RenderPipeline::Execute(BLContext& bl_ctx,
     if (render_board && board) {
         BLRect world_view_rect = GetVisibleWorldBounds(camera, viewport);  // Calculate once
         RenderBoard(bl_ctx, *board, camera, viewport, world_view_rect);    // Pass to RenderBoard
+        RenderBoxSelectionOverlay(bl_ctx, camera, viewport, world_view_rect);
     }
 
     // Grid measurement overlay is now rendered by Application layer using ImGui
@@ -161,14 +168,15 @@ void RenderPipeline::Execute(BLContext& bl_ctx,
 
 /**
  * @brief Creates a view transformation matrix for rendering.
- * @param bl_ctx The Blend2D context
  * @param camera The camera containing position, zoom, and rotation
  * @param viewport The viewport containing screen dimensions
  * @return The transformation matrix for world-to-screen conversion
  */
-BLMatrix2D RenderPipeline::ViewMatrix(BLContext& bl_ctx, const Camera& camera, const Viewport& viewport)
+BLMatrix2D RenderPipeline::ViewMatrix(const Camera& camera, const Viewport& viewport)
 {
-    BLMatrix2D view_matrix = bl_ctx.metaTransform();
+    // Starts from identity: applyTransform() composes with the user matrix, and the meta matrix is applied on top
+    // of that by Blend2D, so folding it in here would apply a tile's sub-pixel offset twice
+    BLMatrix2D view_matrix = BLMatrix2D::makeIdentity();
     view_matrix.translate(viewport.GetWidth() / 2.0, viewport.GetHeight() / 2.0);
     view_matrix.scale(camera.GetZoom());
     view_matrix.rotate(-camera.GetRotation() * (static_cast<float>(kPi) / 180.0f));
@@ -194,6 +202,38 @@ static bool AreRectsIntersecting(const BLRect& r1, const BLRect& r2)
     double r2_y2 = r2.y + r2_h;
     return !(r1_x2 < r2.x || r1.x > r2_x2 || r1_y2 < r2.y || r1.y > r2_y2);
 }
+
+/**
+ * @brief World bounds of everything RenderComponent draws for a component: its rotated body and its pins.
+ * Pads can stick out of the silkscreen body, so culling against a raster band needs them too.
+ */
+static BLRect GetComponentRenderBounds(const Component& component)
+{
+    const double comp_w = (component.width > 0) ? component.width : kDefaultComponentMinDimension;
+    const double comp_h = (component.height > 0) ? component.height : kDefaultComponentMinDimension;
+    const double comp_rot_rad = component.rotation * (kPi / 180.0);
+    const double abs_cos_r = std::abs(std::cos(comp_rot_rad));
+    const double abs_sin_r = std::abs(std::sin(comp_rot_rad));
+    const double rotated_half_w = 0.5 * (comp_w * abs_cos_r + comp_h * abs_sin_r);
+    const double rotated_half_h = 0.5 * (comp_w * abs_sin_r + comp_h * abs_cos_r);
+
+    double min_x = component.center_x - rotated_half_w;
+    double max_x = component.center_x + rotated_half_w;
+    double min_y = component.center_y - rotated_half_h;
+    double max_y = component.center_y + rotated_half_h;
+    for (const auto& pin_ptr : component.pins) {
+        if (!pin_ptr) {
+            continue;
+        }
+        // Half of width + height covers the pad at any rotation
+        const double pin_extent = 0.5 * (pin_ptr->width + pin_ptr->height);
+        min_x = std::min(min_x, pin_ptr->coords.x_ax - pin_extent);
+        max_x = std::max(max_x, pin_ptr->coords.x_ax + pin_extent);
+        min_y = std::min(min_y, pin_ptr->coords.y_ax - pin_extent);
+        max_y = std::max(max_y, pin_ptr->coords.y_ax + pin_extent);
+    }
+    return BLRect(min_x, min_y, max_x - min_x, max_y - min_y);
+}
 static bool ArePointsClose(const BLPoint& p1, const BLPoint& p2, double epsilon = 1e-6)
 {
     return std::abs(p1.x - p2.x) < epsilon && std::abs(p1.y - p2.y) < epsilon;
@@ -228,10 +268,16 @@ BLRect TransformAABB(const BLRect& local_aabb, const BLMatrix2D& transform)
 BLRect RenderPipeline::GetVisibleWorldBounds(const Camera& camera, const Viewport& viewport) const
 {
     // This logic is similar to Grid::GetVisibleWorldBounds
-    Vec2 screen_corners[4] = {{static_cast<float>(viewport.GetX()), static_cast<float>(viewport.GetY())},
-                              {static_cast<float>(viewport.GetX() + viewport.GetWidth()), static_cast<float>(viewport.GetY())},
-                              {static_cast<float>(viewport.GetX()), static_cast<float>(viewport.GetY() + viewport.GetHeight())},
-                              {static_cast<float>(viewport.GetX() + viewport.GetWidth()), static_cast<float>(viewport.GetY() + viewport.GetHeight())}};
+    const BLRect viewport_screen_rect(viewport.GetX(), viewport.GetY(), viewport.GetWidth(), viewport.GetHeight());
+    return GetScreenRectWorldBounds(camera, viewport, viewport_screen_rect);
+}
+
+BLRect RenderPipeline::GetScreenRectWorldBounds(const Camera& camera, const Viewport& viewport, const BLRect& screen_rect) const
+{
+    Vec2 screen_corners[4] = {{static_cast<float>(screen_rect.x), static_cast<float>(screen_rect.y)},
+                              {static_cast<float>(screen_rect.x + screen_rect.w), static_cast<float>(screen_rect.y)},
+                              {static_cast<float>(screen_rect.x), static_cast<float>(screen_rect.y + screen_rect.h)},
+                              {static_cast<float>(screen_rect.x + screen_rect.w), static_cast<float>(screen_rect.y + screen_rect.h)}};
 
     Vec2 world_min = viewport.ScreenToWorld(screen_corners[0], camera);
     Vec2 world_max = world_min;
@@ -254,11 +300,268 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
     // Performance optimization: Reset state tracking for this frame
     ResetBlend2DStateTracking();
 
+    // Performance optimization: Use cached rendering state to avoid repeated BoardDataManager calls.
+    // Resolved here, on the calling thread, so band workers only ever read it.
+    const RenderingState& render_state = GetCachedRenderingState(board);
+
+    if (RenderOverview(bl_ctx, board, camera, viewport, render_state)) {
+        return;
+    }
+
+    // Held for the whole frame, so band workers can share it even if a newer bucket is published meanwhile
+    const std::shared_ptr<const StrokedGeometryCache::Geometry> stroked_geometry = AcquireStrokedGeometry(board, camera, render_state);
+
+    if (ShouldUseBandedRasterization(viewport)) {
+        RenderBoardBanded(bl_ctx, board, camera, viewport, world_view_rect, render_state, stroked_geometry.get());
+        return;
+    }
+
+    RenderBoardRegion(bl_ctx, board, camera, viewport, world_view_rect, render_state, stroked_geometry.get());
+}
+
+std::shared_ptr<const StrokedGeometryCache::Geometry> RenderPipeline::AcquireStrokedGeometry(const Board& board, const Camera& camera,
+                                                                                           const RenderingState& render_state)
+{
+    if (!m_stroked_geometry_enabled_) {
+        return nullptr;
+    }
+    if (render_state.cached_board.get() != &board) {
+        return nullptr;  // Not the board the cache can keep alive and track revisions of
+    }
+
+    StrokedGeometryCache::CollectOptions options;
+    options.default_trace_width = kDefaultTraceWidth;
+    options.default_arc_thickness = kDefaultArcThickness;
+    options.silkscreen_layer_id = kSilkscreenLayerId;
+    options.board_outline_layer_id = kBoardOutlineLayerId;
+    options.board_outline_thickness = render_state.board_outline_thickness;
+    m_stroked_geometry_cache_.Update(render_state.cached_board, options);
+
+    // Flattened for the largest zoom of the bucket, at the quality LODSettings gives that zoom (tolerances are in pixels)
+    const int zoom_bucket = StrokedGeometryCache::GetZoomBucket(camera.GetZoom());
+    const double bucket_zoom = StrokedGeometryCache::GetBucketMaxZoom(zoom_bucket);
+    const lod::LODSettings::QualitySettings* quality = m_lod_manager_.GetQualitySettings(m_lod_manager_.GetZoomLOD(bucket_zoom));
+    return m_stroked_geometry_cache_.Acquire(zoom_bucket, quality->flatten_tolerance / bucket_zoom);
+}
+
+bool RenderPipeline::RenderOverview(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport, const RenderingState& render_state)
+{
+    if (!m_overview_pyramid_enabled_ || render_state.cached_board.get() != &board || !m_render_context_) {
+        return false;
+    }
+    const double zoom = camera.GetZoom();
+    const std::shared_ptr<const OverviewPyramid::Levels> overview =
+        m_overview_pyramid_.Acquire(render_state.cached_board, render_state.view_state, m_render_context_->GetBoardDataManager(), zoom,
+                                    std::max(viewport.GetWidth(), viewport.GetHeight()));
+    if (!overview) {
+        return false;
+    }
+
+    // The level's texels cover exactly its share of the world bounds: level i is the base halved i times
+    const size_t level_index = overview->SelectLevel(zoom);
+    const BLImage& level = overview->GetLevel(level_index);
+    const double level_zoom = std::ldexp(overview->GetBaseZoom(), -static_cast<int>(level_index));
+    const BLRect& world_bounds = overview->GetWorldBounds();
+
     bl_ctx.save();
-    bl_ctx.applyTransform(ViewMatrix(bl_ctx, camera, viewport));
+    bl_ctx.applyTransform(ViewMatrix(camera, viewport));
+    bl_ctx.setHint(BL_CONTEXT_HINT_PATTERN_QUALITY, BL_PATTERN_QUALITY_BILINEAR);
+    bl_ctx.blitImage(BLRect(world_bounds.x, world_bounds.y, level.width() / level_zoom, level.height() / level_zoom), level);
+    bl_ctx.restore();
+    return true;
+}
 
-    // Performance optimization: Use cached rendering state to avoid repeated BoardDataManager calls
-    const RenderingState& render_state = GetCachedRenderingState(board);
+bool RenderPipeline::PollBackgroundWork()
+{
+    // Both polled every time: either finishing means the next frame looks different
+    const bool stroked_geometry_done = m_stroked_geometry_cache_.PollPendingBuild();
+    const bool overview_done = m_overview_pyramid_.PollPendingBuild();
+    return stroked_geometry_done || overview_done;
+}
+
+bool RenderPipeline::HasPendingBackgroundWork() const
+{
+    return m_stroked_geometry_cache_.IsBuildPending() || m_overview_pyramid_.IsBuildPending();
+}
+
+void RenderPipeline::SetThreadPoolEnabled(bool enabled)
+{
+    // The constructor already started the pool; a pipeline that does not use it gives its threads back
+    if (!enabled) {
+        ShutdownThreadPool();
+        return;
+    }
+    m_threading_enabled_ = m_thread_count_ > 0;
+}
+
+void RenderPipeline::SetOverviewPyramidEnabled(bool enabled)
+{
+    m_overview_pyramid_enabled_ = enabled;
+    if (!enabled) {
+        m_overview_pyramid_.Clear();
+    }
+}
+
+void RenderPipeline::FillStrokedCells(BLContext& bl_ctx, const StrokedGeometryCache::Geometry& geometry, int layer_id, StrokedGeometryCache::ShapeKind kind,
+                                      const BLRgba32& color, BoardDataManager::BoardSide view_side, const BLRect& world_view_rect) const
+{
+    using SideGroup = StrokedGeometryCache::SideGroup;
+    static constexpr SideGroup kSideGroups[] = {SideGroup::kUnassigned, SideGroup::kTop, SideGroup::kBottom};
+
+    bool style_set = false;
+    BLFillRule previous_fill_rule = BL_FILL_RULE_NON_ZERO;
+    for (SideGroup side : kSideGroups) {
+        // Only silkscreen is grouped by side; elements on the hidden side are skipped like in the live pass
+        if ((view_side == BoardDataManager::BoardSide::kTop && side == SideGroup::kBottom) ||
+            (view_side == BoardDataManager::BoardSide::kBottom && side == SideGroup::kTop)) {
+            continue;
+        }
+        const std::vector<StrokedGeometryCache::Cell>* cells = geometry.GetCells(layer_id, kind, side);
+        if (!cells) {
+            continue;
+        }
+        for (const StrokedGeometryCache::Cell& cell : *cells) {
+            const BLRect cell_rect(cell.bounds.x0, cell.bounds.y0, cell.bounds.x1 - cell.bounds.x0, cell.bounds.y1 - cell.bounds.y0);
+            if (!AreRectsIntersecting(cell_rect, world_view_rect)) {
+                continue;
+            }
+            if (!style_set) {
+                // Stroked outlines overlap where traces meet; non-zero keeps the overlaps filled
+                previous_fill_rule = static_cast<BLFillRule>(bl_ctx.fillRule());
+                bl_ctx.setFillRule(BL_FILL_RULE_NON_ZERO);
+                bl_ctx.setFillStyle(color);
+                style_set = true;
+            }
+            bl_ctx.fillPath(cell.path);
+        }
+    }
+    if (style_set) {
+        bl_ctx.setFillRule(previous_fill_rule);
+    }
+}
+
+bool RenderPipeline::ShouldUseBandedRasterization(const Viewport& viewport) const
+{
+    if (!m_banded_rasterization_enabled_ || !m_thread_pool_ || m_thread_pool_->get_thread_count() < 2 || !m_render_context_) {
+        return false;
+    }
+    // Bands thinner than this cost more in per-context setup and duplicated component culling than they save
+    return viewport.GetHeight() >= 2 * kMinRasterBandHeight;
+}
+
+void RenderPipeline::RenderBoardBanded(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport,
+                                       const BLRect& world_view_rect, const RenderingState& render_state,
+                                       const StrokedGeometryCache::Geometry* stroked_geometry)
+{
+    // Bands write straight into the render context's back image, which is only what bl_ctx draws into when bl_ctx is
+    // that context's own (RenderContext::BeginFrame begins it on the back image). Any other context renders unbanded.
+    if (&bl_ctx != &m_render_context_->GetBlend2DContext()) {
+        RenderBoardRegion(bl_ctx, board, camera, viewport, world_view_rect, render_state, stroked_geometry);
+        return;
+    }
+
+    // The band contexts reproduce bl_ctx's meta and user matrices. Band culling maps band rows to the world through
+    // the camera alone, which stays exact only while those matrices are a plain translation (a tile's sub-pixel
+    // offset); anything else renders unbanded.
+    const BLMatrix2D meta_transform = bl_ctx.metaTransform();
+    const BLMatrix2D user_transform = bl_ctx.userTransform();
+    const BLMatrix2D pre_view_transform = bl_ctx.finalTransform();
+    if (pre_view_transform.m00 != 1.0 || pre_view_transform.m01 != 0.0 || pre_view_transform.m10 != 0.0 || pre_view_transform.m11 != 1.0) {
+        RenderBoardRegion(bl_ctx, board, camera, viewport, world_view_rect, render_state, stroked_geometry);
+        return;
+    }
+
+    BLImageData target_data;
+    const BLImage& target_image = m_render_context_->GetTargetImage();
+    if (target_image.getData(&target_data) != BL_SUCCESS || target_data.format != BL_FORMAT_PRGB32 ||
+        target_data.size.w != viewport.GetWidth() || target_data.size.h != viewport.GetHeight() ||
+        bl_ctx.targetWidth() != target_data.size.w || bl_ctx.targetHeight() != target_data.size.h) {
+        // Image not yet resized to the viewport (or not a PRGB32 target); bands would not line up
+        RenderBoardRegion(bl_ctx, board, camera, viewport, world_view_rect, render_state, stroked_geometry);
+        return;
+    }
+
+    // The clear and the grid were queued on the main context; they must be in the pixels before
+    // the band contexts composite on top of them.
+    bl_ctx.flush(BL_CONTEXT_FLUSH_SYNC);
+
+    const int image_width = target_data.size.w;
+    const int image_height = target_data.size.h;
+    const int band_count = std::max(1, std::min(static_cast<int>(m_thread_pool_->get_thread_count()), image_height / kMinRasterBandHeight));
+    const int band_height = (image_height + band_count - 1) / band_count;
+
+    // Band contexts inherit the interactive/static quality settings and the compositing state of the main context
+    const BLApproximationOptions approximation_options = bl_ctx.approximationOptions();
+    const BLFillRule fill_rule = static_cast<BLFillRule>(bl_ctx.fillRule());
+    const BLCompOp comp_op = static_cast<BLCompOp>(bl_ctx.compOp());
+    const double global_alpha = bl_ctx.globalAlpha();
+    const double offset_x = pre_view_transform.m20;
+    const double offset_y = pre_view_transform.m21;
+
+    std::vector<std::future<void>> band_futures;
+    band_futures.reserve(static_cast<size_t>(band_count));
+
+    for (int band_index = 0; band_index < band_count; ++band_index) {
+        const int band_top = band_index * band_height;
+        const int band_bottom = std::min(image_height, band_top + band_height);
+        if (band_top >= band_bottom) {
+            break;
+        }
+
+        band_futures.push_back(m_thread_pool_->enqueue([this, &board, &camera, &viewport, &render_state, stroked_geometry, target_data,
+                                                        image_width, image_height, band_top, band_bottom, approximation_options, fill_rule, comp_op,
+                                                        global_alpha, meta_transform, user_transform, offset_x, offset_y]() {
+            // Every band views the whole shared image so the view matrix (and therefore rasterization) is
+            // exactly the one used by the single-threaded path; the clip keeps the bands' writes disjoint.
+            BLImage band_view;
+            if (band_view.createFromData(image_width, image_height, BL_FORMAT_PRGB32, target_data.pixelData, target_data.stride) != BL_SUCCESS) {
+                std::cerr << "RenderPipeline: Failed to create band view for rows " << band_top << "-" << band_bottom << std::endl;
+                return;
+            }
+
+            BLContext band_ctx;
+            if (band_ctx.begin(band_view) != BL_SUCCESS) {
+                std::cerr << "RenderPipeline: Failed to begin band context for rows " << band_top << "-" << band_bottom << std::endl;
+                return;
+            }
+            band_ctx.setApproximationOptions(approximation_options);
+            band_ctx.setFillRule(fill_rule);
+            band_ctx.setCompOp(comp_op);
+            band_ctx.setGlobalAlpha(global_alpha);
+            // Clip in pixels first, then rebuild the main context's meta and user matrices on top
+            band_ctx.clipToRect(BLRectI(0, band_top, image_width, band_bottom - band_top));
+            band_ctx.setTransform(meta_transform);
+            band_ctx.userToMeta();
+            band_ctx.setTransform(user_transform);
+
+            // Cull everything against the band only, padded so anti-aliased edges that straddle the band
+            // boundary are still produced by this band
+            const BLRect band_screen_rect(viewport.GetX() - offset_x - kRasterBandCullMarginPixels,
+                                          viewport.GetY() + band_top - offset_y - kRasterBandCullMarginPixels,
+                                          image_width + 2.0 * kRasterBandCullMarginPixels,
+                                          (band_bottom - band_top) + 2.0 * kRasterBandCullMarginPixels);
+            const BLRect band_world_rect = GetScreenRectWorldBounds(camera, viewport, band_screen_rect);
+
+            RenderBoardRegion(band_ctx, board, camera, viewport, band_world_rect, render_state, stroked_geometry);
+            band_ctx.end();
+        }));
+    }
+
+    for (auto& band_future : band_futures) {
+        band_future.get();
+    }
+}
+
+void RenderPipeline::RenderBoardRegion(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport,
+                                       const BLRect& geometry_cull_rect, const RenderingState& render_state,
+                                       const StrokedGeometryCache::Geometry* stroked_geometry)
+{
+    bl_ctx.save();
+    bl_ctx.applyTransform(ViewMatrix(camera, viewport));
+
+    // Performance optimization: Elements smaller than a pixel are drawn as density or points (a local, so
+    // concurrent bands don't share it)
+    SubPixelBatch sub_pixel_batch(bl_ctx, geometry_cull_rect, m_sub_pixel_options_);
 
     // Use cached values instead of repeated function calls
     const int selected_net_id = render_state.selected_net_id;
@@ -270,7 +573,7 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
 
     // Visual mirror transformation removed - actual element coordinates are now updated
     // when board flip state changes, so no runtime visual transformation is needed
-    const BLRect adjusted_world_view_rect = world_view_rect;
+    const BLRect adjusted_world_view_rect = geometry_cull_rect;
 
     // Performance optimization: Pre-compute fallback colors to avoid repeated map lookups
     const BLRgba32 fallback_color(0xFFFF0000);  // Red
@@ -304,6 +607,12 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
         std::vector<const Trace*> traces_to_render;
         traces_to_render.reserve(1000); // Pre-allocate for performance
 
+        // With pre-stroked geometry, only highlighted traces and arcs are drawn live, on top of the filled ones
+        std::vector<int> stroked_trace_layer_ids;
+        std::vector<std::pair<const Arc*, BLRgba32>> highlighted_arcs;
+        const BoardDataManager::BoardSide stroked_view_side = is_silkscreen_pass ? current_view_side : BoardDataManager::BoardSide::kBoth;
+        const double arc_thickness_override = is_board_outline_pass ? board_outline_thickness : -1.0;
+
         // Performance optimization: Direct layer access instead of iterating all layers
         for (int layer_id : target_layer_ids) {
             auto layer_elements_it = board.m_elements_by_layer.find(layer_id);
@@ -312,8 +621,7 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
             }
 
             // Performance optimization: Check layer visibility once per layer
-            const Board::LayerInfo* layer_info = board.GetLayerById(layer_id);
-            if (!layer_info || !layer_info->IsVisible()) {
+            if (!render_state.IsLayerVisible(layer_id)) {
                 continue;
             }
 
@@ -380,6 +688,9 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
 
                 switch (current_type) {
                     case ElementType::kTrace:
+                        if (stroked_geometry && !is_selected_net && !is_selected_element) {
+                            break;  // Filled with the layer's pre-stroked traces
+                        }
                         if (auto trace = dynamic_cast<const Trace*>(element_ptr.get())) {
                             // Collect traces for parallel processing instead of rendering immediately
                             traces_to_render.push_back(trace);
@@ -392,10 +703,17 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
                         }
                         break;
                     case ElementType::kArc:
+                        if (stroked_geometry && !is_selected_net && !is_selected_element) {
+                            break;  // Filled with the layer's pre-stroked arcs
+                        }
                         if (auto arc = dynamic_cast<const Arc*>(element_ptr.get())) {
+                            if (stroked_geometry) {
+                                // Drawn after the layer's fill, which would otherwise cover the highlight
+                                highlighted_arcs.emplace_back(arc, current_element_color);
+                                break;
+                            }
                             // Pass board outline thickness for board outline elements
-                            double thickness_override = is_board_outline_pass ? board_outline_thickness : -1.0;
-                            RenderArc(bl_ctx, *arc, adjusted_world_view_rect, thickness_override);
+                            RenderArc(bl_ctx, *arc, adjusted_world_view_rect, arc_thickness_override);
                         }
                         break;
                     case ElementType::kVia:
@@ -413,7 +731,7 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
                                 via_color_from = layer_id_color_cache.count(via->GetLayerFrom()) ? layer_id_color_cache.at(via->GetLayerFrom()) : base_layer_theme_color;
                                 via_color_to = layer_id_color_cache.count(via->GetLayerTo()) ? layer_id_color_cache.at(via->GetLayerTo()) : base_layer_theme_color;
                             }
-                            RenderVia(bl_ctx, *via, board, adjusted_world_view_rect, via_color_from, via_color_to);
+                            RenderVia(bl_ctx, *via, board, adjusted_world_view_rect, via_color_from, via_color_to, &sub_pixel_batch);
                         }
                         break;
                     case ElementType::kComponent:
@@ -435,30 +753,61 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
                         break;
                 }
             }
+
+            if (stroked_geometry) {
+                const bool draws_arcs = target_element_types.empty() ||
+                    std::find(target_element_types.begin(), target_element_types.end(), ElementType::kArc) != target_element_types.end();
+                const bool draws_traces = target_element_types.empty() ||
+                    std::find(target_element_types.begin(), target_element_types.end(), ElementType::kTrace) != target_element_types.end();
+                if (draws_arcs) {
+                    const BLRgba32 arc_color = is_silkscreen_pass ? silkscreen_theme_color
+                        : is_board_outline_pass ? board_edges_theme_color
+                        : layer_id_color_cache.count(layer_id) ? layer_id_color_cache.at(layer_id) : base_layer_theme_color;
+                    FillStrokedCells(bl_ctx, *stroked_geometry, layer_id, StrokedGeometryCache::ShapeKind::kArcs, arc_color,
+                                     stroked_view_side, adjusted_world_view_rect);
+                    for (const auto& [arc, arc_color_override] : highlighted_arcs) {
+                        bl_ctx.setStrokeStyle(arc_color_override);
+                        RenderArc(bl_ctx, *arc, adjusted_world_view_rect, arc_thickness_override);
+                    }
+                }
+                highlighted_arcs.clear();
+                if (draws_traces) {
+                    // Filled with the pass's trace batch below, as the live traces are drawn after all of the pass's layers
+                    stroked_trace_layer_ids.push_back(layer_id);
+                }
+            }
+        }
+
+        // Sub-pixel vias, under the traces like the full-size ones
+        sub_pixel_batch.FlushPoints(bl_ctx);
+
+        // Determine base color for this batch of traces
+        BLRgba32 base_trace_color;
+        if (is_silkscreen_pass) {
+            base_trace_color = silkscreen_theme_color;
+        } else if (is_board_outline_pass) {
+            base_trace_color = board_edges_theme_color;
+        } else {
+            // Use the first layer's color for this batch
+            int first_layer_id = target_layer_ids.empty() ? 1 : target_layer_ids[0];
+            base_trace_color = layer_id_color_cache.count(first_layer_id) ?
+                              layer_id_color_cache.at(first_layer_id) : base_layer_theme_color;
+        }
+
+        for (int layer_id : stroked_trace_layer_ids) {
+            FillStrokedCells(bl_ctx, *stroked_geometry, layer_id, StrokedGeometryCache::ShapeKind::kTraces, base_trace_color,
+                             stroked_view_side, adjusted_world_view_rect);
         }
 
         // Performance optimization: Render all collected traces with individual highlighting support
         if (!traces_to_render.empty()) {
-            // Determine base color for this batch of traces
-            BLRgba32 base_trace_color;
-            if (is_silkscreen_pass) {
-                base_trace_color = silkscreen_theme_color;
-            } else if (is_board_outline_pass) {
-                base_trace_color = board_edges_theme_color;
-            } else {
-                // Use the first layer's color for this batch
-                int first_layer_id = target_layer_ids.empty() ? 1 : target_layer_ids[0];
-                base_trace_color = layer_id_color_cache.count(first_layer_id) ?
-                                  layer_id_color_cache.at(first_layer_id) : base_layer_theme_color;
-            }
-
             // Determine thickness override
             double thickness_override = is_board_outline_pass ? board_outline_thickness : -1.0;
 
             // Render traces with individual highlighting support
-            RenderTracesWithHighlighting(traces_to_render, base_trace_color, adjusted_world_view_rect,
+            RenderTracesWithHighlighting(bl_ctx, traces_to_render, base_trace_color, adjusted_world_view_rect,
                                        BL_STROKE_CAP_ROUND, BL_STROKE_CAP_ROUND, thickness_override,
-                                       selected_net_id, selected_element, highlight_color, selected_element_highlight_color);
+                                       selected_net_id, selected_element, highlight_color, selected_element_highlight_color, &sub_pixel_batch);
         }
     };
 
@@ -548,20 +897,15 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
     // Performance optimization: Execute rendering passes with reduced overhead
     std::map<int, std::pair<BLPoint, BLPoint>> trace_cap_manager_copper;
 
-    // Performance optimization: Use reusable containers
-    m_temp_layer_ids_.clear();
-    m_temp_element_types_.clear();
-    m_temp_element_types_.reserve(3);
-    m_temp_element_types_.push_back(ElementType::kTrace);
-    m_temp_element_types_.push_back(ElementType::kArc);
-    m_temp_element_types_.push_back(ElementType::kVia);
+    // Performance optimization: Reuse containers across passes (locals, so concurrent bands don't share them)
+    std::vector<int> single_layer_ids(1);
+    const std::vector<ElementType> copper_element_types = {ElementType::kTrace, ElementType::kArc, ElementType::kVia};
 
     for (int layer_id : rendering_order) {
         if (layer_id >= Board::kTraceLayersStart && layer_id <= Board::kTraceLayersEnd) {
             // Trace layers (1-16) - use reusable containers
-            m_temp_layer_ids_.clear();
-            m_temp_layer_ids_.push_back(layer_id);
-            executeRenderPass(m_temp_layer_ids_, m_temp_element_types_, trace_cap_manager_copper);
+            single_layer_ids[0] = layer_id;
+            executeRenderPass(single_layer_ids, copper_element_types, trace_cap_manager_copper);
         } else if (layer_id == Board::kTopCompLayer || layer_id == Board::kBottomCompLayer) {
             // Component layers (0, 30) - handled by existing component rendering logic below
             // Skip here as components are rendered in their own dedicated pass
@@ -608,8 +952,7 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
         const auto& elements_on_comp_layer = comp_layer_elements_it->second;
 
         // Performance optimization: Pre-check layer visibility once per layer
-        const Board::LayerInfo* comp_layer_info = board.GetLayerById(comp_layer_id);
-        if (!comp_layer_info || !comp_layer_info->IsVisible()) {
+        if (!render_state.IsLayerVisible(comp_layer_id)) {
             continue; // Skip entire layer if not visible
         }
 
@@ -637,78 +980,135 @@ void RenderPipeline::RenderBoard(BLContext& bl_ctx, const Board& board, const Ca
 
     // Render all components using parallel processing
     if (!all_components.empty()) {
-        RenderComponentsOptimized(all_components, board, adjusted_world_view_rect, theme_color_cache, selected_net_id, selected_element);
+        RenderComponentsOptimized(bl_ctx, all_components, board, geometry_cull_rect, theme_color_cache, selected_net_id, selected_element, &sub_pixel_batch);
     }
+    m_elements_sub_pixel_.fetch_add(sub_pixel_batch.GetCollapsedCount(), std::memory_order_relaxed);
     bl_ctx.restore();
 }
 
+std::shared_ptr<const BoardDataManager::ViewState> RenderPipeline::GetViewState() const
+{
+    if (m_view_state_override_) {
+        return m_view_state_override_;
+    }
+    std::shared_ptr<BoardDataManager> bdm = m_render_context_ ? m_render_context_->GetBoardDataManager() : nullptr;
+    return bdm ? bdm->GetViewState() : nullptr;
+}
+
 // Performance optimization: Cached rendering state management
+// One GetViewState() per frame: the state is rebuilt only when a new view state was published or the board changed
 const RenderingState& RenderPipeline::GetCachedRenderingState(const Board& board) const
 {
-    // Check if cache is still valid
-    if (m_cached_rendering_state_.is_valid &&
-        m_render_context_ && m_render_context_->GetBoardDataManager()) {
-
-        auto bdm = m_render_context_->GetBoardDataManager();
-        std::shared_ptr<const Board> current_board = bdm->GetBoard();
-
-        // Quick validation of cache validity
-        if (current_board == m_cached_rendering_state_.cached_board &&
-            bdm->GetCurrentViewSide() == m_cached_rendering_state_.cached_view_side &&
-            bdm->GetSelectedNetId() == m_cached_rendering_state_.cached_selected_net_id &&
-            bdm->GetSelectedElement() == m_cached_rendering_state_.cached_selected_element) {
-            return m_cached_rendering_state_;
+    std::shared_ptr<const BoardDataManager::ViewState> view_state = GetViewState();
+    if (!view_state) {
+        // No view state to follow: the visibility the board was loaded with
+        m_cached_rendering_state_.is_valid = false;
+        m_cached_rendering_state_.layer_id_visibility_cache.clear();
+        for (const Board::LayerInfo& layer_info_entry : board.layers) {
+            m_cached_rendering_state_.layer_id_visibility_cache[layer_info_entry.GetId()] = layer_info_entry.IsVisible();
         }
-    }
+        return m_cached_rendering_state_;
+    }
+    if (m_cached_rendering_state_.is_valid && view_state == m_cached_rendering_state_.view_state &&
+        m_cached_rendering_state_.cached_board.get() == &board) {
+        return m_cached_rendering_state_;
+    }
+
+    // Cache is invalid, rebuild it from the snapshot
+    RenderingState& state = m_cached_rendering_state_;
+    state.selected_net_id = view_state->selected_net_id;
+    state.selected_element = view_state->selected_element;
+    state.current_view_side = view_state->view_side;
+    state.board_outline_thickness = view_state->board_outline_thickness;
+    state.is_board_folding_enabled = view_state->board_folding_enabled;
+
+    // Cache theme colors (batch operation to reduce function call overhead)
+    auto& theme_cache = state.theme_color_cache;
+    theme_cache.clear();
+    theme_cache.reserve(10); // Pre-allocate for known color types
+    for (BoardDataManager::ColorType type :
+         {BoardDataManager::ColorType::kNetHighlight, BoardDataManager::ColorType::kSelectedElementHighlight, BoardDataManager::ColorType::kComponentFill,
+          BoardDataManager::ColorType::kComponentStroke, BoardDataManager::ColorType::kPinFill, BoardDataManager::ColorType::kPinStroke,
+          BoardDataManager::ColorType::kBaseLayer, BoardDataManager::ColorType::kSilkscreen, BoardDataManager::ColorType::kBoardEdges}) {
+        theme_cache[type] = view_state->GetColor(type);
+    }
+
+    // Cache layer colors and visibility (batch operation)
+    auto& layer_cache = state.layer_id_color_cache;
+    auto& visibility_cache = state.layer_id_visibility_cache;
+    layer_cache.clear();
+    visibility_cache.clear();
+
+    const auto& board_layers = board.layers;
+    layer_cache.reserve(board_layers.size()); // Pre-allocate
+    visibility_cache.reserve(board_layers.size());
+
+    for (size_t i = 0; i < board_layers.size(); ++i) {
+        const int layer_id = board_layers[i].GetId();
+        layer_cache[layer_id] = view_state->GetLayerColor(layer_id);
+        visibility_cache[layer_id] = view_state->IsLayerVisible(static_cast<int>(i));
+    }
+
+    // Update cache validity tracking; board is the published board being drawn, kept alive by the frame request
+    state.cached_board = view_state->board.get() == &board ? view_state->board : nullptr;
+    state.view_state = std::move(view_state);
+    state.is_valid = state.cached_board != nullptr;
+    return state;
+}
 
-    // Cache is invalid, rebuild it
-    m_cached_rendering_state_.is_valid = false;
+void RenderPipeline::RenderBoxSelectionOverlay(BLContext& bl_ctx, const Camera& camera, const Viewport& viewport, const BLRect& world_view_rect)
+{
+    const std::shared_ptr<const BoardDataManager::ViewState> view_state = GetViewState();
+    if (!view_state || !view_state->box_selection || view_state->box_selection->empty()) {
+        return;
+    }
+    const std::shared_ptr<const BoardDataManager::BoxSelection>& selection = view_state->box_selection;
 
-    if (m_render_context_ && m_render_context_->GetBoardDataManager()) {
-        auto bdm = m_render_context_->GetBoardDataManager();
-
-        // Cache basic state
-        m_cached_rendering_state_.selected_net_id = bdm->GetSelectedNetId();
-        m_cached_rendering_state_.selected_element = bdm->GetSelectedElement();
-        m_cached_rendering_state_.current_view_side = bdm->GetCurrentViewSide();
-        m_cached_rendering_state_.board_outline_thickness = bdm->GetBoardOutlineThickness();
-        m_cached_rendering_state_.is_board_folding_enabled = bdm->IsBoardFoldingEnabled();
-
-        // Cache theme colors (batch operation to reduce function call overhead)
-        auto& theme_cache = m_cached_rendering_state_.theme_color_cache;
-        theme_cache.clear();
-        theme_cache.reserve(10); // Pre-allocate for known color types
-
-        theme_cache[BoardDataManager::ColorType::kNetHighlight] = bdm->GetColor(BoardDataManager::ColorType::kNetHighlight);
-        theme_cache[BoardDataManager::ColorType::kSelectedElementHighlight] = bdm->GetColor(BoardDataManager::ColorType::kSelectedElementHighlight);
-        theme_cache[BoardDataManager::ColorType::kComponentFill] = bdm->GetColor(BoardDataManager::ColorType::kComponentFill);
-        theme_cache[BoardDataManager::ColorType::kComponentStroke] = bdm->GetColor(BoardDataManager::ColorType::kComponentStroke);
-        theme_cache[BoardDataManager::ColorType::kPinFill] = bdm->GetColor(BoardDataManager::ColorType::kPinFill);
-        theme_cache[BoardDataManager::ColorType::kPinStroke] = bdm->GetColor(BoardDataManager::ColorType::kPinStroke);
-        theme_cache[BoardDataManager::ColorType::kBaseLayer] = bdm->GetColor(BoardDataManager::ColorType::kBaseLayer);
-        theme_cache[BoardDataManager::ColorType::kSilkscreen] = bdm->GetColor(BoardDataManager::ColorType::kSilkscreen);
-        theme_cache[BoardDataManager::ColorType::kBoardEdges] = bdm->GetColor(BoardDataManager::ColorType::kBoardEdges);
-
-        // Cache layer colors (batch operation)
-        auto& layer_cache = m_cached_rendering_state_.layer_id_color_cache;
-        layer_cache.clear();
-
-        const auto& board_layers = board.GetLayers();
-        layer_cache.reserve(board_layers.size()); // Pre-allocate
-
-        for (const Board::LayerInfo& layer_info_entry : board_layers) {
-            layer_cache[layer_info_entry.GetId()] = bdm->GetLayerColor(layer_info_entry.GetId());
+    // Performance optimization: One path for all pad/body boxes and one for all trace centerlines, so even a
+    // selection covering most of the board costs two fills/strokes; elements outside the view are culled.
+    BLPath box_path;
+    BLPath trace_path;
+    for (const ElementInteractionInfo& info : *selection) {
+        if (!info.element) {
+            continue;
+        }
+        if (info.element->GetElementType() == ElementType::kTrace) {
+            const auto* trace = static_cast<const Trace*>(info.element);
+            const BLRect trace_bounds(std::min(trace->x1, trace->x2), std::min(trace->y1, trace->y2), std::abs(trace->x2 - trace->x1), std::abs(trace->y2 - trace->y1));
+            if (AreRectsIntersecting(trace_bounds, world_view_rect)) {
+                trace_path.moveTo(trace->x1, trace->y1);
+                trace_path.lineTo(trace->x2, trace->y2);
+            }
+            continue;
+        }
+        const BLRect bounds = info.element->GetBoundingBox(info.parent_component);
+        if (AreRectsIntersecting(bounds, world_view_rect)) {
+            box_path.addRect(bounds);
         }
+    }
+    if (box_path.empty() && trace_path.empty()) {
+        return;
+    }
+
+    const BLRgba32 highlight = view_state->GetColor(BoardDataManager::ColorType::kSelectedElementHighlight);
+    const double zoom = std::max(1e-6, static_cast<double>(camera.GetZoom()));
 
-        // Update cache validity tracking
-        m_cached_rendering_state_.cached_board = bdm->GetBoard();
-        m_cached_rendering_state_.cached_view_side = m_cached_rendering_state_.current_view_side;
-        m_cached_rendering_state_.cached_selected_net_id = m_cached_rendering_state_.selected_net_id;
-        m_cached_rendering_state_.cached_selected_element = m_cached_rendering_state_.selected_element;
-        m_cached_rendering_state_.is_valid = true;
+    bl_ctx.save();
+    bl_ctx.applyTransform(ViewMatrix(camera, viewport));
+    bl_ctx.setStrokeCaps(BL_STROKE_CAP_ROUND);
+    if (!box_path.empty()) {
+        bl_ctx.fillPath(box_path, BLRgba32(highlight.r(), highlight.g(), highlight.b(), 0x50));
+        bl_ctx.setStrokeWidth(1.5 / zoom);  // Constant 1.5 px outline at any zoom
+        bl_ctx.strokePath(box_path, highlight);
     }
+    if (!trace_path.empty()) {
+        bl_ctx.setStrokeWidth(3.0 / zoom);
+        bl_ctx.strokePath(trace_path, BLRgba32(highlight.r(), highlight.g(), highlight.b(), 0xB0));
+    }
+    bl_ctx.restore();
 
-    return m_cached_rendering_state_;
+    // The overlay bypasses the cached Blend2D state
+    ResetBlend2DStateTracking();
 }
 
 void RenderPipeline::InvalidateRenderingStateCache() const
@@ -779,9 +1179,6 @@ void RenderPipeline::InitializeObjectPools() const
     }
     m_path_pool_index_ = 0;
 
-    // Initialize reusable containers
-    m_temp_layer_ids_.reserve(20);
-    m_temp_element_types_.reserve(10);
 }
 
 // Performance monitoring and debugging
@@ -794,9 +1191,17 @@ void RenderPipeline::LogPerformanceStats() const
         std::cout << "RenderPipeline Performance Stats:" << std::endl;
         std::cout << "  Elements Rendered: " << m_elements_rendered_ << std::endl;
         std::cout << "  Elements Culled: " << m_elements_culled_ << std::endl;
+        std::cout << "  Elements Below a Pixel: " << m_elements_sub_pixel_ << std::endl;
         std::cout << "  Culling Ratio: " << std::fixed << std::setprecision(1) << culling_ratio << "%" << std::endl;
         std::cout << "  Cache Valid: " << (m_cached_rendering_state_.is_valid ? "Yes" : "No") << std::endl;
     }
+    path_cache::BLPathCache::CacheStats path_stats;
+    {
+        std::lock_guard<std::mutex> lock(path_cache::g_path_cache_mutex);
+        path_stats = path_cache::g_path_cache.GetStats();
+    }
+    std::cout << "  Path Cache: " << path_stats.total_entries << " entries, " << path_stats.total_bytes << "/" << path_stats.byte_budget
+              << " bytes, " << path_stats.cache_hits << " hits, " << path_stats.cache_misses << " misses, " << path_stats.evictions << " evictions" << std::endl;
     #endif
 }
 
@@ -863,7 +1268,8 @@ void RenderPipeline::RenderTrace(BLContext& bl_ctx, const Trace& trace, const BL
     ++m_elements_rendered_;
 }
 
-void RenderPipeline::RenderVia(BLContext& bl_ctx, const Via& via, const Board& board, const BLRect& world_view_rect, const BLRgba32& color_from, const BLRgba32& color_to)
+void RenderPipeline::RenderVia(BLContext& bl_ctx, const Via& via, const Board& board, const BLRect& world_view_rect, const BLRgba32& color_from, const BLRgba32& color_to,
+                               SubPixelBatch* sub_pixel_batch)
 {
     // Performance optimization: Cache via coordinates and radii
     const double via_x = via.GetX();
@@ -883,12 +1289,17 @@ void RenderPipeline::RenderVia(BLContext& bl_ctx, const Via& via, const Board& b
         return;  // Cull this via
     }
 
-    // Performance optimization: Batch layer visibility checks
-    const Board::LayerInfo* layer_from_props = board.GetLayerById(via.GetLayerFrom());
-    const Board::LayerInfo* layer_to_props = board.GetLayerById(via.GetLayerTo());
+    // Performance optimization: Batch layer visibility checks, against the state resolved before the bands started
+    const bool render_from_pad = m_cached_rendering_state_.IsLayerVisible(via.GetLayerFrom()) && radius_from > 0;
+    const bool render_to_pad = m_cached_rendering_state_.IsLayerVisible(via.GetLayerTo()) && radius_to > 0;
 
-    const bool render_from_pad = layer_from_props && layer_from_props->IsVisible() && radius_from > 0;
-    const bool render_to_pad = layer_to_props && layer_to_props->IsVisible() && radius_to > 0;
+    // Performance optimization: A via below a pixel is one point in the batch, in the color drawn on top
+    if (sub_pixel_batch && sub_pixel_batch->GetOptions().pad_points && sub_pixel_batch->IsSubPixel(diameter)) {
+        if (render_from_pad || render_to_pad) {
+            sub_pixel_batch->AddPoint(via_x, via_y, render_to_pad ? color_to : color_from);
+        }
+        return;
+    }
 
     // Performance optimization: Render pads with minimal state changes
     if (render_from_pad) {
@@ -907,14 +1318,6 @@ void RenderPipeline::RenderArc(BLContext& bl_ctx, const Arc& arc, const BLRect&
 {
     // AABB for the arc (approximated by the bounding box of its circle)
     // More precise AABB would involve checking arc extents, but this is usually sufficient for culling.
-    double radius = arc.GetRadius();
-    double thickness_for_aabb = arc.GetThickness() > 0 ? arc.GetThickness() : kDefaultArcThickness;
-    BLRect arc_aabb(arc.GetCenterX() - radius - thickness_for_aabb / 2.0, arc.GetCenterY() - radius - thickness_for_aabb / 2.0, 2 * radius + thickness_for_aabb, 2 * radius + thickness_for_aabb);
-
-    if (!AreRectsIntersecting(arc_aabb, world_view_rect)) {
-        return;  // Cull this arc
-    }
-
     // Color is set by RenderBoard.
     double final_thickness;
     if (thickness_override > 0.0) {
@@ -925,6 +1328,16 @@ void RenderPipeline::RenderArc(BLContext& bl_ctx, const Arc& arc, const BLRect&
             final_thickness = kDefaultArcThickness;  // Default thickness.
         }
     }
+
+    // The AABB must use the stroke actually drawn: with banded rasterization an under-sized box
+    // drops the arc from a band it still touches.
+    double radius = arc.GetRadius();
+    BLRect arc_aabb(arc.GetCenterX() - radius - final_thickness / 2.0, arc.GetCenterY() - radius - final_thickness / 2.0, 2 * radius + final_thickness, 2 * radius + final_thickness);
+
+    if (!AreRectsIntersecting(arc_aabb, world_view_rect)) {
+        return;  // Cull this arc
+    }
+
     bl_ctx.setStrokeWidth(final_thickness);
     double start_angle_rad = arc.GetStartAngle() * (kPi / 180.0);
     double end_angle_rad = arc.GetEndAngle() * (kPi / 180.0);
@@ -952,36 +1365,15 @@ void RenderPipeline::RenderComponent(BLContext& bl_ctx,
 									 const BLRgba32& component_stroke_color,
                                      const std::unordered_map<BoardDataManager::ColorType, BLRgba32>& theme_color_cache,
                                      int selected_net_id,
-                                     const Element* selected_element)
+                                     const Element* selected_element,
+                                     SubPixelBatch* sub_pixel_batch)
 {
     // Performance optimization: Cache component properties to avoid repeated member access
     const double comp_w = (component.width > 0) ? component.width : kDefaultComponentMinDimension;
     const double comp_h = (component.height > 0) ? component.height : kDefaultComponentMinDimension;
-    const double comp_cx = component.center_x;
-    const double comp_cy = component.center_y;
-    const double comp_rot_rad = component.rotation * (kPi / 180.0);
-
-    // Performance optimization: Pre-compute trigonometric values
-    const double cos_r = std::cos(comp_rot_rad);
-    const double sin_r = std::sin(comp_rot_rad);
-
-    // Performance optimization: Optimized bounding box calculation
-    // Pre-compute half dimensions to avoid repeated division
-    const double half_w = comp_w * 0.5;
-    const double half_h = comp_h * 0.5;
-
-    // Calculate rotated bounding box extents more efficiently
-    const double abs_cos_r = std::abs(cos_r);
-    const double abs_sin_r = std::abs(sin_r);
-    const double rotated_half_w = half_w * abs_cos_r + half_h * abs_sin_r;
-    const double rotated_half_h = half_w * abs_sin_r + half_h * abs_cos_r;
 
-    // Create axis-aligned bounding box
-    const BLRect component_world_bounds(comp_cx - rotated_half_w, comp_cy - rotated_half_h,
-                                       2.0 * rotated_half_w, 2.0 * rotated_half_h);
-
-    // Performance optimization: Early culling check
-    if (!AreRectsIntersecting(component_world_bounds, world_view_rect)) {
+    // Performance optimization: Early culling check (body and pins)
+    if (!AreRectsIntersecting(GetComponentRenderBounds(component), world_view_rect)) {
         return;  // Cull entire component
     }
 
@@ -1047,8 +1439,7 @@ void RenderPipeline::RenderComponent(BLContext& bl_ctx,
         }
 
         // Performance optimization: Check layer visibility once per pin
-        const Board::LayerInfo* pin_layer = board.GetLayerById(pin_ptr->GetLayerId());
-        if (!pin_layer || !pin_layer->IsVisible()) {
+        if (!m_cached_rendering_state_.IsLayerVisible(pin_ptr->GetLayerId())) {
             continue;
         }
 
@@ -1074,6 +1465,15 @@ void RenderPipeline::RenderComponent(BLContext& bl_ctx,
             final_fill_color = default_pin_fill_color;
             final_stroke_color = default_pin_stroke_color;
         }
+
+        // Performance optimization: A pin below a pixel is one point in the batch
+        if (sub_pixel_batch && sub_pixel_batch->GetOptions().pad_points) {
+            const auto [pin_width, pin_height] = pin_ptr->GetDimensions();
+            if (sub_pixel_batch->IsSubPixel(std::max(pin_width, pin_height))) {
+                sub_pixel_batch->AddPoint(pin_ptr->coords.x_ax, pin_ptr->coords.y_ax, final_fill_color);
+                continue;
+            }
+        }
 		
 
         // Performance optimization: Batch Blend2D state changes for pin rendering
@@ -1098,7 +1498,7 @@ void RenderPipeline::RenderComponent(BLContext& bl_ctx,
 }
 
 // Enhanced font caching system
-BLFont& RenderPipeline::GetCachedFont(const std::string& font_family, float size) {
+BLFont& RenderPipeline::GetCachedFont(InternedString font_family, float size) {
     std::lock_guard<std::mutex> lock(m_font_cache_mutex_);
 
     FontCacheKey key{font_family, size};
@@ -1116,7 +1516,7 @@ BLFont& RenderPipeline::GetCachedFont(const std::string& font_family, float size
     if (face_it != m_font_face_cache_.end()) {
         face = face_it->second;
     } else if (!font_family.empty()) {
-        err = face.createFromFile(font_family.c_str());
+        err = face.createFromFile(font_family.c_str());  // Interned text is NUL-terminated
         if (err == BL_SUCCESS) {
             m_font_face_cache_[font_family] = face;
         }
@@ -1138,7 +1538,7 @@ BLFont& RenderPipeline::GetCachedFont(const std::string& font_family, float size
 
         bool loadedFallback = false;
         for (const std::string& fontName : fallbackFonts) {
-            auto fallback_it = m_font_face_cache_.find(fontName);
+            auto fallback_it = m_font_face_cache_.find(InternedString(fontName));
             if (fallback_it != m_font_face_cache_.end()) {
                 face = fallback_it->second;
                 if (face.isValid()) {
@@ -1148,7 +1548,7 @@ BLFont& RenderPipeline::GetCachedFont(const std::string& font_family, float size
             }
             err = face.createFromFile(fontName.c_str());
             if (err == BL_SUCCESS) {
-                m_font_face_cache_[fontName] = face;
+                m_font_face_cache_[InternedString(fontName)] = face;
                 loadedFallback = true;
                 std::cout << "RenderPipeline: Successfully loaded fallback font: " << fontName << std::endl;
                 break;
@@ -1182,7 +1582,7 @@ void RenderPipeline::PreloadCommonFonts() {
 
     for (const auto& font_family : common_fonts) {
         for (float size : common_sizes) {
-            GetCachedFont(font_family, size);
+            GetCachedFont(InternedString(font_family), size);
         }
     }
 }
@@ -1195,6 +1595,15 @@ void RenderPipeline::RenderTextLabel(BLContext& bl_ctx, const TextLabel& text_la
 
     // Use cached font instead of creating new one every frame
     float final_size = static_cast<float>(text_label.font_size * text_label.scale);
+
+    // Performance optimization: Text shorter than a pixel is not legible; skip its glyph outlines entirely
+    if (m_sub_pixel_options_.text_culling) {
+        const BLMatrix2D view_transform = bl_ctx.userTransform();
+        if (final_size * std::hypot(view_transform.m00, view_transform.m01) < SubPixelBatch::kSubPixelSize) {
+            ++m_elements_sub_pixel_;
+            return;
+        }
+    }
     BLFont& font = GetCachedFont(text_label.font_family, final_size);
 
     bl_ctx.setFillStyle(color);
@@ -1377,7 +1786,8 @@ void RenderPipeline::ShutdownThreadPool()
 
 
 
-void RenderPipeline::RenderTracesWithHighlighting(const std::vector<const Trace*>& traces,
+void RenderPipeline::RenderTracesWithHighlighting(BLContext& ctx,
+                                                  const std::vector<const Trace*>& traces,
                                                   const BLRgba32& base_color,
                                                   const BLRect& world_view_rect,
                                                   BLStrokeCap start_cap,
@@ -1386,12 +1796,11 @@ void RenderPipeline::RenderTracesWithHighlighting(const std::vector<const Trace*
                                                   int selected_net_id,
                                                   const Element* selected_element,
                                                   const BLRgba32& highlight_color,
-                                                  const BLRgba32& selected_element_highlight_color)
+                                                  const BLRgba32& selected_element_highlight_color,
+                                                  SubPixelBatch* sub_pixel_batch)
 {
     if (traces.empty()) return;
 
-    auto& ctx = m_render_context_->GetBlend2DContext();
-
     // Group traces by color and thickness to minimize state changes while preserving highlighting
     // Use a simpler approach: separate containers for different colors
     std::vector<const Trace*> normal_traces;
@@ -1415,8 +1824,14 @@ void RenderPipeline::RenderTracesWithHighlighting(const std::vector<const Trace*
         }
     }
 
+    // Highlighted traces and forced thicknesses (board outline) always keep their stroke
+    SubPixelBatch* const density_batch = (thickness_override > 0.0) ? nullptr : sub_pixel_batch;
+
     // Helper lambda to render a group of traces with the same color
-    auto render_trace_group = [&](const std::vector<const Trace*>& group_traces, const BLRgba32& group_color) {
+    // Performance optimization: Highlighted and selected traces are drawn live every frame over the stroked fill;
+    // they fill outlines from the path cache instead of being stroked again each time
+    auto render_trace_group = [&](const std::vector<const Trace*>& group_traces, const BLRgba32& group_color, SubPixelBatch* group_density_batch,
+                                  bool use_path_cache) {
         if (group_traces.empty()) return;
 
         // Group by thickness to minimize state changes
@@ -1433,6 +1848,7 @@ void RenderPipeline::RenderTracesWithHighlighting(const std::vector<const Trace*
             if (traces_in_group.empty()) continue;
 
             // Set rendering state once for this thickness group
+            ctx.setFillStyle(group_color);
             ctx.setStrokeStyle(group_color);
             ctx.setStrokeWidth(thickness);
             ctx.setStrokeStartCap(start_cap);
@@ -1465,39 +1881,55 @@ void RenderPipeline::RenderTracesWithHighlighting(const std::vector<const Trace*
                     continue; // Cull this trace
                 }
 
+                // Performance optimization: Short sub-pixel traces only add their coverage to the density raster
+                if (group_density_batch && group_density_batch->AddTrace(start_x, start_y, end_x, end_y, thickness)) {
+                    continue;
+                }
+
+                if (use_path_cache) {
+                    RenderSingleTraceOptimized(ctx, trace, thickness_override, start_cap, end_cap);
+                    visible_count++;
+                    continue;
+                }
+
                 // Add line to batch path
                 batch_path.moveTo(start_x, start_y);
                 batch_path.lineTo(end_x, end_y);
                 visible_count++;
-                m_elements_rendered_++;
             }
 
             // Render entire batch with single stroke call
             if (visible_count > 0) {
-                ctx.strokePath(batch_path);
+                if (!batch_path.empty()) {
+                    ctx.strokePath(batch_path);
+                }
+                m_elements_rendered_.fetch_add(static_cast<size_t>(visible_count), std::memory_order_relaxed);
             }
         }
     };
 
     // Render traces in order: normal, highlighted, selected (so selected appears on top)
-    render_trace_group(normal_traces, base_color);
-    render_trace_group(highlighted_traces, highlight_color);
-    render_trace_group(selected_traces, selected_element_highlight_color);
+    render_trace_group(normal_traces, base_color, density_batch, false);
+    if (density_batch) {
+        density_batch->FlushTraces(ctx, base_color);
+    }
+    render_trace_group(highlighted_traces, highlight_color, nullptr, true);
+    render_trace_group(selected_traces, selected_element_highlight_color, nullptr, true);
 }
 
 
 
-void RenderPipeline::RenderComponentsOptimized(const std::vector<const Component*>& components,
+void RenderPipeline::RenderComponentsOptimized(BLContext& ctx,
+                                              const std::vector<const Component*>& components,
                                               const Board& board,
                                               const BLRect& world_view_rect,
                                               const std::unordered_map<BoardDataManager::ColorType, BLRgba32>& theme_colors,
                                               int selected_net_id,
-                                              const Element* selected_element)
+                                              const Element* selected_element,
+                                              SubPixelBatch* sub_pixel_batch)
 {
     if (components.empty()) return;
 
-    auto& ctx = m_render_context_->GetBlend2DContext();
-
     // Performance optimization: Group components by selection state to minimize state changes
     std::vector<const Component*> normal_components;
     std::vector<const Component*> selected_net_components;
@@ -1513,20 +1945,10 @@ void RenderPipeline::RenderComponentsOptimized(const std::vector<const Component
     for (const Component* component : components) {
         if (!component) continue;
 
-        // Early viewport culling with simple AABB check
-        const double comp_w = (component->width > 0) ? component->width : kDefaultComponentMinDimension;
-        const double comp_h = (component->height > 0) ? component->height : kDefaultComponentMinDimension;
-        const double comp_cx = component->center_x;
-        const double comp_cy = component->center_y;
-
-        // Simple AABB check for culling (could be enhanced with rotation later)
-        const double half_w = comp_w * 0.5;
-        const double half_h = comp_h * 0.5;
-        const BLRect component_bounds(comp_cx - half_w, comp_cy - half_h, comp_w, comp_h);
-
-        if (!AreRectsIntersecting(component_bounds, world_view_rect)) {
+        // Early viewport culling against the rotated body and the pins, so a band keeps every component
+        // that reaches into it
+        if (!AreRectsIntersecting(GetComponentRenderBounds(*component), world_view_rect)) {
             culled_count++;
-            m_elements_culled_++;
             continue; // Cull this component
         }
 
@@ -1557,10 +1979,11 @@ void RenderPipeline::RenderComponentsOptimized(const std::vector<const Component
         if (batch.empty()) return;
 
         for (const Component* component : batch) {
-            RenderComponent(ctx, *component, board, world_view_rect, fill_color, stroke_color, theme_colors, selected_net_id, selected_element);
-            m_elements_rendered_++;
+            RenderComponent(ctx, *component, board, world_view_rect, fill_color, stroke_color, theme_colors, selected_net_id, selected_element, sub_pixel_batch);
         }
+        m_elements_rendered_.fetch_add(batch.size(), std::memory_order_relaxed);
     };
+    m_elements_culled_.fetch_add(culled_count, std::memory_order_relaxed);
 
     // Render normal components
     auto fill_it = theme_colors.find(BoardDataManager::ColorType::kComponentFill);
@@ -1579,6 +2002,11 @@ void RenderPipeline::RenderComponentsOptimized(const std::vector<const Component
     BLRgba32 element_color = (element_it != theme_colors.end()) ? element_it->second : BLRgba32(0xFFFFFF00);
     render_component_batch(selected_element_components, element_color, element_color);
 
+    // Sub-pixel pins of all components, on top of the bodies
+    if (sub_pixel_batch) {
+        sub_pixel_batch->FlushPoints(ctx);
+    }
+
 
 }
 
@@ -1656,7 +2084,7 @@ void RenderPipeline::RenderBoardLowDetail(BLContext& bl_ctx, const Board& board,
 {
     // Low detail - render basic shapes without fine details
     bl_ctx.save();
-    bl_ctx.applyTransform(ViewMatrix(bl_ctx, camera, viewport));
+    bl_ctx.applyTransform(ViewMatrix(camera, viewport));
 
     const RenderingState& render_state = GetCachedRenderingState(board);
 
@@ -1672,8 +2100,7 @@ void RenderPipeline::RenderBoardLowDetail(BLContext& bl_ctx, const Board& board,
         auto layer_it = board.m_elements_by_layer.find(layer_id);
         if (layer_it == board.m_elements_by_layer.end()) continue;
 
-        const Board::LayerInfo* layer_info = board.GetLayerById(layer_id);
-        if (!layer_info || !layer_info->IsVisible()) continue;
+        if (!render_state.IsLayerVisible(layer_id)) continue;
 
         for (const auto& element_ptr : layer_it->second) {
             if (!element_ptr || !element_ptr->IsVisible()) continue;
@@ -1730,8 +2157,7 @@ void RenderPipeline::RenderComponentsSimplified(BLContext& bl_ctx, const Board&
         auto layer_it = board.m_elements_by_layer.find(layer_id);
         if (layer_it == board.m_elements_by_layer.end()) continue;
 
-        const Board::LayerInfo* layer_info = board.GetLayerById(layer_id);
-        if (!layer_info || !layer_info->IsVisible()) continue;
+        if (!render_state.IsLayerVisible(layer_id)) continue;
 
         for (const auto& element_ptr : layer_it->second) {
             if (!element_ptr || !element_ptr->IsVisible()) continue;
@@ -1844,44 +2270,6 @@ bool RenderPipeline::ShouldUseCache(const Camera& camera, const Viewport& viewpo
                                            std::vector<bool>{}); // TODO: Add layer visibility tracking
 }
 
-void RenderPipeline::RebuildSpatialIndex(const Board& board)
-{
-    if (!m_spatial_index_dirty_) return;
-
-    // Collect all visible elements
-    std::vector<const Element*> all_elements;
-
-    for (const auto& layer_pair : board.m_elements_by_layer) {
-        const Board::LayerInfo* layer_info = board.GetLayerById(layer_pair.first);
-        if (!layer_info || !layer_info->IsVisible()) continue;
-
-        for (const auto& element_ptr : layer_pair.second) {
-            if (element_ptr && element_ptr->IsVisible()) {
-                all_elements.push_back(element_ptr.get());
-            }
-        }
-    }
-
-    // Rebuild spatial index
-    m_hit_detector_.RebuildIndex(all_elements);
-    m_spatial_index_dirty_ = false;
-}
-
-const Element* RenderPipeline::FindHitElementOptimized(const Vec2& world_pos, float tolerance, const Component* parent_component)
-{
-    // Ensure spatial index is up to date
-    if (m_spatial_index_dirty_ && m_render_context_ && m_render_context_->GetBoardDataManager()) {
-        auto bdm = m_render_context_->GetBoardDataManager();
-        auto board = bdm->GetBoard();
-        if (board) {
-            RebuildSpatialIndex(*board);
-        }
-    }
-
-    // Use optimized hit detection
-    return m_hit_detector_.FindHitElement(world_pos, tolerance, parent_component);
-}
-
 void RenderPipeline::RenderTracesOptimized(const std::vector<const Trace*>& traces,
                                           const BLRgba32& color,
                                           const BLRect& world_view_rect,
@@ -1902,17 +2290,22 @@ void RenderPipeline::RenderTracesOptimized(const std::vector<const Trace*>& trac
     RenderTracesBatchedAsync(ctx, traces, color, world_view_rect, start_cap, end_cap, thickness_override);
 }
 
-void RenderPipeline::RenderSingleTraceOptimized(BLContext& bl_ctx, const Trace* trace, double thickness_override)
+void RenderPipeline::RenderSingleTraceOptimized(BLContext& bl_ctx, const Trace* trace, double thickness_override, BLStrokeCap start_cap,
+                                                BLStrokeCap end_cap)
 {
     if (!trace) return;
 
-    // Create cache key for this trace
-    std::string trace_id = std::to_string(reinterpret_cast<uintptr_t>(trace));
     double final_thickness = (thickness_override > 0.0) ? thickness_override :
                             (trace->GetWidth() > 0 ? trace->GetWidth() : kDefaultTraceWidth);
 
-    auto cache_key = path_cache::BLPathCache::CreateTraceKey(trace_id, final_thickness,
-                                                            BL_STROKE_CAP_ROUND, BL_STROKE_CAP_ROUND);
+    // The context's scale is the camera zoom; it picks how finely the cached outline is flattened
+    const BLMatrix2D view_transform = bl_ctx.userTransform();
+    const int32_t zoom_bucket = path_cache::BLPathCache::GetZoomBucket(std::hypot(view_transform.m00, view_transform.m01));
+    // Keyed by the trace's end points rather than its address: the outline depends on nothing else, and an address
+    // can be reused by another trace once a board or geometry variant is freed. The key holds the points themselves,
+    // so a hash collision between two traces cannot hand one the other's outline.
+    auto cache_key = path_cache::BLPathCache::CreateTraceKey(trace->GetStartX(), trace->GetStartY(), trace->GetEndX(), trace->GetEndY(), final_thickness,
+                                                             start_cap, end_cap, zoom_bucket);
 
     // Create path for this trace
     BLPath trace_path;
@@ -1922,13 +2315,17 @@ void RenderPipeline::RenderSingleTraceOptimized(BLContext& bl_ctx, const Trace*
     // Set up stroke options
     BLStrokeOptions stroke_opts;
     stroke_opts.width = final_thickness;
-    stroke_opts.startCap = BL_STROKE_CAP_ROUND;
-    stroke_opts.endCap = BL_STROKE_CAP_ROUND;
+    stroke_opts.startCap = start_cap;
+    stroke_opts.endCap = end_cap;
 
     // Get cached stroked path
-    const BLPath& stroked_path = path_cache::g_path_cache.GetStrokedPath(cache_key, trace_path, stroke_opts);
+    BLPath stroked_path;
+    {
+        std::lock_guard<std::mutex> lock(path_cache::g_path_cache_mutex);
+        stroked_path = path_cache::g_path_cache.GetStrokedPath(cache_key, trace_path, stroke_opts);
+    }
 
-    // Render the cached path
+    // Render the cached path with the context's fill style
     bl_ctx.fillPath(stroked_path);
 }
 
@@ -12,15 +12,19 @@
 #include <queue>
 #include <functional>
 #include <map>  // Added for std::map usage
+#include <cmath>
 
 #include <blend2d.h>  // Include for BLContext
 
 #include "core/BoardDataManager.hpp"
 #include "utils/Constants.hpp"  // For kPi
 #include "pcb/elements/Element.hpp"  // For ElementType enum
+#include "pcb/StringInterner.hpp"
 #include "BLPathCache.hpp"  // Enhanced path caching
 #include "LODManager.hpp"   // Level of Detail management
-#include "../utils/SpatialIndex.hpp"  // Spatial indexing for hit detection
+#include "StrokedGeometryCache.hpp"
+#include "OverviewPyramid.hpp"
+#include "SubPixelBatch.hpp"
 
 // Forward declarations
 class RenderContext;  // The Blend2D-focused RenderContext
@@ -44,14 +48,19 @@ struct RenderingState {
     float board_outline_thickness = 0.1f;
     std::unordered_map<BoardDataManager::ColorType, BLRgba32> theme_color_cache;
     std::unordered_map<int, BLRgba32> layer_id_color_cache;
+    std::unordered_map<int, bool> layer_id_visibility_cache;  // From view_state, so a frame sees one consistent set
     bool is_board_folding_enabled = false;
 
-    // Cache validity tracking
+    // Cache validity tracking: published view states are immutable, so the pointer identifies the state
     mutable bool is_valid = false;
+    mutable std::shared_ptr<const BoardDataManager::ViewState> view_state;
     mutable std::shared_ptr<const Board> cached_board;
-    mutable BoardDataManager::BoardSide cached_view_side = BoardDataManager::BoardSide::kBoth;
-    mutable int cached_selected_net_id = -1;
-    mutable const Element* cached_selected_element = nullptr;
+
+    [[nodiscard]] bool IsLayerVisible(int layer_id) const
+    {
+        auto it = layer_id_visibility_cache.find(layer_id);
+        return it != layer_id_visibility_cache.end() && it->second;
+    }
 };
 
 // Performance optimization: Dirty region tracking for intelligent re-rendering
@@ -131,19 +140,21 @@ struct CachedBoardRender {
 };
 
 // Enhanced font caching structure
+// Performance optimization: Interned family plus the size in hundredths, so lookups compare and hash two integers
 struct FontCacheKey {
-    std::string font_family;
-    float size;
+    InternedString font_family;
+    int32_t size_hundredths = 0;
+
+    FontCacheKey(InternedString family, float size) : font_family(family), size_hundredths(static_cast<int32_t>(std::lround(size * 100.0f))) {}
 
     bool operator==(const FontCacheKey& other) const {
-        return font_family == other.font_family && std::abs(size - other.size) < 0.01f;
+        return font_family == other.font_family && size_hundredths == other.size_hundredths;
     }
 };
 
 struct FontCacheKeyHash {
     std::size_t operator()(const FontCacheKey& key) const {
-        return std::hash<std::string>{}(key.font_family) ^
-               (std::hash<float>{}(key.size) << 1);
+        return std::hash<uint64_t>{}((static_cast<uint64_t>(key.font_family.GetSymbol()) << 32) | static_cast<uint32_t>(key.size_hundredths));
     }
 };
 
@@ -262,11 +273,18 @@ public:
                  bool render_board  // New: flag to control board rendering
     );
 
-    BLMatrix2D ViewMatrix(BLContext& bl_ctx, const Camera& camera, const Viewport& viewport);
+    // World-to-viewport matrix for applyTransform. It leaves out the context's meta matrix, which Blend2D already
+    // applies after the user matrix (TileRenderer keeps its sub-pixel offset there).
+    BLMatrix2D ViewMatrix(const Camera& camera, const Viewport& viewport);
 
     // Cache invalidation for immediate color updates
     void InvalidateRenderingStateCache() const;
 
+    // Work finishing on workers (pre-stroked geometry and overview pyramid builds), polled from the render thread. Poll returns true
+    // when its result should be drawn, i.e. the board needs a redraw.
+    bool PollBackgroundWork();
+    [[nodiscard]] bool HasPendingBackgroundWork() const;
+
 
 
     // To keep PcbRenderer simple, RenderPipeline will be responsible for calling Grid::Render().
@@ -278,7 +296,8 @@ public:
 
     // Helper methods for rendering specific PCB elements
     void RenderTrace(BLContext& bl_ctx, const Trace& trace, const BLRect& world_view_rect, BLStrokeCap start_cap, BLStrokeCap end_cap, double thickness_override = -1.0);
-    void RenderVia(BLContext& bl_ctx, const Via& via, const Board& board, const BLRect& world_view_rect, const BLRgba32& color_from, const BLRgba32& color_to);
+    void RenderVia(BLContext& bl_ctx, const Via& via, const Board& board, const BLRect& world_view_rect, const BLRgba32& color_from, const BLRgba32& color_to,
+                   SubPixelBatch* sub_pixel_batch = nullptr);
     void RenderArc(BLContext& bl_ctx, const Arc& arc, const BLRect& world_view_rect, double thickness_override = -1.0);
     void RenderComponent(BLContext& bl_ctx,
                          const Component& component,
@@ -288,7 +307,8 @@ public:
 						 const BLRgba32& component_stroke_color,
                          const std::unordered_map<BoardDataManager::ColorType, BLRgba32>& theme_color_cache,
                          int selected_net_id,
-                         const class Element* selected_element = nullptr);
+                         const class Element* selected_element = nullptr,
+                         SubPixelBatch* sub_pixel_batch = nullptr);
     void RenderTextLabel(BLContext& bl_ctx, const TextLabel& text_label, const BLRgba32& color);
     // TODO: Consider passing layer_properties_map to RenderTextLabel if it needs more than just color
     // void RenderPin(BLContext &bl_ctx, const Pin &pin, const Component &component, const Board &board, const BLRgba32 &highlightColor);
@@ -297,16 +317,41 @@ public:
     // Initialization status
     bool IsInitialized() const { return m_initialized_; }
 
-    // Hit detection
-    const Element* FindHitElementOptimized(const Vec2& world_pos, float tolerance, const Component* parent_component = nullptr);
+    // Banded rasterization: split the viewport into horizontal bands rendered in parallel
+    // by the thread pool, each through its own BLContext clipped to the band
+    void SetBandedRasterizationEnabled(bool enabled) { m_banded_rasterization_enabled_ = enabled; }
+    [[nodiscard]] bool IsBandedRasterizationEnabled() const { return m_banded_rasterization_enabled_; }
+
+    // Headless renderers that run several pipelines side by side (tiled export, tile serving) keep each one lean:
+    // no thread pool for bands (call before Initialize()) and no pre-stroked geometry, whose byte budget and
+    // background build would otherwise be paid once per pipeline
+    void SetThreadPoolEnabled(bool enabled);
+    void SetStrokedGeometryCacheEnabled(bool enabled) { m_stroked_geometry_enabled_ = enabled; }
+    // Zoomed-out frames blit the OverviewPyramid instead of drawing vectors
+    void SetOverviewPyramidEnabled(bool enabled);
+    [[nodiscard]] bool IsOverviewPyramidEnabled() const { return m_overview_pyramid_enabled_; }
+    // Quality toggles for the stand-ins drawn for sub-pixel traces, vias, pins and text
+    void SetSubPixelCulling(const SubPixelBatch::Options& options) { m_sub_pixel_options_ = options; }
+    [[nodiscard]] const SubPixelBatch::Options& GetSubPixelCulling() const { return m_sub_pixel_options_; }
+    // Draws this view state instead of the BoardDataManager's published one (tile server: layers and net from the
+    // request); null follows the manager again. Its board must be the one passed to Execute.
+    void SetViewStateOverride(std::shared_ptr<const BoardDataManager::ViewState> view_state) { m_view_state_override_ = std::move(view_state); }
 
 private:
     // Helper function to get the visible area in world coordinates
     [[nodiscard]] BLRect GetVisibleWorldBounds(const Camera& camera, const Viewport& viewport) const;
+    // World-space AABB of an arbitrary screen rectangle (screen coordinates include the viewport offset)
+    [[nodiscard]] BLRect GetScreenRectWorldBounds(const Camera& camera, const Viewport& viewport, const BLRect& screen_rect) const;
+
+    // The override if set, else the manager's published state; null without either
+    [[nodiscard]] std::shared_ptr<const BoardDataManager::ViewState> GetViewState() const;
 
     // Performance optimization: Cached rendering state management
     const RenderingState& GetCachedRenderingState(const Board& board) const;
 
+    // Highlight overlay for BoardDataManager's box selection, drawn on top of the finished board
+    void RenderBoxSelectionOverlay(BLContext& bl_ctx, const Camera& camera, const Viewport& viewport, const BLRect& world_view_rect);
+
     // Performance optimization: Batch rendering methods to reduce state changes
     void SetFillColorOptimized(BLContext& ctx, const BLRgba32& color) const;
     void SetStrokeColorOptimized(BLContext& ctx, const BLRgba32& color) const;
@@ -322,6 +367,7 @@ private:
     void LogPerformanceStats() const;
     size_t GetElementsRendered() const { return m_elements_rendered_; }
     size_t GetElementsCulled() const { return m_elements_culled_; }
+    size_t GetElementsSubPixel() const { return m_elements_sub_pixel_; }
     double GetCullingRatio() const {
         size_t total = m_elements_rendered_ + m_elements_culled_;
         return total > 0 ? static_cast<double>(m_elements_culled_) / total : 0.0;
@@ -333,17 +379,20 @@ private:
 
 
 
-    void RenderComponentsOptimized(const std::vector<const Component*>& components,
+    void RenderComponentsOptimized(BLContext& ctx,
+                                  const std::vector<const Component*>& components,
                                   const Board& board,
                                   const BLRect& world_view_rect,
                                   const std::unordered_map<BoardDataManager::ColorType, BLRgba32>& theme_colors,
                                   int selected_net_id,
-                                  const Element* selected_element);
+                                  const Element* selected_element,
+                                  SubPixelBatch* sub_pixel_batch = nullptr);
 
 
 
     // Enhanced trace rendering with individual highlighting support
-    void RenderTracesWithHighlighting(const std::vector<const Trace*>& traces,
+    void RenderTracesWithHighlighting(BLContext& ctx,
+                                     const std::vector<const Trace*>& traces,
                                      const BLRgba32& base_color,
                                      const BLRect& world_view_rect,
                                      BLStrokeCap start_cap,
@@ -352,19 +401,27 @@ private:
                                      int selected_net_id,
                                      const Element* selected_element,
                                      const BLRgba32& highlight_color,
-                                     const BLRgba32& selected_element_highlight_color);
+                                     const BLRgba32& selected_element_highlight_color,
+                                     SubPixelBatch* sub_pixel_batch = nullptr);
 
-    void RenderComponentsParallel(const std::vector<const Component*>& components,
-                                 const Board& board,
-                                 const BLRect& world_view_rect,
-                                 const std::unordered_map<BoardDataManager::ColorType, BLRgba32>& theme_colors,
-                                 int selected_net_id,
-                                 const Element* selected_element);
+    // Banded rasterization helpers
+    [[nodiscard]] bool ShouldUseBandedRasterization(const Viewport& viewport) const;
+    void RenderBoardBanded(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport,
+                           const BLRect& world_view_rect, const RenderingState& render_state,
+                           const StrokedGeometryCache::Geometry* stroked_geometry);
 
+    // Pre-stroked trace/arc geometry for the current board and zoom, or null while it is being built
+    std::shared_ptr<const StrokedGeometryCache::Geometry> AcquireStrokedGeometry(const Board& board, const Camera& camera,
+                                                                               const RenderingState& render_state);
+    // Draws the board from the overview pyramid if the zoom is low enough and it is built; false to draw vectors
+    bool RenderOverview(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport, const RenderingState& render_state);
+    // Fills one layer's pre-stroked traces or arcs, culled per spatial cell
+    void FillStrokedCells(BLContext& bl_ctx, const StrokedGeometryCache::Geometry& geometry, int layer_id, StrokedGeometryCache::ShapeKind kind,
+                          const BLRgba32& color, BoardDataManager::BoardSide view_side, const BLRect& world_view_rect) const;
 
 
     // Enhanced font management
-    BLFont& GetCachedFont(const std::string& font_family, float size);
+    BLFont& GetCachedFont(InternedString font_family, float size);
     void PreloadCommonFonts();
 
     // New optimization methods
@@ -375,9 +432,6 @@ private:
     void UpdateDirtyRegions(const Camera& camera, const Viewport& viewport, const Board& board);
     bool ShouldUseCache(const Camera& camera, const Viewport& viewport, const Board& board) const;
 
-    // Spatial indexing methods
-    void RebuildSpatialIndex(const Board& board);
-
     // Enhanced trace rendering with spatial partitioning
     void RenderTracesOptimized(const std::vector<const Trace*>& traces,
                               const BLRgba32& color,
@@ -401,8 +455,9 @@ private:
     void RenderComponentsSimplified(BLContext& bl_ctx, const Board& board,
                                    const BLRect& world_view_rect, const RenderingState& render_state);
 
-    // Optimized single trace rendering with path caching
-    void RenderSingleTraceOptimized(BLContext& bl_ctx, const Trace* trace, double thickness_override);
+    // Optimized single trace rendering with path caching: fills the trace's cached outline (see g_path_cache)
+    void RenderSingleTraceOptimized(BLContext& bl_ctx, const Trace* trace, double thickness_override, BLStrokeCap start_cap = BL_STROKE_CAP_ROUND,
+                                    BLStrokeCap end_cap = BL_STROKE_CAP_ROUND);
 
     // std::vector<std::unique_ptr<RenderStage>> m_stages;
     // Or a more direct approach if stages are fixed:
@@ -413,12 +468,18 @@ private:
 
     // Helper methods for drawing specific parts, called from Execute
     void RenderBoard(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport, const BLRect& world_view_rect);
+    // Draws the board into bl_ctx, culled against geometry_cull_rect (the view, or a single band in banded mode).
+    // Components are culled with their pins, so pins overhanging a band edge are drawn by both bands.
+    // With stroked_geometry, traces and arcs that are not highlighted are filled from it instead of stroked.
+    void RenderBoardRegion(BLContext& bl_ctx, const Board& board, const Camera& camera, const Viewport& viewport,
+                           const BLRect& geometry_cull_rect, const RenderingState& render_state,
+                           const StrokedGeometryCache::Geometry* stroked_geometry);
 
     RenderContext* m_render_context_ = nullptr;  // Store a pointer to the context if needed by multiple methods
     bool m_initialized_ = false;
 
     // Enhanced font caching system
-    std::map<std::string, BLFontFace> m_font_face_cache_;
+    std::unordered_map<InternedString, BLFontFace> m_font_face_cache_;
     std::unordered_map<FontCacheKey, BLFont, FontCacheKeyHash> m_font_cache_;
     mutable std::mutex m_font_cache_mutex_;
 
@@ -431,9 +492,10 @@ private:
     mutable double m_last_stroke_width_;
     mutable bool m_blend2d_state_dirty_;
 
-    // Performance optimization: Culling statistics for debugging
-    mutable size_t m_elements_rendered_;
-    mutable size_t m_elements_culled_;
+    // Performance optimization: Culling statistics for debugging (atomic: bands update them concurrently)
+    mutable std::atomic<size_t> m_elements_rendered_{0};
+    mutable std::atomic<size_t> m_elements_culled_{0};
+    mutable std::atomic<size_t> m_elements_sub_pixel_{0};  // Drawn as density, points, or skipped text
 
 
 
@@ -441,15 +503,16 @@ private:
     mutable std::vector<BLPath> m_path_pool_;
     mutable size_t m_path_pool_index_;
 
-    // Performance optimization: Reusable containers to avoid allocations
-    mutable std::vector<int> m_temp_layer_ids_;
-    mutable std::vector<ElementType> m_temp_element_types_;
-
     // Enhanced multi-threading system with persistent thread pool
     mutable std::unique_ptr<ThreadPool> m_thread_pool_;
     mutable std::atomic<bool> m_threading_enabled_;
     mutable std::mutex m_thread_mutex_;
     mutable unsigned int m_thread_count_;
+    bool m_banded_rasterization_enabled_ = false;
+    bool m_stroked_geometry_enabled_ = true;
+    bool m_overview_pyramid_enabled_ = true;
+    SubPixelBatch::Options m_sub_pixel_options_;
+    std::shared_ptr<const BoardDataManager::ViewState> m_view_state_override_;
 
     // Performance tuning parameters
     mutable size_t m_min_traces_for_threading_;
@@ -459,12 +522,16 @@ private:
 
     // Enhanced optimization systems
     mutable lod::LODManager m_lod_manager_;
-    mutable spatial_index::OptimizedHitDetector m_hit_detector_;
-    mutable bool m_spatial_index_dirty_;
 
     // Performance optimization: Dirty region tracking for intelligent re-rendering
     mutable DirtyRegionTracker m_dirty_tracker_;
     mutable CachedBoardRender m_cached_board_render_;
 
+    // Performance optimization: Traces and arcs stroked once per zoom bucket, filled every frame
+    StrokedGeometryCache m_stroked_geometry_cache_;
+
+    // Performance optimization: Zoomed-out frames blit a prebuilt raster pyramid of the board
+    OverviewPyramid m_overview_pyramid_;
+
     // Add any other members needed for managing rendering state or resources for the pipeline
 };
@@ -0,0 +1,401 @@
+#include "StrokedGeometryCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+
+#include "pcb/Board.hpp"
+#include "pcb/elements/Arc.hpp"
+#include "pcb/elements/Component.hpp"
+#include "pcb/elements/Trace.hpp"
+#include "utils/Constants.hpp"
+
+namespace
+{
+// Bytes Blend2D keeps per path besides its vertex and command arrays
+constexpr size_t kPathImplOverheadBytes = 64;
+
+size_t GetPathBytes(const BLPath& path)
+{
+    // One point plus one command byte per vertex
+    return kPathImplOverheadBytes + path.capacity() * (sizeof(BLPoint) + sizeof(uint8_t));
+}
+
+void ExpandBox(BLBox& box, double min_x, double min_y, double max_x, double max_y)
+{
+    box.x0 = std::min(box.x0, min_x);
+    box.y0 = std::min(box.y0, min_y);
+    box.x1 = std::max(box.x1, max_x);
+    box.y1 = std::max(box.y1, max_y);
+}
+}  // namespace
+
+const std::vector<StrokedGeometryCache::Cell>* StrokedGeometryCache::Geometry::GetCells(int layer_id, ShapeKind kind, SideGroup side) const
+{
+    auto it = m_groups_.find(MakeGroupKey(layer_id, kind, side));
+    return it != m_groups_.end() ? &it->second : nullptr;
+}
+
+bool StrokedGeometryCache::CollectOptions::operator==(const CollectOptions& other) const
+{
+    return default_trace_width == other.default_trace_width && default_arc_thickness == other.default_arc_thickness &&
+           silkscreen_layer_id == other.silkscreen_layer_id && board_outline_layer_id == other.board_outline_layer_id &&
+           board_outline_thickness == other.board_outline_thickness;
+}
+
+StrokedGeometryCache::StrokedGeometryCache(size_t byte_budget) : m_byte_budget_(byte_budget) {}
+
+StrokedGeometryCache::~StrokedGeometryCache()
+{
+    Clear();
+}
+
+void StrokedGeometryCache::Update(const std::shared_ptr<const Board>& board, const CollectOptions& options)
+{
+    PollPendingBuild();
+
+    if (!board || !board->IsLoaded()) {
+        if (m_sources_) {
+            Clear();
+        }
+        return;
+    }
+
+    const std::shared_ptr<const Board> current_board = m_board_.lock();
+    if (m_sources_ && current_board == board && m_board_revision_ == board->GetGeometryRevision() && m_options_ == options) {
+        return;
+    }
+
+    // Performance optimization: Another board (usually another geometry variant) keeps what was built for the
+    // current one, and may have been shown before itself; geometry that moved or other options make it stale.
+    // Boards that are gone can never be shown again.
+    m_parked_boards_.erase(std::remove_if(m_parked_boards_.begin(), m_parked_boards_.end(),
+                                          [](const ParkedBoard& entry) { return entry.board.expired(); }),
+                           m_parked_boards_.end());
+    if (m_sources_ && current_board && current_board != board) {
+        ParkCurrent();
+    } else {
+        ResetCurrent();
+    }
+    if (RestoreParked(board, options)) {
+        return;
+    }
+
+    const auto collect_start = std::chrono::steady_clock::now();
+    m_board_ = board;
+    m_board_revision_ = board->GetGeometryRevision();
+    m_options_ = options;
+    m_sources_ = CollectSources(*board, options);
+    const double collect_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - collect_start).count();
+    std::cout << "StrokedGeometryCache: Collected " << m_sources_->groups.size() << " stroke groups in " << collect_ms << " ms" << std::endl;
+}
+
+std::shared_ptr<const StrokedGeometryCache::Geometry> StrokedGeometryCache::Acquire(int zoom_bucket, double world_tolerance)
+{
+    PollPendingBuild();
+    if (!m_sources_) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < m_buckets_.size(); ++i) {
+        if (m_buckets_[i]->GetZoomBucket() == zoom_bucket) {
+            std::rotate(m_buckets_.begin(), m_buckets_.begin() + static_cast<std::ptrdiff_t>(i), m_buckets_.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+            return m_buckets_.front();
+        }
+    }
+
+    // One build at a time: a bucket the view only passed through is not worth a second worker
+    const bool unavailable = std::find(m_unavailable_buckets_.begin(), m_unavailable_buckets_.end(), zoom_bucket) != m_unavailable_buckets_.end();
+    if (!m_pending_ && !unavailable) {
+        StartBuild(zoom_bucket, world_tolerance);
+    }
+    return nullptr;
+}
+
+void StrokedGeometryCache::Clear()
+{
+    ResetCurrent();
+    m_parked_boards_.clear();
+}
+
+void StrokedGeometryCache::ResetCurrent()
+{
+    if (m_pending_) {
+        // The worker stops at its next group; its result is dropped by the generation check
+        m_pending_->cancelled->store(true, std::memory_order_relaxed);
+    }
+    ++m_generation_;
+    m_sources_.reset();
+    m_buckets_.clear();
+    m_unavailable_buckets_.clear();
+    m_board_.reset();
+}
+
+void StrokedGeometryCache::ParkCurrent()
+{
+    ParkedBoard parked;
+    parked.board = m_board_;
+    parked.board_revision = m_board_revision_;
+    parked.options = m_options_;
+    parked.sources = std::move(m_sources_);
+    parked.buckets = std::move(m_buckets_);
+    parked.unavailable_buckets = std::move(m_unavailable_buckets_);
+    ResetCurrent();
+
+    m_parked_boards_.insert(m_parked_boards_.begin(), std::move(parked));
+    if (m_parked_boards_.size() > kMaxParkedBoards) {
+        m_parked_boards_.resize(kMaxParkedBoards);
+    }
+}
+
+bool StrokedGeometryCache::RestoreParked(const std::shared_ptr<const Board>& board, const CollectOptions& options)
+{
+    for (auto it = m_parked_boards_.begin(); it != m_parked_boards_.end(); ++it) {
+        if (it->board.lock() != board) {
+            continue;
+        }
+        const bool is_current = it->board_revision == board->GetGeometryRevision() && it->options == options;
+        if (is_current) {
+            m_board_ = board;
+            m_board_revision_ = it->board_revision;
+            m_options_ = it->options;
+            m_sources_ = std::move(it->sources);
+            m_buckets_ = std::move(it->buckets);
+            m_unavailable_buckets_ = std::move(it->unavailable_buckets);
+        }
+        m_parked_boards_.erase(it);
+        return is_current;
+    }
+    return false;
+}
+
+size_t StrokedGeometryCache::GetMemoryUsageBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& geometry : m_buckets_) {
+        bytes += geometry->GetMemoryUsageBytes();
+    }
+    for (const ParkedBoard& parked : m_parked_boards_) {
+        for (const auto& geometry : parked.buckets) {
+            bytes += geometry->GetMemoryUsageBytes();
+        }
+    }
+    return bytes;
+}
+
+int StrokedGeometryCache::GetZoomBucket(double zoom)
+{
+    if (!(zoom > 0.0)) {
+        return 0;
+    }
+    return static_cast<int>(std::floor(std::log2(zoom)));
+}
+
+double StrokedGeometryCache::GetBucketMaxZoom(int zoom_bucket)
+{
+    return std::exp2(static_cast<double>(zoom_bucket + 1));
+}
+
+uint32_t StrokedGeometryCache::MakeGroupKey(int layer_id, ShapeKind kind, SideGroup side)
+{
+    return (static_cast<uint32_t>(layer_id) << 8) | (static_cast<uint32_t>(kind) << 4) | static_cast<uint32_t>(side);
+}
+
+bool StrokedGeometryCache::PollPendingBuild()
+{
+    if (!m_pending_ || m_pending_->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+
+    std::unique_ptr<PendingBuild> pending = std::move(m_pending_);
+    std::shared_ptr<Geometry> geometry = pending->result.get();
+    if (pending->generation != m_generation_) {
+        return false;  // Built from sources that have since been replaced
+    }
+    if (!geometry) {
+        m_unavailable_buckets_.push_back(pending->zoom_bucket);
+        std::cout << "StrokedGeometryCache: Zoom bucket " << pending->zoom_bucket << " exceeds the " << m_byte_budget_ / (1024 * 1024)
+                  << " MB budget; rendering it live" << std::endl;
+        return false;
+    }
+
+    // Make room: the parked boards' buckets go first, least recently shown board first; then this board's least
+    // recently used buckets over the count or byte limit
+    size_t bytes = GetMemoryUsageBytes();
+    while (!m_parked_boards_.empty() && bytes + geometry->GetMemoryUsageBytes() > m_byte_budget_) {
+        ParkedBoard& oldest = m_parked_boards_.back();
+        if (oldest.buckets.empty()) {
+            m_parked_boards_.pop_back();
+            continue;
+        }
+        bytes -= oldest.buckets.back()->GetMemoryUsageBytes();
+        oldest.buckets.pop_back();
+    }
+    while (!m_buckets_.empty() && (m_buckets_.size() >= kMaxBuckets || bytes + geometry->GetMemoryUsageBytes() > m_byte_budget_)) {
+        bytes -= m_buckets_.back()->GetMemoryUsageBytes();
+        m_buckets_.pop_back();
+    }
+    m_buckets_.insert(m_buckets_.begin(), std::move(geometry));
+    return true;
+}
+
+void StrokedGeometryCache::StartBuild(int zoom_bucket, double world_tolerance)
+{
+    auto pending = std::make_unique<PendingBuild>();
+    pending->zoom_bucket = zoom_bucket;
+    pending->generation = m_generation_;
+    pending->cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    // The task keeps the sources and its cancel flag alive, so Clear() never waits for it
+    std::shared_ptr<const Sources> sources = m_sources_;
+    std::shared_ptr<std::atomic<bool>> cancelled = pending->cancelled;
+    const size_t byte_budget = m_byte_budget_;
+    pending->result = std::async(std::launch::async, [sources, cancelled, zoom_bucket, world_tolerance, byte_budget]() {
+        const auto build_start = std::chrono::steady_clock::now();
+        std::shared_ptr<Geometry> geometry = BuildGeometry(*sources, zoom_bucket, world_tolerance, byte_budget, *cancelled);
+        if (geometry) {
+            const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+            std::cout << "StrokedGeometryCache: Stroked zoom bucket " << zoom_bucket << " in " << build_ms << " ms ("
+                      << geometry->GetMemoryUsageBytes() / (1024 * 1024) << " MB)" << std::endl;
+        }
+        return geometry;
+    });
+    m_pending_ = std::move(pending);
+}
+
+std::shared_ptr<StrokedGeometryCache::Sources> StrokedGeometryCache::CollectSources(const Board& board, const CollectOptions& options)
+{
+    auto sources = std::make_shared<Sources>();
+    sources->bounds = BLBox(std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                            std::numeric_limits<double>::lowest());
+    std::unordered_map<uint32_t, size_t> group_indices;
+    auto get_group = [&](uint32_t key) -> Group& {
+        auto [it, inserted] = group_indices.emplace(key, sources->groups.size());
+        if (inserted) {
+            sources->groups.emplace_back();
+            sources->groups.back().key = key;
+        }
+        return sources->groups[it->second];
+    };
+
+    for (const auto& [layer_id, elements] : board.m_elements_by_layer) {
+        const bool is_outline_layer = layer_id == options.board_outline_layer_id;
+        const bool is_side_grouped = layer_id == options.silkscreen_layer_id;
+
+        for (const auto& element_ptr : elements) {
+            if (!element_ptr || !element_ptr->IsVisible()) {
+                continue;
+            }
+            const ElementType type = element_ptr->GetElementType();
+            if (type != ElementType::kTrace && type != ElementType::kArc) {
+                continue;
+            }
+
+            SideGroup side = SideGroup::kUnassigned;
+            if (is_side_grouped && element_ptr->HasBoardSideAssigned()) {
+                side = element_ptr->GetBoardSide() == MountingSide::kTop ? SideGroup::kTop : SideGroup::kBottom;
+            }
+
+            if (type == ElementType::kTrace) {
+                const auto* trace = static_cast<const Trace*>(element_ptr.get());
+                const double width = is_outline_layer ? options.board_outline_thickness
+                                                      : (trace->GetWidth() > 0 ? trace->GetWidth() : options.default_trace_width);
+                get_group(MakeGroupKey(layer_id, ShapeKind::kTraces, side))
+                    .segments.push_back(Segment {trace->GetStartX(), trace->GetStartY(), trace->GetEndX(), trace->GetEndY(), width});
+                ExpandBox(sources->bounds, std::min(trace->GetStartX(), trace->GetEndX()), std::min(trace->GetStartY(), trace->GetEndY()),
+                          std::max(trace->GetStartX(), trace->GetEndX()), std::max(trace->GetStartY(), trace->GetEndY()));
+            } else {
+                const auto* arc = static_cast<const Arc*>(element_ptr.get());
+                const double width = is_outline_layer ? options.board_outline_thickness
+                                                      : (arc->GetThickness() > 0 ? arc->GetThickness() : options.default_arc_thickness);
+                // Same sweep normalization as the live arc path: counter-clockwise from start to end
+                const double start_rad = arc->GetStartAngle() * (kPi / 180.0);
+                double sweep_rad = arc->GetEndAngle() * (kPi / 180.0) - start_rad;
+                if (sweep_rad < 0) {
+                    sweep_rad += 2 * kPi;
+                }
+                get_group(MakeGroupKey(layer_id, ShapeKind::kArcs, side))
+                    .arcs.push_back(ArcShape {arc->GetCenterX(), arc->GetCenterY(), arc->GetRadius(), start_rad, sweep_rad, width});
+                ExpandBox(sources->bounds, arc->GetCenterX() - arc->GetRadius(), arc->GetCenterY() - arc->GetRadius(), arc->GetCenterX() + arc->GetRadius(),
+                          arc->GetCenterY() + arc->GetRadius());
+            }
+        }
+    }
+    return sources;
+}
+
+std::shared_ptr<StrokedGeometryCache::Geometry> StrokedGeometryCache::BuildGeometry(const Sources& sources, int zoom_bucket, double world_tolerance,
+                                                                                    size_t byte_budget, const std::atomic<bool>& cancelled)
+{
+    auto geometry = std::make_shared<Geometry>();
+    geometry->m_zoom_bucket_ = zoom_bucket;
+
+    BLApproximationOptions approx_opts = blDefaultApproximationOptions;
+    approx_opts.flattenMode = BL_FLATTEN_MODE_DEFAULT;
+    approx_opts.flattenTolerance = world_tolerance;
+
+    BLStrokeOptions stroke_opts;
+    stroke_opts.startCap = BL_STROKE_CAP_ROUND;
+    stroke_opts.endCap = BL_STROKE_CAP_ROUND;
+    stroke_opts.join = BL_STROKE_JOIN_ROUND;
+
+    const double cell_width = std::max((sources.bounds.x1 - sources.bounds.x0) / kCellsPerAxis, std::numeric_limits<double>::min());
+    const double cell_height = std::max((sources.bounds.y1 - sources.bounds.y0) / kCellsPerAxis, std::numeric_limits<double>::min());
+    auto cell_index = [&](double x, double y) {
+        const int column = std::clamp(static_cast<int>((x - sources.bounds.x0) / cell_width), 0, kCellsPerAxis - 1);
+        const int row = std::clamp(static_cast<int>((y - sources.bounds.y0) / cell_height), 0, kCellsPerAxis - 1);
+        return row * kCellsPerAxis + column;
+    };
+
+    // Unstroked centerlines of one cell, one batch per stroke width (a stroke call takes a single width)
+    std::vector<std::map<double, BLPath>> cell_batches(static_cast<size_t>(kCellsPerAxis * kCellsPerAxis));
+
+    for (const Group& group : sources.groups) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        for (const Segment& segment : group.segments) {
+            BLPath& batch = cell_batches[cell_index((segment.x1 + segment.x2) * 0.5, (segment.y1 + segment.y2) * 0.5)][segment.width];
+            batch.moveTo(segment.x1, segment.y1);
+            batch.lineTo(segment.x2, segment.y2);
+        }
+        for (const ArcShape& arc : group.arcs) {
+            const double mid_angle = arc.start_rad + arc.sweep_rad * 0.5;
+            BLPath& batch = cell_batches[cell_index(arc.cx + arc.radius * std::cos(mid_angle), arc.cy + arc.radius * std::sin(mid_angle))][arc.width];
+            batch.arcTo(arc.cx, arc.cy, arc.radius, arc.radius, arc.start_rad, arc.sweep_rad, true);  // Own sub-path per arc
+        }
+
+        std::vector<Cell> cells;
+        for (auto& batches : cell_batches) {
+            if (batches.empty()) {
+                continue;
+            }
+            if (cancelled.load(std::memory_order_relaxed)) {
+                return nullptr;  // A copper layer can take a while; do not hold up a board change
+            }
+            Cell cell;
+            for (auto& [width, batch] : batches) {
+                stroke_opts.width = width;
+                cell.path.addStrokedPath(batch, stroke_opts, approx_opts);
+            }
+            batches.clear();
+            cell.path.shrink();
+            if (cell.path.getBoundingBox(&cell.bounds) != BL_SUCCESS) {
+                continue;  // Nothing to fill
+            }
+            geometry->m_bytes_ += GetPathBytes(cell.path) + sizeof(Cell);
+            cells.push_back(std::move(cell));
+        }
+        if (geometry->m_bytes_ > byte_budget) {
+            return nullptr;
+        }
+        if (!cells.empty()) {
+            geometry->m_groups_.emplace(group.key, std::move(cells));
+        }
+    }
+    return geometry;
+}
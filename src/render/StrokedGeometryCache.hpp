@@ -0,0 +1,156 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Board;
+
+// Performance optimization: Board-level cache of already stroked trace and arc outlines.
+// Copper, silkscreen and board outline geometry never changes between frames, yet stroking it (flattening
+// the round caps and arcs into polygons) is most of the cost of drawing it. The cache strokes every visible
+// trace and arc once per (layer, shape kind, board side) group and spatial cell, at a flatten tolerance that
+// depends on the zoom bucket, so steady-state frames only fill finished polygons.
+//
+// Usage, once per frame on the rendering thread:
+//   Update() with the board - collects the geometry when the board, its geometry revision or the collect
+//            options changed (a copy of coordinates on the calling thread, much cheaper than stroking).
+//            The previous boards' geometry is kept aside, so switching back to a geometry variant (folding,
+//            flipping) picks up its finished buckets.
+//   Acquire() with the zoom bucket - returns the stroked geometry if that bucket is built; otherwise starts
+//            building it on a worker and returns null, and the frame renders live as before.
+// A few buckets are kept, least recently used first out, within a byte budget.
+class StrokedGeometryCache
+{
+public:
+    static constexpr size_t kDefaultByteBudget = 192 * 1024 * 1024;
+    static constexpr size_t kMaxBuckets = 3;       // Zoom buckets kept at once
+    static constexpr size_t kMaxParkedBoards = 1;  // The loaded board while a folded variant is shown; the only other one kept alive
+    static constexpr int kCellsPerAxis = 16;  // Spatial cells per group, for culling the filled polygons
+
+    enum class ShapeKind : uint8_t { kTraces, kArcs };
+    enum class SideGroup : uint8_t { kUnassigned, kTop, kBottom };
+
+    // Filled polygons of one (layer, shape kind, side) group within one spatial cell
+    struct Cell {
+        BLBox bounds;  // Of the stroked outline, in world units
+        BLPath path;   // Non-zero fill rule
+    };
+
+    // One zoom bucket's finished geometry. Immutable once published, so band threads share it freely.
+    class Geometry
+    {
+    public:
+        // Cells of a group; null if the group had no visible traces/arcs
+        [[nodiscard]] const std::vector<Cell>* GetCells(int layer_id, ShapeKind kind, SideGroup side) const;
+        [[nodiscard]] int GetZoomBucket() const { return m_zoom_bucket_; }
+        [[nodiscard]] size_t GetMemoryUsageBytes() const { return m_bytes_; }
+
+    private:
+        friend class StrokedGeometryCache;
+
+        std::unordered_map<uint32_t, std::vector<Cell>> m_groups_;
+        int m_zoom_bucket_ = 0;
+        size_t m_bytes_ = 0;
+    };
+
+    // How elements become stroke geometry; the same rules the live passes apply
+    struct CollectOptions {
+        double default_trace_width = 0.0;    // For traces without a width
+        double default_arc_thickness = 0.0;  // For arcs without a thickness
+        int silkscreen_layer_id = -1;        // Grouped by board side, so the view side can be filtered when drawing
+        int board_outline_layer_id = -1;     // Traces and arcs stroked at board_outline_thickness
+        double board_outline_thickness = 0.0;
+
+        bool operator==(const CollectOptions& other) const;
+        bool operator!=(const CollectOptions& other) const { return !(*this == other); }
+    };
+
+    explicit StrokedGeometryCache(size_t byte_budget = kDefaultByteBudget);
+    ~StrokedGeometryCache();
+
+    StrokedGeometryCache(const StrokedGeometryCache&) = delete;
+    StrokedGeometryCache& operator=(const StrokedGeometryCache&) = delete;
+
+    // Every visible trace and arc of the board is collected, on all layers
+    void Update(const std::shared_ptr<const Board>& board, const CollectOptions& options);
+
+    // world_tolerance is the flatten tolerance, in world units, used if the bucket has to be built
+    std::shared_ptr<const Geometry> Acquire(int zoom_bucket, double world_tolerance);
+
+    // Publishes a finished build; true if new geometry became available (a frame drawn now would use it)
+    bool PollPendingBuild();
+    [[nodiscard]] bool IsBuildPending() const { return m_pending_ != nullptr; }
+
+    // Drops all geometry, including the parked boards', e.g. when the renderer shuts down
+    void Clear();
+
+    void SetByteBudget(size_t byte_budget) { m_byte_budget_ = byte_budget; }
+    [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+    // Buckets are octaves of zoom (pixels per world unit)
+    static int GetZoomBucket(double zoom);
+    // Largest zoom of a bucket: geometry flattened for it is accurate across the whole bucket
+    static double GetBucketMaxZoom(int zoom_bucket);
+
+    static uint32_t MakeGroupKey(int layer_id, ShapeKind kind, SideGroup side);
+
+private:
+    struct Segment {
+        double x1, y1, x2, y2, width;
+    };
+    struct ArcShape {
+        double cx, cy, radius, start_rad, sweep_rad, width;
+    };
+    struct Group {
+        uint32_t key = 0;
+        std::vector<Segment> segments;
+        std::vector<ArcShape> arcs;
+    };
+    // Coordinates copied off the board, so workers never touch live elements
+    struct Sources {
+        std::vector<Group> groups;
+        BLBox bounds;  // Of all segment and arc extents
+    };
+    // A board's geometry put aside while another board is shown
+    struct ParkedBoard {
+        std::weak_ptr<const Board> board;
+        uint64_t board_revision = 0;
+        CollectOptions options;
+        std::shared_ptr<const Sources> sources;
+        std::vector<std::shared_ptr<const Geometry>> buckets;
+        std::vector<int> unavailable_buckets;
+    };
+    struct PendingBuild {
+        int zoom_bucket = 0;
+        uint64_t generation = 0;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::future<std::shared_ptr<Geometry>> result;  // Null geometry if it did not fit the budget
+    };
+
+    void StartBuild(int zoom_bucket, double world_tolerance);
+    void ResetCurrent();  // Cancels the pending build and drops the current board's geometry
+    void ParkCurrent();   // Moves the current board's geometry to the front of m_parked_boards_
+    bool RestoreParked(const std::shared_ptr<const Board>& board, const CollectOptions& options);
+    static std::shared_ptr<Sources> CollectSources(const Board& board, const CollectOptions& options);
+    static std::shared_ptr<Geometry> BuildGeometry(const Sources& sources, int zoom_bucket, double world_tolerance, size_t byte_budget,
+                                                   const std::atomic<bool>& cancelled);
+
+    size_t m_byte_budget_;
+    std::weak_ptr<const Board> m_board_;
+    uint64_t m_board_revision_ = 0;
+    CollectOptions m_options_;
+    uint64_t m_generation_ = 0;  // Bumped whenever the sources change; results of older builds are dropped
+    std::shared_ptr<const Sources> m_sources_;
+
+    std::vector<std::shared_ptr<const Geometry>> m_buckets_;  // Most recently used first
+    std::vector<int> m_unavailable_buckets_;                  // Buckets that exceeded the budget for these sources
+    std::unique_ptr<PendingBuild> m_pending_;
+    std::vector<ParkedBoard> m_parked_boards_;  // Most recently shown first; their buckets count toward the budget
+};
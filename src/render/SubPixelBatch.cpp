@@ -0,0 +1,173 @@
+#include "SubPixelBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+SubPixelBatch::SubPixelBatch(const BLContext& ctx, const BLRect& world_rect, const Options& options) : m_options_(options)
+{
+    m_world_to_pixel_ = ctx.finalTransform();
+    m_pixel_to_user_ = ctx.metaTransform();
+    m_pixel_to_user_.invert();
+    m_pixels_per_world_ = std::sqrt(std::abs(m_world_to_pixel_.m00 * m_world_to_pixel_.m11 - m_world_to_pixel_.m01 * m_world_to_pixel_.m10));
+
+    // The region's corners on the target, clamped to it; the camera may be rotated
+    const BLPoint corners[] = {m_world_to_pixel_.mapPoint(world_rect.x, world_rect.y),
+                               m_world_to_pixel_.mapPoint(world_rect.x + world_rect.w, world_rect.y),
+                               m_world_to_pixel_.mapPoint(world_rect.x, world_rect.y + world_rect.h),
+                               m_world_to_pixel_.mapPoint(world_rect.x + world_rect.w, world_rect.y + world_rect.h)};
+    double min_x = corners[0].x;
+    double min_y = corners[0].y;
+    double max_x = corners[0].x;
+    double max_y = corners[0].y;
+    for (const BLPoint& corner : corners) {
+        min_x = std::min(min_x, corner.x);
+        min_y = std::min(min_y, corner.y);
+        max_x = std::max(max_x, corner.x);
+        max_y = std::max(max_y, corner.y);
+    }
+    const int x0 = std::max(0, static_cast<int>(std::floor(min_x)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(min_y)));
+    const int x1 = std::min(static_cast<int>(ctx.targetWidth()), static_cast<int>(std::ceil(max_x)));
+    const int y1 = std::min(static_cast<int>(ctx.targetHeight()), static_cast<int>(std::ceil(max_y)));
+    m_pixel_bounds_ = BLRectI(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+}
+
+bool SubPixelBatch::AddTrace(double start_x, double start_y, double end_x, double end_y, double width)
+{
+    if (!m_options_.trace_density) {
+        return false;
+    }
+    const BLPoint start = m_world_to_pixel_.mapPoint(start_x, start_y);
+    const BLPoint end = m_world_to_pixel_.mapPoint(end_x, end_y);
+    const double width_pixels = width * m_pixels_per_world_;
+    const double length_pixels = std::hypot(end.x - start.x, end.y - start.y);
+    if (width_pixels >= kSubPixelSize || length_pixels > kMaxDensityTraceLength) {
+        return false;
+    }
+
+    ++m_collapsed_count_;
+    if (m_pixel_bounds_.w <= 0 || m_pixel_bounds_.h <= 0) {
+        return true;
+    }
+    if (m_coverage_.empty()) {
+        m_coverage_.assign(static_cast<size_t>(m_pixel_bounds_.w) * static_cast<size_t>(m_pixel_bounds_.h), 0.0F);
+    }
+
+    // The stroke's area in pixels (round caps add about one width), spread along the centerline a pixel apart
+    const double area = width_pixels * (length_pixels + width_pixels);
+    const int samples = std::max(1, static_cast<int>(std::ceil(length_pixels)));
+    const float amount = static_cast<float>(area / samples);
+    for (int i = 0; i < samples; ++i) {
+        const double t = (i + 0.5) / samples;
+        Splat(start.x + (end.x - start.x) * t - m_pixel_bounds_.x, start.y + (end.y - start.y) * t - m_pixel_bounds_.y, amount);
+    }
+    return true;
+}
+
+void SubPixelBatch::AddPoint(double x, double y, const BLRgba32& color)
+{
+    ++m_collapsed_count_;
+    const BLPoint pixel = m_world_to_pixel_.mapPoint(x, y);
+    const int pixel_x = static_cast<int>(std::floor(pixel.x));
+    const int pixel_y = static_cast<int>(std::floor(pixel.y));
+    if (pixel_x < m_pixel_bounds_.x || pixel_y < m_pixel_bounds_.y || pixel_x >= m_pixel_bounds_.x + m_pixel_bounds_.w ||
+        pixel_y >= m_pixel_bounds_.y + m_pixel_bounds_.h) {
+        return;
+    }
+    auto points = std::find_if(m_points_by_color_.begin(), m_points_by_color_.end(),
+                               [&color](const std::pair<uint32_t, std::vector<BLRectI>>& entry) { return entry.first == color.value; });
+    if (points == m_points_by_color_.end()) {
+        m_points_by_color_.emplace_back(color.value, std::vector<BLRectI>());
+        points = m_points_by_color_.end() - 1;
+    }
+    points->second.emplace_back(pixel_x, pixel_y, 1, 1);
+}
+
+void SubPixelBatch::FlushTraces(BLContext& ctx, const BLRgba32& color)
+{
+    if (m_dirty_x1_ < m_dirty_x0_ || m_dirty_y1_ < m_dirty_y0_) {
+        return;
+    }
+    const int width = m_dirty_x1_ - m_dirty_x0_ + 1;
+    const int height = m_dirty_y1_ - m_dirty_y0_ + 1;
+    if (m_raster_image_.empty() && m_raster_image_.create(m_pixel_bounds_.w, m_pixel_bounds_.h, BL_FORMAT_PRGB32) != BL_SUCCESS) {
+        return;
+    }
+
+    BLImageData data;
+    if (m_raster_image_.makeMutable(&data) == BL_SUCCESS) {
+        // Coverage becomes the color's alpha, premultiplied; the coverage is cleared for the next layer
+        for (int y = 0; y < height; ++y) {
+            auto* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(data.pixelData) + static_cast<intptr_t>(y) * data.stride);
+            float* coverage = &m_coverage_[static_cast<size_t>(m_dirty_y0_ + y) * static_cast<size_t>(m_pixel_bounds_.w) + static_cast<size_t>(m_dirty_x0_)];
+            for (int x = 0; x < width; ++x) {
+                const uint32_t alpha = static_cast<uint32_t>(std::min(coverage[x], 1.0F) * color.a() + 0.5F);
+                row[x] = (alpha << 24) | (((color.r() * alpha + 127) / 255) << 16) | (((color.g() * alpha + 127) / 255) << 8) | ((color.b() * alpha + 127) / 255);
+                coverage[x] = 0.0F;
+            }
+        }
+        BeginPixelSpace(ctx);
+        ctx.blitImage(BLPointI(m_pixel_bounds_.x + m_dirty_x0_, m_pixel_bounds_.y + m_dirty_y0_), m_raster_image_, BLRectI(0, 0, width, height));
+        ctx.restore();
+    }
+    m_dirty_x0_ = 0;
+    m_dirty_y0_ = 0;
+    m_dirty_x1_ = -1;
+    m_dirty_y1_ = -1;
+}
+
+void SubPixelBatch::FlushPoints(BLContext& ctx)
+{
+    bool has_points = false;
+    for (const auto& entry : m_points_by_color_) {
+        has_points = has_points || !entry.second.empty();
+    }
+    if (!has_points) {
+        return;
+    }
+    BeginPixelSpace(ctx);
+    for (auto& [color, points] : m_points_by_color_) {
+        if (points.empty()) {
+            continue;
+        }
+        ctx.setFillStyle(BLRgba32(color));
+        ctx.fillRectArray(points.data(), points.size());
+        points.clear();
+    }
+    ctx.restore();
+}
+
+void SubPixelBatch::Splat(double x, double y, float amount)
+{
+    // Pixel centers are at +0.5; the amount is shared by the four nearest ones
+    const double fx = x - 0.5;
+    const double fy = y - 0.5;
+    const int ix = static_cast<int>(std::floor(fx));
+    const int iy = static_cast<int>(std::floor(fy));
+    const float wx = static_cast<float>(fx - ix);
+    const float wy = static_cast<float>(fy - iy);
+    const float weights[4] = {(1.0F - wx) * (1.0F - wy), wx * (1.0F - wy), (1.0F - wx) * wy, wx * wy};
+    for (int corner = 0; corner < 4; ++corner) {
+        const int px = ix + (corner & 1);
+        const int py = iy + (corner >> 1);
+        if (px < 0 || py < 0 || px >= m_pixel_bounds_.w || py >= m_pixel_bounds_.h) {
+            continue;
+        }
+        m_coverage_[static_cast<size_t>(py) * static_cast<size_t>(m_pixel_bounds_.w) + static_cast<size_t>(px)] += amount * weights[corner];
+        if (m_dirty_x1_ < m_dirty_x0_) {
+            m_dirty_x0_ = m_dirty_x1_ = px;
+            m_dirty_y0_ = m_dirty_y1_ = py;
+        } else {
+            m_dirty_x0_ = std::min(m_dirty_x0_, px);
+            m_dirty_y0_ = std::min(m_dirty_y0_, py);
+            m_dirty_x1_ = std::max(m_dirty_x1_, px);
+            m_dirty_y1_ = std::max(m_dirty_y1_, py);
+        }
+    }
+}
+
+void SubPixelBatch::BeginPixelSpace(BLContext& ctx) const
+{
+    ctx.save();
+    ctx.setTransform(m_pixel_to_user_);
+}
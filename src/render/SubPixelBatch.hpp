@@ -0,0 +1,76 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Performance optimization: Cheap stand-ins for elements smaller than a pixel.
+// At the fit-to-board zoom of a dense board most traces, vias and pins project to a fraction of a pixel, yet
+// stroking or filling each one costs the rasterizer setup of a full-size shape. Per render region, a
+// SubPixelBatch takes them over instead:
+//   - short sub-pixel traces add their area to a per-pixel coverage buffer (a density raster), which is
+//     composited in the layer's color with one blit when the layer's traces are done;
+//   - sub-pixel vias and pins become single-pixel points, filled in one call per color.
+// Text below a pixel is not drawn at all (RenderPipeline::RenderTextLabel). Each of the three can be turned off
+// for full quality.
+//
+// Where it runs: tile rendering and exports (TileRenderer), which draw every trace live. On the desktop the
+// non-highlighted traces are filled from StrokedGeometryCache once it is built, and zoomed-out views are blitted
+// from the overview pyramid, so at fit zoom the trace density path only runs while those are still being built;
+// highlighted traces are never collapsed.
+//
+// A batch belongs to one BLContext and render region; bands each use their own.
+class SubPixelBatch
+{
+public:
+    struct Options {
+        bool trace_density = true;  // Collapse sub-pixel traces into the density raster
+        bool pad_points = true;     // Draw sub-pixel vias and pins as single-pixel points
+        bool text_culling = true;   // Skip text whose height is below a pixel
+    };
+
+    static constexpr double kSubPixelSize = 1.0;           // Projected pixels below which an element is sub-pixel
+    static constexpr double kMaxDensityTraceLength = 4.0;  // Longer thin traces keep their stroke, so lines stay crisp
+
+    // The context's current transform maps world to its target; world_rect is the region's cull rect
+    SubPixelBatch(const BLContext& ctx, const BLRect& world_rect, const Options& options);
+
+    [[nodiscard]] const Options& GetOptions() const { return m_options_; }
+    [[nodiscard]] double GetPixelsPerWorldUnit() const { return m_pixels_per_world_; }
+    [[nodiscard]] bool IsSubPixel(double world_size) const { return world_size * m_pixels_per_world_ < kSubPixelSize; }
+
+    // False if the trace is too large for the raster; the caller strokes it then
+    bool AddTrace(double start_x, double start_y, double end_x, double end_y, double width);
+    void AddPoint(double x, double y, const BLRgba32& color);
+
+    // Composites the traces added since the last call in color, and clears them
+    void FlushTraces(BLContext& ctx, const BLRgba32& color);
+    // Fills the points added since the last call, one fill per color
+    void FlushPoints(BLContext& ctx);
+
+    // Elements drawn through the batch so far
+    [[nodiscard]] size_t GetCollapsedCount() const { return m_collapsed_count_; }
+
+private:
+    void Splat(double x, double y, float amount);  // Bilinear, in target pixels
+    void BeginPixelSpace(BLContext& ctx) const;    // Saves the context and draws in target pixels
+
+    Options m_options_;
+    BLMatrix2D m_world_to_pixel_ {};
+    BLMatrix2D m_pixel_to_user_ {};  // Inverse of the meta transform: user coordinates that land on target pixels
+    double m_pixels_per_world_ = 1.0;
+    BLRectI m_pixel_bounds_ {};      // Region on the target the raster covers
+
+    std::vector<float> m_coverage_;  // Pixels of coverage, m_pixel_bounds_ sized once a trace is added
+    int m_dirty_x0_ = 0;             // Touched raster area, relative to m_pixel_bounds_
+    int m_dirty_y0_ = 0;
+    int m_dirty_x1_ = -1;
+    int m_dirty_y1_ = -1;
+    BLImage m_raster_image_;
+
+    std::vector<std::pair<uint32_t, std::vector<BLRectI>>> m_points_by_color_;
+    size_t m_collapsed_count_ = 0;
+};
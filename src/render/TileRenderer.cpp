@@ -0,0 +1,66 @@
+#include "TileRenderer.hpp"
+
+#include "pcb/Board.hpp"
+#include "view/GridSettings.hpp"
+#include "view/Viewport.hpp"
+
+bool TileRenderer::Initialize(int tile_size, std::shared_ptr<BoardDataManager> board_data_manager, const BLRgba32& background_color)
+{
+    const int render_size = tile_size + 2 * kPaddingPixels;
+    if (!m_render_context_.Initialize(render_size, render_size, 1)) {
+        return false;
+    }
+    m_tile_size_ = tile_size;
+    m_render_context_.SetBoardDataManager(std::move(board_data_manager));
+    m_render_context_.SetClearColor(background_color.r() / 255.0F, background_color.g() / 255.0F, background_color.b() / 255.0F, background_color.a() / 255.0F);
+
+    m_pipeline_.SetThreadPoolEnabled(false);  // Parallelism comes from running several tile renderers
+    m_pipeline_.SetStrokedGeometryCacheEnabled(false);
+    m_pipeline_.SetOverviewPyramidEnabled(false);  // Tiles are the vectors the pyramid is built from
+    m_pipeline_.Initialize(m_render_context_);
+
+    m_grid_ = std::make_unique<Grid>(std::make_shared<GridSettings>());
+    return true;
+}
+
+const BLImage& TileRenderer::Render(const Board& board, const BLPoint& world_origin, double zoom, int width, int height,
+                                    std::shared_ptr<const BoardDataManager::ViewState> view_state)
+{
+    const int render_size = m_tile_size_ + 2 * kPaddingPixels;
+    if (m_tile_image_.width() != width || m_tile_image_.height() != height) {
+        m_tile_image_.create(width, height, BL_FORMAT_PRGB32);
+    }
+    if (!m_grid_ || width > m_tile_size_ || height > m_tile_size_) {
+        return m_tile_image_;
+    }
+
+    // The camera (float) is centered on the padded image and the rounding left over is applied as a pixel
+    // offset, computed in double, so tiles far from the origin still line up to the pixel. The offset goes into the
+    // meta matrix, under the pipeline's view matrix, which does not include the meta matrix itself.
+    m_camera_.SetZoom(static_cast<float>(zoom));
+    zoom = m_camera_.GetZoom();
+    const double center_x = world_origin.x + (render_size / 2.0 - kPaddingPixels) / zoom;
+    const double center_y = world_origin.y + (render_size / 2.0 - kPaddingPixels) / zoom;
+    m_camera_.SetPosition(Vec2(static_cast<float>(center_x), static_cast<float>(center_y)));
+    const double offset_x = (m_camera_.GetPosition().x_ax - center_x) * zoom;
+    const double offset_y = (m_camera_.GetPosition().y_ax - center_y) * zoom;
+    const Viewport viewport(0, 0, render_size, render_size);
+
+    m_pipeline_.SetViewStateOverride(std::move(view_state));
+    m_render_context_.BeginFrame();
+    BLContext& bl_ctx = m_render_context_.GetBlend2DContext();
+    bl_ctx.translate(offset_x, offset_y);
+    bl_ctx.userToMeta();
+    m_pipeline_.BeginScene(bl_ctx);
+    m_pipeline_.Execute(bl_ctx, &board, m_camera_, viewport, *m_grid_, false, true);
+    m_pipeline_.EndScene();
+    m_render_context_.EndFrame();
+    m_pipeline_.SetViewStateOverride(nullptr);
+
+    // Crop the padding off
+    BLContext crop_ctx(m_tile_image_);
+    crop_ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+    crop_ctx.blitImage(BLPointI(-kPaddingPixels, -kPaddingPixels), m_render_context_.GetFrontImage());
+    crop_ctx.end();
+    return m_tile_image_;
+}
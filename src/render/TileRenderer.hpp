@@ -0,0 +1,47 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <memory>
+
+#include "core/BoardDataManager.hpp"
+#include "render/RenderContext.hpp"
+#include "render/RenderPipeline.hpp"
+#include "view/Camera.hpp"
+#include "view/Grid.hpp"
+
+class Board;
+
+// Headless renderer for one square tile of the board at a time (tiled export, tile serving). Owns a small
+// RenderContext and a lean RenderPipeline, and is used by one thread; run one per worker for parallel tiles.
+// Tiles are drawn with kPaddingPixels around them and cropped, so culling and anti-aliasing at the tile
+// edges match the neighbouring tiles.
+class TileRenderer
+{
+public:
+    TileRenderer() = default;
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+
+    // tile_size is the largest tile Render() is asked for
+    bool Initialize(int tile_size, std::shared_ptr<BoardDataManager> board_data_manager, const BLRgba32& background_color);
+
+    // Renders width x height pixels whose top-left corner is world_origin, at zoom pixels per world unit.
+    // view_state overrides the manager's published state (its board must be board); null draws the published one.
+    // The image is valid until the next call.
+    const BLImage& Render(const Board& board, const BLPoint& world_origin, double zoom, int width, int height,
+                          std::shared_ptr<const BoardDataManager::ViewState> view_state = nullptr);
+
+    // Sub-pixel culling of the tile pipeline; all on unless changed
+    void SetSubPixelCulling(const SubPixelBatch::Options& options) { m_pipeline_.SetSubPixelCulling(options); }
+
+    static constexpr int kPaddingPixels = 4;
+
+private:
+    int m_tile_size_ = 0;
+    RenderContext m_render_context_;
+    RenderPipeline m_pipeline_;
+    Camera m_camera_;
+    std::unique_ptr<Grid> m_grid_;  // Not drawn; Execute takes one
+    BLImage m_tile_image_;
+};
@@ -0,0 +1,310 @@
+#include "HttpServer.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+constexpr uintptr_t kInvalidSocket = static_cast<uintptr_t>(INVALID_SOCKET);
+#else
+constexpr int kInvalidSocket = -1;
+#endif
+
+const char* GetStatusText(int status)
+{
+    switch (status) {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 405:
+            return "Method Not Allowed";
+        case 500:
+            return "Internal Server Error";
+        default:
+            return "Unknown";
+    }
+}
+
+bool SendAll(uintptr_t socket, const char* data, size_t size)
+{
+    while (size > 0) {
+#ifdef _WIN32
+        const int sent = send(static_cast<SOCKET>(socket), data, static_cast<int>(size), 0);
+#else
+        const ssize_t sent = send(static_cast<int>(socket), data, size, MSG_NOSIGNAL);
+#endif
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+}  // namespace
+
+HttpServer::Response HttpServer::Response::Text(int status, const std::string& text)
+{
+    Response response;
+    response.status = status;
+    response.body = std::make_shared<const std::string>(text);
+    return response;
+}
+
+HttpServer::HttpServer(Handler handler) : m_handler_(std::move(handler)), m_listen_socket_(kInvalidSocket) {}
+
+HttpServer::~HttpServer()
+{
+    Stop();
+}
+
+bool HttpServer::Start(const std::string& host, uint16_t port, int worker_count)
+{
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        std::cerr << "HttpServer: WSAStartup failed" << std::endl;
+        return false;
+    }
+    m_socket_library_initialized_ = true;
+#endif
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "HttpServer: Invalid IPv4 address " << host << std::endl;
+        return false;
+    }
+
+    const auto listen_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (static_cast<SocketHandle>(listen_socket) == kInvalidSocket) {
+        std::cerr << "HttpServer: Failed to create a socket" << std::endl;
+        return false;
+    }
+    m_listen_socket_ = static_cast<SocketHandle>(listen_socket);
+
+    const int reuse = 1;
+    setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    if (bind(listen_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_socket, SOMAXCONN) != 0) {
+        std::cerr << "HttpServer: Failed to listen on " << host << ":" << port << std::endl;
+        CloseSocket(m_listen_socket_);
+        m_listen_socket_ = kInvalidSocket;
+        return false;
+    }
+
+    m_running_ = true;
+    m_workers_.reserve(static_cast<size_t>(worker_count));
+    for (int i = 0; i < worker_count; ++i) {
+        m_workers_.emplace_back(&HttpServer::WorkerLoop, this);
+    }
+    return true;
+}
+
+void HttpServer::Run(const std::atomic<bool>& stop_requested)
+{
+    while (m_running_ && !stop_requested) {
+        // Wake up regularly so a stop request is noticed without a connection arriving
+        fd_set read_set;
+        FD_ZERO(&read_set);
+        FD_SET(m_listen_socket_, &read_set);
+        timeval timeout {0, 250000};
+        const int ready = select(static_cast<int>(m_listen_socket_ + 1), &read_set, nullptr, nullptr, &timeout);
+        if (ready <= 0) {
+            continue;
+        }
+
+        const auto client = accept(m_listen_socket_, nullptr, nullptr);
+        if (static_cast<SocketHandle>(client) == kInvalidSocket) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex_);
+            m_pending_connections_.push(static_cast<SocketHandle>(client));
+        }
+        m_queue_condition_.notify_one();
+    }
+    Stop();
+}
+
+void HttpServer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queue_mutex_);
+        m_running_ = false;
+    }
+    m_queue_condition_.notify_all();
+    for (auto& worker : m_workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers_.clear();
+
+    while (!m_pending_connections_.empty()) {
+        CloseSocket(m_pending_connections_.front());
+        m_pending_connections_.pop();
+    }
+    if (m_listen_socket_ != kInvalidSocket) {
+        CloseSocket(m_listen_socket_);
+        m_listen_socket_ = kInvalidSocket;
+    }
+#ifdef _WIN32
+    if (m_socket_library_initialized_) {
+        WSACleanup();
+        m_socket_library_initialized_ = false;
+    }
+#endif
+}
+
+void HttpServer::WorkerLoop()
+{
+    while (true) {
+        SocketHandle client = kInvalidSocket;
+        {
+            std::unique_lock<std::mutex> lock(m_queue_mutex_);
+            m_queue_condition_.wait(lock, [this] { return !m_running_ || !m_pending_connections_.empty(); });
+            if (!m_running_) {
+                return;
+            }
+            client = m_pending_connections_.front();
+            m_pending_connections_.pop();
+        }
+        HandleConnection(client);
+        CloseSocket(client);
+    }
+}
+
+void HttpServer::HandleConnection(SocketHandle client)
+{
+#ifdef _WIN32
+    const DWORD timeout_ms = kReceiveTimeoutMs;
+    setsockopt(static_cast<SOCKET>(client), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout_ms), sizeof(timeout_ms));
+#else
+    const timeval timeout {kReceiveTimeoutMs / 1000, (kReceiveTimeoutMs % 1000) * 1000};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+
+    // Read the request head; GET requests have no body
+    std::string head;
+    char buffer[2048];
+    while (head.find("\r\n\r\n") == std::string::npos) {
+        if (head.size() >= kMaxRequestHeadBytes) {
+            return;
+        }
+#ifdef _WIN32
+        const int received = recv(static_cast<SOCKET>(client), buffer, sizeof(buffer), 0);
+#else
+        const ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+#endif
+        if (received <= 0) {
+            return;
+        }
+        head.append(buffer, static_cast<size_t>(received));
+    }
+
+    Request request;
+    Response response;
+    if (!ParseRequest(head, request)) {
+        response = Response::Text(400, "Bad request");
+    } else if (request.method != "GET") {
+        response = Response::Text(405, "Only GET is supported");
+    } else {
+        response = m_handler_(request);
+    }
+    if (!response.body) {
+        response.body = std::make_shared<const std::string>();
+    }
+
+    std::ostringstream header;
+    header << "HTTP/1.1 " << response.status << " " << GetStatusText(response.status) << "\r\n"
+           << "Content-Type: " << response.content_type << "\r\n"
+           << "Content-Length: " << response.body->size() << "\r\n"
+           << "Connection: close\r\n";
+    if (!response.cache_control.empty()) {
+        header << "Cache-Control: " << response.cache_control << "\r\n";
+    }
+    header << "\r\n";
+    const std::string header_text = header.str();
+    if (SendAll(client, header_text.data(), header_text.size())) {
+        SendAll(client, response.body->data(), response.body->size());
+    }
+}
+
+bool HttpServer::ParseRequest(const std::string& head, Request& request)
+{
+    // Request line: METHOD SP target SP HTTP/1.x
+    const size_t line_end = head.find("\r\n");
+    const std::string line = head.substr(0, line_end);
+    const size_t method_end = line.find(' ');
+    const size_t target_end = method_end == std::string::npos ? std::string::npos : line.find(' ', method_end + 1);
+    if (target_end == std::string::npos) {
+        return false;
+    }
+    request.method = line.substr(0, method_end);
+    const std::string target = line.substr(method_end + 1, target_end - method_end - 1);
+    if (target.empty() || target[0] != '/') {
+        return false;
+    }
+
+    const size_t query_start = target.find('?');
+    request.path = UrlDecode(target.substr(0, query_start));
+    if (query_start == std::string::npos) {
+        return true;
+    }
+    std::istringstream query(target.substr(query_start + 1));
+    std::string pair;
+    while (std::getline(query, pair, '&')) {
+        const size_t equals = pair.find('=');
+        const std::string key = UrlDecode(pair.substr(0, equals));
+        if (!key.empty()) {
+            request.query[key] = equals == std::string::npos ? std::string() : UrlDecode(pair.substr(equals + 1));
+        }
+    }
+    return true;
+}
+
+std::string HttpServer::UrlDecode(const std::string& text)
+{
+    std::string decoded;
+    decoded.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '+') {
+            decoded += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            decoded += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            decoded += text[i];
+        }
+    }
+    return decoded;
+}
+
+void HttpServer::CloseSocket(SocketHandle socket)
+{
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(socket));
+#else
+    close(socket);
+#endif
+}
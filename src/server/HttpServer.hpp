@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Minimal HTTP/1.1 server for the tile server: GET only, one request per connection, no TLS. Meant for a bench
+// PC and a browser on the local network, not for the open internet.
+// Performance optimization: Connections are queued to a fixed pool of worker threads, so a slow tile render
+// holds up one worker while the others keep answering cache hits.
+class HttpServer
+{
+public:
+    struct Request {
+        std::string method;
+        std::string path;                                    // Decoded, without the query string
+        std::unordered_map<std::string, std::string> query;  // Decoded query parameters
+    };
+
+    struct Response {
+        int status = 200;
+        std::string content_type = "text/plain";
+        std::shared_ptr<const std::string> body;  // Shared so cached tiles are sent without a copy
+        std::string cache_control;
+
+        static Response Text(int status, const std::string& text);
+    };
+
+    // Called from worker threads; must be thread-safe
+    using Handler = std::function<Response(const Request&)>;
+
+    explicit HttpServer(Handler handler);
+    ~HttpServer();
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    // Binds and starts the workers; false if the address cannot be bound
+    bool Start(const std::string& host, uint16_t port, int worker_count);
+    // Accepts connections until stop_requested is set (e.g. by a signal handler), then stops the workers
+    void Run(const std::atomic<bool>& stop_requested);
+    void Stop();
+
+private:
+#ifdef _WIN32
+    using SocketHandle = uintptr_t;
+#else
+    using SocketHandle = int;
+#endif
+
+    void WorkerLoop();
+    void HandleConnection(SocketHandle client);
+    static bool ParseRequest(const std::string& head, Request& request);
+    static std::string UrlDecode(const std::string& text);
+    static void CloseSocket(SocketHandle socket);
+
+    static constexpr size_t kMaxRequestHeadBytes = 8192;
+    static constexpr int kReceiveTimeoutMs = 5000;
+
+    Handler m_handler_;
+    SocketHandle m_listen_socket_;
+    bool m_socket_library_initialized_ = false;
+    std::atomic<bool> m_running_ {false};
+
+    std::vector<std::thread> m_workers_;
+    std::queue<SocketHandle> m_pending_connections_;
+    std::mutex m_queue_mutex_;
+    std::condition_variable m_queue_condition_;
+};
@@ -0,0 +1,252 @@
+#include "TilePrefetcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#else
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Lowers the calling thread's scheduling priority, so prefetch renders yield the cores to renders a client waits for
+void LowerThreadPriority()
+{
+#ifdef _WIN32
+    if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST)) {
+        std::cerr << "TilePrefetcher: Failed to lower thread priority (error " << GetLastError() << ")" << std::endl;
+    }
+#elif defined(__APPLE__)
+    const int error = pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+    if (error != 0) {
+        std::cerr << "TilePrefetcher: Failed to lower thread priority: " << std::strerror(error) << std::endl;
+    }
+#else
+    // On Linux the nice value is per thread, addressed by its thread id; client requests keep the default 0
+    constexpr int kPrefetchThreadNice = 10;
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), kPrefetchThreadNice) != 0) {
+        std::cerr << "TilePrefetcher: Failed to lower thread priority: " << std::strerror(errno) << std::endl;
+    }
+#endif
+}
+}  // namespace
+
+TilePrefetcher::TilePrefetcher(const TileGrid& grid, int thread_count) : m_grid_(grid)
+{
+    for (int i = 0; i < thread_count; ++i) {
+        m_threads_.emplace_back(&TilePrefetcher::WorkerLoop, this);
+    }
+}
+
+TilePrefetcher::~TilePrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_stopping_ = true;
+        m_stats_.cancelled += m_queue_.size();
+        m_queue_.clear();
+    }
+    m_condition_.notify_all();
+    for (std::thread& thread : m_threads_) {
+        thread.join();
+    }
+}
+
+void TilePrefetcher::UpdateView(const std::string& session_id, const ViewReport& view, PrefetchFunction prefetch)
+{
+    if (m_threads_.empty() || view.width <= 0 || view.height <= 0 || view.zoom_level < 0 || view.zoom_level > m_grid_.max_zoom_level) {
+        return;
+    }
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    ++m_stats_.view_reports;
+
+    // Sessions are never closed explicitly; the ones that went quiet are dropped here
+    for (auto session = m_sessions_.begin(); session != m_sessions_.end();) {
+        if (session->first != session_id && std::chrono::duration<double>(now - session->second.last_report).count() > kSessionTimeoutSeconds) {
+            RemoveQueuedJobs(session->first);
+            session = m_sessions_.erase(session);
+        } else {
+            ++session;
+        }
+    }
+
+    Session& session = m_sessions_[session_id];
+    if (!UpdateMotion(session, view, now)) {
+        return;  // Same view reported again; its queue is still right
+    }
+
+    RemoveQueuedJobs(session_id);
+    std::vector<Job> jobs = PlanTiles(session);
+    for (Job& job : jobs) {
+        job.session_id = session_id;
+        job.sequence = m_next_sequence_++;
+        job.prefetch = prefetch;
+        m_queue_.push_back(std::move(job));
+    }
+    m_stats_.queued += jobs.size();
+    if (!jobs.empty()) {
+        m_condition_.notify_all();
+    }
+}
+
+TilePrefetcher::Stats TilePrefetcher::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_stats_;
+}
+
+bool TilePrefetcher::UpdateMotion(Session& session, const ViewReport& view, Clock::time_point now) const
+{
+    const bool is_new = session.last_report == Clock::time_point {};
+    const Vec2 previous_position = session.camera.GetPosition();
+    const int previous_zoom_level = session.zoom_level;
+    const double elapsed = std::chrono::duration<double>(now - session.last_report).count();
+
+    session.camera.ClearViewChangedFlag();
+    session.camera.SetPosition(view.center);
+    session.camera.SetZoom(static_cast<float>(GetLevelZoom(view.zoom_level)));
+    const bool resized = session.width != view.width || session.height != view.height;
+    session.zoom_level = view.zoom_level;
+    session.width = view.width;
+    session.height = view.height;
+    session.last_report = now;
+    if (!is_new && !resized && !session.camera.WasViewChangedThisFrame()) {
+        return false;
+    }
+    if (is_new) {
+        return true;
+    }
+
+    if (elapsed > kMotionTimeoutSeconds) {
+        // The user stopped; old motion says nothing about where they go next
+        session.pixel_velocity = Vec2(0.0, 0.0);
+        session.zoom_trend *= 0.5;
+    }
+
+    if (view.zoom_level != previous_zoom_level) {
+        // A zoom step: pan speed measured at the old level scales with it
+        const double direction = view.zoom_level > previous_zoom_level ? 1.0 : -1.0;
+        session.zoom_trend = (1.0 - kZoomTrendSmoothing) * session.zoom_trend + kZoomTrendSmoothing * direction;
+        session.pixel_velocity *= std::ldexp(1.0, view.zoom_level - previous_zoom_level);
+    } else if (elapsed <= kMotionTimeoutSeconds) {
+        const double seconds = std::max(elapsed, 1.0 / 60.0);
+        const Vec2 pixel_delta = (view.center - previous_position) * GetLevelZoom(view.zoom_level);
+        session.pixel_velocity = session.pixel_velocity * (1.0 - kVelocitySmoothing) + pixel_delta * (kVelocitySmoothing / seconds);
+    }
+    return true;
+}
+
+std::vector<TilePrefetcher::Job> TilePrefetcher::PlanTiles(const Session& session) const
+{
+    std::vector<Job> jobs;
+    const double tile_size = m_grid_.tile_size;
+
+    // Visits the tiles of a level-pixel rect, skipping those inside skip_rect (the ones the viewer loads itself)
+    auto add_tiles = [&](int zoom_level, const BLRect& rect, const BLRect& skip_rect, const BLPoint& focus, double priority_offset) {
+        const int tiles_per_side = 1 << zoom_level;
+        const int first_x = std::max(0, static_cast<int>(std::floor(rect.x / tile_size)));
+        const int first_y = std::max(0, static_cast<int>(std::floor(rect.y / tile_size)));
+        const int last_x = std::min(tiles_per_side - 1, static_cast<int>(std::floor((rect.x + rect.w) / tile_size)));
+        const int last_y = std::min(tiles_per_side - 1, static_cast<int>(std::floor((rect.y + rect.h) / tile_size)));
+        for (int y = first_y; y <= last_y; ++y) {
+            for (int x = first_x; x <= last_x; ++x) {
+                const double left = x * tile_size;
+                const double top = y * tile_size;
+                if (left + tile_size > skip_rect.x && left < skip_rect.x + skip_rect.w && top + tile_size > skip_rect.y && top < skip_rect.y + skip_rect.h) {
+                    continue;
+                }
+                Job job;
+                job.zoom_level = zoom_level;
+                job.x = x;
+                job.y = y;
+                job.priority = priority_offset + std::hypot(left + tile_size / 2.0 - focus.x, top + tile_size / 2.0 - focus.y) / tile_size;
+                jobs.push_back(std::move(job));
+            }
+        }
+    };
+    auto view_rect = [&](int zoom_level, const Vec2& shift) {
+        const double zoom = GetLevelZoom(zoom_level);
+        const double center_x = (session.camera.GetPosition().x_ax - m_grid_.world_bounds.x) * zoom + shift.x_ax;
+        const double center_y = (session.camera.GetPosition().y_ax - m_grid_.world_bounds.y) * zoom + shift.y_ax;
+        return BLRect(center_x - session.width / 2.0, center_y - session.height / 2.0, session.width, session.height);
+    };
+    auto rect_center = [](const BLRect& rect) { return BLPoint(rect.x + rect.w / 2.0, rect.y + rect.h / 2.0); };
+
+    // Same level: where the viewport will be after the lookahead, and a ring of half a tile around both views
+    const int level = session.zoom_level;
+    const BLRect current = view_rect(level, Vec2(0.0, 0.0));
+    const BLRect ahead = view_rect(level, session.pixel_velocity * kLookaheadSeconds);
+    const double ring = tile_size / 2.0;
+    const double left = std::min(current.x, ahead.x) - ring;
+    const double top = std::min(current.y, ahead.y) - ring;
+    const BLRect reach(left, top, std::max(current.x + current.w, ahead.x + ahead.w) + ring - left,
+                       std::max(current.y + current.h, ahead.y + ahead.h) + ring - top);
+    add_tiles(level, reach, current, rect_center(ahead), 0.0);
+
+    // Adjacent level in the zoom direction, with the viewport's tiles there. Wheel zooms keep the point under
+    // the cursor, which is unknown here, so the view center is the guess. It ranks after the nearest ring tiles.
+    int adjacent_level = level;
+    if (session.zoom_trend > kZoomTrendThreshold && level < m_grid_.max_zoom_level) {
+        adjacent_level = level + 1;
+    } else if (session.zoom_trend < -kZoomTrendThreshold && level > 0) {
+        adjacent_level = level - 1;
+    }
+    if (adjacent_level != level) {
+        const BLRect adjacent = view_rect(adjacent_level, Vec2(0.0, 0.0));
+        add_tiles(adjacent_level, adjacent, BLRect(), rect_center(adjacent), 1.0);
+    }
+
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.priority < b.priority; });
+    if (jobs.size() > kMaxTilesPerReport) {
+        jobs.resize(kMaxTilesPerReport);
+    }
+    return jobs;
+}
+
+double TilePrefetcher::GetLevelZoom(int zoom_level) const
+{
+    return std::ldexp(m_grid_.tile_size / m_grid_.world_bounds.w, zoom_level);
+}
+
+void TilePrefetcher::RemoveQueuedJobs(const std::string& session_id)
+{
+    const auto removed = std::remove_if(m_queue_.begin(), m_queue_.end(), [&session_id](const Job& job) { return job.session_id == session_id; });
+    m_stats_.cancelled += static_cast<uint64_t>(m_queue_.end() - removed);
+    m_queue_.erase(removed, m_queue_.end());
+}
+
+void TilePrefetcher::WorkerLoop()
+{
+    LowerThreadPriority();
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex_);
+            m_condition_.wait(lock, [this]() { return m_stopping_ || !m_queue_.empty(); });
+            if (m_stopping_) {
+                return;
+            }
+            // The queue holds at most kMaxTilesPerReport per active session, so a scan is cheap
+            const auto best = std::min_element(m_queue_.begin(), m_queue_.end(), [](const Job& a, const Job& b) {
+                return a.priority != b.priority ? a.priority < b.priority : a.sequence < b.sequence;
+            });
+            job = std::move(*best);
+            m_queue_.erase(best);
+            ++m_stats_.prefetched;
+        }
+        job.prefetch(job.zoom_level, job.x, job.y);
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/Vec2.hpp"
+#include "view/Camera.hpp"
+
+// Performance optimization: Renders the tiles a client is about to ask for before it asks.
+// Each viewer reports its view (center, tile zoom level, size) as it moves. The report is applied to the
+// session's Camera, and its motion is turned into a prediction: the pan velocity (smoothed, in screen pixels
+// per second) and the trend of the zoom steps (smoothed direction of Camera zoom changes). From those, a report
+// queues renders for
+//   - the tiles the viewport will cover kLookaheadSeconds from now, plus a ring just outside it, and
+//   - the viewport's tiles at the adjacent zoom level the user is zooming towards.
+// Queued tiles run on a few threads below normal OS priority, nearest to the predicted view first. A new report replaces
+// the session's queue, so tiles for a view the user has already left are never rendered.
+class TilePrefetcher
+{
+public:
+    // The tile pyramid: level 0 is one tile covering world_bounds, each level doubles the tiles per side
+    struct TileGrid {
+        BLRect world_bounds {};
+        int tile_size = 256;
+        int max_zoom_level = 0;
+    };
+
+    struct ViewReport {
+        Vec2 center;         // World units
+        int zoom_level = 0;  // Tile pyramid level the viewer is showing
+        int width = 0;       // Viewport, screen pixels
+        int height = 0;
+    };
+
+    struct Stats {
+        uint64_t view_reports = 0;
+        uint64_t queued = 0;     // Tiles put in a queue
+        uint64_t prefetched = 0;  // Tiles the prefetch threads handed to the prefetch function
+        uint64_t cancelled = 0;  // Queued tiles dropped because their session moved on or expired
+    };
+
+    // Called on a prefetch thread; renders (or finds cached) the tile of the session's view
+    using PrefetchFunction = std::function<void(int zoom_level, int x, int y)>;
+
+    TilePrefetcher(const TileGrid& grid, int thread_count);
+    ~TilePrefetcher();
+    TilePrefetcher(const TilePrefetcher&) = delete;
+    TilePrefetcher& operator=(const TilePrefetcher&) = delete;
+
+    // Thread-safe. prefetch identifies the session's layers and net; it replaces the previous one with the queue.
+    void UpdateView(const std::string& session_id, const ViewReport& view, PrefetchFunction prefetch);
+
+    [[nodiscard]] Stats GetStats() const;
+
+    static constexpr double kLookaheadSeconds = 0.75;
+    static constexpr double kVelocitySmoothing = 0.5;    // Weight of the newest pan sample
+    static constexpr double kZoomTrendSmoothing = 0.5;   // Weight of the newest zoom step
+    static constexpr double kZoomTrendThreshold = 0.25;  // |trend| above which the adjacent level is prefetched
+    static constexpr double kMotionTimeoutSeconds = 1.0;  // A longer pause starts the motion estimate afresh
+    static constexpr double kSessionTimeoutSeconds = 120.0;
+    static constexpr size_t kMaxTilesPerReport = 64;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Session {
+        Camera camera;
+        int zoom_level = 0;
+        int width = 0;
+        int height = 0;
+        Clock::time_point last_report {};
+        Vec2 pixel_velocity;      // Screen pixels per second
+        double zoom_trend = 0.0;  // -1 always zooming out .. 1 always zooming in
+    };
+
+    struct Job {
+        std::string session_id;
+        double priority = 0.0;  // Lower runs first
+        uint64_t sequence = 0;  // Ties run in queue order
+        int zoom_level = 0;
+        int x = 0;
+        int y = 0;
+        PrefetchFunction prefetch;
+    };
+
+    // Updates the session's motion estimate from a report; false if the view did not change
+    bool UpdateMotion(Session& session, const ViewReport& view, Clock::time_point now) const;
+    // Tiles to prefetch for the session's current view and motion, best first
+    std::vector<Job> PlanTiles(const Session& session) const;
+    [[nodiscard]] double GetLevelZoom(int zoom_level) const;  // Pixels per world unit
+
+    void RemoveQueuedJobs(const std::string& session_id);
+    void WorkerLoop();
+
+    TileGrid m_grid_;
+
+    mutable std::mutex m_mutex_;
+    std::condition_variable m_condition_;
+    bool m_stopping_ = false;
+    std::unordered_map<std::string, Session> m_sessions_;
+    std::vector<Job> m_queue_;
+    uint64_t m_next_sequence_ = 0;
+    Stats m_stats_;
+
+    std::vector<std::thread> m_threads_;
+};
@@ -0,0 +1,542 @@
+#include "TileServer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "pcb/Board.hpp"
+#include "render/TileRenderer.hpp"
+#include "server/ViewerPage.hpp"
+#include "view/Camera.hpp"
+
+namespace
+{
+// FNV-1a: stable across runs and platforms, unlike std::hash, so disk cache paths stay valid
+class StableHash
+{
+public:
+    void Add(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_value_ = (m_value_ ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+    void Add(const std::string& text) { Add(text.data(), text.size() + 1); }
+    void Add(uint64_t value) { Add(&value, sizeof(value)); }
+    void Add(const BLRgba32& color) { Add(static_cast<uint64_t>(color.value)); }
+
+    [[nodiscard]] std::string ToHex() const
+    {
+        std::ostringstream stream;
+        stream << std::hex << m_value_;
+        return stream.str();
+    }
+
+private:
+    uint64_t m_value_ = 14695981039346656037ULL;
+};
+
+std::string EscapeJson(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+bool ParseTilePath(const std::string& path, int& zoom_level, int& x, int& y)
+{
+    char extension[8] = {};
+    return std::sscanf(path.c_str(), "/tiles/%d/%d/%d.%7s", &zoom_level, &x, &y, extension) == 4 && std::string(extension) == "png";
+}
+
+bool ReadFile(const std::filesystem::path& path, std::string& contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return static_cast<bool>(file);
+}
+}  // namespace
+
+TileServer::TileServer(std::shared_ptr<BoardDataManager> board_data_manager, Options options)
+    : m_board_data_manager_(std::move(board_data_manager)), m_options_(std::move(options))
+{
+    m_base_view_state_ = m_board_data_manager_->GetViewState();
+    m_board_ = m_base_view_state_->board;
+    if (!m_board_) {
+        return;
+    }
+
+    // Level 0 is a square around all layers, so the tile grid does not move when layers are toggled
+    const BLRect bounds = m_board_->GetBoundingBox(true);
+    const double extent = std::max({bounds.w, bounds.h, 1.0});
+    m_tile_world_bounds_ = BLRect(bounds.x + bounds.w / 2.0 - extent / 2.0, bounds.y + bounds.h / 2.0 - extent / 2.0, extent, extent);
+    while (m_max_zoom_level_ < kMaxZoomLevelLimit && std::ldexp(kTileSize / extent, m_max_zoom_level_ + 1) <= Camera::kMaxZoomLevel) {
+        ++m_max_zoom_level_;
+    }
+
+    for (const auto& [net_id, net] : m_board_->m_nets) {
+        m_net_ids_by_name_[net.GetName()] = net_id;
+    }
+
+    // Everything that changes the pixels of a tile other than the URL's layers and net
+    StableHash hash;
+    hash.Add(m_board_->GetFilePath());
+    std::error_code error;
+    const std::filesystem::path board_path(m_board_->GetFilePath());
+    hash.Add(static_cast<uint64_t>(std::filesystem::file_size(board_path, error)));
+    hash.Add(static_cast<uint64_t>(std::filesystem::last_write_time(board_path, error).time_since_epoch().count()));
+    hash.Add(static_cast<uint64_t>(m_base_view_state_->view_side));
+    hash.Add(static_cast<uint64_t>(m_base_view_state_->board_folding_enabled));
+    hash.Add(static_cast<uint64_t>(m_base_view_state_->board_outline_thickness * 1000.0f));
+    hash.Add(static_cast<uint64_t>(m_base_view_state_->component_stroke_thickness * 1000.0f));
+    hash.Add(static_cast<uint64_t>(m_base_view_state_->pin_stroke_thickness * 1000.0f));
+    hash.Add(m_options_.background_color);
+    for (int type = 0; type <= static_cast<int>(BoardDataManager::ColorType::kNC); ++type) {
+        hash.Add(m_base_view_state_->GetColor(static_cast<BoardDataManager::ColorType>(type)));
+    }
+    for (const Board::LayerInfo& layer : m_board_->layers) {
+        hash.Add(m_base_view_state_->GetLayerColor(layer.GetId()));
+    }
+    m_board_cache_key_ = board_path.stem().string() + "-" + hash.ToHex();
+
+    if (m_options_.prefetch_threads > 0) {
+        TilePrefetcher::TileGrid grid;
+        grid.world_bounds = m_tile_world_bounds_;
+        grid.tile_size = kTileSize;
+        grid.max_zoom_level = m_max_zoom_level_;
+        m_prefetcher_ = std::make_unique<TilePrefetcher>(grid, m_options_.prefetch_threads);
+    }
+
+    std::cout << "TileServer: Zoom levels 0-" << m_max_zoom_level_ << ", " << kTileSize << " px tiles";
+    if (!m_options_.cache_directory.empty()) {
+        std::cout << ", disk cache " << (std::filesystem::path(m_options_.cache_directory) / m_board_cache_key_).string();
+    }
+    std::cout << std::endl;
+}
+
+TileServer::~TileServer()
+{
+    m_prefetcher_.reset();  // Joins the prefetch threads while the caches they fill still exist
+}
+
+HttpServer::Response TileServer::HandleRequest(const HttpServer::Request& request)
+{
+    if (!m_board_) {
+        return HttpServer::Response::Text(500, "No board loaded");
+    }
+    if (request.path == "/" || request.path == "/index.html") {
+        HttpServer::Response response;
+        response.content_type = "text/html; charset=utf-8";
+        response.body = std::make_shared<const std::string>(GetViewerPageHtml());
+        return response;
+    }
+    if (request.path == "/board.json") {
+        return ServeBoardInfo();
+    }
+    if (request.path == "/stats.json") {
+        return ServeStats();
+    }
+    if (request.path.rfind("/tiles/", 0) == 0) {
+        return ServeTile(request);
+    }
+    if (request.path == "/view") {
+        return ServeViewReport(request);
+    }
+    return HttpServer::Response::Text(404, "Not found");
+}
+
+HttpServer::Response TileServer::ServeBoardInfo() const
+{
+    std::ostringstream json;
+    json << "{\n  \"name\": \"" << EscapeJson(std::filesystem::path(m_board_->GetFilePath()).filename().string()) << "\",\n"
+         << "  \"tile_size\": " << kTileSize << ",\n"
+         << "  \"max_zoom\": " << m_max_zoom_level_ << ",\n"
+         << "  \"layers\": [";
+    for (size_t i = 0; i < m_board_->layers.size(); ++i) {
+        const Board::LayerInfo& layer = m_board_->layers[i];
+        json << (i ? ", " : "") << "{\"id\": " << layer.GetId() << ", \"name\": \"" << EscapeJson(layer.GetName())
+             << "\", \"visible\": " << (m_base_view_state_->IsLayerVisible(static_cast<int>(i)) ? "true" : "false") << "}";
+    }
+    json << "],\n  \"nets\": [";
+    std::vector<std::string> net_names;
+    net_names.reserve(m_net_ids_by_name_.size());
+    for (const auto& entry : m_net_ids_by_name_) {
+        net_names.push_back(entry.first);
+    }
+    std::sort(net_names.begin(), net_names.end());
+    for (size_t i = 0; i < net_names.size(); ++i) {
+        json << (i ? ", " : "") << "\"" << EscapeJson(net_names[i]) << "\"";
+    }
+    json << "]\n}\n";
+
+    HttpServer::Response response;
+    response.content_type = "application/json";
+    response.body = std::make_shared<const std::string>(json.str());
+    return response;
+}
+
+HttpServer::Response TileServer::ServeStats() const
+{
+    const TilePrefetcher::Stats prefetch = m_prefetcher_ ? m_prefetcher_->GetStats() : TilePrefetcher::Stats {};
+    std::lock_guard<std::mutex> lock(m_stats_mutex_);
+    std::ostringstream json;
+    // cache_hit_rate: requests served without waiting for a render. prefetch_accuracy: prefetched tiles that
+    // were requested later
+    json << "{\"tile_requests\": " << m_tile_requests_ << ", \"memory_hits\": " << m_memory_hits_ << ", \"disk_hits\": " << m_disk_hits_
+         << ", \"shared_renders\": " << m_shared_renders_ << ", \"renders\": " << m_renders_
+         << ", \"average_render_ms\": " << (m_renders_ ? m_render_ms_total_ / m_renders_ : 0.0)
+         << ", \"cache_hit_rate\": " << (m_tile_requests_ ? static_cast<double>(m_memory_hits_ + m_disk_hits_) / m_tile_requests_ : 0.0)
+         << ",\n \"prefetch\": {\"view_reports\": " << prefetch.view_reports << ", \"queued\": " << prefetch.queued << ", \"started\": " << prefetch.prefetched
+         << ", \"cancelled\": " << prefetch.cancelled << ", \"loads\": " << m_prefetch_loads_ << ", \"renders\": " << m_prefetch_renders_
+         << ", \"hits\": " << m_prefetch_hits_ << ", \"partial_hits\": " << m_prefetch_partial_hits_
+         << ", \"accuracy\": " << (m_prefetch_loads_ ? static_cast<double>(m_prefetch_hits_ + m_prefetch_partial_hits_) / m_prefetch_loads_ : 0.0) << "}}\n";
+    HttpServer::Response response;
+    response.content_type = "application/json";
+    response.body = std::make_shared<const std::string>(json.str());
+    return response;
+}
+
+HttpServer::Response TileServer::ServeTile(const HttpServer::Request& request)
+{
+    int zoom_level = 0;
+    int x = 0;
+    int y = 0;
+    if (!ParseTilePath(request.path, zoom_level, x, y)) {
+        return HttpServer::Response::Text(404, "Tiles are /tiles/<z>/<x>/<y>.png");
+    }
+    if (zoom_level < 0 || zoom_level > m_max_zoom_level_ || x < 0 || y < 0 || x >= (1 << zoom_level) || y >= (1 << zoom_level)) {
+        return HttpServer::Response::Text(404, "Tile out of range");
+    }
+
+    std::string error;
+    const TileView view = GetTileView(request, error);
+    if (!view.state) {
+        return HttpServer::Response::Text(400, error);
+    }
+
+    TileData tile = GetTile(view, zoom_level, x, y);
+    if (!tile) {
+        return HttpServer::Response::Text(500, "Failed to render the tile");
+    }
+    HttpServer::Response response;
+    response.content_type = "image/png";
+    response.cache_control = "public, max-age=3600";
+    response.body = std::move(tile);
+    return response;
+}
+
+HttpServer::Response TileServer::ServeViewReport(const HttpServer::Request& request)
+{
+    if (!m_prefetcher_) {
+        return HttpServer::Response::Text(200, "Prefetching is disabled");
+    }
+    const auto session = request.query.find("session");
+    if (session == request.query.end() || session->second.empty() || session->second.size() > 64) {
+        return HttpServer::Response::Text(400, "Missing session");
+    }
+    auto number = [&request](const char* name, double& value) {
+        const auto param = request.query.find(name);
+        if (param == request.query.end()) {
+            return false;
+        }
+        char* end = nullptr;
+        value = std::strtod(param->second.c_str(), &end);
+        return *end == '\0' && std::isfinite(value);
+    };
+    double zoom_level = 0.0;
+    double center_x = 0.0;
+    double center_y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    if (!number("z", zoom_level) || !number("x", center_x) || !number("y", center_y) || !number("w", width) || !number("h", height)) {
+        return HttpServer::Response::Text(400, "Views are /view?session=<id>&z=<level>&x=<center>&y=<center>&w=<width>&h=<height>");
+    }
+
+    std::string error;
+    const TileView view = GetTileView(request, error);
+    if (!view.state) {
+        return HttpServer::Response::Text(400, error);
+    }
+
+    TilePrefetcher::ViewReport report;
+    const double world_per_pixel = m_tile_world_bounds_.w / kTileSize;  // At level 0
+    report.center = Vec2(m_tile_world_bounds_.x + center_x * world_per_pixel, m_tile_world_bounds_.y + center_y * world_per_pixel);
+    report.zoom_level = static_cast<int>(zoom_level);
+    report.width = static_cast<int>(std::min(width, 16384.0));
+    report.height = static_cast<int>(std::min(height, 16384.0));
+    m_prefetcher_->UpdateView(session->second, report, [this, view](int level, int x, int y) { GetTile(view, level, x, y, true); });
+    return HttpServer::Response::Text(200, "OK");
+}
+
+TileServer::TileView TileServer::GetTileView(const HttpServer::Request& request, std::string& error)
+{
+    std::vector<uint8_t> layer_visibility = m_base_view_state_->layer_visibility;
+    const auto layers_param = request.query.find("layers");
+    if (layers_param != request.query.end()) {
+        std::fill(layer_visibility.begin(), layer_visibility.end(), 0);
+        layer_visibility.resize(m_board_->layers.size(), 0);
+        std::istringstream ids(layers_param->second);
+        std::string id_text;
+        while (std::getline(ids, id_text, ',')) {
+            if (id_text.empty()) {
+                continue;
+            }
+            char* end = nullptr;
+            const long layer_id = std::strtol(id_text.c_str(), &end, 10);
+            const auto layer = std::find_if(m_board_->layers.begin(), m_board_->layers.end(),
+                                            [layer_id](const Board::LayerInfo& info) { return info.GetId() == layer_id; });
+            if (*end != '\0' || layer == m_board_->layers.end()) {
+                error = "Unknown layer " + id_text;
+                return {};
+            }
+            layer_visibility[static_cast<size_t>(layer - m_board_->layers.begin())] = 1;
+        }
+    }
+
+    int net_id = -1;
+    const auto net_param = request.query.find("net");
+    if (net_param != request.query.end() && !net_param->second.empty()) {
+        const auto net = m_net_ids_by_name_.find(net_param->second);
+        if (net == m_net_ids_by_name_.end()) {
+            error = "Unknown net " + net_param->second;
+            return {};
+        }
+        net_id = net->second;
+    }
+
+    TileView view;
+    StableHash hash;
+    hash.Add(layer_visibility.data(), layer_visibility.size());
+    view.key = hash.ToHex() + "_" + std::to_string(net_id);
+
+    // Reusing the state keeps each renderer's cached RenderingState valid across tiles of the same view
+    std::lock_guard<std::mutex> lock(m_view_states_mutex_);
+    const auto cached = m_view_states_.find(view.key);
+    if (cached != m_view_states_.end()) {
+        view.state = cached->second;
+        return view;
+    }
+    if (m_view_states_.size() >= kMaxCachedViewStates) {
+        m_view_states_.clear();  // Rarely reached; states in use stay alive through their shared_ptr
+    }
+    auto derived = std::make_shared<BoardDataManager::ViewState>(*m_base_view_state_);
+    derived->layer_visibility = std::move(layer_visibility);
+    derived->selected_net_id = net_id;
+    derived->selected_element = nullptr;
+    derived->box_selection = nullptr;
+    view.state = derived;
+    m_view_states_.emplace(view.key, std::move(derived));
+    return view;
+}
+
+TileServer::TileData TileServer::GetTile(const TileView& view, int zoom_level, int x, int y, bool is_prefetch)
+{
+    const std::string key = view.key + "/" + std::to_string(zoom_level) + "/" + std::to_string(x) + "/" + std::to_string(y);
+    if (!is_prefetch) {
+        std::lock_guard<std::mutex> lock(m_stats_mutex_);
+        ++m_tile_requests_;
+    }
+    bool was_prefetched = false;
+    if (TileData tile = FindInMemoryCache(key, is_prefetch ? nullptr : &was_prefetched)) {
+        if (!is_prefetch) {
+            std::lock_guard<std::mutex> lock(m_stats_mutex_);
+            ++m_memory_hits_;
+            m_prefetch_hits_ += was_prefetched ? 1 : 0;
+        }
+        return tile;
+    }
+
+    // The first request for a tile renders it; the others wait for the same result
+    std::promise<TileData> promise;
+    std::shared_future<TileData> future;
+    bool is_owner = false;
+    bool joined_prefetch = false;
+    {
+        std::lock_guard<std::mutex> lock(m_in_flight_mutex_);
+        auto in_flight = m_in_flight_.find(key);
+        if (in_flight != m_in_flight_.end()) {
+            future = in_flight->second.result;
+            joined_prefetch = in_flight->second.is_prefetch;
+        } else {
+            future = promise.get_future().share();
+            m_in_flight_.emplace(key, InFlightTile {future, is_prefetch});
+            is_owner = true;
+        }
+    }
+    if (!is_owner) {
+        if (is_prefetch) {
+            return nullptr;  // Someone is already producing it
+        }
+        if (joined_prefetch) {
+            // Consumes the prefetch flag, so the tile is counted once
+            bool was_prefetched = false;
+            future.wait();
+            FindInMemoryCache(key, &was_prefetched);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_stats_mutex_);
+            ++m_shared_renders_;
+            m_prefetch_partial_hits_ += joined_prefetch ? 1 : 0;
+        }
+        return future.get();
+    }
+
+    TileData tile;
+    const std::string disk_path = GetDiskCachePath(view, zoom_level, x, y);
+    std::string contents;
+    if (!disk_path.empty() && ReadFile(disk_path, contents)) {
+        tile = std::make_shared<const std::string>(std::move(contents));
+        std::lock_guard<std::mutex> lock(m_stats_mutex_);
+        m_disk_hits_ += is_prefetch ? 0 : 1;
+        m_prefetch_loads_ += is_prefetch ? 1 : 0;
+    } else {
+        tile = RenderTile(view, zoom_level, x, y);
+        if (tile && is_prefetch) {
+            std::lock_guard<std::mutex> lock(m_stats_mutex_);
+            ++m_prefetch_loads_;
+            ++m_prefetch_renders_;
+        }
+        if (tile && !disk_path.empty()) {
+            // Written under a temporary name and renamed, so readers never see a partial file
+            std::error_code error;
+            const std::filesystem::path path(disk_path);
+            std::filesystem::create_directories(path.parent_path(), error);
+            std::filesystem::path temporary_path = path;
+            temporary_path += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            {
+                std::ofstream file(temporary_path, std::ios::binary);
+                file.write(tile->data(), static_cast<std::streamsize>(tile->size()));
+            }
+            std::filesystem::rename(temporary_path, path, error);
+            if (error) {
+                std::filesystem::remove(temporary_path, error);
+            }
+        }
+    }
+
+    if (tile) {
+        AddToMemoryCache(key, tile, is_prefetch);
+    }
+    promise.set_value(tile);
+    {
+        std::lock_guard<std::mutex> lock(m_in_flight_mutex_);
+        m_in_flight_.erase(key);
+    }
+    return tile;
+}
+
+TileServer::TileData TileServer::RenderTile(const TileView& view, int zoom_level, int x, int y)
+{
+    const auto render_start = std::chrono::steady_clock::now();
+    std::unique_ptr<TileRenderer> renderer = AcquireRenderer();
+    if (!renderer) {
+        return nullptr;
+    }
+
+    const double zoom = std::ldexp(kTileSize / m_tile_world_bounds_.w, zoom_level);
+    const BLPoint origin(m_tile_world_bounds_.x + x * kTileSize / zoom, m_tile_world_bounds_.y + y * kTileSize / zoom);
+    const BLImage& image = renderer->Render(*m_board_, origin, zoom, kTileSize, kTileSize, view.state);
+
+    BLImageCodec codec;
+    BLArray<uint8_t> encoded;
+    TileData tile;
+    if (codec.findByName("PNG") == BL_SUCCESS && image.writeToData(encoded, codec) == BL_SUCCESS) {
+        tile = std::make_shared<const std::string>(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    }
+    ReleaseRenderer(std::move(renderer));
+
+    std::lock_guard<std::mutex> lock(m_stats_mutex_);
+    ++m_renders_;
+    m_render_ms_total_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - render_start).count();
+    return tile;
+}
+
+std::string TileServer::GetDiskCachePath(const TileView& view, int zoom_level, int x, int y) const
+{
+    if (m_options_.cache_directory.empty()) {
+        return std::string();
+    }
+    const std::filesystem::path path = std::filesystem::path(m_options_.cache_directory) / m_board_cache_key_ / view.key / std::to_string(zoom_level) /
+                                       std::to_string(x) / (std::to_string(y) + ".png");
+    return path.string();
+}
+
+TileServer::TileData TileServer::FindInMemoryCache(const std::string& key, bool* was_prefetched)
+{
+    std::lock_guard<std::mutex> lock(m_memory_cache_mutex_);
+    auto entry = m_memory_cache_.find(key);
+    if (entry == m_memory_cache_.end()) {
+        return nullptr;
+    }
+    if (was_prefetched) {
+        *was_prefetched = m_prefetched_unrequested_.erase(key) > 0;
+    }
+    m_memory_cache_order_.splice(m_memory_cache_order_.begin(), m_memory_cache_order_, entry->second);
+    return entry->second->second;
+}
+
+void TileServer::AddToMemoryCache(const std::string& key, TileData tile, bool is_prefetch)
+{
+    std::lock_guard<std::mutex> lock(m_memory_cache_mutex_);
+    if (m_memory_cache_.count(key) || m_options_.memory_cache_tiles == 0) {
+        return;
+    }
+    m_memory_cache_order_.emplace_front(key, std::move(tile));
+    m_memory_cache_[key] = m_memory_cache_order_.begin();
+    if (is_prefetch) {
+        m_prefetched_unrequested_.insert(key);
+    }
+    while (m_memory_cache_order_.size() > m_options_.memory_cache_tiles) {
+        m_memory_cache_.erase(m_memory_cache_order_.back().first);
+        m_prefetched_unrequested_.erase(m_memory_cache_order_.back().first);
+        m_memory_cache_order_.pop_back();
+    }
+}
+
+std::unique_ptr<TileRenderer> TileServer::AcquireRenderer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_renderers_mutex_);
+        if (!m_idle_renderers_.empty()) {
+            std::unique_ptr<TileRenderer> renderer = std::move(m_idle_renderers_.back());
+            m_idle_renderers_.pop_back();
+            return renderer;
+        }
+    }
+    // At most one renderer per HTTP worker and prefetch thread ever exists, since each holds one while rendering
+    auto renderer = std::make_unique<TileRenderer>();
+    if (!renderer->Initialize(kTileSize, m_board_data_manager_, m_options_.background_color)) {
+        std::cerr << "TileServer: Failed to set up a tile renderer" << std::endl;
+        return nullptr;
+    }
+    return renderer;
+}
+
+void TileServer::ReleaseRenderer(std::unique_ptr<TileRenderer> renderer)
+{
+    std::lock_guard<std::mutex> lock(m_renderers_mutex_);
+    m_idle_renderers_.push_back(std::move(renderer));
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <blend2d.h>
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/BoardDataManager.hpp"
+#include "server/HttpServer.hpp"
+#include "server/TilePrefetcher.hpp"
+
+class Board;
+class TileRenderer;
+
+// Serves the board as a slippy map: 256 px PNG tiles at /tiles/<z>/<x>/<y>.png, where zoom level 0 fits the whole
+// board in one tile and every level doubles the resolution, plus a small viewer page at /, board metadata at
+// /board.json and cache statistics at /stats.json. The view is chosen in the URL:
+//   layers=<id>,<id>,...  layer IDs to draw (default: the visibility in the settings file)
+//   net=<name>            net to highlight
+// One loaded board and BoardDataManager are shared by every client; requests only differ in the ViewState they
+// render, which is derived from the published one and cached per layer/net combination.
+// Performance optimization: Tiles are looked up in an in-memory LRU cache, then in the on-disk cache, and only
+// then rendered; concurrent requests for the same tile wait for one render instead of each drawing it.
+// The viewer reports its view to /view?session=<id>&z=<level>&x=<center>&y=<center>&w=<width>&h=<height> (center
+// in level 0 pixels) as it moves, and a TilePrefetcher renders the tiles it is heading for in the background.
+// Rendering is CPU only (Blend2D through TileRenderer), so the server runs on machines without a GPU.
+class TileServer
+{
+public:
+    struct Options {
+        std::string cache_directory;        // On-disk tile cache; empty disables it
+        size_t memory_cache_tiles = 4096;   // Encoded tiles kept in memory (~10-60 KB each)
+        BLRgba32 background_color = BLRgba32(0xFF000000);
+        int prefetch_threads = 1;           // Background renders ahead of viewers; 0 disables prefetching
+    };
+
+    TileServer(std::shared_ptr<BoardDataManager> board_data_manager, Options options);
+    ~TileServer();
+    TileServer(const TileServer&) = delete;
+    TileServer& operator=(const TileServer&) = delete;
+
+    // Thread-safe; the HttpServer handler
+    HttpServer::Response HandleRequest(const HttpServer::Request& request);
+
+    [[nodiscard]] int GetMaxZoomLevel() const { return m_max_zoom_level_; }
+
+    static constexpr int kTileSize = 256;
+    static constexpr int kMaxZoomLevelLimit = 24;
+    static constexpr size_t kMaxCachedViewStates = 64;
+
+private:
+    using TileData = std::shared_ptr<const std::string>;  // Encoded PNG
+
+    // A request's view: the state to render and the key naming it in cache paths
+    struct TileView {
+        std::shared_ptr<const BoardDataManager::ViewState> state;
+        std::string key;
+    };
+
+    HttpServer::Response ServeBoardInfo() const;
+    HttpServer::Response ServeStats() const;
+    HttpServer::Response ServeTile(const HttpServer::Request& request);
+    HttpServer::Response ServeViewReport(const HttpServer::Request& request);
+
+    // Null with an error message for unknown layers or nets
+    TileView GetTileView(const HttpServer::Request& request, std::string& error);
+    // is_prefetch: a background render nobody waits for yet; kept apart in the statistics
+    TileData GetTile(const TileView& view, int zoom_level, int x, int y, bool is_prefetch = false);
+    TileData RenderTile(const TileView& view, int zoom_level, int x, int y);
+    [[nodiscard]] std::string GetDiskCachePath(const TileView& view, int zoom_level, int x, int y) const;
+
+    // was_prefetched, if given, reports whether a prefetch put the tile there, once per tile
+    TileData FindInMemoryCache(const std::string& key, bool* was_prefetched = nullptr);
+    void AddToMemoryCache(const std::string& key, TileData tile, bool is_prefetch);
+
+    std::unique_ptr<TileRenderer> AcquireRenderer();
+    void ReleaseRenderer(std::unique_ptr<TileRenderer> renderer);
+
+    std::shared_ptr<BoardDataManager> m_board_data_manager_;
+    std::shared_ptr<const BoardDataManager::ViewState> m_base_view_state_;  // Published state at startup
+    std::shared_ptr<const Board> m_board_;
+    Options m_options_;
+
+    BLRect m_tile_world_bounds_ {};  // Square covered by the zoom level 0 tile
+    int m_max_zoom_level_ = 0;
+    std::string m_board_cache_key_;  // Changes with the board file and everything that colors the tiles
+    std::unordered_map<std::string, int> m_net_ids_by_name_;
+
+    std::mutex m_view_states_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const BoardDataManager::ViewState>> m_view_states_;
+
+    // LRU: most recently used at the front
+    std::mutex m_memory_cache_mutex_;
+    std::list<std::pair<std::string, TileData>> m_memory_cache_order_;
+    std::unordered_map<std::string, std::list<std::pair<std::string, TileData>>::iterator> m_memory_cache_;
+    std::unordered_set<std::string> m_prefetched_unrequested_;  // Cached tiles a prefetch loaded and no request used yet
+
+    struct InFlightTile {
+        std::shared_future<TileData> result;
+        bool is_prefetch = false;
+    };
+    std::mutex m_in_flight_mutex_;
+    std::unordered_map<std::string, InFlightTile> m_in_flight_;
+
+    std::mutex m_renderers_mutex_;
+    std::vector<std::unique_ptr<TileRenderer>> m_idle_renderers_;
+
+    mutable std::mutex m_stats_mutex_;
+    uint64_t m_tile_requests_ = 0;
+    uint64_t m_memory_hits_ = 0;
+    uint64_t m_disk_hits_ = 0;
+    uint64_t m_shared_renders_ = 0;  // Requests that waited for another request's render
+    uint64_t m_renders_ = 0;  // Requested and prefetched
+    double m_render_ms_total_ = 0.0;
+    uint64_t m_prefetch_loads_ = 0;         // Tiles a prefetch rendered or read from disk into the memory cache
+    uint64_t m_prefetch_renders_ = 0;
+    uint64_t m_prefetch_hits_ = 0;          // Requests served from memory thanks to a prefetch
+    uint64_t m_prefetch_partial_hits_ = 0;  // Requests that joined a prefetch render already under way
+
+    // Last: its threads call GetTile(), so it is destroyed before everything they use
+    std::unique_ptr<TilePrefetcher> m_prefetcher_;
+};
@@ -0,0 +1,136 @@
+#include "ViewerPage.hpp"
+
+const char* GetViewerPageHtml()
+{
+    return R"HTML(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>XZZPCB Tile Viewer</title>
+<style>
+  html, body { margin: 0; height: 100%; background: #000; color: #ddd; font: 13px sans-serif; overflow: hidden; }
+  #map { position: absolute; inset: 0; cursor: grab; }
+  #map img { position: absolute; width: 256px; height: 256px; image-rendering: auto; user-select: none; }
+  #panel { position: absolute; top: 8px; left: 8px; max-height: calc(100% - 32px); overflow: auto; padding: 8px;
+           background: rgba(20, 20, 20, 0.85); border-radius: 4px; }
+  #panel label { display: block; white-space: nowrap; }
+</style>
+</head>
+<body>
+<div id="map"></div>
+<div id="panel">
+  <b id="title"></b>
+  <div><input id="net" list="nets" placeholder="Highlight net"><datalist id="nets"></datalist></div>
+  <div id="layers"></div>
+</div>
+<script>
+const map = document.getElementById('map');
+let info = null;
+let zoom = 1;           // Tile pyramid level
+let center = [128, 128]; // Level 0 pixels
+let query = '';
+const session = Math.random().toString(36).slice(2);
+let reportTimer = null;
+
+// Tells the server where the view is, so it can render the tiles ahead of it; at most every 100 ms
+function reportView() {
+  if (reportTimer) return;
+  reportTimer = setTimeout(() => {
+    reportTimer = null;
+    fetch('/view' + query + '&session=' + session + '&z=' + zoom + '&x=' + center[0] + '&y=' + center[1] +
+          '&w=' + map.clientWidth + '&h=' + map.clientHeight, { cache: 'no-store' }).catch(() => {});
+  }, 100);
+}
+
+function updateQuery() {
+  const layers = [...document.querySelectorAll('#layers input')].filter(box => box.checked).map(box => box.value);
+  const net = document.getElementById('net').value.trim();
+  query = '?layers=' + layers.join(',') + (net ? '&net=' + encodeURIComponent(net) : '');
+  map.innerHTML = '';
+  draw();
+}
+
+function draw() {
+  if (!info) return;
+  const scale = Math.pow(2, zoom);
+  const left = center[0] * scale - map.clientWidth / 2;
+  const top = center[1] * scale - map.clientHeight / 2;
+  const count = 1 << zoom;
+  const wanted = new Set();
+  for (let y = Math.max(0, Math.floor(top / 256)); y <= Math.min(count - 1, Math.floor((top + map.clientHeight) / 256)); y++) {
+    for (let x = Math.max(0, Math.floor(left / 256)); x <= Math.min(count - 1, Math.floor((left + map.clientWidth) / 256)); x++) {
+      const src = '/tiles/' + zoom + '/' + x + '/' + y + '.png' + query;
+      wanted.add(src);
+      let img = map.querySelector('img[data-src="' + CSS.escape(src) + '"]');
+      if (!img) {
+        img = document.createElement('img');
+        img.dataset.src = src;
+        img.src = src;
+        img.draggable = false;
+        map.appendChild(img);
+      }
+      img.style.left = (x * 256 - left) + 'px';
+      img.style.top = (y * 256 - top) + 'px';
+    }
+  }
+  for (const img of [...map.querySelectorAll('img')]) {
+    if (!wanted.has(img.dataset.src)) img.remove();
+  }
+  reportView();
+}
+
+let drag = null;
+map.addEventListener('mousedown', event => { drag = [event.clientX, event.clientY]; map.style.cursor = 'grabbing'; });
+window.addEventListener('mouseup', () => { drag = null; map.style.cursor = 'grab'; });
+window.addEventListener('mousemove', event => {
+  if (!drag) return;
+  const scale = Math.pow(2, zoom);
+  center = [center[0] - (event.clientX - drag[0]) / scale, center[1] - (event.clientY - drag[1]) / scale];
+  drag = [event.clientX, event.clientY];
+  draw();
+});
+map.addEventListener('wheel', event => {
+  event.preventDefault();
+  const next = Math.max(0, Math.min(info.max_zoom, zoom + (event.deltaY < 0 ? 1 : -1)));
+  if (next === zoom) return;
+  // Keep the point under the cursor in place
+  const offset = [event.clientX - map.clientWidth / 2, event.clientY - map.clientHeight / 2];
+  const before = Math.pow(2, zoom);
+  const after = Math.pow(2, next);
+  center = [center[0] + offset[0] / before - offset[0] / after, center[1] + offset[1] / before - offset[1] / after];
+  zoom = next;
+  map.innerHTML = '';
+  draw();
+}, { passive: false });
+window.addEventListener('resize', draw);
+
+fetch('/board.json').then(response => response.json()).then(board => {
+  info = board;
+  document.title = board.name;
+  document.getElementById('title').textContent = board.name;
+  const layers = document.getElementById('layers');
+  for (const layer of board.layers) {
+    const label = document.createElement('label');
+    const box = document.createElement('input');
+    box.type = 'checkbox';
+    box.value = layer.id;
+    box.checked = layer.visible;
+    box.addEventListener('change', updateQuery);
+    label.append(box, ' ' + layer.name);
+    layers.appendChild(label);
+  }
+  const nets = document.getElementById('nets');
+  for (const name of board.nets) {
+    const option = document.createElement('option');
+    option.value = name;
+    nets.appendChild(option);
+  }
+  document.getElementById('net').addEventListener('change', updateQuery);
+  zoom = Math.min(board.max_zoom, Math.max(0, Math.floor(Math.log2(Math.min(map.clientWidth, map.clientHeight) / 256))));
+  updateQuery();
+});
+</script>
+</body>
+</html>
+)HTML";
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Self-contained HTML/JS page served at / by the tile server: pans and zooms the /tiles pyramid with the mouse,
+// with layer checkboxes and a net field that go into the tile URLs. No external scripts, so it works offline.
+const char* GetViewerPageHtml();
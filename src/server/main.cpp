@@ -0,0 +1,148 @@
+// Tile server: loads one board and serves it to browsers as map tiles, without a window or GPU.
+//   XZZPCB-Tile-Server <board.pcb> [--host 127.0.0.1] [--port 8080] [--threads N] [--cache-dir <directory>]
+//                      [--side top|bottom|both] [--background AARRGGBB] [--config <settings.ini>] [--prefetch-threads N]
+// Then open http://<host>:<port>/ in a browser.
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "core/BoardDataManager.hpp"
+#include "core/Config.hpp"
+#include "pcb/Board.hpp"
+#include "pcb/BoardLoaderFactory.hpp"
+#include "server/HttpServer.hpp"
+#include "server/TileServer.hpp"
+
+namespace
+{
+std::atomic<bool> g_stop_requested {false};
+
+void HandleSignal(int /*signal*/)
+{
+    g_stop_requested = true;
+}
+
+struct Arguments {
+    std::string board_path;
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    int thread_count = 0;
+    std::string side;
+    std::string config_path;
+    TileServer::Options options;
+};
+
+void PrintUsage()
+{
+    std::cerr << "Usage: XZZPCB-Tile-Server <board.pcb> [--host 127.0.0.1] [--port 8080] [--threads N] [--cache-dir <directory>]\n"
+                 "                          [--side top|bottom|both] [--background AARRGGBB] [--config <settings.ini>] [--prefetch-threads N]"
+              << std::endl;
+}
+
+bool ParseArguments(int argc, char* argv[], Arguments& arguments)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag.rfind("--", 0) != 0) {
+            if (!arguments.board_path.empty()) {
+                return false;
+            }
+            arguments.board_path = flag;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "TileServer: Missing value for " << flag << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        char* end = nullptr;
+        if (flag == "--host") {
+            arguments.host = value;
+        } else if (flag == "--port") {
+            arguments.port = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (flag == "--threads") {
+            arguments.thread_count = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else if (flag == "--cache-dir") {
+            arguments.options.cache_directory = value;
+        } else if (flag == "--side") {
+            arguments.side = value;
+        } else if (flag == "--background") {
+            arguments.options.background_color = BLRgba32(static_cast<uint32_t>(std::strtoul(value.c_str(), &end, 16)));
+        } else if (flag == "--config") {
+            arguments.config_path = value;
+        } else if (flag == "--prefetch-threads") {
+            arguments.options.prefetch_threads = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+        } else {
+            std::cerr << "TileServer: Unknown option " << flag << std::endl;
+            return false;
+        }
+        if (end && *end != '\0') {
+            std::cerr << "TileServer: Invalid value for " << flag << ": " << value << std::endl;
+            return false;
+        }
+    }
+    if (arguments.board_path.empty() || arguments.port <= 0 || arguments.port > 65535 || arguments.options.prefetch_threads < 0) {
+        return false;
+    }
+    return arguments.side.empty() || arguments.side == "top" || arguments.side == "bottom" || arguments.side == "both";
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Arguments arguments;
+    if (!ParseArguments(argc, argv, arguments)) {
+        PrintUsage();
+        return 2;
+    }
+
+    auto board_data_manager = std::make_shared<BoardDataManager>();
+    if (!arguments.config_path.empty()) {
+        Config config;
+        if (!config.LoadFromFile(arguments.config_path)) {
+            std::cerr << "TileServer: Failed to load " << arguments.config_path << std::endl;
+            return 1;
+        }
+        board_data_manager->LoadSettingsFromConfig(config);
+    }
+
+    BoardLoaderFactory loader_factory;
+    std::shared_ptr<Board> board = loader_factory.LoadBoard(arguments.board_path);
+    if (!board || !board->IsLoaded()) {
+        std::cerr << "TileServer: Failed to load " << arguments.board_path << std::endl;
+        return 1;
+    }
+    board->SetBoardDataManager(board_data_manager);
+    board_data_manager->SetBoard(board);
+    board_data_manager->RegenerateLayerColors(board);
+    if (arguments.side == "top") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kTop);
+    } else if (arguments.side == "bottom") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kBottom);
+    } else if (arguments.side == "both") {
+        board_data_manager->SetCurrentViewSide(BoardDataManager::BoardSide::kBoth);
+    }
+    board_data_manager->WaitForBoardVariant();  // Folded or flipped boards are built on a worker
+
+    TileServer tile_server(board_data_manager, arguments.options);
+    HttpServer http_server([&tile_server](const HttpServer::Request& request) { return tile_server.HandleRequest(request); });
+
+    // Workers render tiles themselves, so one per core keeps every core busy on cache misses
+    const int thread_count = arguments.thread_count > 0 ? arguments.thread_count : std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    if (!http_server.Start(arguments.host, static_cast<uint16_t>(arguments.port), thread_count)) {
+        return 1;
+    }
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    std::cout << "TileServer: Serving " << arguments.board_path << " at http://" << arguments.host << ":" << arguments.port << "/ on " << thread_count
+              << " threads (Ctrl+C to stop)" << std::endl;
+
+    http_server.Run(g_stop_requested);
+    std::cout << "TileServer: Stopped" << std::endl;
+    return 0;
+}
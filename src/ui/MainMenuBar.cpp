@@ -38,7 +38,11 @@ void MainMenuBar::RenderUI(Application& app)
                 // Application will handle visibility logic based on whether a board is loaded
                 app.SetShowPcbDetailsRequested(true);  // Uses new public setter
             }
+            if (ImGui::MenuItem("Search", "Ctrl+K")) {
+                app.SetShowSearchRequested(true);
+            }
             ImGui::Separator();
+            ImGui::MenuItem("Memory Usage Overlay", nullptr, &m_show_memory_overlay_);
             ImGui::MenuItem("ImGui Demo Window", nullptr, &m_show_im_gui_demo_window_);
             ImGui::MenuItem("ImGui Metrics/Debugger", nullptr, &m_show_im_gui_metrics_window_);
             ImGui::EndMenu();
@@ -28,6 +28,7 @@ public:
 
     // Toggle states for menu items
     bool* GetShowDemoWindowFlag() { return &m_show_demo_window_; }
+    [[nodiscard]] bool IsMemoryOverlayShown() const { return m_show_memory_overlay_; }
     void SetSettingsWindowVisible(bool is_visible) { m_is_settings_window_visible_ = is_visible; }
     bool WantsToToggleSettings()
     {
@@ -49,4 +50,7 @@ private:
     // State for ImGui helper windows, as Application.hpp indicated MainMenuBar would handle these
     bool m_show_im_gui_demo_window_ = false;
     bool m_show_im_gui_metrics_window_ = false;
+
+    // Board memory HUD in the PCB viewer; Application forwards it every frame
+    bool m_show_memory_overlay_ = false;
 };
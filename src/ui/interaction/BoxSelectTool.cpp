@@ -0,0 +1,168 @@
+#include "ui/interaction/BoxSelectTool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_set>
+
+#include "core/BoardDataManager.hpp"
+#include "pcb/Board.hpp"
+#include "ui/interaction/NavigationTool.hpp"
+#include "view/Camera.hpp"
+#include "view/Viewport.hpp"
+
+namespace
+{
+// Releases closer than this to the press position count as a click, not a box
+constexpr float kMinDragPixels = 4.0f;
+
+// Rubber band colors: blue for "fully inside", green for "touching"
+constexpr ImU32 kInsideFillColor = IM_COL32(60, 140, 255, 40);
+constexpr ImU32 kInsideEdgeColor = IM_COL32(60, 140, 255, 220);
+constexpr ImU32 kTouchingFillColor = IM_COL32(60, 220, 120, 40);
+constexpr ImU32 kTouchingEdgeColor = IM_COL32(60, 220, 120, 220);
+}  // namespace
+
+BoxSelectTool::BoxSelectTool(std::shared_ptr<Camera> camera,
+                             std::shared_ptr<Viewport> viewport,
+                             std::shared_ptr<BoardDataManager> board_data_manager,
+                             std::shared_ptr<NavigationTool> navigation_tool)
+    : InteractionTool(kToolName, camera, viewport), m_board_data_manager_(board_data_manager), m_navigation_tool_(navigation_tool)
+{
+}
+
+void BoxSelectTool::ProcessInput(ImGuiIO& io, bool is_viewport_focused, bool is_viewport_hovered, ImVec2 viewport_top_left, ImVec2 viewport_size)
+{
+    // Zoom, pan, rotation and hover tooltips behave exactly as in navigation mode
+    if (m_navigation_tool_) {
+        m_navigation_tool_->ProcessInput(io, is_viewport_focused, is_viewport_hovered, viewport_top_left, viewport_size);
+    }
+
+    const std::shared_ptr<Camera> camera = GetCamera();
+    const std::shared_ptr<Viewport> viewport = GetViewport();
+    if (!camera || !viewport || !m_board_data_manager_ || !m_navigation_tool_) {
+        return;
+    }
+
+    std::shared_ptr<const Board> current_board = m_board_data_manager_->GetBoard();
+    if (!current_board || !current_board->IsLoaded()) {
+        m_is_dragging_ = false;
+        return;
+    }
+
+    const ImVec2 mouse_in_viewport(io.MousePos.x - viewport_top_left.x, io.MousePos.y - viewport_top_left.y);
+    const Vec2 mouse_world = viewport->ScreenToWorld(Vec2(mouse_in_viewport.x, mouse_in_viewport.y), *camera);
+
+    if (is_viewport_hovered && is_viewport_focused && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+        m_is_dragging_ = true;
+        m_drag_start_screen_ = mouse_in_viewport;
+        m_drag_start_world_ = mouse_world;
+        m_drag_current_world_ = mouse_world;
+    }
+
+    if (m_is_dragging_) {
+        m_drag_current_world_ = mouse_world;
+        const Vec2 drag_start_screen = viewport->WorldToScreen(m_drag_start_world_, *camera);
+        const HitTestIndex::RectMode mode =
+            (mouse_in_viewport.x >= drag_start_screen.x_ax) ? HitTestIndex::RectMode::kFullyInside : HitTestIndex::RectMode::kTouching;
+
+        if (ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+            DrawRubberBand(viewport_top_left, mode);
+        } else {
+            m_is_dragging_ = false;
+            const float drag_dx = mouse_in_viewport.x - m_drag_start_screen_.x;
+            const float drag_dy = mouse_in_viewport.y - m_drag_start_screen_.y;
+            if (std::sqrt(drag_dx * drag_dx + drag_dy * drag_dy) >= kMinDragPixels) {
+                ApplySelection(mode, io.KeyShift);
+            } else if (!io.KeyShift) {
+                m_board_data_manager_->ClearBoxSelection();
+            }
+        }
+    }
+
+    if (is_viewport_focused && ImGui::IsKeyPressed(ImGuiKey_Escape, false)) {
+        m_is_dragging_ = false;
+        m_board_data_manager_->ClearBoxSelection();
+    }
+}
+
+void BoxSelectTool::ApplySelection(HitTestIndex::RectMode mode, bool additive)
+{
+    const BLRect world_rect(std::min(m_drag_start_world_.x_ax, m_drag_current_world_.x_ax),
+                            std::min(m_drag_start_world_.y_ax, m_drag_current_world_.y_ax),
+                            std::abs(m_drag_current_world_.x_ax - m_drag_start_world_.x_ax),
+                            std::abs(m_drag_current_world_.y_ax - m_drag_start_world_.y_ax));
+
+    const HitTestIndex& index = m_navigation_tool_->GetHitTestIndex();
+    const auto query_start = std::chrono::steady_clock::now();
+    index.FindInRect(world_rect, mode, m_query_hits_);
+    m_last_query_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - query_start).count();
+
+    BoardDataManager::BoxSelection selection;
+    if (additive) {
+        // Keep the existing selection first and append only elements that are not already in it
+        const std::shared_ptr<const BoardDataManager::BoxSelection> previous = m_board_data_manager_->GetBoxSelection();
+        selection.reserve(previous->size() + m_query_hits_.size());
+        selection.assign(previous->begin(), previous->end());
+        std::unordered_set<const Element*> already_selected;
+        already_selected.reserve(previous->size());
+        for (const ElementInteractionInfo& info : *previous) {
+            already_selected.insert(info.element);
+        }
+        for (const HitTestIndex::Hit& hit : m_query_hits_) {
+            if (already_selected.insert(hit.element).second) {
+                selection.push_back(ElementInteractionInfo {hit.element, hit.parent_component});
+            }
+        }
+    } else {
+        selection.reserve(m_query_hits_.size());
+        for (const HitTestIndex::Hit& hit : m_query_hits_) {
+            selection.push_back(ElementInteractionInfo {hit.element, hit.parent_component});
+        }
+    }
+
+    std::cout << "BoxSelectTool: " << (mode == HitTestIndex::RectMode::kFullyInside ? "Inside" : "Touching") << " query found " << m_query_hits_.size()
+              << " elements in " << m_last_query_ms_ << " ms (selection: " << selection.size() << ")" << std::endl;
+    m_board_data_manager_->SetBoxSelection(std::move(selection));
+}
+
+void BoxSelectTool::DrawRubberBand(ImVec2 viewport_top_left, HitTestIndex::RectMode mode) const
+{
+    const std::shared_ptr<Camera> camera = GetCamera();
+    const std::shared_ptr<Viewport> viewport = GetViewport();
+
+    // World-aligned rectangle, so it shows up rotated when the camera is rotated
+    const Vec2 world_corners[4] = {m_drag_start_world_,
+                                   Vec2(m_drag_current_world_.x_ax, m_drag_start_world_.y_ax),
+                                   m_drag_current_world_,
+                                   Vec2(m_drag_start_world_.x_ax, m_drag_current_world_.y_ax)};
+    ImVec2 screen_corners[4];
+    for (int i = 0; i < 4; ++i) {
+        const Vec2 screen = viewport->WorldToScreen(world_corners[i], *camera);
+        screen_corners[i] = ImVec2(viewport_top_left.x + static_cast<float>(screen.x_ax), viewport_top_left.y + static_cast<float>(screen.y_ax));
+    }
+
+    const bool inside = (mode == HitTestIndex::RectMode::kFullyInside);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddQuadFilled(screen_corners[0], screen_corners[1], screen_corners[2], screen_corners[3], inside ? kInsideFillColor : kTouchingFillColor);
+    draw_list->AddQuad(screen_corners[0], screen_corners[1], screen_corners[2], screen_corners[3], inside ? kInsideEdgeColor : kTouchingEdgeColor, 1.5f);
+}
+
+void BoxSelectTool::OnActivated()
+{
+    std::cout << GetName() << " activated." << std::endl;
+    // The left button now spans boxes instead of picking single elements
+    if (m_navigation_tool_) {
+        m_navigation_tool_->SetClickSelectionEnabled(false);
+    }
+}
+
+void BoxSelectTool::OnDeactivated()
+{
+    std::cout << GetName() << " deactivated." << std::endl;
+    m_is_dragging_ = false;
+    if (m_navigation_tool_) {
+        m_navigation_tool_->SetClickSelectionEnabled(true);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "imgui.h"
+
+#include "pcb/HitTestIndex.hpp"
+#include "ui/interaction/InteractionTool.hpp"
+#include "utils/Vec2.hpp"
+
+// Forward declarations
+class BoardDataManager;
+class NavigationTool;
+
+// Rubber-band box selection backed by HitTestIndex::FindInRect.
+//
+// Left-drag spans a world-aligned rectangle. Dragging left-to-right selects elements fully inside it,
+// right-to-left selects everything it touches. Shift adds to the current selection, a plain click or Escape
+// clears it. Results are published through BoardDataManager::SetBoxSelection for PcbDetailsWindow and the
+// render overlay. Camera navigation and hover tooltips are delegated to the NavigationTool, whose hit-test
+// index this tool queries.
+class BoxSelectTool : public InteractionTool
+{
+public:
+    static constexpr const char* kToolName = "Box Select";
+
+    BoxSelectTool(std::shared_ptr<Camera> camera,
+                  std::shared_ptr<Viewport> viewport,
+                  std::shared_ptr<BoardDataManager> board_data_manager,
+                  std::shared_ptr<NavigationTool> navigation_tool);
+    ~BoxSelectTool() override = default;
+
+    void ProcessInput(ImGuiIO& io, bool is_viewport_focused, bool is_viewport_hovered, ImVec2 viewport_top_left, ImVec2 viewport_size) override;
+
+    void OnActivated() override;
+    void OnDeactivated() override;
+
+    // Duration of the last rectangle query, for diagnostics
+    [[nodiscard]] double GetLastQueryMilliseconds() const { return m_last_query_ms_; }
+
+private:
+    void ApplySelection(HitTestIndex::RectMode mode, bool additive);
+    void DrawRubberBand(ImVec2 viewport_top_left, HitTestIndex::RectMode mode) const;
+
+    std::shared_ptr<BoardDataManager> m_board_data_manager_;
+    std::shared_ptr<NavigationTool> m_navigation_tool_;
+
+    // Drag state; the rectangle is anchored in world space so zooming mid-drag keeps the start corner in place
+    bool m_is_dragging_ = false;
+    ImVec2 m_drag_start_screen_;  // Relative to the viewport top-left
+    Vec2 m_drag_start_world_;
+    Vec2 m_drag_current_world_;
+
+    std::vector<HitTestIndex::Hit> m_query_hits_;  // Reused between queries to avoid reallocating
+    double m_last_query_ms_ = 0.0;
+};
@@ -2,11 +2,13 @@
 
 #include <iostream>
 
+#include "BoxSelectTool.hpp"
 #include "InteractionTool.hpp"
 #include "NavigationTool.hpp"
 
 #include "core/BoardDataManager.hpp"
 #include "core/ControlSettings.hpp"
+#include "core/InputActions.hpp"
 #include "render/PcbRenderer.hpp"
 #include "view/Camera.hpp"
 #include "view/Viewport.hpp"
@@ -19,6 +21,8 @@ InteractionManager::InteractionManager(std::shared_ptr<Camera> camera,
 {
     auto navigationTool = std::make_shared<NavigationTool>(m_camera_, m_viewport_, m_control_settings_, m_board_data_manager_);
     AddTool(navigationTool);
+    // Box selection shares the navigation tool's camera controls and hit-test index
+    AddTool(std::make_shared<BoxSelectTool>(m_camera_, m_viewport_, m_board_data_manager_, navigationTool));
 
     // Ensure an active tool is set if any tools were added.
     if (!m_tools_.empty() && !m_active_tool_) {
@@ -41,6 +45,16 @@ InteractionManager::~InteractionManager()
 
 void InteractionManager::ProcessInput(ImGuiIO& io, bool isViewportFocused, bool isViewportHovered, ImVec2 viewportTopLeft, ImVec2 viewportSize, PcbRenderer* pcbRenderer)
 {
+    // Tool switching: toggle between navigation and box selection
+    if (isViewportFocused && m_control_settings_) {
+        const KeyCombination toggle_key = m_control_settings_->GetKeybind(InputAction::kToggleBoxSelect);
+        if (toggle_key.IsBound() && ImGui::IsKeyPressed(toggle_key.key, false) && (!toggle_key.ctrl || io.KeyCtrl) && (!toggle_key.shift || io.KeyShift) &&
+            (!toggle_key.alt || io.KeyAlt)) {
+            const bool box_select_active = m_active_tool_ && m_active_tool_->GetName() == BoxSelectTool::kToolName;
+            SetActiveTool(box_select_active ? "Navigation" : BoxSelectTool::kToolName);
+        }
+    }
+
     if (m_active_tool_) {
         m_active_tool_->ProcessInput(io, isViewportFocused, isViewportHovered, viewportTopLeft, viewportSize);
     }
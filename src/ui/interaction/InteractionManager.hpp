@@ -11,6 +11,7 @@ class Camera;
 class Viewport;
 class InteractionTool;  // Base class
 class NavigationTool;   // Concrete tool
+class BoxSelectTool;    // Rubber-band selection tool
 // class InspectionTool;  // REMOVED
 class ControlSettings;
 class BoardDataManager;
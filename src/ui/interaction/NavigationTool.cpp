@@ -1,5 +1,6 @@
 #include "ui/interaction/NavigationTool.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "imgui.h"  // For ImGui:: functions
@@ -71,8 +72,7 @@ NavigationTool::NavigationTool(std::shared_ptr<Camera> camera,
       m_board_data_manager_(board_data_manager),
       m_is_hovering_element_(false),  // Initialize new members
       m_selected_net_id_(-1),
-      m_cache_valid_(false),  // Initialize cache as invalid
-      m_cached_board_side_(BoardDataManager::BoardSide::kBoth)
+      m_cache_valid_(false)  // Initialize cache as invalid
 {
     // Note: We don't register callbacks to avoid interfering with existing callbacks
     // from PcbRenderer and Application. Instead, we use a polling approach to detect changes.
@@ -93,7 +93,6 @@ void NavigationTool::ProcessInput(ImGuiIO& io, bool is_viewport_focused, bool is
     bool board_available = current_board && current_board->IsLoaded();
     // Reset hover state for this frame - moved up so it's always reset
     m_is_hovering_element_ = false;
-    m_hovered_element_info_ = "";
 
     if (is_viewport_hovered && board_available) {
         ImVec2 screenMousePos = io.MousePos;
@@ -110,93 +109,35 @@ void NavigationTool::ProcessInput(ImGuiIO& io, bool is_viewport_focused, bool is
             float pick_tolerance = 2.0f / camera->GetZoom();   // World units
             pick_tolerance = std::max(0.01f, pick_tolerance);  // Ensure minimum pick tolerance
 
-            // Get cached interactive elements (performance optimization)
-            const std::vector<ElementInteractionInfo>& interactive_elements = GetCachedInteractiveElements();
+            // Refresh the interaction cache (and its hit-test index) if the board state changed
+            GetCachedInteractiveElements();
 
-            // Check for hover
-            // Iterate in reverse to prioritize elements rendered on top (assuming later elements in vector are "on top")
-            // However, GetCachedInteractiveElements doesn't guarantee render order.
-            // OPTIMIZATION: Use spatial indexing for faster hit detection
-            // This replaces the expensive linear search that was identified as a bottleneck in VTune
+            // Performance optimization: Query the packed hit-test index instead of scanning every element with IsHit.
+            // The index keeps the interaction priority order, masks hidden layers and does not allocate per query.
+            HitTestIndex::Hit hover_hit;
             const Element* hit_element = nullptr;
-            const Component* hit_parent_component = nullptr;
-
-            // Try optimized spatial hit detection first
-            if (m_render_pipeline_ && m_render_pipeline_->IsInitialized()) {
-                hit_element = m_render_pipeline_->FindHitElementOptimized(transformedWorldMousePos, pick_tolerance, nullptr);
-
-                // If spatial index found an element, find its parent component from cache
-                if (hit_element) {
-                    for (const auto& item : interactive_elements) {
-                        if (item.element == hit_element) {
-                            hit_parent_component = item.parent_component;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            // Fallback to linear search if spatial index is not available or failed
-            if (!hit_element) {
-                for (const auto& item : interactive_elements) {
-                    if (!item.element) {
-                        continue;
-                    }
-                    if (item.element->IsHit(transformedWorldMousePos, pick_tolerance, item.parent_component)) {
-                        hit_element = item.element;
-                        hit_parent_component = item.parent_component;
-                        break;  // Found a hovered element
-                    }
-                }
+            if (m_hit_test_index_.FindBestHit(transformedWorldMousePos, pick_tolerance, hover_hit)) {
+                hit_element = hover_hit.element;
             }
 
-            // Update hover state
+            // Update hover state; tooltip text is only rebuilt when the hovered element changes
             if (hit_element) {
                 m_is_hovering_element_ = true;
-                m_hovered_element_info_ = hit_element->GetInfo(hit_parent_component, current_board.get());
+                if (hit_element != m_hovered_element_ || hover_hit.parent_component != m_hovered_parent_component_) {
+                    m_hovered_element_ = hit_element;
+                    m_hovered_parent_component_ = hover_hit.parent_component;
+                    m_hovered_element_info_ = hit_element->GetInfo(hover_hit.parent_component, current_board.get());
+                }
+            } else {
+                m_hovered_element_ = nullptr;
+                m_hovered_parent_component_ = nullptr;
             }
 
             // Handle Mouse Click for Selection (Left Click)
-            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && is_viewport_focused) {
-                int clicked_net_id = -1;
-                const Element* clicked_element = nullptr;
-
-                // OPTIMIZATION: Reuse hit detection result from hover if mouse hasn't moved significantly
-                static Vec2 last_mouse_pos = {-1000.0f, -1000.0f};
-                static const Element* last_hit_element = nullptr;
-
-                float mouse_move_distance = geometry_utils::FastDistance(transformedWorldMousePos, last_mouse_pos);
-
-                if (mouse_move_distance < pick_tolerance && last_hit_element == hit_element) {
-                    // Reuse previous hit detection result
-                    clicked_element = hit_element;
-                    if (clicked_element) {
-                        clicked_net_id = clicked_element->GetNetId();
-                    }
-                } else {
-                    // Perform fresh hit detection using optimized method
-                    if (m_render_pipeline_ && m_render_pipeline_->IsInitialized()) {
-                        clicked_element = m_render_pipeline_->FindHitElementOptimized(transformedWorldMousePos, pick_tolerance, nullptr);
-                    }
-
-                    // Fallback to linear search if needed
-                    if (!clicked_element) {
-                        for (const auto& item : interactive_elements) {
-                            if (item.element && item.element->IsHit(transformedWorldMousePos, pick_tolerance, item.parent_component)) {
-                                clicked_element = item.element;
-                                break;  // Found the first hit element (prioritize by render order)
-                            }
-                        }
-                    }
-
-                    if (clicked_element) {
-                        clicked_net_id = clicked_element->GetNetId();
-                    }
-
-                    // Update cache
-                    last_mouse_pos = transformedWorldMousePos;
-                    last_hit_element = clicked_element;
-                }
+            if (m_click_selection_enabled_ && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && is_viewport_focused) {
+                // The hover query above already ran at this exact position this frame
+                const Element* clicked_element = hit_element;
+                int clicked_net_id = clicked_element ? clicked_element->GetNetId() : -1;
 
                 // Always set the selected element (even if nullptr for empty space)
                 m_board_data_manager_->SetSelectedElement(clicked_element);
@@ -471,9 +412,10 @@ void NavigationTool::OnActivated()
     m_board_data_manager_->SetSelectedNetId(-1);
     m_is_hovering_element_ = false;
     m_hovered_element_info_ = "";
+    m_hovered_element_ = nullptr;
+    m_hovered_parent_component_ = nullptr;
 
-    // Invalidate cache when tool is activated to ensure fresh data
-    InvalidateElementCache();
+    // The element cache revalidates itself against the board on next access
 }
 
 void NavigationTool::OnDeactivated()
@@ -482,10 +424,12 @@ void NavigationTool::OnDeactivated()
     // Clear hover state when tool is deactivated
     m_is_hovering_element_ = false;
     m_hovered_element_info_ = "";
+    m_hovered_element_ = nullptr;
+    m_hovered_parent_component_ = nullptr;
     // Optionally keep m_selectedNetId or clear it based on desired behavior
 
-    // Clear cache when tool is deactivated to free memory
-    InvalidateElementCache();
+    // The element cache is kept: the box select tool keeps querying it while this tool is inactive,
+    // and switching tools must not cost a full index rebuild
 }
 
 int NavigationTool::GetSelectedNetId() const
@@ -512,9 +456,14 @@ void NavigationTool::ClearSelection()
 void NavigationTool::InvalidateElementCache() const
 {
     m_cache_valid_ = false;
-    m_cached_interactive_elements_.clear();
+    m_cached_interactive_elements_.reset();
+    m_cached_view_generation_ = 0;
     m_cached_layer_visibility_.clear();
     m_cached_board_.reset();
+    m_hit_test_index_.Clear();
+    m_parked_hit_test_indices_.clear();
+    m_hovered_element_ = nullptr;
+    m_hovered_parent_component_ = nullptr;
 }
 
 bool NavigationTool::HasCacheInvalidatingChanges() const
@@ -530,35 +479,15 @@ bool NavigationTool::HasCacheInvalidatingChanges() const
         return true;
     }
 
-    // Check if board side changed (second most common case)
-    if (m_board_data_manager_->GetCurrentViewSide() != m_cached_board_side_) {
+    // The board's shared interaction view changed (board side switched, interaction priorities changed): the
+    // ranks and groups of the packed index are stale. Layer toggles leave the full view's generation alone.
+    if (current_board && current_board->GetInteractionViewGeneration(true) != m_cached_view_generation_) {
         return true;
     }
 
-    // Only check layer visibility if we have a valid board and cached state
-    if (current_board && current_board->IsLoaded() && !m_cached_layer_visibility_.empty()) {
-        int layer_count = current_board->GetLayerCount();
-        if (m_cached_layer_visibility_.size() != static_cast<size_t>(layer_count)) {
-            return true;
-        }
-
-        // Quick check: only compare a few key layers first (optimization for large layer counts)
-        // Check layers 0, 1, 16, 28 (common important layers) before doing full scan
-        const std::vector<int> key_layers = {0, 1, 16, 28};
-        for (int layer_id : key_layers) {
-            if (layer_id < layer_count) {
-                if (m_board_data_manager_->IsLayerVisible(layer_id) != m_cached_layer_visibility_[layer_id]) {
-                    return true;
-                }
-            }
-        }
-
-        // If key layers match, do full scan (less frequent)
-        for (int i = 0; i < layer_count; ++i) {
-            if (m_board_data_manager_->IsLayerVisible(i) != m_cached_layer_visibility_[i]) {
-                return true;
-            }
-        }
+    // Layer visibility changes no longer invalidate the cache: the hit-test index masks hidden layer groups itself
+    if (current_board && current_board->IsLoaded() && current_board->GetLayerCount() != static_cast<int>(m_cached_layer_visibility_.size())) {
+        return true;
     }
 
     return false;
@@ -577,9 +506,13 @@ void NavigationTool::UpdateElementCache() const
         return;
     }
 
+    // Switching boards (a fold or flip publishes another geometry variant) keeps the current index for switching back
+    if (m_cached_board_ && m_cached_board_ != current_board && m_cached_interactive_elements_) {
+        ParkHitTestIndex();
+    }
+
     // Update cached state
     m_cached_board_ = current_board;
-    m_cached_board_side_ = m_board_data_manager_->GetCurrentViewSide();
 
     int layer_count = current_board->GetLayerCount();
     m_cached_layer_visibility_.resize(layer_count);
@@ -587,13 +520,80 @@ void NavigationTool::UpdateElementCache() const
         m_cached_layer_visibility_[i] = m_board_data_manager_->IsLayerVisible(i);
     }
 
-    // Get fresh elements from the board
-    m_cached_interactive_elements_ = current_board->GetAllVisibleElementsForInteraction();
+    // A full build when there is no index to reuse: another variant's elements are all new objects, and a side
+    // switch or priority change re-ranks the whole list, so there is nothing to re-insert incrementally.
+    if (!RestoreParkedHitTestIndex(current_board)) {
+        // Share the board's view, hidden layers included; visibility is applied by the index mask
+        Board::InteractionView view = current_board->GetInteractionView(true);
+        m_cached_interactive_elements_ = std::move(view.elements);
+        m_cached_view_generation_ = view.generation;
+        m_hit_test_index_.Build(*m_cached_interactive_elements_);
+    }
+    m_hit_test_index_.SyncLayerVisibility(*current_board);
     m_cache_valid_ = true;
 
+    // Element pointers may have been rebuilt; force the tooltip text to refresh
+    m_hovered_element_ = nullptr;
+    m_hovered_parent_component_ = nullptr;
+
     // Only log cache updates for large boards to avoid spam
-    if (m_cached_interactive_elements_.size() > 1000) {
-        std::cout << "NavigationTool: Element cache updated with " << m_cached_interactive_elements_.size() << " elements" << std::endl;
+    if (m_cached_interactive_elements_->size() > 1000) {
+        std::cout << "NavigationTool: Element cache updated with " << m_cached_interactive_elements_->size() << " elements" << std::endl;
+    }
+}
+
+void NavigationTool::ParkHitTestIndex() const
+{
+    ParkedHitTestIndex parked;
+    parked.board = m_cached_board_;
+    parked.view_generation = m_cached_view_generation_;
+    parked.elements = std::move(m_cached_interactive_elements_);
+    parked.index = std::move(m_hit_test_index_);
+    m_hit_test_index_ = HitTestIndex();
+    m_cached_interactive_elements_.reset();
+
+    // Boards that are gone can never be shown again
+    m_parked_hit_test_indices_.erase(std::remove_if(m_parked_hit_test_indices_.begin(), m_parked_hit_test_indices_.end(),
+                                                    [](const ParkedHitTestIndex& entry) { return entry.board.expired(); }),
+                                     m_parked_hit_test_indices_.end());
+    m_parked_hit_test_indices_.insert(m_parked_hit_test_indices_.begin(), std::move(parked));
+    if (m_parked_hit_test_indices_.size() > kMaxParkedHitTestIndices) {
+        m_parked_hit_test_indices_.resize(kMaxParkedHitTestIndices);
+    }
+}
+
+bool NavigationTool::RestoreParkedHitTestIndex(const std::shared_ptr<const Board>& board) const
+{
+    for (auto it = m_parked_hit_test_indices_.begin(); it != m_parked_hit_test_indices_.end(); ++it) {
+        if (it->board.lock() != board) {
+            continue;
+        }
+        // Usable only if the board's view was not re-ranked meanwhile (e.g. the interaction priorities changed)
+        const bool is_current = it->view_generation == board->GetInteractionViewGeneration(true);
+        if (is_current) {
+            m_cached_interactive_elements_ = std::move(it->elements);
+            m_cached_view_generation_ = it->view_generation;
+            m_hit_test_index_ = std::move(it->index);
+        }
+        m_parked_hit_test_indices_.erase(it);
+        return is_current;
+    }
+    return false;
+}
+
+void NavigationTool::SyncLayerVisibilityMask() const
+{
+    // Performance optimization: A layer toggle only flips group bits in the hit-test index (O(layers)), no rebuild
+    bool changed = false;
+    for (size_t i = 0; i < m_cached_layer_visibility_.size(); ++i) {
+        const bool visible = m_board_data_manager_->IsLayerVisible(static_cast<int>(i));
+        if (visible != m_cached_layer_visibility_[i]) {
+            m_cached_layer_visibility_[i] = visible;
+            changed = true;
+        }
+    }
+    if (changed && m_cached_board_) {
+        m_hit_test_index_.SyncLayerVisibility(*m_cached_board_);
     }
 }
 
@@ -602,7 +602,7 @@ const std::vector<ElementInteractionInfo>& NavigationTool::GetCachedInteractiveE
     // Check if cache needs to be invalidated due to changes
     if (m_cache_valid_ && HasCacheInvalidatingChanges()) {
         // Only log cache invalidation for large boards to avoid spam
-        if (m_cached_interactive_elements_.size() > 1000) {
+        if (m_cached_interactive_elements_ && m_cached_interactive_elements_->size() > 1000) {
             std::cout << "NavigationTool: Cache invalidated due to detected changes" << std::endl;
         }
         m_cache_valid_ = false;
@@ -610,35 +610,28 @@ const std::vector<ElementInteractionInfo>& NavigationTool::GetCachedInteractiveE
 
     if (!m_cache_valid_) {
         UpdateElementCache();
+    } else {
+        SyncLayerVisibilityMask();
     }
-    return m_cached_interactive_elements_;
+
+    static const std::vector<ElementInteractionInfo> kNoElements;
+    return m_cached_interactive_elements_ ? *m_cached_interactive_elements_ : kNoElements;
 }
 
-// Spatial hit detection with memory optimization
-const Element* NavigationTool::FindHitElementOptimized(const Vec2& world_pos, float tolerance) {
-    // Use cached results if available and valid
-    static Vec2 last_query_pos = {-1000.0f, -1000.0f};
-    static const Element* last_hit_result = nullptr;
-    static float last_tolerance = 0.0f;
-    
-    // Check if we can reuse previous result (within 1/4 tolerance distance)
-    float cache_distance = geometry_utils::FastDistanceSquared(world_pos, last_query_pos);
-    if (cache_distance < (tolerance * tolerance * 0.0625f) && tolerance == last_tolerance) {
-        return last_hit_result;
-    }
-    
-    const Element* hit_element = nullptr;
-    
-    // Try optimized spatial hit detection first
-    if (m_render_pipeline_ && m_render_pipeline_->IsInitialized()) {
-        // Use a prefetch hint for the spatial index data
-        hit_element = m_render_pipeline_->FindHitElementOptimized(world_pos, tolerance, nullptr);
+const HitTestIndex& NavigationTool::GetHitTestIndex() const
+{
+    GetCachedInteractiveElements();
+    return m_hit_test_index_;
+}
+
+// Spatial hit detection through the packed hit-test index
+const Element* NavigationTool::FindHitElementOptimized(const Vec2& world_pos, float tolerance)
+{
+    GetCachedInteractiveElements();
+
+    HitTestIndex::Hit hit;
+    if (m_hit_test_index_.FindBestHit(world_pos, tolerance, hit)) {
+        return hit.element;
     }
-    
-    // Cache the result for future queries
-    last_query_pos = world_pos;
-    last_hit_result = hit_element;
-    last_tolerance = tolerance;
-    
-    return hit_element;
+    return nullptr;
 }
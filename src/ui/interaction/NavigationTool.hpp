@@ -7,10 +7,10 @@
 
 #include "core/BoardDataManager.hpp"  // Need full declaration for BoardSide enum
 #include "pcb/Board.hpp"
+#include "pcb/HitTestIndex.hpp"
 #include "ui/interaction/InteractionTool.hpp"
 #include "utils/Vec2.hpp"
 #include "utils/GeometryUtils.hpp"  // For fast distance calculations
-#include "render/RenderPipeline.hpp"  // For optimized hit detection
 
 // Forward declarations
 class ControlSettings;
@@ -21,9 +21,6 @@ public:
     NavigationTool(std::shared_ptr<Camera> camera, std::shared_ptr<Viewport> viewport, std::shared_ptr<ControlSettings> control_settings, std::shared_ptr<BoardDataManager> board_data_manager);
     ~NavigationTool() override = default;
 
-    // Set render pipeline for optimized hit detection
-    void SetRenderPipeline(RenderPipeline* render_pipeline) { m_render_pipeline_ = render_pipeline; }
-
     void ProcessInput(ImGuiIO& io, bool is_viewport_focused, bool is_viewport_hovered, ImVec2 viewport_top_left, ImVec2 viewport_size) override;
 
     void OnActivated() override;
@@ -35,6 +32,11 @@ public:
     // Selection specific methods
     [[nodiscard]] int GetSelectedNetId() const;
     void ClearSelection();
+    // Left-click element selection; disabled while another tool (box select) owns the left button
+    void SetClickSelectionEnabled(bool enabled) { m_click_selection_enabled_ = enabled; }
+
+    // Hit-test index over the current board, refreshed if the board state changed. Shared with the box select tool.
+    const HitTestIndex& GetHitTestIndex() const;
 
     // Configuration for the tool, if any
     // void SetPanSpeed(float speed) { m_panSpeed = speed; }
@@ -43,29 +45,47 @@ public:
 private:
     std::shared_ptr<ControlSettings> m_control_settings_;
     std::shared_ptr<BoardDataManager> m_board_data_manager_;
-    RenderPipeline* m_render_pipeline_ = nullptr;  // For optimized hit detection
 
     // --- New members for hover and selection ---
     std::string m_hovered_element_info_;
+    mutable const Element* m_hovered_element_ = nullptr;  // Element m_hovered_element_info_ was built for
+    mutable const Component* m_hovered_parent_component_ = nullptr;
     bool m_is_hovering_element_ = false;
     int m_selected_net_id_ = -1;  // -1 indicates no net is selected
+    bool m_click_selection_enabled_ = true;
     // Potentially store more info about the selected element if needed
     // --- End new members ---
 
     // --- Performance optimization: Element caching system ---
-    mutable std::vector<ElementInteractionInfo> m_cached_interactive_elements_;
+    mutable std::shared_ptr<const std::vector<ElementInteractionInfo>> m_cached_interactive_elements_;  // Board's shared view
     mutable bool m_cache_valid_ = false;
+    mutable HitTestIndex m_hit_test_index_;  // Packed hit-test index over m_cached_interactive_elements_
 
     // Cache state tracking for invalidation detection
-    mutable BoardDataManager::BoardSide m_cached_board_side_ = BoardDataManager::BoardSide::kBoth;
+    mutable uint64_t m_cached_view_generation_ = 0;  // Board::GetInteractionViewGeneration(true) the index was built for
     mutable std::vector<bool> m_cached_layer_visibility_;
     mutable std::shared_ptr<const Board> m_cached_board_;
 
+    // Performance optimization: Hit-test index of the board shown before. Folding and flipping publish another
+    // geometry variant whose elements are all distinct objects; the loaded board stays alive while a variant is
+    // shown, so unfolding reuses its index. Variants are freed when no longer shown, so theirs expire with them.
+    static constexpr size_t kMaxParkedHitTestIndices = 1;
+    struct ParkedHitTestIndex {
+        std::weak_ptr<const Board> board;
+        uint64_t view_generation = 0;
+        std::shared_ptr<const std::vector<ElementInteractionInfo>> elements;
+        HitTestIndex index;
+    };
+    mutable std::vector<ParkedHitTestIndex> m_parked_hit_test_indices_;
+
     // Cache management methods
     void InvalidateElementCache() const;
     void UpdateElementCache() const;
     const std::vector<ElementInteractionInfo>& GetCachedInteractiveElements() const;
     bool HasCacheInvalidatingChanges() const;
+    void SyncLayerVisibilityMask() const;
+    void ParkHitTestIndex() const;  // Moves the current board's index to the front of m_parked_hit_test_indices_
+    bool RestoreParkedHitTestIndex(const std::shared_ptr<const Board>& board) const;
     // --- End caching system ---
 
     // TransformMousePositionForBoardFlip method removed - no longer needed
@@ -14,6 +14,7 @@
 #include "core/BoardDataManager.hpp"
 #include "core/ControlSettings.hpp"
 #include "pcb/Board.hpp"
+#include "render/BLPathCache.hpp"
 #include "render/PcbRenderer.hpp"
 #include "ui/interaction/InteractionManager.hpp"
 #include "view/Camera.hpp"
@@ -246,6 +247,7 @@ void PCBViewerWindow::RenderIntegrated(SDL_Renderer* sdl_renderer, PcbRenderer*
 
             // Render grid measurement overlay on top of the PCB image
             RenderGridMeasurementOverlay();
+            RenderMemoryOverlay(pcb_renderer);
 
             // Handle interaction after the image is drawn, so ImGui::IsItemHovered() refers to the image
             if (m_interaction_manager_ && (m_is_focused_ || m_is_hovered_)) {
@@ -361,3 +363,61 @@ void PCBViewerWindow::RenderGridMeasurementOverlay()
     // Draw white text on top
     draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), readout_text.c_str());
 }
+
+void PCBViewerWindow::RenderMemoryOverlay(const PcbRenderer* pcb_renderer)
+{
+    if (!m_show_memory_overlay_ || !m_board_data_manager_) {
+        return;
+    }
+    std::shared_ptr<const Board> board = m_board_data_manager_->GetBoard();
+    if (!board || !board->IsLoaded()) {
+        return;
+    }
+
+    const double now = ImGui::GetTime();
+    if (board.get() != m_memory_report_board_ || board->GetGeometryRevision() != m_memory_report_revision_ ||
+        m_memory_report_time_ < 0.0 || now - m_memory_report_time_ >= kMemoryReportRefreshSeconds) {
+        m_memory_report_ = board->GetMemoryReport();
+        m_memory_report_board_ = board.get();
+        m_memory_report_revision_ = board->GetGeometryRevision();
+        m_memory_report_time_ = now;
+    }
+
+    const BoardMemoryReport& report = m_memory_report_;
+    constexpr double kBytesPerMb = 1024.0 * 1024.0;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "Board memory: " << report.GetTotalBytes() / kBytesPerMb << " MB\n";
+    ss << "Elements " << report.GetElementBytes() / kBytesPerMb << " | Strings " << report.GetStringBytes() / kBytesPerMb << " | Vectors "
+       << report.GetVectorBytes() / kBytesPerMb << " | Caches " << report.GetCacheBytes() / kBytesPerMb << " MB";
+    for (size_t i = 0; i < BoardMemoryReport::kElementTypeCount; ++i) {
+        const BoardMemoryReport::TypeUsage& usage = report.element_types[i];
+        if (usage.count > 0) {
+            ss << "\n" << BoardMemoryReport::ElementTypeToString(static_cast<ElementType>(i)) << ": " << usage.count << " ("
+               << usage.GetTotalBytes() / kBytesPerMb << " MB)";
+        }
+    }
+    // Renderer-wide, as of the last finished frame: the cache itself belongs to the render thread
+    if (pcb_renderer) {
+        const path_cache::BLPathCache::CacheStats path_stats = pcb_renderer->GetPathCacheStats();
+        ss << "\nPath cache: " << path_stats.total_entries << " paths, " << path_stats.total_bytes / kBytesPerMb << "/" << path_stats.byte_budget / kBytesPerMb
+           << " MB, hit " << path_stats.hit_ratio * 100.0 << "%, " << path_stats.evictions << " evicted";
+    }
+    std::string overlay_text = ss.str();
+
+    // Same look as the grid measurement readout, anchored to the top-left corner of the content area
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    ImVec2 text_size = ImGui::CalcTextSize(overlay_text.c_str());
+    const float kPadding = 8.0f;
+    const float kRounding = 4.0f;
+    const float kMargin = 10.0f;
+
+    ImVec2 window_pos = ImGui::GetWindowPos();
+    ImVec2 content_min = ImGui::GetWindowContentRegionMin();
+    ImVec2 text_pos = ImVec2(window_pos.x + content_min.x + kMargin + kPadding, window_pos.y + content_min.y + kMargin + kPadding);
+
+    ImVec2 bg_min = ImVec2(text_pos.x - kPadding, text_pos.y - kPadding);
+    ImVec2 bg_max = ImVec2(text_pos.x + text_size.x + kPadding, text_pos.y + text_size.y + kPadding);
+    draw_list->AddRectFilled(bg_min, bg_max, IM_COL32(0, 0, 0, 192), kRounding);
+    draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), overlay_text.c_str());
+}
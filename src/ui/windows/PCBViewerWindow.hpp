@@ -8,6 +8,7 @@
 
 #include "core/BoardDataManager.hpp"
 #include "core/ControlSettings.hpp"
+#include "pcb/BoardMemoryReport.hpp"
 // #include <blend2d.h> // Included in .cpp, forward declare if only types used here
 
 // Forward declarations
@@ -51,6 +52,7 @@ public:
     [[nodiscard]] bool IsWindowHovered() const { return m_is_hovered_; }
     [[nodiscard]] bool IsWindowVisible() const { return m_is_open_; }
     void SetVisible(bool visible) { m_is_open_ = visible; }
+    void SetMemoryOverlayVisible(bool visible) { m_show_memory_overlay_ = visible; }
 
 private:
     // This method will handle getting data from PcbRenderer and updating m_renderTexture
@@ -59,6 +61,9 @@ private:
     // Render grid measurement overlay within the PCB viewer window
     void RenderGridMeasurementOverlay();
 
+    // Render the board memory report in the top-left corner of the viewer
+    void RenderMemoryOverlay(const PcbRenderer* pcb_renderer);
+
     std::string m_window_name_ = "PCB Viewer";
     std::shared_ptr<Camera> m_camera_;
     std::shared_ptr<Viewport> m_viewport_;  // This viewport will be updated by the ImGui window size
@@ -77,6 +82,15 @@ private:
     bool m_is_hovered_ = false;
     bool m_is_content_region_hovered_ = false;  // Specifically if mouse is over the texture/render area
 
+    // Memory overlay: the report walks every element, so it is only taken again when the board or its geometry
+    // changes, or after kMemoryReportRefreshSeconds (caches grow without a geometry change)
+    bool m_show_memory_overlay_ = false;
+    BoardMemoryReport m_memory_report_;
+    const Board* m_memory_report_board_ = nullptr;
+    uint64_t m_memory_report_revision_ = 0;
+    double m_memory_report_time_ = -1.0;
+    static constexpr double kMemoryReportRefreshSeconds = 2.0;
+
     ImVec2 m_content_region_top_left_screen_;  // Renamed for clarity (screen coordinates)
     ImVec2 m_content_region_size_;             // Size of the renderable content area
 
@@ -1,12 +1,18 @@
 #include "PcbDetailsWindow.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <cstddef>
 #include <memory>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
 #include "imgui.h"
 
+#include "core/BoardDataManager.hpp"
 #include "pcb/Board.hpp"
 #include "pcb/elements/Arc.hpp"
 #include "pcb/elements/Component.hpp"
@@ -15,15 +21,118 @@
 #include "pcb/elements/Trace.hpp"
 #include "pcb/elements/Via.hpp"
 
+namespace
+{
+// Column user IDs, shared by all detail tables so the sort code can switch on them
+enum DetailsColumnId : ImGuiID { kColumnName, kColumnId, kColumnValue, kColumnFootprint, kColumnLayer, kColumnCount, kColumnNet, kColumnX, kColumnY };
+
+constexpr ImGuiTableFlags kTableFlags =
+    ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable;
+constexpr float kTableVisibleRows = 12.0f;
+
+ImVec2 TableOuterSize()
+{
+    return ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * kTableVisibleRows);
+}
+
+std::string ToLower(std::string_view text)
+{
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+// Orders embedded numbers by value so "R2" sorts before "R10"
+bool NaturalLess(const std::string& a, const std::string& b)
+{
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (std::isdigit(static_cast<unsigned char>(a[i])) && std::isdigit(static_cast<unsigned char>(b[j]))) {
+            const size_t a_start = i;
+            const size_t b_start = j;
+            while (i < a.size() && std::isdigit(static_cast<unsigned char>(a[i])))
+                ++i;
+            while (j < b.size() && std::isdigit(static_cast<unsigned char>(b[j])))
+                ++j;
+            // Compare digit runs by length first (ignoring leading zeros), then lexically
+            const std::string_view a_num = std::string_view(a).substr(a_start, i - a_start);
+            const std::string_view b_num = std::string_view(b).substr(b_start, j - b_start);
+            const std::string_view a_trim = a_num.substr(std::min(a_num.find_first_not_of('0'), a_num.size()));
+            const std::string_view b_trim = b_num.substr(std::min(b_num.find_first_not_of('0'), b_num.size()));
+            if (a_trim.size() != b_trim.size()) {
+                return a_trim.size() < b_trim.size();
+            }
+            if (a_trim != b_trim) {
+                return a_trim < b_trim;
+            }
+            continue;
+        }
+        const int ca = std::tolower(static_cast<unsigned char>(a[i]));
+        const int cb = std::tolower(static_cast<unsigned char>(b[j]));
+        if (ca != cb) {
+            return ca < cb;
+        }
+        ++i;
+        ++j;
+    }
+    return (a.size() - i) < (b.size() - j);
+}
+
+// Stores each row's position in the order defined by less, so later sorts compare integers only
+template <typename Row, typename Less>
+void AssignRanks(std::vector<Row>& rows, uint32_t Row::*rank_member, Less less)
+{
+    std::vector<uint32_t> order(rows.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return less(rows[a], rows[b]); });
+    for (size_t i = 0; i < order.size(); ++i) {
+        rows[order[i]].*rank_member = static_cast<uint32_t>(i);
+    }
+}
+
+struct SortRequest {
+    ImGuiID column;
+    bool descending;
+};
+
+SortRequest GetSortRequest(const ImGuiTableSortSpecs* sort_specs, ImGuiID default_column)
+{
+    if (sort_specs == nullptr || sort_specs->SpecsCount == 0) {
+        return SortRequest {default_column, false};
+    }
+    return SortRequest {sort_specs->Specs[0].ColumnUserID, sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending};
+}
+
+// Sorts a view by a precomputed key; ties fall back to the row index so the order is deterministic
+template <typename KeyFn>
+void SortView(std::vector<uint32_t>& view, bool descending, KeyFn key)
+{
+    std::sort(view.begin(), view.end(), [&](uint32_t a, uint32_t b) {
+        const auto key_a = key(a);
+        const auto key_b = key(b);
+        if (key_a != key_b) {
+            return descending ? key_b < key_a : key_a < key_b;
+        }
+        return a < b;
+    });
+}
+}  // namespace
+
 // Constructor
 PcbDetailsWindow::PcbDetailsWindow() : current_board_(nullptr) {}
 
 // Added methods
-void PcbDetailsWindow::SetBoard(std::shared_ptr<Board> board)
+void PcbDetailsWindow::SetBoard(std::shared_ptr<const Board> board)
 {
     current_board_ = board;
 }
 
+void PcbDetailsWindow::SetBoardDataManager(std::shared_ptr<BoardDataManager> board_data_manager)
+{
+    board_data_manager_ = board_data_manager;
+}
+
 void PcbDetailsWindow::SetVisible(bool visible)
 {
     is_visible_ = visible;
@@ -36,6 +145,13 @@ bool PcbDetailsWindow::IsWindowVisible() const
 
 void PcbDetailsWindow::Render()
 {
+    // Follow the published board, e.g. the folded variant after folding was toggled
+    if (board_data_manager_) {
+        std::shared_ptr<const Board> published_board = board_data_manager_->GetBoard();
+        if (published_board) {
+            current_board_ = std::move(published_board);
+        }
+    }
     if (!is_visible_ || !current_board_) {
         return;
     }
@@ -44,11 +160,15 @@ void PcbDetailsWindow::Render()
     window_open = ImGui::Begin("PCB Details", &is_visible_);
 
     if (window_open) {
+        UpdateRowTables(current_board_.get());
         DisplayBasicInfo(current_board_.get());
+        DisplayBoxSelection(current_board_.get());
         DisplayLayers(current_board_.get());
-        DisplayNets(current_board_.get());
-        DisplayComponents(current_board_.get());
-        DisplayStandaloneElements(current_board_.get());
+        DisplayFilter();
+        DisplayNets();
+        DisplayComponents();
+        DisplayStandaloneElements();
+        DisplayDetails(current_board_.get());
     }
 
     ImGui::End();  // Always call End() to match Begin()
@@ -64,19 +184,10 @@ void PcbDetailsWindow::DisplayBasicInfo(const Board* board_data)
 
 void PcbDetailsWindow::DisplayLayers(const Board* board_data)
 {
-    for (const auto& layer : board_data->layers) {
-        ImGui::Text("ID: %d, Name: %s, Type: %d, Visible: %s", layer.id, layer.name.c_str(), static_cast<int>(layer.type), layer.is_visible ? "Yes" : "No");
-    }
-}
-
-void PcbDetailsWindow::DisplayNets(const Board* board_data)
-{
-    if (ImGui::TreeNodeEx("Nets", ImGuiTreeNodeFlags_DefaultOpen)) {
-        for (const auto& pair : board_data->m_nets) {
-            const Net& net = pair.second;
-            ImGui::Text("ID: %d, Name: %s", net.GetId(), net.GetName().c_str());
-        }
-        ImGui::TreePop();
+    for (size_t i = 0; i < board_data->layers.size(); ++i) {
+        const LayerInfo& layer = board_data->layers[i];
+        const bool visible = board_data_manager_ ? board_data_manager_->IsLayerVisible(static_cast<int>(i)) : layer.is_visible;
+        ImGui::Text("ID: %d, Name: %s, Type: %d, Visible: %s", layer.id, layer.name.c_str(), static_cast<int>(layer.type), visible ? "Yes" : "No");
     }
 }
 
@@ -115,7 +226,7 @@ void PcbDetailsWindow::DisplayPins(const Board* board_data, const std::vector<st
             }
         }
 
-        if (ImGui::TreeNodeEx(("Pin: " + pin.pin_name + " (" + net_info_str + ")").c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::TreeNodeEx(("Pin: " + pin.pin_name.str() + " (" + net_info_str + ")").c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
             ImGui::Text("Coords: (%.2f, %.2f), Layer: %d, Side: %d", pin.coords.x_ax, pin.coords.y_ax, pin.GetLayerId(), pin.side);
             DisplayPadShape(pin.pad_shape);
             if (!pin.diode_reading.empty()) {
@@ -138,205 +249,628 @@ void PcbDetailsWindow::DisplayGraphicalElements(const std::vector<LineSegment>&
     }
 }
 
-void PcbDetailsWindow::DisplayComponents(const Board* board_data)
-{
-    if (ImGui::TreeNodeEx("Components", ImGuiTreeNodeFlags_DefaultOpen)) {
-        std::vector<int> comp_layers = {Board::kTopCompLayer, Board::kBottomCompLayer};
-        for (int layer_id : comp_layers) {
-            auto comp_layer_it = board_data->m_elements_by_layer.find(layer_id);
-            if (comp_layer_it != board_data->m_elements_by_layer.end()) {
-                for (const auto& element_ptr : comp_layer_it->second) {
-                    if (!element_ptr)
-                        continue;
-                    const Component* comp = dynamic_cast<const Component*>(element_ptr.get());
-                    if (!comp)
-                        continue;
-
-                std::string compNodeName = comp->reference_designator + " (" + comp->value + ") - " + comp->footprint_name;
-                if (ImGui::TreeNode(compNodeName.c_str())) {
-                    ImGui::Text("Pos: (%.2f, %.2f), Layer: %d, Rot: %.1f deg", comp->center_x, comp->center_y, comp->layer, comp->rotation);
-                    ImGui::Text("Type: %d, Side: %d", static_cast<int>(comp->type), static_cast<int>(comp->side));
-
-                    if (ImGui::TreeNodeEx("Pins", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
-                        DisplayPins(board_data, comp->pins);
-                        ImGui::TreePop();
-                    }
-                    if (ImGui::TreeNodeEx("Labels", ImGuiTreeNodeFlags_Framed)) {
-                        for (const auto& lbl_ptr : comp->text_labels) {
-                            if (!lbl_ptr)
-                                continue;
-                            const TextLabel& lbl = *lbl_ptr;
-                            ImGui::Text("L%d (%.1f,%.1f) S%.1f: %s", lbl.GetLayerId(), lbl.coords.x_ax, lbl.coords.y_ax, lbl.font_size, lbl.text_content.c_str());
-                        }
-                        ImGui::TreePop();
-                    }
-                    if (ImGui::TreeNodeEx("Graphical Elements", ImGuiTreeNodeFlags_Framed)) {
-                        DisplayGraphicalElements(comp->graphical_elements);
-                        ImGui::TreePop();
-                    }
-                    ImGui::TreePop();
+void PcbDetailsWindow::DisplayFilter()
+{
+    ImGui::SetNextItemWidth(-1.0f);
+    if (ImGui::InputTextWithHint("##DetailsFilter", "Filter nets, components (ref/value/footprint) and elements (net name)", filter_text_, IM_ARRAYSIZE(filter_text_))) {
+        ApplyFilter();
+    }
+}
+
+void PcbDetailsWindow::DisplayNets()
+{
+    const std::string header = "Nets (" + std::to_string(net_view_.size()) + "/" + std::to_string(net_rows_.size()) + ")###Nets";
+    if (!ImGui::TreeNodeEx(header.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+    if (ImGui::BeginTable("##NetsTable", 3, kTableFlags, TableOuterSize())) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_DefaultSort, 0.0f, kColumnName);
+        ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_None, 0.0f, kColumnId);
+        ImGui::TableSetupColumn("Elements", ImGuiTableColumnFlags_None, 0.0f, kColumnCount);
+        ImGui::TableHeadersRow();
+
+        ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (net_view_dirty_ || (sort_specs && sort_specs->SpecsDirty)) {
+            RebuildNetView(sort_specs);
+            if (sort_specs) {
+                sort_specs->SpecsDirty = false;
+            }
+        }
+
+        const int selected_net_id = board_data_manager_ ? board_data_manager_->GetSelectedNetId() : -1;
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(net_view_.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const uint32_t net_rank = net_view_[static_cast<size_t>(row)];
+                const NetRow& net_row = net_rows_[net_rank];
+                const int net_id = net_row.net->GetId();
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(static_cast<int>(net_rank));
+                if (ImGui::Selectable(GetNetLabel(net_rank), net_id == selected_net_id, ImGuiSelectableFlags_SpanAllColumns) && board_data_manager_) {
+                    board_data_manager_->SetSelectedNetId(net_id);
                 }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", net_id);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", net_row.element_count);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TreePop();
+}
+
+void PcbDetailsWindow::DisplayComponents()
+{
+    const std::string header = "Components (" + std::to_string(component_view_.size()) + "/" + std::to_string(component_rows_.size()) + ")###Components";
+    if (!ImGui::TreeNodeEx(header.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+    if (ImGui::BeginTable("##ComponentsTable", 5, kTableFlags, TableOuterSize())) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Ref", ImGuiTableColumnFlags_DefaultSort, 0.0f, kColumnName);
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_None, 0.0f, kColumnValue);
+        ImGui::TableSetupColumn("Footprint", ImGuiTableColumnFlags_None, 0.0f, kColumnFootprint);
+        ImGui::TableSetupColumn("Layer", ImGuiTableColumnFlags_None, 0.0f, kColumnLayer);
+        ImGui::TableSetupColumn("Pins", ImGuiTableColumnFlags_None, 0.0f, kColumnCount);
+        ImGui::TableHeadersRow();
+
+        ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (component_view_dirty_ || (sort_specs && sort_specs->SpecsDirty)) {
+            RebuildComponentView(sort_specs);
+            if (sort_specs) {
+                sort_specs->SpecsDirty = false;
+            }
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(component_view_.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const uint32_t row_index = component_view_[static_cast<size_t>(row)];
+                const Component* comp = component_rows_[row_index].component;
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(static_cast<int>(row_index));
+                if (ImGui::Selectable(comp->reference_designator.c_str(), details_element_ == comp, ImGuiSelectableFlags_SpanAllColumns)) {
+                    details_element_ = comp;
                 }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(comp->value.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(comp->footprint_name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", comp->layer);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", comp->pins.size());
             }
         }
+        ImGui::EndTable();
+    }
+    ImGui::TreePop();
+}
+
+void PcbDetailsWindow::DisplayStandaloneElements()
+{
+    if (ImGui::TreeNodeEx("Standalone Elements", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (ElementTable& table : element_tables_) {
+            DisplayElementTable(table);
+        }
         ImGui::TreePop();
     }
 }
 
-void PcbDetailsWindow::DisplayStandaloneElements(const Board* board_data)
+void PcbDetailsWindow::DisplayElementTable(ElementTable& table)
+{
+    const std::string header = std::string(table.title) + " (" + std::to_string(table.view_dirty ? table.rows.size() : table.view.size()) + "/" +
+                               std::to_string(table.rows.size()) + ")###" + table.title;
+    if (!ImGui::TreeNodeEx(header.c_str())) {
+        return;
+    }
+    if (ImGui::BeginTable(table.title, 4, kTableFlags, TableOuterSize())) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Net", ImGuiTableColumnFlags_None, 0.0f, kColumnNet);
+        ImGui::TableSetupColumn("Layer", ImGuiTableColumnFlags_DefaultSort, 0.0f, kColumnLayer);
+        ImGui::TableSetupColumn("X", ImGuiTableColumnFlags_None, 0.0f, kColumnX);
+        ImGui::TableSetupColumn("Y", ImGuiTableColumnFlags_None, 0.0f, kColumnY);
+        ImGui::TableHeadersRow();
+
+        ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (table.view_dirty || (sort_specs && sort_specs->SpecsDirty)) {
+            RebuildElementView(table, sort_specs);
+            if (sort_specs) {
+                sort_specs->SpecsDirty = false;
+            }
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(table.view.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const uint32_t row_index = table.view[static_cast<size_t>(row)];
+                const ElementRow& element_row = table.rows[row_index];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(static_cast<int>(row_index));
+                if (ImGui::Selectable(GetNetLabel(element_row.net_rank), details_element_ == element_row.element, ImGuiSelectableFlags_SpanAllColumns)) {
+                    details_element_ = element_row.element;
+                }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", element_row.layer_id);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", element_row.x);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", element_row.y);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TreePop();
+}
+
+void PcbDetailsWindow::DisplayDetails(const Board* board_data)
 {
-    if (board_data == nullptr) {
+    if (details_element_ == nullptr) {
         return;
     }
+    if (ImGui::TreeNodeEx("Details", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::SmallButton("Close")) {
+            details_element_ = nullptr;
+        } else if (details_element_->GetElementType() == ElementType::kComponent) {
+            DisplayComponentDetails(board_data, static_cast<const Component*>(details_element_));
+        } else {
+            DisplayElementDetails(board_data, details_element_);
+        }
+        ImGui::TreePop();
+    }
+}
 
-    std::vector<ElementInteractionInfo> all_elements = board_data->GetAllVisibleElementsForInteraction();
+void PcbDetailsWindow::DisplayComponentDetails(const Board* board_data, const Component* comp)
+{
+    ImGui::Text("%s (%s) - %s", comp->reference_designator.c_str(), comp->value.c_str(), comp->footprint_name.c_str());
+    ImGui::Text("Pos: (%.2f, %.2f), Layer: %d, Rot: %.1f deg", comp->center_x, comp->center_y, comp->layer, comp->rotation);
+    ImGui::Text("Type: %d, Side: %d", static_cast<int>(comp->type), static_cast<int>(comp->side));
 
-    if (ImGui::TreeNodeEx("Standalone Elements", ImGuiTreeNodeFlags_DefaultOpen)) {
-        int arc_count = 0;
-        int via_count = 0;
-        int trace_count = 0;
-        int label_count = 0;
-        for (const auto& info : all_elements) {
-            if (info.parent_component)
-                continue;  // Skip elements belonging to a component
-            if (!info.element)
+    if (ImGui::TreeNodeEx("Pins", ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed)) {
+        DisplayPins(board_data, comp->pins);
+        ImGui::TreePop();
+    }
+    if (ImGui::TreeNodeEx("Labels", ImGuiTreeNodeFlags_Framed)) {
+        for (const auto& lbl_ptr : comp->text_labels) {
+            if (!lbl_ptr)
                 continue;
+            const TextLabel& lbl = *lbl_ptr;
+            ImGui::Text("L%d (%.1f,%.1f) S%.1f: %s", lbl.GetLayerId(), lbl.coords.x_ax, lbl.coords.y_ax, lbl.font_size, lbl.text_content.c_str());
+        }
+        ImGui::TreePop();
+    }
+    if (ImGui::TreeNodeEx("Graphical Elements", ImGuiTreeNodeFlags_Framed)) {
+        DisplayGraphicalElements(comp->graphical_elements);
+        ImGui::TreePop();
+    }
+}
+
+void PcbDetailsWindow::DisplayElementDetails(const Board* board_data, const Element* element)
+{
+    std::string net_info_str = "No Net";
+    if (element->GetNetId() != -1) {
+        const Net* net = board_data->GetNetById(element->GetNetId());
+        if (net)
+            net_info_str = "Net: " + (net->GetName().empty() ? "[Unnamed]" : net->GetName()) + " (ID: " + std::to_string(element->GetNetId()) + ")";
+        else
+            net_info_str = "Net ID: " + std::to_string(element->GetNetId()) + " [Not Found]";
+    }
 
-            switch (info.element->GetElementType()) {
-                case ElementType::kArc:
-                    arc_count++;
-                    break;
-                case ElementType::kVia:
-                    via_count++;
-                    break;
-                case ElementType::kTrace:
-                    trace_count++;
-                    break;
-                case ElementType::kTextLabel:
-                    label_count++;
-                    break;
-                default:
-                    break;
+    // Row tables only hold the types below, so the element type identifies the concrete class
+    switch (element->GetElementType()) {
+        case ElementType::kArc: {
+            const auto* arc = static_cast<const Arc*>(element);
+            ImGui::Text("Arc (%s)", net_info_str.c_str());
+            ImGui::Text("Layer: %d", arc->GetLayerId());
+            ImGui::Text("Center: (%.2f, %.2f), Radius: %.2f", arc->GetCenterX(), arc->GetCenterY(), arc->GetRadius());
+            ImGui::Text("Angles: Start %.1f°, End %.1f°", arc->GetStartAngle(), arc->GetEndAngle());
+            ImGui::Text("Thickness: %.2f", arc->GetThickness());
+            break;
+        }
+        case ElementType::kVia: {
+            const auto* via = static_cast<const Via*>(element);
+            ImGui::Text("Via (%s)", net_info_str.c_str());
+            ImGui::Text("Coords: (%.2f, %.2f)", via->GetX(), via->GetY());
+            ImGui::Text("Layers: %d to %d (Primary: %d)", via->GetLayerFrom(), via->GetLayerTo(), via->GetLayerId());
+            ImGui::Text("Drill Diameter: %.2f", via->GetDrillDiameter());
+            ImGui::Text("Pad Radius (From): %.2f, Pad Radius (To): %.2f", via->GetPadRadiusFrom(), via->GetPadRadiusTo());
+            if (!via->GetOptionalText().empty()) {
+                ImGui::Text("Text: %s", via->GetOptionalText().c_str());
             }
+            break;
+        }
+        case ElementType::kTrace: {
+            const auto* trace = static_cast<const Trace*>(element);
+            ImGui::Text("Trace (%s)", net_info_str.c_str());
+            ImGui::Text("Layer: %d", trace->GetLayerId());
+            ImGui::Text("Start: (%.2f, %.2f), End: (%.2f, %.2f)", trace->GetStartX(), trace->GetStartY(), trace->GetEndX(), trace->GetEndY());
+            ImGui::Text("Width: %.2f", trace->GetWidth());
+            break;
         }
+        case ElementType::kTextLabel: {
+            const auto* lbl = static_cast<const TextLabel*>(element);
+            ImGui::Text("Label (%s)", net_info_str.c_str());
+            ImGui::Text("Layer: %d", lbl->GetLayerId());
+            ImGui::Text("Position: (%.2f, %.2f)", lbl->coords.x_ax, lbl->coords.y_ax);
+            ImGui::Text("Font Size: %.2f, Scale: %.2f, Rotation: %.1f°", lbl->font_size, lbl->scale, lbl->rotation);
+            ImGui::Text("Family: %s", lbl->font_family.empty() ? "[Default]" : lbl->font_family.c_str());
+            ImGui::TextWrapped("Content: %s", lbl->text_content.c_str());
+            break;
+        }
+        default:
+            ImGui::TextUnformatted(element->GetInfo(nullptr, board_data).c_str());
+            break;
+    }
+}
 
-        if (ImGui::TreeNodeEx(("Arcs (" + std::to_string(arc_count) + ")").c_str())) {
-            for (const auto& info : all_elements) {
-                if (info.parent_component || !info.element || info.element->GetElementType() != ElementType::kArc)
-                    continue;
-                const Arc* arc = dynamic_cast<const Arc*>(info.element);
-                if (!arc)
-                    continue;
-
-                std::string net_info_str = "Net ID: " + std::to_string(arc->GetNetId());
-                const Net* net = board_data->GetNetById(arc->GetNetId());
-                if (net)
-                    net_info_str = "Net: " + (net->GetName().empty() ? "[Unnamed]" : net->GetName()) + " (ID: " + std::to_string(arc->GetNetId()) + ")";
-                else if (arc->GetNetId() != -1)
-                    net_info_str = "Net ID: " + std::to_string(arc->GetNetId()) + " [Not Found]";
-                else
-                    net_info_str = "No Net";
-
-                if (ImGui::TreeNodeEx(("Arc##" + std::to_string(reinterpret_cast<uintptr_t>(arc)) + " (" + net_info_str + ")").c_str())) {
-                    ImGui::Text("Layer: %d", arc->GetLayerId());
-                    ImGui::Text("Center: (%.2f, %.2f), Radius: %.2f", arc->GetCenterX(), arc->GetCenterY(), arc->GetRadius());
-                    ImGui::Text("Angles: Start %.1f°, End %.1f°", arc->GetStartAngle(), arc->GetEndAngle());
-                    ImGui::Text("Thickness: %.2f", arc->GetThickness());
-                    ImGui::TreePop();
-                }
+void PcbDetailsWindow::UpdateRowTables(const Board* board_data)
+{
+    // O(layers) per frame; the expensive rebuild only runs when the board's visible interaction view changed
+    // (another board, layer visibility, view side or moved geometry)
+    if (board_data != tables_board_ || board_data->GetInteractionViewGeneration(false) != tables_view_generation_) {
+        RebuildRowTables(board_data);
+    }
+}
+
+void PcbDetailsWindow::RebuildRowTables(const Board* board_data)
+{
+    if (board_data != tables_board_) {
+        details_element_ = nullptr;
+    }
+    tables_board_ = board_data;
+    const Board::InteractionView view = board_data->GetInteractionView(false);
+    tables_view_generation_ = view.generation;
+
+    // Nets sorted by name; the position in net_rows_ is the net sort key used by every table
+    net_rows_.clear();
+    net_rows_.reserve(board_data->m_nets.size());
+    for (const auto& [net_id, net] : board_data->m_nets) {
+        net_rows_.push_back(NetRow {&net, ToLower(net.GetName()), 0});
+    }
+    std::sort(net_rows_.begin(), net_rows_.end(), [](const NetRow& a, const NetRow& b) {
+        if (a.search_key != b.search_key) {
+            return a.search_key < b.search_key;
+        }
+        return a.net->GetId() < b.net->GetId();
+    });
+    std::unordered_map<int, uint32_t> net_rank_by_id;
+    net_rank_by_id.reserve(net_rows_.size());
+    for (size_t i = 0; i < net_rows_.size(); ++i) {
+        net_rank_by_id.emplace(net_rows_[i].net->GetId(), static_cast<uint32_t>(i));
+    }
+    const auto no_net_rank = static_cast<uint32_t>(net_rows_.size());
+    auto net_rank_of = [&](int net_id) {
+        const auto it = net_rank_by_id.find(net_id);
+        return it == net_rank_by_id.end() ? no_net_rank : it->second;
+    };
+
+    // Standalone elements on visible layers, one table per type
+    element_tables_[kTraceTable].title = "Traces";
+    element_tables_[kViaTable].title = "Vias";
+    element_tables_[kArcTable].title = "Arcs";
+    element_tables_[kLabelTable].title = "Text Labels";
+    for (ElementTable& table : element_tables_) {
+        table.rows.clear();
+        table.view.clear();
+        table.view_dirty = true;
+    }
+    for (const ElementInteractionInfo& info : *view.elements) {
+        if (!info.element) {
+            continue;
+        }
+        const uint32_t net_rank = net_rank_of(info.element->GetNetId());
+        if (info.parent_component) {
+            if (info.element->GetElementType() == ElementType::kPin && net_rank != no_net_rank) {
+                net_rows_[net_rank].element_count++;
             }
-            ImGui::TreePop();
+            continue;
         }
 
-        if (ImGui::TreeNodeEx(("Vias (" + std::to_string(via_count) + ")").c_str())) {
-            for (const auto& info : all_elements) {
-                if (info.parent_component || !info.element || info.element->GetElementType() != ElementType::kVia)
-                    continue;
-                const Via* via = dynamic_cast<const Via*>(info.element);
-                if (!via)
-                    continue;
-
-                std::string net_info_str = "Net ID: " + std::to_string(via->GetNetId());
-                const Net* net = board_data->GetNetById(via->GetNetId());
-                if (net)
-                    net_info_str = "Net: " + (net->GetName().empty() ? "[Unnamed]" : net->GetName()) + " (ID: " + std::to_string(via->GetNetId()) + ")";
-                else if (via->GetNetId() != -1)
-                    net_info_str = "Net ID: " + std::to_string(via->GetNetId()) + " [Not Found]";
-                else
-                    net_info_str = "No Net";
-
-                if (ImGui::TreeNodeEx(("Via##" + std::to_string(reinterpret_cast<uintptr_t>(via)) + " (" + net_info_str + ")").c_str())) {
-                    ImGui::Text("Coords: (%.2f, %.2f)", via->GetX(), via->GetY());
-                    ImGui::Text("Layers: %d to %d (Primary: %d)", via->GetLayerFrom(), via->GetLayerTo(), via->GetLayerId());
-                    ImGui::Text("Drill Diameter: %.2f", via->GetDrillDiameter());
-                    ImGui::Text("Pad Radius (From): %.2f, Pad Radius (To): %.2f", via->GetPadRadiusFrom(), via->GetPadRadiusTo());
-                    if (!via->GetOptionalText().empty()) {
-                        ImGui::Text("Text: %s", via->GetOptionalText().c_str());
-                    }
-                    ImGui::TreePop();
-                }
+        size_t table_index = kElementTableCount;
+        switch (info.element->GetElementType()) {
+            case ElementType::kTrace:
+                table_index = kTraceTable;
+                break;
+            case ElementType::kVia:
+                table_index = kViaTable;
+                break;
+            case ElementType::kArc:
+                table_index = kArcTable;
+                break;
+            case ElementType::kTextLabel:
+                table_index = kLabelTable;
+                break;
+            default:
+                break;
+        }
+        if (table_index == kElementTableCount) {
+            continue;
+        }
+        if (net_rank != no_net_rank) {
+            net_rows_[net_rank].element_count++;
+        }
+        const BLRect bounds = info.element->GetBoundingBox(nullptr);
+        element_tables_[table_index].rows.push_back(ElementRow {info.element,
+                                                                net_rank,
+                                                                info.element->GetLayerId(),
+                                                                static_cast<float>(bounds.x + bounds.w * 0.5),
+                                                                static_cast<float>(bounds.y + bounds.h * 0.5)});
+    }
+
+    // Components are listed regardless of layer visibility
+    component_rows_.clear();
+    for (int layer_id : {Board::kTopCompLayer, Board::kBottomCompLayer}) {
+        const auto comp_layer_it = board_data->m_elements_by_layer.find(layer_id);
+        if (comp_layer_it == board_data->m_elements_by_layer.end()) {
+            continue;
+        }
+        for (const auto& element_ptr : comp_layer_it->second) {
+            if (!element_ptr || element_ptr->GetElementType() != ElementType::kComponent) {
+                continue;
             }
-            ImGui::TreePop();
+            const auto* comp = static_cast<const Component*>(element_ptr.get());
+            component_rows_.push_back(ComponentRow {comp, ToLower(comp->reference_designator + " " + comp->value + " " + comp->footprint_name.str())});
         }
+    }
+    AssignRanks(component_rows_, &ComponentRow::ref_rank, [](const ComponentRow& a, const ComponentRow& b) {
+        return NaturalLess(a.component->reference_designator, b.component->reference_designator);
+    });
+    AssignRanks(component_rows_, &ComponentRow::value_rank, [](const ComponentRow& a, const ComponentRow& b) {
+        return NaturalLess(a.component->value, b.component->value);
+    });
+    AssignRanks(component_rows_, &ComponentRow::footprint_rank, [](const ComponentRow& a, const ComponentRow& b) {
+        return a.component->footprint_name < b.component->footprint_name;
+    });
+
+    ApplyFilter();
+}
 
-        if (ImGui::TreeNodeEx(("Traces (" + std::to_string(trace_count) + ")").c_str())) {
-            for (const auto& info : all_elements) {
-                if (info.parent_component || !info.element || info.element->GetElementType() != ElementType::kTrace)
-                    continue;
-                const Trace* trace = dynamic_cast<const Trace*>(info.element);
-                if (!trace)
-                    continue;
-
-                std::string net_info_str = "Net ID: " + std::to_string(trace->GetNetId());
-                const Net* net = board_data->GetNetById(trace->GetNetId());
-                if (net)
-                    net_info_str = "Net: " + (net->GetName().empty() ? "[Unnamed]" : net->GetName()) + " (ID: " + std::to_string(trace->GetNetId()) + ")";
-                else if (trace->GetNetId() != -1)
-                    net_info_str = "Net ID: " + std::to_string(trace->GetNetId()) + " [Not Found]";
-                else
-                    net_info_str = "No Net";
-
-                if (ImGui::TreeNodeEx(("Trace##" + std::to_string(reinterpret_cast<uintptr_t>(trace)) + " (" + net_info_str + ")").c_str())) {
-                    ImGui::Text("Layer: %d", trace->GetLayerId());
-                    ImGui::Text("Start: (%.2f, %.2f), End: (%.2f, %.2f)", trace->GetStartX(), trace->GetStartY(), trace->GetEndX(), trace->GetEndY());
-                    ImGui::Text("Width: %.2f", trace->GetWidth());
-                    ImGui::TreePop();
-                }
+void PcbDetailsWindow::ApplyFilter()
+{
+    filter_lower_ = ToLower(filter_text_);
+    net_filter_match_.assign(net_rows_.size() + 1, 0);
+    for (size_t i = 0; i < net_rows_.size(); ++i) {
+        net_filter_match_[i] = static_cast<uint8_t>(filter_lower_.empty() || net_rows_[i].search_key.find(filter_lower_) != std::string::npos);
+    }
+    net_filter_match_.back() = static_cast<uint8_t>(filter_lower_.empty());  // Elements without a net only show unfiltered
+
+    net_view_dirty_ = true;
+    component_view_dirty_ = true;
+    for (ElementTable& table : element_tables_) {
+        table.view_dirty = true;
+    }
+}
+
+void PcbDetailsWindow::RebuildNetView(const ImGuiTableSortSpecs* sort_specs)
+{
+    net_view_.clear();
+    for (size_t i = 0; i < net_rows_.size(); ++i) {
+        if (net_filter_match_[i]) {
+            net_view_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    const SortRequest sort = GetSortRequest(sort_specs, kColumnName);
+    switch (sort.column) {
+        case kColumnId:
+            SortView(net_view_, sort.descending, [this](uint32_t i) { return net_rows_[i].net->GetId(); });
+            break;
+        case kColumnCount:
+            SortView(net_view_, sort.descending, [this](uint32_t i) { return net_rows_[i].element_count; });
+            break;
+        default:
+            SortView(net_view_, sort.descending, [](uint32_t i) { return i; });
+            break;
+    }
+    net_view_dirty_ = false;
+}
+
+void PcbDetailsWindow::RebuildComponentView(const ImGuiTableSortSpecs* sort_specs)
+{
+    component_view_.clear();
+    for (size_t i = 0; i < component_rows_.size(); ++i) {
+        if (filter_lower_.empty() || component_rows_[i].search_key.find(filter_lower_) != std::string::npos) {
+            component_view_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    const SortRequest sort = GetSortRequest(sort_specs, kColumnName);
+    switch (sort.column) {
+        case kColumnValue:
+            SortView(component_view_, sort.descending, [this](uint32_t i) { return component_rows_[i].value_rank; });
+            break;
+        case kColumnFootprint:
+            SortView(component_view_, sort.descending, [this](uint32_t i) { return component_rows_[i].footprint_rank; });
+            break;
+        case kColumnLayer:
+            SortView(component_view_, sort.descending, [this](uint32_t i) { return component_rows_[i].component->layer; });
+            break;
+        case kColumnCount:
+            SortView(component_view_, sort.descending, [this](uint32_t i) { return component_rows_[i].component->pins.size(); });
+            break;
+        default:
+            SortView(component_view_, sort.descending, [this](uint32_t i) { return component_rows_[i].ref_rank; });
+            break;
+    }
+    component_view_dirty_ = false;
+}
+
+void PcbDetailsWindow::RebuildElementView(ElementTable& table, const ImGuiTableSortSpecs* sort_specs)
+{
+    table.view.clear();
+    for (size_t i = 0; i < table.rows.size(); ++i) {
+        if (net_filter_match_[table.rows[i].net_rank]) {
+            table.view.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    const std::vector<ElementRow>& rows = table.rows;
+    const SortRequest sort = GetSortRequest(sort_specs, kColumnLayer);
+    switch (sort.column) {
+        case kColumnNet:
+            SortView(table.view, sort.descending, [&rows](uint32_t i) { return rows[i].net_rank; });
+            break;
+        case kColumnX:
+            SortView(table.view, sort.descending, [&rows](uint32_t i) { return rows[i].x; });
+            break;
+        case kColumnY:
+            SortView(table.view, sort.descending, [&rows](uint32_t i) { return rows[i].y; });
+            break;
+        default:
+            SortView(table.view, sort.descending, [&rows](uint32_t i) { return rows[i].layer_id; });
+            break;
+    }
+    table.view_dirty = false;
+}
+
+const char* PcbDetailsWindow::GetNetLabel(uint32_t net_rank) const
+{
+    if (net_rank >= net_rows_.size()) {
+        return "[No Net]";
+    }
+    const std::string& name = net_rows_[net_rank].net->GetName();
+    return name.empty() ? "[Unnamed]" : name.c_str();
+}
+
+void PcbDetailsWindow::UpdateBoxSelectionSummary()
+{
+    const uint64_t revision = board_data_manager_->GetBoxSelectionRevision();
+    if (revision == box_selection_summary_.revision) {
+        return;
+    }
+
+    BoxSelectionSummary summary;
+    summary.revision = revision;
+    summary.selection = board_data_manager_->GetBoxSelection();
+
+    std::unordered_map<int, size_t> net_counts;
+    for (const ElementInteractionInfo& info : *summary.selection) {
+        if (!info.element) {
+            continue;
+        }
+        switch (info.element->GetElementType()) {
+            case ElementType::kComponent:
+                summary.components.push_back(static_cast<const Component*>(info.element));
+                break;
+            case ElementType::kPin:
+                summary.pins.push_back(info);
+                break;
+            case ElementType::kTrace:
+                summary.trace_count++;
+                break;
+            case ElementType::kVia:
+                summary.via_count++;
+                break;
+            case ElementType::kArc:
+                summary.arc_count++;
+                break;
+            default:
+                break;
+        }
+        if (info.element->GetNetId() != -1) {
+            net_counts[info.element->GetNetId()]++;
+        }
+    }
+    summary.nets.assign(net_counts.begin(), net_counts.end());
+    std::sort(summary.nets.begin(), summary.nets.end());
+
+    box_selection_summary_ = std::move(summary);
+}
+
+void PcbDetailsWindow::DisplayBoxSelection(const Board* board_data)
+{
+    if (!board_data_manager_ || board_data == nullptr) {
+        return;
+    }
+    UpdateBoxSelectionSummary();
+    const BoxSelectionSummary& summary = box_selection_summary_;
+
+    const std::string header = "Box Selection (" + std::to_string(summary.selection ? summary.selection->size() : 0) + ")###BoxSelection";
+    if (!ImGui::TreeNodeEx(header.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+    if (!summary.selection || summary.selection->empty()) {
+        ImGui::TextDisabled("Empty. Press B in the viewport and drag a box (left-to-right: fully inside, right-to-left: touching).");
+        ImGui::TreePop();
+        return;
+    }
+
+    ImGui::Text("Traces: %zu, Vias: %zu, Arcs: %zu", summary.trace_count, summary.via_count, summary.arc_count);
+    if (ImGui::Button("Clear Selection")) {
+        board_data_manager_->ClearBoxSelection();
+    }
+
+    // Performance optimization: Selections can hold hundreds of thousands of rows; the clipper only
+    // formats the rows that are actually on screen.
+    const float list_height = ImGui::GetTextLineHeightWithSpacing() * 10.0f;
+
+    if (ImGui::TreeNodeEx(("Components (" + std::to_string(summary.components.size()) + ")###BoxSelComponents").c_str())) {
+        ImGui::BeginChild("##BoxSelComponentList", ImVec2(0, list_height), true);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(summary.components.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const Component* comp = summary.components[static_cast<size_t>(row)];
+                ImGui::Text("%s (%s) - %s, Pins: %zu", comp->reference_designator.c_str(), comp->value.c_str(), comp->footprint_name.c_str(), comp->pins.size());
             }
-            ImGui::TreePop();
         }
+        ImGui::EndChild();
+        ImGui::TreePop();
+    }
 
-        if (ImGui::TreeNodeEx(("Standalone Text Labels (" + std::to_string(label_count) + ")").c_str())) {
-            for (const auto& info : all_elements) {
-                if (info.parent_component || !info.element || info.element->GetElementType() != ElementType::kTextLabel)
-                    continue;
-                const TextLabel* lbl = dynamic_cast<const TextLabel*>(info.element);
-                if (!lbl)
-                    continue;
-
-                std::string net_info_str = "Net ID: " + std::to_string(lbl->GetNetId());
-                // Text labels usually don't have nets, but handle if they do.
-                if (lbl->GetNetId() != -1) {
-                    const Net* net = board_data->GetNetById(lbl->GetNetId());
-                    if (net)
-                        net_info_str = "Net: " + (net->GetName().empty() ? "[Unnamed]" : net->GetName()) + " (ID: " + std::to_string(lbl->GetNetId()) + ")";
-                    else
-                        net_info_str = "Net ID: " + std::to_string(lbl->GetNetId()) + " [Not Found]";
-                } else {
-                    net_info_str = "No Net";
-                }
+    if (ImGui::TreeNodeEx(("Pins (" + std::to_string(summary.pins.size()) + ")###BoxSelPins").c_str())) {
+        ImGui::BeginChild("##BoxSelPinList", ImVec2(0, list_height), true);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(summary.pins.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const ElementInteractionInfo& info = summary.pins[static_cast<size_t>(row)];
+                const auto* pin = static_cast<const Pin*>(info.element);
+                const Net* net = board_data->GetNetById(pin->GetNetId());
+                ImGui::Text("%s.%s  %s", info.parent_component ? info.parent_component->reference_designator.c_str() : "?", pin->pin_name.c_str(),
+                            net ? net->GetName().c_str() : "[No Net]");
+            }
+        }
+        ImGui::EndChild();
+        ImGui::TreePop();
+    }
 
-                if (ImGui::TreeNodeEx(("Label##" + std::to_string(reinterpret_cast<uintptr_t>(lbl)) + " (" + net_info_str + ")").c_str())) {
-                    ImGui::Text("Layer: %d", lbl->GetLayerId());
-                    ImGui::Text("Position: (%.2f, %.2f)", lbl->coords.x_ax, lbl->coords.y_ax);
-                    ImGui::Text("Font Size: %.2f, Scale: %.2f, Rotation: %.1f°", lbl->font_size, lbl->scale, lbl->rotation);
-                    ImGui::Text("Family: %s", lbl->font_family.empty() ? "[Default]" : lbl->font_family.c_str());
-                    ImGui::TextWrapped("Content: %s", lbl->text_content.c_str());
-                    ImGui::TreePop();
+    if (ImGui::TreeNodeEx(("Nets (" + std::to_string(summary.nets.size()) + ")###BoxSelNets").c_str())) {
+        ImGui::BeginChild("##BoxSelNetList", ImVec2(0, list_height), true);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(summary.nets.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto& [net_id, element_count] = summary.nets[static_cast<size_t>(row)];
+                const Net* net = board_data->GetNetById(net_id);
+                const std::string net_name = net ? (net->GetName().empty() ? "[Unnamed]" : net->GetName()) : "[Not Found]";
+                ImGui::PushID(net_id);
+                if (ImGui::Selectable(net_name.c_str(), board_data_manager_->GetSelectedNetId() == net_id)) {
+                    board_data_manager_->SetSelectedNetId(net_id);
                 }
+                ImGui::SameLine();
+                ImGui::TextDisabled("ID %d, %zu elements", net_id, element_count);
+                ImGui::PopID();
             }
-            ImGui::TreePop();
         }
-        ImGui::TreePop();  // End of "Standalone Elements"
+        ImGui::EndChild();
+        ImGui::TreePop();
     }
+
+    ImGui::TreePop();
+    ImGui::Separator();
 }
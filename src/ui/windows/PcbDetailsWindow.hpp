@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "imgui.h"
 
@@ -8,25 +12,105 @@
 #include "pcb/elements/Pin.hpp"
 #include "pcb/elements/Component.hpp"  // For LineSegment definition
 
+class BoardDataManager;
+
 class PcbDetailsWindow
 {
 public:
     PcbDetailsWindow();
     void Render();
-    void SetBoard(std::shared_ptr<Board> board);
+    void SetBoard(std::shared_ptr<const Board> board);  // Replaced by BoardDataManager's snapshot once one is set
+    void SetBoardDataManager(std::shared_ptr<BoardDataManager> board_data_manager);  // Source of the box selection
     void SetVisible(bool visible);
     [[nodiscard]] bool IsWindowVisible() const;
 
 private:
-    std::shared_ptr<Board> current_board_;
+    std::shared_ptr<const Board> current_board_;
+    std::shared_ptr<BoardDataManager> board_data_manager_;
     bool is_visible_ = false;
 
+    // Box selection grouped for display; rebuilt only when the selection revision changes
+    struct BoxSelectionSummary {
+        uint64_t revision = UINT64_MAX;
+        std::shared_ptr<const std::vector<ElementInteractionInfo>> selection;
+        std::vector<const Component*> components;
+        std::vector<ElementInteractionInfo> pins;
+        std::vector<std::pair<int, size_t>> nets;  // (net id, selected element count), sorted by net id
+        size_t trace_count = 0;
+        size_t via_count = 0;
+        size_t arc_count = 0;
+    };
+    BoxSelectionSummary box_selection_summary_;
+
+    // Performance optimization: The element lists are backed by row tables that are built once per board or
+    // layer visibility change and rendered through ImGuiListClipper, so only rows on screen are formatted.
+    // Sorting and filtering run on the precomputed keys below and only when the sort specs or filter change.
+    struct NetRow {
+        const Net* net = nullptr;
+        std::string search_key;      // Lowercase name
+        uint32_t element_count = 0;  // Visible standalone elements and pins on this net
+    };
+    struct ComponentRow {
+        const Component* component = nullptr;
+        std::string search_key;  // Lowercase "ref value footprint"
+        uint32_t ref_rank = 0;   // Natural order of the reference designator ("R2" before "R10")
+        uint32_t value_rank = 0;
+        uint32_t footprint_rank = 0;
+    };
+    struct ElementRow {
+        const Element* element = nullptr;
+        uint32_t net_rank = 0;  // Index into net_rows_, net_rows_.size() for "no net"
+        int layer_id = 0;
+        float x = 0.0f;  // Bounding box center
+        float y = 0.0f;
+    };
+    struct ElementTable {
+        const char* title = "";
+        std::vector<ElementRow> rows;
+        std::vector<uint32_t> view;  // Filtered and sorted indices into rows
+        bool view_dirty = true;
+    };
+
+    enum ElementTableIndex : size_t { kTraceTable, kViaTable, kArcTable, kLabelTable, kElementTableCount };
+
+    const Board* tables_board_ = nullptr;
+    uint64_t tables_view_generation_ = 0;  // Board::GetInteractionViewGeneration(false) the tables were built from
+    std::vector<NetRow> net_rows_;  // Sorted by name, so the index doubles as the name sort key
+    std::vector<uint32_t> net_view_;
+    bool net_view_dirty_ = true;
+    std::vector<ComponentRow> component_rows_;
+    std::vector<uint32_t> component_view_;
+    bool component_view_dirty_ = true;
+    std::array<ElementTable, kElementTableCount> element_tables_;
+
+    char filter_text_[128] = {};
+    std::string filter_lower_;
+    std::vector<uint8_t> net_filter_match_;  // Per net rank (plus "no net"), refreshed when the filter changes
+
+    const Element* details_element_ = nullptr;  // Component or standalone element shown in the details pane
+
     void DisplayBasicInfo(const Board* board_data);
     void DisplayLayers(const Board* board_data);
-    void DisplayNets(const Board* board_data);
-    void DisplayComponents(const Board* board_data);
+    void DisplayFilter();
+    void DisplayNets();
+    void DisplayComponents();
+    void DisplayStandaloneElements();
+    void DisplayElementTable(ElementTable& table);
+    void DisplayDetails(const Board* board_data);
+    void DisplayComponentDetails(const Board* board_data, const Component* comp);
+    void DisplayElementDetails(const Board* board_data, const Element* element);
     void DisplayPins(const Board* board_data, const std::vector<std::unique_ptr<Pin>>& pins);
     void DisplayPadShape(const PadShape& shape);
     void DisplayGraphicalElements(const std::vector<LineSegment>& elements);
-    void DisplayStandaloneElements(const Board* board_data);
+    void DisplayBoxSelection(const Board* board_data);
+    void UpdateBoxSelectionSummary();
+
+    // Row table maintenance
+    void UpdateRowTables(const Board* board_data);
+    void RebuildRowTables(const Board* board_data);
+    void ApplyFilter();
+    void RebuildNetView(const ImGuiTableSortSpecs* sort_specs);
+    void RebuildComponentView(const ImGuiTableSortSpecs* sort_specs);
+    void RebuildElementView(ElementTable& table, const ImGuiTableSortSpecs* sort_specs);
+    [[nodiscard]] const char* GetNetLabel(uint32_t net_rank) const;
 };
@@ -0,0 +1,316 @@
+#include "SearchWindow.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "imgui.h"
+
+#include "core/BoardDataManager.hpp"
+#include "pcb/Board.hpp"
+#include "pcb/elements/Component.hpp"
+#include "view/Camera.hpp"
+#include "view/Viewport.hpp"
+
+namespace
+{
+constexpr size_t kMaxResults = 500;
+
+// Tiny hits (a single pin) are framed with at least this fraction of the board extent around them
+constexpr double kMinFocusExtentFraction = 0.02;
+
+constexpr ImGuiTableFlags kResultTableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+void UnionRect(BLRect& accumulated, bool& has_bounds, const BLRect& rect)
+{
+    if (!has_bounds) {
+        accumulated = rect;
+        has_bounds = true;
+        return;
+    }
+    const double min_x = std::min(accumulated.x, rect.x);
+    const double min_y = std::min(accumulated.y, rect.y);
+    const double max_x = std::max(accumulated.x + accumulated.w, rect.x + rect.w);
+    const double max_y = std::max(accumulated.y + accumulated.h, rect.y + rect.h);
+    accumulated = BLRect(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+}  // namespace
+
+SearchWindow::SearchWindow(std::shared_ptr<Camera> camera, std::shared_ptr<Viewport> viewport, std::shared_ptr<BoardDataManager> board_data_manager)
+    : camera_(camera), viewport_(viewport), board_data_manager_(board_data_manager)
+{
+}
+
+SearchWindow::~SearchWindow()
+{
+    if (pending_build_) {
+        // The worker stops at its next step; the future's destructor then only waits for that
+        pending_build_->cancelled->store(true, std::memory_order_relaxed);
+    }
+}
+
+void SearchWindow::SetBoard(std::shared_ptr<const Board> board)
+{
+    if (board == indexed_board_) {
+        return;
+    }
+    indexed_board_ = std::move(board);
+    index_.reset();
+    results_.clear();
+    selected_result_ = -1;
+    if (pending_build_) {
+        // PollIndexBuild() drops its result and starts the build for the new board once the worker has stopped
+        pending_build_->cancelled->store(true, std::memory_order_relaxed);
+        return;
+    }
+    StartIndexBuild();
+}
+
+void SearchWindow::SetVisible(bool visible)
+{
+    if (visible && !is_visible_) {
+        focus_query_input_ = true;
+    }
+    is_visible_ = visible;
+}
+
+bool SearchWindow::IsWindowVisible() const
+{
+    return is_visible_;
+}
+
+void SearchWindow::StartIndexBuild()
+{
+    if (!indexed_board_ || !indexed_board_->IsLoaded()) {
+        return;
+    }
+
+    // Collecting is a cheap walk that only records string views; copying, sorting and indexing run on the worker.
+    // The task keeps the board alive, so the views stay valid even if another board is loaded meanwhile.
+    std::vector<SearchIndex::Source> sources = SearchIndex::CollectSources(*indexed_board_);
+
+    auto pending = std::make_unique<PendingBuild>();
+    pending->board = indexed_board_;
+    pending->cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<const Board> board = indexed_board_;
+    std::shared_ptr<std::atomic<bool>> cancelled = pending->cancelled;
+    pending->result = std::async(std::launch::async, [board, cancelled, sources = std::move(sources)]() {
+        const auto build_start = std::chrono::steady_clock::now();
+        auto index = std::make_shared<SearchIndex>();
+        index->Build(sources, cancelled.get());
+        BuildResult result;
+        result.build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+        result.index = std::move(index);
+        return result;
+    });
+    pending_build_ = std::move(pending);
+}
+
+void SearchWindow::PollIndexBuild()
+{
+    // Only another loaded file invalidates the index; folding and flipping publish variants that it resolves into
+    if (board_data_manager_) {
+        std::shared_ptr<const Board> loaded_board = board_data_manager_->GetLoadedBoard();
+        if (loaded_board && loaded_board != indexed_board_) {
+            SetBoard(std::move(loaded_board));
+        }
+    }
+
+    if (!pending_build_ || pending_build_->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+
+    std::unique_ptr<PendingBuild> pending = std::move(pending_build_);
+    BuildResult result = pending->result.get();
+    if (pending->cancelled->load(std::memory_order_relaxed) || pending->board != indexed_board_) {
+        StartIndexBuild();
+        return;
+    }
+
+    index_ = std::move(result.index);
+    last_build_ms_ = result.build_ms;
+    std::cout << "SearchWindow: Indexed " << index_->GetEntryCount() << " entries in " << last_build_ms_ << " ms ("
+              << index_->GetMemoryUsageBytes() / (1024 * 1024) << " MB)" << std::endl;
+    RunQuery();
+}
+
+std::shared_ptr<const Board> SearchWindow::GetShownBoard() const
+{
+    std::shared_ptr<const Board> shown_board = board_data_manager_ ? board_data_manager_->GetBoard() : nullptr;
+    return shown_board ? shown_board : indexed_board_;
+}
+
+void SearchWindow::RunQuery()
+{
+    results_.clear();
+    selected_result_ = -1;
+    if (!index_) {
+        return;
+    }
+    const auto query_start = std::chrono::steady_clock::now();
+    index_->Search(query_text_, static_cast<SearchIndex::QueryMode>(query_mode_), kMaxResults, results_);
+    last_query_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - query_start).count();
+}
+
+BLRect SearchWindow::GetEntryBounds(uint32_t entry, const Board& board) const
+{
+    const SearchIndex::EntryKind kind = index_->GetKind(entry);
+    const Component* parent = nullptr;
+    const Element* element = index_->ResolveElement(entry, board, &parent);
+    if (!element && kind != SearchIndex::EntryKind::kNet) {
+        return BLRect(0, 0, -1, -1);  // Not part of the variant on screen
+    }
+
+    switch (kind) {
+        case SearchIndex::EntryKind::kNet: {
+            // Everything on the net; walked on demand since it only happens on a click
+            const int net_id = index_->GetNetId(entry);
+            BLRect bounds;
+            bool has_bounds = false;
+            for (const auto& [layer_id, elements] : board.m_elements_by_layer) {
+                for (const auto& element_ptr : elements) {
+                    if (!element_ptr) {
+                        continue;
+                    }
+                    if (element_ptr->GetElementType() == ElementType::kComponent) {
+                        const auto* comp = static_cast<const Component*>(element_ptr.get());
+                        for (const auto& pin_ptr : comp->pins) {
+                            if (pin_ptr && pin_ptr->GetNetId() == net_id) {
+                                UnionRect(bounds, has_bounds, pin_ptr->GetBoundingBox(comp));
+                            }
+                        }
+                    } else if (element_ptr->GetNetId() == net_id) {
+                        UnionRect(bounds, has_bounds, element_ptr->GetBoundingBox());
+                    }
+                }
+            }
+            return has_bounds ? bounds : BLRect(0, 0, -1, -1);
+        }
+        case SearchIndex::EntryKind::kPin:
+        case SearchIndex::EntryKind::kDiodeReading:
+            return element->GetBoundingBox(parent);
+        case SearchIndex::EntryKind::kTextLabel:
+            // Component labels are stored in component-local coordinates; frame the component instead
+            return parent ? parent->GetBoundingBox() : element->GetBoundingBox();
+        default:
+            return element->GetBoundingBox();
+    }
+}
+
+void SearchWindow::JumpToResult(uint32_t entry)
+{
+    const std::shared_ptr<const Board> board = GetShownBoard();
+    if (!index_ || !board || !camera_ || !viewport_) {
+        return;
+    }
+
+    BLRect bounds = GetEntryBounds(entry, *board);
+    if (bounds.w < 0.0 || bounds.h < 0.0) {
+        std::cout << "SearchWindow: Nothing to focus on for '" << index_->GetText(entry) << "'" << std::endl;
+        return;
+    }
+
+    const BLRect board_bounds = board->GetBoundingBox(true);
+    const double min_extent = std::max(board_bounds.w, board_bounds.h) * kMinFocusExtentFraction;
+    if (bounds.w < min_extent) {
+        bounds.x -= (min_extent - bounds.w) * 0.5;
+        bounds.w = min_extent;
+    }
+    if (bounds.h < min_extent) {
+        bounds.y -= (min_extent - bounds.h) * 0.5;
+        bounds.h = min_extent;
+    }
+    camera_->FocusOnRect(bounds, *viewport_, 0.2f);
+
+    const SearchIndex::EntryKind kind = index_->GetKind(entry);
+    const int net_id = index_->GetNetId(entry);
+    if (board_data_manager_ && net_id != -1 &&
+        (kind == SearchIndex::EntryKind::kNet || kind == SearchIndex::EntryKind::kPin || kind == SearchIndex::EntryKind::kDiodeReading)) {
+        board_data_manager_->SetSelectedNetId(net_id);
+    }
+}
+
+void SearchWindow::Render()
+{
+    if (!is_visible_) {
+        return;
+    }
+    PollIndexBuild();
+
+    if (!ImGui::Begin("Search", &is_visible_)) {
+        ImGui::End();
+        return;
+    }
+
+    if (!indexed_board_) {
+        ImGui::TextDisabled("No board loaded.");
+        ImGui::End();
+        return;
+    }
+
+    if (focus_query_input_) {
+        ImGui::SetKeyboardFocusHere();
+        focus_query_input_ = false;
+    }
+    ImGui::SetNextItemWidth(-160.0f);
+    bool query_changed = ImGui::InputTextWithHint("##SearchQuery", "Reference, net, pin (U12.3), value, label...", query_text_, IM_ARRAYSIZE(query_text_));
+    const bool jump_requested = ImGui::IsItemDeactivated() && ImGui::IsKeyPressed(ImGuiKey_Enter);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(-1.0f);
+    const char* modes[] = {"All", "Prefix", "Substring", "Fuzzy"};
+    query_changed |= ImGui::Combo("##SearchMode", &query_mode_, modes, IM_ARRAYSIZE(modes));
+
+    if (query_changed) {
+        RunQuery();
+    }
+    if (jump_requested && !results_.empty()) {
+        selected_result_ = 0;
+        JumpToResult(results_[0].entry);
+    }
+
+    if (!index_) {
+        ImGui::TextDisabled("Building search index...");
+    } else {
+        ImGui::TextDisabled("%zu entries indexed in %.0f ms. %zu results in %.2f ms.", index_->GetEntryCount(), last_build_ms_, results_.size(), last_query_ms_);
+    }
+
+    const std::shared_ptr<const Board> shown_board = index_ ? GetShownBoard() : nullptr;
+    if (shown_board && ImGui::BeginTable("##SearchResults", 4, kResultTableFlags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Match");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("Component");
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(results_.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const SearchIndex::Result& result = results_[static_cast<size_t>(row)];
+                const std::string text(index_->GetText(result.entry));
+                const Component* parent = nullptr;  // Owner of a pin or label
+                static_cast<void>(index_->ResolveElement(result.entry, *shown_board, &parent));
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(row);
+                if (ImGui::Selectable(text.c_str(), selected_result_ == row, ImGuiSelectableFlags_SpanAllColumns)) {
+                    selected_result_ = row;
+                    JumpToResult(result.entry);
+                }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(SearchIndex::EntryKindToString(index_->GetKind(result.entry)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(parent ? parent->reference_designator.c_str() : "");
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(SearchIndex::MatchTypeToString(result.match));
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <blend2d.h>
+
+#include "pcb/SearchIndex.hpp"
+
+// Forward declarations
+class Board;
+class BoardDataManager;
+class Camera;
+class Viewport;
+
+// Full-text search over the loaded board (components, nets, pins, labels, diode readings).
+//
+// The SearchIndex is built on a worker thread whenever a board is loaded, so loading never waits for it; the window
+// shows progress until the index is ready. The index belongs to the loaded board and survives folding and flipping:
+// entries record where their element sits, and a selected result is looked up in the variant on screen at that
+// moment. Queries run on every edit of the search box against the immutable index.
+// Selecting a result focuses the camera on it, and results on a net also select that net for highlighting.
+class SearchWindow
+{
+public:
+    SearchWindow(std::shared_ptr<Camera> camera, std::shared_ptr<Viewport> viewport, std::shared_ptr<BoardDataManager> board_data_manager);
+    ~SearchWindow();
+
+    void SetBoard(std::shared_ptr<const Board> board);  // The loaded board; starts a background index build
+    void Render();
+
+    void SetVisible(bool visible);
+    [[nodiscard]] bool IsWindowVisible() const;
+    // True while the index is built; the window polls for it only while visible
+    [[nodiscard]] bool IsIndexBuildPending() const { return pending_build_ != nullptr; }
+
+private:
+    struct BuildResult {
+        std::shared_ptr<const SearchIndex> index;
+        double build_ms = 0.0;
+    };
+
+    struct PendingBuild {
+        std::shared_ptr<const Board> board;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::future<BuildResult> result;
+    };
+
+    void StartIndexBuild();
+    void PollIndexBuild();
+    void RunQuery();
+    void JumpToResult(uint32_t entry);
+    [[nodiscard]] BLRect GetEntryBounds(uint32_t entry, const Board& board) const;
+    // The variant on screen, which results are looked up in
+    [[nodiscard]] std::shared_ptr<const Board> GetShownBoard() const;
+
+    std::shared_ptr<Camera> camera_;
+    std::shared_ptr<Viewport> viewport_;
+    std::shared_ptr<BoardDataManager> board_data_manager_;
+    std::shared_ptr<const Board> indexed_board_;  // The loaded board, not a fold or flip of it
+    bool is_visible_ = false;
+    bool focus_query_input_ = false;
+
+    // Index state; index_ always belongs to indexed_board_. One build runs at a time: a build for a board that is
+    // no longer loaded is cancelled and replaced once it has wound down, so its future is never destroyed while
+    // the worker still runs.
+    std::shared_ptr<const SearchIndex> index_;
+    std::unique_ptr<PendingBuild> pending_build_;
+    double last_build_ms_ = 0.0;
+
+    // Query state
+    char query_text_[128] = {};
+    int query_mode_ = 0;  // SearchIndex::QueryMode
+    std::vector<SearchIndex::Result> results_;
+    double last_query_ms_ = 0.0;
+    int selected_result_ = -1;
+};
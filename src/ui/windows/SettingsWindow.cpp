@@ -550,7 +550,7 @@ void SettingsWindow::ShowControlSettings()
     }
 }
 
-void SettingsWindow::ShowLayerControls(const std::shared_ptr<Board>& currentBoard)
+void SettingsWindow::ShowLayerControls(const std::shared_ptr<const Board>& currentBoard)
 {  // Updated signature
     if (!currentBoard) {
         ImGui::TextDisabled("No board loaded. Layer controls unavailable.");
@@ -776,40 +776,28 @@ void SettingsWindow::ShowLayerControls(const std::shared_ptr<Board>& currentBoar
     }
 }
 
-void SettingsWindow::ShowAppearanceSettings(const std::shared_ptr<Board>& currentBoard)
+void SettingsWindow::ShowAppearanceSettings(const std::shared_ptr<const Board>& currentBoard)
 {
     // Board View Settings
     ImGui::SeparatorText("Board View");
 
-    // Board Folding Toggle with pending state display
+    // Board Folding Toggle; applied to the loaded board immediately (each geometry variant is built once and kept)
     bool current_folding_enabled = m_board_data_manager_->IsBoardFoldingEnabled();
-    bool pending_folding_enabled = m_board_data_manager_->GetPendingBoardFoldingEnabled();
-    bool has_pending_change = m_board_data_manager_->HasPendingFoldingChange();
 
-    // Use the pending setting for the checkbox display
-    bool checkbox_value = pending_folding_enabled;
+    bool checkbox_value = current_folding_enabled;
     if (ImGui::Checkbox("Enable Board Folding", &checkbox_value)) {
         m_board_data_manager_->SetBoardFoldingEnabled(checkbox_value);
+        current_folding_enabled = checkbox_value;
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Fold the board to stack components from both sides for easier inspection.\nComponents will be mirrored and assigned to top/bottom mounting sides.");
     }
 
-    // Show pending state information
-    if (has_pending_change) {
-        ImGui::SameLine();
-        ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.4f, 1.0f), "(pending)");
-        ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.4f, 1.0f),
-                          "Board folding: %s → %s (will apply on next board load)",
-                          current_folding_enabled ? "enabled" : "disabled",
-                          pending_folding_enabled ? "enabled" : "disabled");
-    } else {
-        ImGui::TextColored(ImVec4(0.7f, 0.9f, 0.7f, 1.0f),
-                          "Board folding: %s",
-                          current_folding_enabled ? "enabled" : "disabled");
-    }
+    ImGui::TextColored(ImVec4(0.7f, 0.9f, 0.7f, 1.0f),
+                      "Board folding: %s",
+                      current_folding_enabled ? "enabled" : "disabled");
 
-    // Board Side View Selection (only show if current folding is enabled, not pending)
+    // Board Side View Selection (only show if folding is enabled)
     if (current_folding_enabled) {
         ImGui::Indent();
 
@@ -984,7 +972,7 @@ void SettingsWindow::ShowAppearanceSettings(const std::shared_ptr<Board>& curren
     ShowLayerControls(currentBoard);  // Pass currentBoard
 }
 
-void SettingsWindow::RenderUI(const std::shared_ptr<Board>& currentBoard)
+void SettingsWindow::RenderUI(const std::shared_ptr<const Board>& currentBoard)
 {  // Added currentBoard parameter back
     if (!m_is_open_) {
         return;
@@ -31,7 +31,7 @@ public:
     SettingsWindow(SettingsWindow&&) = delete;
     SettingsWindow& operator=(SettingsWindow&&) = delete;
 
-    void RenderUI(const std::shared_ptr<Board>& current_board);
+    void RenderUI(const std::shared_ptr<const Board>& current_board);
 
     [[nodiscard]] bool IsWindowVisible() const { return m_is_open_; }
     void SetVisible(bool visible) { m_is_open_ = visible; }
@@ -64,8 +64,8 @@ private:
     // void ShowThemeSettings();
     // void ShowApplicationSettings();
     void ShowControlSettings();
-    void ShowAppearanceSettings(const std::shared_ptr<Board>& current_board);
-    void ShowLayerControls(const std::shared_ptr<Board>& current_board);
+    void ShowAppearanceSettings(const std::shared_ptr<const Board>& current_board);
+    void ShowLayerControls(const std::shared_ptr<const Board>& current_board);
     void ShowAccessibilitySettings();
 
     // Helper method for rendering color controls
@@ -3,10 +3,19 @@
 #include <cmath>      // For std::sqrt, std::fmod, std::atan2, M_PI (if needed)
 #include <vector>     // For std::vector
 
+#include <cstddef>    // For size_t
+#include <cstdint>    // For uint32_t
+
 #ifdef __SSE__
 #include <immintrin.h>  // For SSE/AVX vectorization
 #endif
 
+// SSE2 is baseline on x86-64; MSVC does not define __SSE__/__SSE2__, so check its own macros too
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOMETRY_UTILS_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include "Vec2.hpp"  // For Vec2 struct
 
 // Forward declare Blend2D types if you only pass pointers/references
@@ -234,4 +243,139 @@ inline float FastDistanceApprox(const Vec2& a, const Vec2& b) {
     return max_val + 0.4142135f * min_val;  // 0.4142135 ≈ sqrt(2) - 1
 }
 
+// --- Packed (SoA) hit-test kernels ---
+// These test one query point against a contiguous run [begin, end) of packed shapes and return the index of
+// the first shape hit, or `end` if none is. Callers keep each run sorted by interaction priority, so the first
+// hit is also the best one. Coordinates are floats relative to a caller-chosen origin. No allocation.
+
+// Capsule segments (traces): hit when the point lies within radius + tolerance of segment (x1,y1)-(x2,y2).
+// Matches IsPointNearLineSegment with radius = thickness / 2.
+inline size_t FindFirstSegmentHit(const float* x1, const float* y1, const float* x2, const float* y2, const float* radius,
+                                  size_t begin, size_t end, float px, float py, float tolerance)
+{
+    size_t i = begin;
+#ifdef GEOMETRY_UTILS_HAS_SSE2
+    const __m128 v_px = _mm_set1_ps(px);
+    const __m128 v_py = _mm_set1_ps(py);
+    const __m128 v_tol = _mm_set1_ps(tolerance);
+    const __m128 v_zero = _mm_setzero_ps();
+    const __m128 v_one = _mm_set1_ps(1.0f);
+    const __m128 v_tiny = _mm_set1_ps(1e-20f);
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 ax = _mm_loadu_ps(x1 + i);
+        const __m128 ay = _mm_loadu_ps(y1 + i);
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x2 + i), ax);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y2 + i), ay);
+        const __m128 rx = _mm_sub_ps(v_px, ax);
+        const __m128 ry = _mm_sub_ps(v_py, ay);
+
+        // Projection ratio clamped to [0, 1]; degenerate segments project to their start point
+        const __m128 len_sq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 dot = _mm_add_ps(_mm_mul_ps(rx, dx), _mm_mul_ps(ry, dy));
+        __m128 t = _mm_div_ps(dot, _mm_max_ps(len_sq, v_tiny));
+        t = _mm_min_ps(_mm_max_ps(t, v_zero), v_one);
+
+        const __m128 ex = _mm_sub_ps(rx, _mm_mul_ps(t, dx));
+        const __m128 ey = _mm_sub_ps(ry, _mm_mul_ps(t, dy));
+        const __m128 dist_sq = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+        const __m128 reach = _mm_add_ps(_mm_loadu_ps(radius + i), v_tol);
+
+        const int mask = _mm_movemask_ps(_mm_cmple_ps(dist_sq, _mm_mul_ps(reach, reach)));
+        if (mask != 0) {
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) {
+                    return i + static_cast<size_t>(lane);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        const float dx = x2[i] - x1[i];
+        const float dy = y2[i] - y1[i];
+        const float rx = px - x1[i];
+        const float ry = py - y1[i];
+        float t = (rx * dx + ry * dy) / std::max(dx * dx + dy * dy, 1e-20f);
+        t = std::min(std::max(t, 0.0f), 1.0f);
+        const float ex = rx - t * dx;
+        const float ey = ry - t * dy;
+        const float reach = radius[i] + tolerance;
+        if (ex * ex + ey * ey <= reach * reach) {
+            return i;
+        }
+    }
+    return end;
+}
+
+// Oriented pads (pins, vias, component bodies). The point is rotated into the pad frame with (cos_r, sin_r),
+// then tested against a box of half extents (half_w, half_h):
+//   box_mask set   -> axis-aligned box grown by tolerance (RectanglePad, Component)
+//   box_mask clear -> box rounded by corner_radius + tolerance (CirclePad: 0x0 box, CapsulePad: 1D box)
+// box_mask is 0xFFFFFFFF or 0 so the SIMD path can select per lane without branching.
+inline size_t FindFirstPadHit(const float* cx, const float* cy, const float* cos_r, const float* sin_r,
+                              const float* half_w, const float* half_h, const float* corner_radius, const uint32_t* box_mask,
+                              size_t begin, size_t end, float px, float py, float tolerance)
+{
+    size_t i = begin;
+#ifdef GEOMETRY_UTILS_HAS_SSE2
+    const __m128 v_px = _mm_set1_ps(px);
+    const __m128 v_py = _mm_set1_ps(py);
+    const __m128 v_tol = _mm_set1_ps(tolerance);
+    const __m128 v_zero = _mm_setzero_ps();
+    const __m128 v_abs = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 dx = _mm_sub_ps(v_px, _mm_loadu_ps(cx + i));
+        const __m128 dy = _mm_sub_ps(v_py, _mm_loadu_ps(cy + i));
+        const __m128 c = _mm_loadu_ps(cos_r + i);
+        const __m128 s = _mm_loadu_ps(sin_r + i);
+        const __m128 lx = _mm_sub_ps(_mm_mul_ps(dx, c), _mm_mul_ps(dy, s));
+        const __m128 ly = _mm_add_ps(_mm_mul_ps(dx, s), _mm_mul_ps(dy, c));
+
+        const __m128 ex = _mm_sub_ps(_mm_and_ps(lx, v_abs), _mm_loadu_ps(half_w + i));
+        const __m128 ey = _mm_sub_ps(_mm_and_ps(ly, v_abs), _mm_loadu_ps(half_h + i));
+        const __m128 box_hit = _mm_cmple_ps(_mm_max_ps(ex, ey), v_tol);
+
+        const __m128 qx = _mm_max_ps(ex, v_zero);
+        const __m128 qy = _mm_max_ps(ey, v_zero);
+        const __m128 reach = _mm_add_ps(_mm_loadu_ps(corner_radius + i), v_tol);
+        const __m128 round_hit = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_mul_ps(reach, reach));
+
+        const __m128 is_box = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(box_mask + i)));
+        const __m128 hit = _mm_or_ps(_mm_and_ps(is_box, box_hit), _mm_andnot_ps(is_box, round_hit));
+
+        const int mask = _mm_movemask_ps(hit);
+        if (mask != 0) {
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) {
+                    return i + static_cast<size_t>(lane);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        const float dx = px - cx[i];
+        const float dy = py - cy[i];
+        const float lx = dx * cos_r[i] - dy * sin_r[i];
+        const float ly = dx * sin_r[i] + dy * cos_r[i];
+        const float ex = std::abs(lx) - half_w[i];
+        const float ey = std::abs(ly) - half_h[i];
+        if (box_mask[i] != 0) {
+            if (std::max(ex, ey) <= tolerance) {
+                return i;
+            }
+        } else {
+            const float qx = std::max(ex, 0.0f);
+            const float qy = std::max(ey, 0.0f);
+            const float reach = corner_radius[i] + tolerance;
+            if (qx * qx + qy * qy <= reach * reach) {
+                return i;
+            }
+        }
+    }
+    return end;
+}
+
 }  // namespace geometry_utils
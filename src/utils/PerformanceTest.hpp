@@ -1,12 +1,26 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
 #include <vector>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 
 #include "GeometryUtils.hpp"
 #include "Vec2.hpp"
+#include "pcb/Board.hpp"
+#include "pcb/HitTestIndex.hpp"
+#include "pcb/StringInterner.hpp"
+#include "pcb/elements/Arc.hpp"
+#include "pcb/elements/Component.hpp"
+#include "pcb/elements/Pin.hpp"
+#include "pcb/elements/TextLabel.hpp"
+#include "pcb/elements/Trace.hpp"
+#include "pcb/elements/Via.hpp"
 
 namespace performance_test {
 
@@ -18,7 +32,7 @@ private:
 
 public:
     explicit PerformanceTimer(const std::string& test_name) 
-        : m_test_name_(test_name), m_start_time_(std::chrono::high_resolution_clock::now()) {}
+        : m_start_time_(std::chrono::high_resolution_clock::now()), m_test_name_(test_name) {}
     
     ~PerformanceTimer() {
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -33,8 +47,11 @@ public:
     }
 };
 
+// Performance tests with a correctness check each; run by XZZPCB-Benchmarks --self-tests. Each prints its
+// timings and returns whether its check passed.
+
 // Test vectorized math performance
-void TestVectorizedMath() {
+inline bool TestVectorizedMath() {
     std::cout << "\n=== Testing Vectorized Math Performance ===" << std::endl;
     
     // Create test data
@@ -76,7 +93,7 @@ void TestVectorizedMath() {
         }
     }
     
-    std::cout << "Results match: " << (results_match ? "YES" : "NO") << std::endl;
+    std::cout << "Results match: " << (results_match ? "PASS" : "FAIL") << std::endl;
     
     // Test fast distance approximations
     {
@@ -101,22 +118,345 @@ void TestVectorizedMath() {
             std::sqrt(dx*dx + dy*dy);
         }
     }
+    return results_match;
 }
 
-// Test spatial indexing performance
-void TestSpatialIndexing() {
+// Test hover hit-testing performance on a synthetic 1M element board
+inline bool TestSpatialIndexing() {
     std::cout << "\n=== Testing Spatial Indexing Performance ===" << std::endl;
-    
-    // This would require actual Element objects, so we'll just print a placeholder
-    std::cout << "Spatial indexing test requires actual board data - implement in integration test" << std::endl;
+
+    constexpr size_t kTraceCount = 600000;
+    constexpr size_t kViaCount = 200000;
+    constexpr size_t kPinCount = 150000;
+    constexpr size_t kComponentCount = 50000;
+    constexpr double kBoardSize = 1000.0;
+    constexpr size_t kQueryCount = 10000;
+    constexpr size_t kVerifyCount = 200;
+    constexpr double kTargetMicroseconds = 50.0;  // Reported only: timings depend on the machine
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> pos_dist(0.0, kBoardSize);
+    std::uniform_real_distribution<double> offset_dist(-1.0, 1.0);
+    std::uniform_real_distribution<double> size_dist(0.1, 0.6);
+    std::uniform_real_distribution<double> angle_dist(0.0, 360.0);
+
+    std::vector<std::unique_ptr<Element>> elements;
+    elements.reserve(kTraceCount + kViaCount + kPinCount + kComponentCount);
+    std::vector<ElementInteractionInfo> entries;
+    entries.reserve(elements.capacity());
+
+    // Default priority order: pins, components, traces, vias
+    for (size_t i = 0; i < kPinCount; ++i) {
+        PadShape shape = CirclePad {size_dist(rng) / 2.0};
+        if (i % 3 == 1) {
+            shape = RectanglePad {size_dist(rng), size_dist(rng)};
+        } else if (i % 3 == 2) {
+            shape = CapsulePad {size_dist(rng) * 2.0, size_dist(rng)};
+        }
+        auto pin = std::make_unique<Pin>(Vec2(pos_dist(rng), pos_dist(rng)), "P", shape, 1);
+        pin->rotation = (i % 2 == 0) ? 0.0 : angle_dist(rng);
+        entries.push_back({pin.get(), nullptr});
+        elements.push_back(std::move(pin));
+    }
+    for (size_t i = 0; i < kComponentCount; ++i) {
+        auto component = std::make_unique<Component>("U", "", pos_dist(rng), pos_dist(rng));
+        component->width = size_dist(rng) * 4.0;
+        component->height = size_dist(rng) * 4.0;
+        component->rotation = angle_dist(rng);
+        entries.push_back({component.get(), nullptr});
+        elements.push_back(std::move(component));
+    }
+    for (size_t i = 0; i < kTraceCount; ++i) {
+        const Vec2 start(pos_dist(rng), pos_dist(rng));
+        const Vec2 end(start.x_ax + offset_dist(rng) * 2.0, start.y_ax + offset_dist(rng) * 2.0);
+        auto trace = std::make_unique<Trace>(1, start, end, size_dist(rng) / 4.0);
+        entries.push_back({trace.get(), nullptr});
+        elements.push_back(std::move(trace));
+    }
+    for (size_t i = 0; i < kViaCount; ++i) {
+        const double radius = size_dist(rng) / 2.0;
+        auto via = std::make_unique<Via>(pos_dist(rng), pos_dist(rng), 1, 2, radius, radius, radius);
+        entries.push_back({via.get(), nullptr});
+        elements.push_back(std::move(via));
+    }
+
+    HitTestIndex index;
+    {
+        PerformanceTimer timer("Hit-test index build (" + std::to_string(entries.size()) + " elements)");
+        index.Build(entries);
+    }
+    std::cout << "Hit-test index memory: " << (index.GetMemoryUsageBytes() / (1024 * 1024)) << " MB" << std::endl;
+
+    std::vector<Vec2> queries;
+    queries.reserve(kQueryCount);
+    for (size_t i = 0; i < kQueryCount; ++i) {
+        queries.emplace_back(pos_dist(rng), pos_dist(rng));
+    }
+    const float tolerance = 0.05f;
+
+    std::vector<double> query_us;
+    query_us.reserve(kQueryCount);
+    size_t hit_count = 0;
+    for (const Vec2& query : queries) {
+        HitTestIndex::Hit hit;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const bool found = index.FindBestHit(query, tolerance, hit);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        query_us.push_back(std::chrono::duration<double, std::micro>(end_time - start_time).count());
+        hit_count += found ? 1 : 0;
+    }
+    double total_us = 0.0;
+    for (double us : query_us) {
+        total_us += us;
+    }
+    std::sort(query_us.begin(), query_us.end());
+    const double avg_us = total_us / static_cast<double>(kQueryCount);
+    const double p99_us = query_us[(kQueryCount * 99) / 100];
+    // Timing is informational; the benchmark baseline tracks it per machine. Only the linear-scan match below decides
+    // the test, so a slow or busy machine does not fail it.
+    std::cout << "Hover query: avg " << avg_us << " us, p99 " << p99_us << " us, max " << query_us.back() << " us, hits " << hit_count << "/" << kQueryCount
+              << " (p99 target " << kTargetMicroseconds << " us: " << (p99_us <= kTargetMicroseconds ? "met" : "missed") << ")" << std::endl;
+
+    // Linear IsHit scan for comparison and correctness (priority = first hit in entry order)
+    size_t matches = 0;
+    double linear_total_us = 0.0;
+    for (size_t i = 0; i < kVerifyCount; ++i) {
+        const Vec2& query = queries[i];
+        const Element* expected = nullptr;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (const auto& entry : entries) {
+            if (entry.element->IsHit(query, tolerance, entry.parent_component)) {
+                expected = entry.element;
+                break;
+            }
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        linear_total_us += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+
+        HitTestIndex::Hit hit;
+        const Element* actual = index.FindBestHit(query, tolerance, hit) ? hit.element : nullptr;
+        matches += (actual == expected) ? 1 : 0;
+    }
+    std::cout << "Linear scan: avg " << (linear_total_us / kVerifyCount) << " us" << std::endl;
+    std::cout << "Results match linear scan: " << matches << "/" << kVerifyCount << ": " << (matches == kVerifyCount ? "PASS" : "FAIL") << std::endl;
+    return matches == kVerifyCount;
+}
+
+// Fills board with a synthetic ~1M element layout; the same seed always yields the same board
+inline void PopulateBulkTransformBoard(Board& board, unsigned int seed) {
+    constexpr size_t kTraceCount = 600000;
+    constexpr size_t kViaCount = 150000;
+    constexpr size_t kArcCount = 100000;
+    constexpr size_t kComponentCount = 40000;  // 4 pins, a label and 4 outline segments each
+    constexpr double kBoardSize = 1000.0;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> pos_dist(0.0, kBoardSize);
+    std::uniform_real_distribution<double> offset_dist(-1.0, 1.0);
+    std::uniform_real_distribution<double> angle_dist(0.0, 360.0);
+
+    for (size_t i = 0; i < kTraceCount; ++i) {
+        const int layer = 1 + static_cast<int>(i % 4);
+        const Vec2 start(pos_dist(rng), pos_dist(rng));
+        const Vec2 end(start.x_ax + offset_dist(rng), start.y_ax + offset_dist(rng));
+        board.m_elements_by_layer[layer].push_back(std::make_unique<Trace>(layer, start, end, 0.1));
+    }
+    for (size_t i = 0; i < kViaCount; ++i) {
+        board.m_elements_by_layer[1].push_back(std::make_unique<Via>(pos_dist(rng), pos_dist(rng), 1, 2, 0.2, 0.3, 0.3));
+    }
+    for (size_t i = 0; i < kArcCount; ++i) {
+        board.m_elements_by_layer[2].push_back(std::make_unique<Arc>(2, Vec2(pos_dist(rng), pos_dist(rng)), 0.5, angle_dist(rng), angle_dist(rng)));
+    }
+    for (size_t i = 0; i < kComponentCount; ++i) {
+        auto component = std::make_unique<Component>("U", "", pos_dist(rng), pos_dist(rng), Board::kTopCompLayer);
+        for (int pin = 0; pin < 4; ++pin) {
+            const Vec2 coords(component->center_x + offset_dist(rng), component->center_y + offset_dist(rng));
+            component->pins.push_back(std::make_unique<Pin>(coords, "P", CirclePad {0.2}, Board::kTopPinsLayer));
+        }
+        component->text_labels.push_back(std::make_unique<TextLabel>("U", Vec2(component->center_x, component->center_y), Board::kTopCompLayer, 1.0));
+        for (int segment = 0; segment < 4; ++segment) {
+            LineSegment outline;
+            outline.start = Vec2(component->center_x + offset_dist(rng), component->center_y + offset_dist(rng));
+            outline.end = Vec2(component->center_x + offset_dist(rng), component->center_y + offset_dist(rng));
+            component->graphical_elements.push_back(outline);
+        }
+        board.m_elements_by_layer[Board::kTopCompLayer].push_back(std::move(component));
+    }
+}
+
+// Largest coordinate difference between two boards populated from the same seed
+inline double MaxCoordinateDifference(const Board& lhs, const Board& rhs) {
+    double max_diff = 0.0;
+    auto diff = [&max_diff](double a, double b) { max_diff = std::max(max_diff, std::abs(a - b)); };
+    for (const auto& [layer_id, elements] : lhs.m_elements_by_layer) {
+        const auto& other_elements = rhs.m_elements_by_layer.at(layer_id);
+        for (size_t i = 0; i < elements.size(); ++i) {
+            const Element* a = elements[i].get();
+            const Element* b = other_elements[i].get();
+            if (const auto* trace = dynamic_cast<const Trace*>(a)) {
+                const auto* other = static_cast<const Trace*>(b);
+                diff(trace->x1, other->x1), diff(trace->y1, other->y1), diff(trace->x2, other->x2), diff(trace->y2, other->y2);
+            } else if (const auto* via = dynamic_cast<const Via*>(a)) {
+                const auto* other = static_cast<const Via*>(b);
+                diff(via->x, other->x), diff(via->y, other->y);
+            } else if (const auto* arc = dynamic_cast<const Arc*>(a)) {
+                const auto* other = static_cast<const Arc*>(b);
+                diff(arc->center.x_ax, other->center.x_ax), diff(arc->center.y_ax, other->center.y_ax);
+                diff(arc->start_angle, other->start_angle), diff(arc->end_angle, other->end_angle);
+            } else if (const auto* comp = dynamic_cast<const Component*>(a)) {
+                const auto* other = static_cast<const Component*>(b);
+                diff(comp->center_x, other->center_x), diff(comp->center_y, other->center_y);
+                for (size_t p = 0; p < comp->pins.size(); ++p) {
+                    diff(comp->pins[p]->coords.x_ax, other->pins[p]->coords.x_ax), diff(comp->pins[p]->coords.y_ax, other->pins[p]->coords.y_ax);
+                }
+                for (size_t l = 0; l < comp->text_labels.size(); ++l) {
+                    diff(comp->text_labels[l]->coords.x_ax, other->text_labels[l]->coords.x_ax);
+                    diff(comp->text_labels[l]->coords.y_ax, other->text_labels[l]->coords.y_ax);
+                }
+                for (size_t g = 0; g < comp->graphical_elements.size(); ++g) {
+                    diff(comp->graphical_elements[g].start.x_ax, other->graphical_elements[g].start.x_ax);
+                    diff(comp->graphical_elements[g].end.y_ax, other->graphical_elements[g].end.y_ax);
+                }
+            }
+        }
+    }
+    return max_diff;
+}
+
+// Compare per-element Translate + Mirror passes against one fused bulk transform on a synthetic 1M element board
+inline bool TestBulkBoardTransform() {
+    std::cout << "\n=== Testing Bulk Board Transform Performance ===" << std::endl;
+
+    constexpr unsigned int kSeed = 4242;
+    constexpr double kOffsetX = 500.0;
+    constexpr double kOffsetY = 500.0;
+    constexpr double kMirrorAxis = 3.25;
+    constexpr double kMaxAllowedDifference = 1e-9;
+
+    Board per_element_board;
+    Board bulk_board;
+    PopulateBulkTransformBoard(per_element_board, kSeed);
+    PopulateBulkTransformBoard(bulk_board, kSeed);
+
+    // The two load-time passes (normalize, then global mirror) as they ran before, one virtual call per element each
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (auto& [layer_id, elements] : per_element_board.m_elements_by_layer) {
+        for (auto& element : elements) {
+            element->Translate(-kOffsetX, -kOffsetY);
+        }
+    }
+    for (auto& [layer_id, elements] : per_element_board.m_elements_by_layer) {
+        for (auto& element : elements) {
+            element->Mirror(kMirrorAxis);
+        }
+    }
+    const double per_element_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    start_time = std::chrono::high_resolution_clock::now();
+    bulk_board.ApplyBulkTransform(BoardTransform::Translation(-kOffsetX, -kOffsetY).Then(BoardTransform::MirrorX(kMirrorAxis)));
+    const double bulk_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    const double max_difference = MaxCoordinateDifference(per_element_board, bulk_board);
+    std::cout << "Per-element normalize + mirror: " << per_element_ms << " ms" << std::endl;
+    std::cout << "Fused bulk transform: " << bulk_ms << " ms (" << (bulk_ms > 0.0 ? per_element_ms / bulk_ms : 0.0) << "x)" << std::endl;
+    std::cout << "Max coordinate difference: " << max_difference << ": " << (max_difference <= kMaxAllowedDifference ? "PASS" : "FAIL") << std::endl;
+    return max_difference <= kMaxAllowedDifference;
+}
+
+// Builds and destroys the same large board with elements from the general heap and from the board's arena
+inline bool TestBoardLoadUnload() {
+    std::cout << "\n=== Testing Board Load/Unload Performance ===" << std::endl;
+
+    constexpr unsigned int kSeed = 4242;
+    double load_ms[2] = {};
+    double unload_ms[2] = {};
+    size_t element_counts[2] = {};
+    size_t chunk_count = 0;
+
+    for (int use_arena = 0; use_arena < 2; ++use_arena) {
+        auto board = std::make_unique<Board>();
+        auto start_time = std::chrono::high_resolution_clock::now();
+        {
+            BoardArena::Scope arena_scope(use_arena ? &board->GetArena() : nullptr);
+            PopulateBulkTransformBoard(*board, kSeed);
+        }
+        load_ms[use_arena] = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+        element_counts[use_arena] = board->GetMemoryReport().GetElementCount();
+        if (use_arena) {
+            chunk_count = board->GetArena().GetChunkCount();
+        }
+
+        start_time = std::chrono::high_resolution_clock::now();
+        board.reset();
+        unload_ms[use_arena] = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+    }
+
+    std::cout << "Heap elements: load " << load_ms[0] << " ms, unload " << unload_ms[0] << " ms" << std::endl;
+    std::cout << "Arena elements: load " << load_ms[1] << " ms, unload " << unload_ms[1] << " ms (" << chunk_count << " chunks, "
+              << (unload_ms[1] > 0.0 ? unload_ms[0] / unload_ms[1] : 0.0) << "x faster unload)" << std::endl;
+    std::cout << "Element count: " << element_counts[0] << " vs " << element_counts[1] << ": "
+              << (element_counts[0] == element_counts[1] ? "PASS" : "FAIL") << std::endl;
+    return element_counts[0] == element_counts[1];
+}
+
+// Cache lookups keyed by full strings (hash and compare the text) against the same lookups keyed by interned symbols
+inline bool TestInternedKeyLookup() {
+    std::cout << "\n=== Testing Interned Key Lookup Performance ===" << std::endl;
+
+    constexpr int kNameCount = 64;
+    constexpr int kLookupCount = 2000000;
+
+    std::vector<std::string> names;
+    for (int i = 0; i < kNameCount; ++i) {
+        names.push_back("/usr/share/fonts/truetype/family_" + std::to_string(i) + ".ttf");
+    }
+    std::vector<InternedString> symbols(names.begin(), names.end());
+
+    std::unordered_map<std::string, int> string_map;
+    std::unordered_map<InternedString, int> symbol_map;
+    for (int i = 0; i < kNameCount; ++i) {
+        string_map.emplace(names[i], i);
+        symbol_map.emplace(symbols[i], i);
+    }
+
+    std::mt19937 gen(4242);
+    std::uniform_int_distribution<int> pick(0, kNameCount - 1);
+    std::vector<int> order(kLookupCount);
+    for (int& index : order) {
+        index = pick(gen);
+    }
+
+    long long string_sum = 0;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int index : order) {
+        string_sum += string_map.find(names[index])->second;
+    }
+    const double string_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    long long symbol_sum = 0;
+    start_time = std::chrono::high_resolution_clock::now();
+    for (int index : order) {
+        symbol_sum += symbol_map.find(symbols[index])->second;
+    }
+    const double symbol_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    std::cout << "String keys: " << string_ms << " ms for " << kLookupCount << " lookups" << std::endl;
+    std::cout << "Symbol keys: " << symbol_ms << " ms (" << (symbol_ms > 0.0 ? string_ms / symbol_ms : 0.0) << "x)" << std::endl;
+    std::cout << "Results match: " << (string_sum == symbol_sum ? "PASS" : "FAIL") << std::endl;
+    return string_sum == symbol_sum;
 }
 
-// Run all performance tests
-void RunAllTests() {
+// Run all performance tests; returns the number that failed their check
+inline int RunAllTests() {
     std::cout << "=== PCB Renderer Performance Tests ===" << std::endl;
-    TestVectorizedMath();
-    TestSpatialIndexing();
-    std::cout << "=== Performance Tests Complete ===" << std::endl;
+    int failures = 0;
+    failures += TestVectorizedMath() ? 0 : 1;
+    failures += TestSpatialIndexing() ? 0 : 1;
+    failures += TestBulkBoardTransform() ? 0 : 1;
+    failures += TestBoardLoadUnload() ? 0 : 1;
+    failures += TestInternedKeyLookup() ? 0 : 1;
+    std::cout << "=== Performance Tests Complete: " << failures << " failed ===" << std::endl;
+    return failures;
 }
 
 } // namespace performance_test
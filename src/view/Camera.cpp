@@ -13,10 +13,6 @@ const float kDefaultZoom = 2.5f;
 const Vec2 kDefaultPosition = {0.0f, 0.0f};
 const float kDefaultRotation = 0.0f;
 
-// Define zoom limits
-const float kMinZoomLevel = 0.01f;
-const float kMaxZoomLevel = 100.0f;
-
 // Define PI if not available from cmath or a math library
 #ifndef M_PI
 #    define M_PI 3.14159265358979323846
@@ -26,6 +26,10 @@ public:
     void SetZoom(float zoom);  // Zoom level (e.g., 1.0f = normal, >1.0f = zoomed in, <1.0f = zoomed out)
     [[nodiscard]] float GetZoom() const;
 
+    // SetZoom clamps to these
+    static constexpr float kMinZoomLevel = 0.01f;
+    static constexpr float kMaxZoomLevel = 100.0f;
+
     void SetRotation(float angle_degrees);  // Rotation in degrees
     [[nodiscard]] float GetRotation() const;
 
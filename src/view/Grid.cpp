@@ -519,6 +519,123 @@ void Grid::DrawGridDots(BLContext& bl_ctx,
     }
 }
 
+bool Grid::TileKey::operator==(const TileKey& other) const
+{
+    return style == other.style && size == other.size && subdivisions == other.subdivisions && draw_major == other.draw_major &&
+           major_color == other.major_color && minor_color == other.minor_color && line_thickness == other.line_thickness &&
+           dot_radius == other.dot_radius;
+}
+
+void Grid::BuildTile(const TileKey& key) const
+{
+    if (m_tile_image_.width() != key.size || m_tile_image_.height() != key.size) {
+        m_tile_image_.create(key.size, key.size, BL_FORMAT_PRGB32);
+    }
+
+    BLContext tile_ctx(m_tile_image_);
+    tile_ctx.clearAll();
+
+    // Lattice points on the tile edges are drawn on both opposite edges; the halves meet when the tile repeats
+    const double size = static_cast<double>(key.size);
+    if (key.style == GridStyle::kLines) {
+        BLPath minor_path;
+        for (int i = 0; i <= key.subdivisions; ++i) {
+            const double offset = size * i / key.subdivisions;
+            minor_path.moveTo(offset, 0.0);
+            minor_path.lineTo(offset, size);
+            minor_path.moveTo(0.0, offset);
+            minor_path.lineTo(size, offset);
+        }
+        tile_ctx.setStrokeWidth(key.line_thickness);
+        if (!minor_path.empty()) {
+            tile_ctx.setStrokeStyle(BLRgba32(key.minor_color));
+            tile_ctx.strokePath(minor_path);
+        }
+        if (key.draw_major) {
+            BLPath major_path;
+            for (double offset : {0.0, size}) {
+                major_path.moveTo(offset, 0.0);
+                major_path.lineTo(offset, size);
+                major_path.moveTo(0.0, offset);
+                major_path.lineTo(size, offset);
+            }
+            tile_ctx.setStrokeStyle(BLRgba32(key.major_color));
+            tile_ctx.strokePath(major_path);
+        }
+    } else {
+        BLPath minor_dots;
+        for (int i = 0; i <= key.subdivisions; ++i) {
+            for (int j = 0; j <= key.subdivisions; ++j) {
+                minor_dots.addCircle(BLCircle(size * i / key.subdivisions, size * j / key.subdivisions, key.dot_radius));
+            }
+        }
+        if (!minor_dots.empty()) {
+            tile_ctx.setFillStyle(BLRgba32(key.minor_color));
+            tile_ctx.fillPath(minor_dots);
+        }
+        if (key.draw_major) {
+            BLPath major_dots;
+            for (double x : {0.0, size}) {
+                for (double y : {0.0, size}) {
+                    major_dots.addCircle(BLCircle(x, y, key.dot_radius));
+                }
+            }
+            tile_ctx.setFillStyle(BLRgba32(key.major_color));
+            tile_ctx.fillPath(major_dots);
+        }
+    }
+    tile_ctx.end();
+    m_tile_key_ = key;
+}
+
+bool Grid::DrawTiledGrid(BLContext& bl_ctx,
+                         const Camera& camera,
+                         const Viewport& viewport,
+                         float major_spacing,
+                         int effective_subdivisions,
+                         bool actually_draw_major,
+                         bool actually_draw_minor) const
+{
+    const double major_px = static_cast<double>(major_spacing) * camera.GetZoom();
+    if (!std::isfinite(major_px) || major_px > kMaxTileSize) {
+        return false;
+    }
+    if (!actually_draw_major && !actually_draw_minor) {
+        return true;  // Nothing to draw
+    }
+
+    TileKey key;
+    key.style = m_settings_->m_style;
+    key.size = std::max(1, static_cast<int>(std::lround(major_px)));
+    key.subdivisions = actually_draw_minor ? effective_subdivisions : 0;
+    key.draw_major = actually_draw_major;
+    key.major_color = m_settings_->m_major_line_color.value;
+    key.minor_color = m_settings_->m_minor_line_color.value;
+    key.line_thickness = m_settings_->m_line_thickness;
+    key.dot_radius = m_settings_->m_dot_radius;
+    if (m_tile_image_.empty() || !(key == m_tile_key_)) {
+        BuildTile(key);
+    }
+
+    // Tile pixels to screen: the world lattice point nearest the camera is the tile origin, so large coordinates keep
+    // their precision; the tile is scaled by the rounding of its size and rotated with the camera.
+    const Vec2 camera_position = camera.GetPosition();
+    const Vec2 lattice_origin = {std::floor(camera_position.x_ax / major_spacing) * major_spacing, std::floor(camera_position.y_ax / major_spacing) * major_spacing};
+    const Vec2 screen_origin = viewport.WorldToScreen(lattice_origin, camera);
+    if (!std::isfinite(screen_origin.x_ax) || !std::isfinite(screen_origin.y_ax)) {
+        return false;
+    }
+    const double scale = major_px / key.size;
+    const double cos_a = camera.GetCachedCosRotation() * scale;
+    const double sin_a = camera.GetCachedSinRotation() * scale;
+    const BLPattern pattern(m_tile_image_, BL_EXTEND_MODE_REPEAT, BLMatrix2D(cos_a, -sin_a, sin_a, cos_a, screen_origin.x_ax, screen_origin.y_ax));
+
+    bl_ctx.setHint(BL_CONTEXT_HINT_PATTERN_QUALITY, BL_PATTERN_QUALITY_BILINEAR);
+    bl_ctx.setFillStyle(pattern);
+    bl_ctx.fillRect(BLRect(0, 0, viewport.GetWidth(), viewport.GetHeight()));
+    return true;
+}
+
 void Grid::DrawLinesStyle(BLContext& bl_ctx,
                           const Camera& camera,
                           const Viewport& viewport,
@@ -661,7 +778,10 @@ void Grid::Render(BLContext& bl_ctx, const Camera& camera, const Viewport& viewp
         bl_ctx.clipToRect(BLRect(0, 0, viewport.GetWidth(), viewport.GetHeight()));
 
         // Draw grid elements
-        if (m_settings_->m_style == GridStyle::kLines) {
+        if (DrawTiledGrid(bl_ctx, camera, viewport, eff_major_spacing_world, effective_subdivisions_to_consider, actually_draw_major_elements,
+                          actually_draw_minor_elements)) {
+            // Filled from the cached tile
+        } else if (m_settings_->m_style == GridStyle::kLines) {
             DrawLinesStyle(bl_ctx, camera, viewport, eff_major_spacing_world, eff_minor_spacing_world, world_min, world_max, actually_draw_major_elements, actually_draw_minor_elements);
         } else if (m_settings_->m_style == GridStyle::kDots) {
             DrawDotsStyle(bl_ctx, camera, viewport, eff_major_spacing_world, eff_minor_spacing_world, world_min, world_max, actually_draw_major_elements, actually_draw_minor_elements);
@@ -57,6 +57,7 @@ public:
 
     // Update settings if needed (e.g., if settings are not owned via shared_ptr)
     // void SetSettings(const GridSettings& settings);
+    [[nodiscard]] const GridSettings& GetSettings() const { return *m_settings_; }
 
     // Calculates effective spacings and subdivision count based on settings and camera zoom.
     void GetEffectiveSpacings(const Camera& camera,
@@ -65,7 +66,27 @@ public:
                               int& out_effective_subdivisions  // Output: Effective number of subdivisions to consider for rendering
     ) const;
 
+    // Performance optimization: Largest grid period, in pixels, drawn from a cached tile; beyond it only a few lines are
+    // on screen and they are drawn as paths
+    static constexpr int kMaxTileSize = 1024;
+
 private:
+    // One period of the grid (a major cell with its minor lines/dots), rasterized once and filled as a repeating
+    // pattern, so drawing costs the same however dense the grid is. Panning or rotating only moves the pattern;
+    // the tile is redrawn only when its pixel size or the settings drawn into it change.
+    struct TileKey {
+        GridStyle style = GridStyle::kLines;
+        int size = 0;          // Pixels per major period
+        int subdivisions = 0;  // Minor cells per major period drawn into the tile; 0 if minor lines/dots are hidden
+        bool draw_major = false;
+        uint32_t major_color = 0;
+        uint32_t minor_color = 0;
+        float line_thickness = 0.0F;
+        float dot_radius = 0.0F;
+
+        bool operator==(const TileKey& other) const;
+    };
+
     // Settings and old Blend2D font members (kept for backward compatibility with old readout method)
     std::shared_ptr<GridSettings> m_settings_;
     mutable BLFontFace m_font_face_ {};
@@ -73,8 +94,22 @@ private:
     mutable bool m_font_initialized_ = false;
     mutable bool m_font_load_failed_ = false;
 
+    // Tile cache; only touched by the thread that renders the grid
+    mutable BLImage m_tile_image_ {};
+    mutable TileKey m_tile_key_ {};
+
     // Helper methods
     void InitializeFont() const;
+
+    // Fills the grid with the cached tile; false if the period is too large for a tile and paths must be drawn
+    bool DrawTiledGrid(BLContext& bl_ctx,
+                       const Camera& camera,
+                       const Viewport& viewport,
+                       float major_spacing,
+                       int effective_subdivisions,
+                       bool actually_draw_major,
+                       bool actually_draw_minor) const;
+    void BuildTile(const TileKey& key) const;
     static void GetVisibleWorldBounds(const Camera& camera, const Viewport& viewport, Vec2& out_min_world, Vec2& out_max_world);
 
     void DrawLinesStyle(BLContext& bl_ctx,